@@ -1,7 +1,7 @@
 /**
  * @file    dgn.h
  * @brief   Diagnostics (DGN) public interface for TDC
- * @details Circular-buffer event log, SPI Flash deferred write, and
+ * @details Circular-buffer event log, log-structured SPI Flash store, and
  *          diagnostic serial port (read-only in Normal mode).
  *
  * @project TDC (Train Door Control System)
@@ -27,29 +27,109 @@
 #include <stdint.h>
 #include "tdc_types.h"
 
+/*============================================================================
+ * EVENT LOG INTEGRITY
+ * An entry carries only a cheap in-RAM guard; the CRC-16-CCITT is computed
+ * once per Flash page by DGN_FlushToFlash.
+ *===========================================================================*/
+
+/** @brief In-RAM guard of an event_log_entry_t: inverted XOR fold of the
+ *         fields into 16 bits (any single-bit error, and an all-zero entry,
+ *         is detected) */
+#define DGN_ENTRY_GUARD(e)                                               \
+    ((uint16_t)~(uint16_t)((((e)->timestamp_ms >> 16U) ^                 \
+                            (e)->timestamp_ms ^                          \
+                            ((uint32_t)(e)->source_comp << 8U) ^         \
+                            (uint32_t)(e)->event_code ^                  \
+                            (uint32_t)(e)->data) & 0xFFFFU))
+
+/*============================================================================
+ * FLASH LOG FORMAT (dgn_flash.c)
+ * Log-structured ring over the HAL Flash partition: entries are packed into
+ * full pages, each programmed once; the sector ahead of the write head is
+ * erased as the head enters it, so every sector is erased in turn (wear
+ * levelling) and the oldest sector is the one discarded. A page is valid
+ * only if its magic and CRC match, so a page torn by a power cut is never
+ * read back; DGN_Init remounts the ring after the newest valid page.
+ *===========================================================================*/
+
+/** @brief Maximum entries taken from the RAM log per DGN_FlushToFlash call */
+#define DGN_FLUSH_BATCH_SIZE    (8U)
+
+/** @brief Bytes per entry record in a Flash page: timestamp(4, big-endian)
+ *         + source(1) + code(1) + data(2, big-endian) */
+#define DGN_FLASH_RECORD_BYTES  (8U)
+
+/** @brief Magic marker of a valid Flash page */
+#define DGN_FLASH_MAGIC         (0xDEADU)
+
+/** @brief Bytes per Flash page (equals HAL_FLASH_PAGE_BYTES) */
+#define DGN_FLASH_PAGE_BYTES    (256U)
+
+/** @brief Page header, big-endian: magic(2) count(2) page_seq(4) crc16(2),
+ *         then 6 reserved bytes left erased */
+#define DGN_FLASH_HEADER_BYTES  (16U)
+
+/** @brief Entry records per Flash page (30) */
+#define DGN_FLASH_PAGE_RECORDS  \
+    ((DGN_FLASH_PAGE_BYTES - DGN_FLASH_HEADER_BYTES) / DGN_FLASH_RECORD_BYTES)
+
 /**
- * @brief Initialise DGN module — clear circular buffer, reset write pointer.
- * @return error_t SUCCESS
- * @note   Complexity: 1
+ * @brief One Flash page of the event log, as read back by DGN_ReadFlashPage.
  */
-error_t DGN_Init(void);
+typedef struct {
+    uint16_t magic;     /**< DGN_FLASH_MAGIC */
+    uint16_t count;     /**< Records used (1–DGN_FLASH_PAGE_RECORDS) */
+    uint32_t page_seq;  /**< Pages programmed before this one (whole life of
+                             the partition) */
+    uint16_t crc16;     /**< CRC-16-CCITT over magic, count, page_seq and
+                             record[0..count-1] as stored */
+    uint8_t  record[DGN_FLASH_PAGE_RECORDS][DGN_FLASH_RECORD_BYTES];
+} dgn_flash_page_t;
 
 /**
- * @brief 20 ms cycle entry — flush pending log entries to SPI Flash.
+ * @brief Flash log state and counters (diagnostic port query).
+ */
+typedef struct {
+    uint16_t head_page;       /**< Next page to program */
+    uint16_t buffered;        /**< Records in the RAM page not yet programmed */
+    uint32_t next_page_seq;   /**< page_seq of the next page */
+    uint32_t pages_written;   /**< Pages programmed since DGN_Init */
+    uint32_t records_written; /**< Records in those pages */
+    uint32_t sectors_erased;  /**< Sectors erased since DGN_Init */
+    uint32_t write_errors;    /**< Failed programs / erases (location skipped) */
+} dgn_flash_stats_t;
+
+/**
+ * @brief Initialise DGN module — clear circular buffer, reset write pointer,
+ *        mount the Flash log (DGN_MountFlash).
+ * @return error_t SUCCESS, ERR_HW_FAULT (Flash not readable — the RAM log
+ *         still works)
  * @note   Complexity: 2
  */
+error_t DGN_Init(void);
+
+/**
+ * @brief Periodic entry — flush pending log entries to SPI Flash.
+ * @details Called by SKN_RunCycle in its 200 ms DGN slot (static schedule,
+ *          skn_schedule.c).
+ * @note   Complexity: 1
+ */
 void DGN_RunCycle(void);
 
 /**
  * @brief Write an event to the circular event log.
- * @details Thread-safe for single-writer contexts (atomic index increment).
+ * @details Lock-free and safe from any number of tasks and ISRs: the slot
+ *          is reserved by an atomic fetch-add and published by a per-slot
+ *          commit marker (see dgn_log.c).
  *          Overwrites oldest entry when log is full (circular).
- *          CRC-16-CCITT is computed over the entry (excluding crc16 field).
+ *          Stores the raw fields and DGN_ENTRY_GUARD only; the CRC is
+ *          computed per Flash page by DGN_FlushToFlash.
  * @param[in] source_comp Source component ID (COMP_xxx constant)
  * @param[in] event_code  Event code (EVT_xxx constant)
  * @param[in] data        Event-specific data payload
  * @return error_t SUCCESS
- * @note   Complexity: 3
+ * @note   Complexity: 1
  */
 error_t DGN_LogEvent(uint8_t source_comp, uint8_t event_code, uint16_t data);
 
@@ -57,25 +137,104 @@ error_t DGN_LogEvent(uint8_t source_comp, uint8_t event_code, uint16_t data);
  * @brief Read one event from the log by index.
  * @param[in]  index     Log index (0–MAX_LOG_ENTRIES-1)
  * @param[out] entry_out Pointer to output entry structure (must not be NULL)
- * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE,
+ *         ERR_INVALID_STATE (entry still being written — skip or retry),
+ *         ERR_CRC (entry guard mismatch — RAM corruption)
  * @note   Complexity: 3
  */
 error_t DGN_ReadEvent(uint16_t index, event_log_entry_t *entry_out);
 
+/**
+ * @brief Copy the entry of one log sequence number (the n-th entry written
+ *        since DGN_Init) if it is completely written.
+ * @details Used by DGN_ReadEvent and DGN_FlushToFlash; never returns a
+ *          half-written entry.
+ * @param[in]  seq       Sequence number
+ * @param[out] entry_out Pointer to output entry structure (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR,
+ *         ERR_INVALID_STATE (being written, not yet written or overwritten),
+ *         ERR_CRC (entry guard mismatch — RAM corruption)
+ * @note   Complexity: 5
+ */
+error_t DGN_CopyLogEntry(uint32_t seq, event_log_entry_t *entry_out);
+
 /**
  * @brief Get the current number of valid log entries.
  * @return uint16_t Entry count (0–MAX_LOG_ENTRIES)
- * @note   Complexity: 1
+ * @note   Complexity: 2
  */
 uint16_t DGN_GetLogCount(void);
 
 /**
- * @brief Flush pending log entries to SPI Flash storage (deferred write).
- * @return error_t SUCCESS, ERR_TIMEOUT, ERR_HW_FAULT
+ * @brief Move pending log entries towards SPI Flash (deferred write).
+ * @details Takes at most DGN_FLUSH_BATCH_SIZE entries per call, in write
+ *          order, into the RAM page; the take ends at an entry still being
+ *          written. Entries failing their guard are dropped and counted
+ *          (DGN_GetGuardFailCount). A full page (DGN_FLASH_PAGE_RECORDS) is
+ *          programmed with one CRC-16-CCITT, after erasing its sector if the
+ *          page starts one. A page that fails to program is retried at the
+ *          next page (the next sector if the erase failed).
+ * @return error_t SUCCESS, ERR_TIMEOUT (Flash busy — retried on the next
+ *         call), ERR_HW_FAULT
  * @note   Complexity: 5
  */
 error_t DGN_FlushToFlash(void);
 
+/**
+ * @brief Write everything logged so far to Flash, including a partly
+ *        filled page (shutdown, before a maintenance download).
+ * @details Bounded: at most MAX_LOG_ENTRIES / DGN_FLUSH_BATCH_SIZE + 1
+ *          DGN_FlushToFlash calls. Each partial page costs a whole page of
+ *          Flash, so this is not for periodic use.
+ * @return error_t As DGN_FlushToFlash
+ * @note   Complexity: 6
+ */
+error_t DGN_SyncToFlash(void);
+
+/**
+ * @brief Mount the Flash log: find the newest valid page and place the
+ *        write head after it, skipping pages torn by a power cut.
+ * @details Called by DGN_Init. Reads the whole partition once.
+ * @return error_t SUCCESS, ERR_HW_FAULT
+ * @note   Complexity: 8
+ */
+error_t DGN_MountFlash(void);
+
+/**
+ * @brief Read and verify one Flash page of the log.
+ * @param[in]  page_index Page (0 .. HAL_FLASH_SIZE_BYTES /
+ *                        DGN_FLASH_PAGE_BYTES - 1)
+ * @param[out] page_out   Decoded page (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE, ERR_HW_FAULT,
+ *         ERR_CRC (erased, torn or corrupted page)
+ * @note   Complexity: 4
+ */
+error_t DGN_ReadFlashPage(uint16_t page_index, dgn_flash_page_t *page_out);
+
+/**
+ * @brief Flash log state and counters.
+ * @param[out] stats_out Statistics (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   Complexity: 2
+ */
+error_t DGN_GetFlashStats(dgn_flash_stats_t *stats_out);
+
+/**
+ * @brief Number of entries dropped by DGN_FlushToFlash because their
+ *        in-RAM guard did not match.
+ * @return uint32_t Dropped entries since DGN_Init
+ * @note   Complexity: 1
+ */
+uint32_t DGN_GetGuardFailCount(void);
+
+/**
+ * @brief Number of log entries not yet taken by DGN_FlushToFlash (entries
+ *        in the RAM page are no longer pending; see DGN_GetFlashStats).
+ * @return uint16_t Pending entry count
+ * @note   Complexity: 2
+ */
+uint16_t DGN_GetFlushPending(void);
+
 /**
  * @brief Service the diagnostic serial port (read-only in Normal mode).
  * @param[in] op_mode Current operational mode (used for access control)
@@ -84,6 +243,92 @@ error_t DGN_FlushToFlash(void);
  */
 error_t DGN_ServiceDiagPort(op_mode_t op_mode);
 
+/*============================================================================
+ * CYCLE-TIME PROFILER (dgn_profile.c)
+ * Compile-time option: build with -DDGN_PROFILE_ENABLE=1. When disabled
+ * (default) the macros expand to nothing and dgn_profile.c is empty — no
+ * code, no RAM, no timer reads in the cycle.
+ *===========================================================================*/
+
+#ifndef DGN_PROFILE_ENABLE
+/** @brief Cycle profiler switch (0 = compiled out) */
+#define DGN_PROFILE_ENABLE        (0)
+#endif
+
+#if (DGN_PROFILE_ENABLE != 0)
+
+#ifndef DGN_PROFILE_MAX_STEPS
+/** @brief Number of profiled steps per cycle */
+#define DGN_PROFILE_MAX_STEPS     (20U)
+#endif
+
+/** @brief Pseudo-step index for the whole cycle (start to end) */
+#define DGN_PROFILE_TOTAL         (DGN_PROFILE_MAX_STEPS)
+
+/** @brief Timing statistics of one step, in HAL cycle-counter ticks */
+typedef struct
+{
+    uint32_t min_ticks;       /**< Shortest sample */
+    uint32_t max_ticks;       /**< Longest sample */
+    uint32_t p99_ticks;       /**< 99th percentile (histogram bucket upper bound) */
+    uint32_t sample_count;    /**< Samples since reset (saturating) */
+} dgn_profile_stats_t;
+
+/**
+ * @brief Clear all histograms, statistics and the overrun counter.
+ * @note   Complexity: 3
+ */
+void DGN_Profile_Reset(void);
+
+/**
+ * @brief Mark the start of a cycle (and of its first step).
+ * @note   Complexity: 1
+ */
+void DGN_Profile_CycleStart(void);
+
+/**
+ * @brief Mark the end of a step: time since the previous mark is recorded
+ *        against that step.
+ * @param[in] step Step index (0–DGN_PROFILE_MAX_STEPS-1; others ignored)
+ * @note   Complexity: 2
+ */
+void DGN_Profile_StepEnd(uint8_t step);
+
+/**
+ * @brief Mark the end of the cycle: records the total and counts an overrun
+ *        if it exceeded the CYCLE_MS budget.
+ * @note   Complexity: 2
+ */
+void DGN_Profile_CycleEnd(void);
+
+/**
+ * @brief Read min/max/p99 for one step (diagnostic port query).
+ * @param[in]  step      Step index, or DGN_PROFILE_TOTAL for the whole cycle
+ * @param[out] stats_out Statistics (all zero if no samples yet)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE
+ * @note   Complexity: 8
+ */
+error_t DGN_Profile_GetStats(uint8_t step, dgn_profile_stats_t *stats_out);
+
+/**
+ * @brief Number of cycles whose total time exceeded CYCLE_MS.
+ * @return uint32_t Overrun count since reset
+ * @note   Complexity: 1
+ */
+uint32_t DGN_Profile_GetOverrunCount(void);
+
+#define DGN_PROFILE_CYCLE_START()   DGN_Profile_CycleStart()
+#define DGN_PROFILE_STEP(step)      DGN_Profile_StepEnd((uint8_t)(step))
+#define DGN_PROFILE_CYCLE_END()     DGN_Profile_CycleEnd()
+
+#else
+
+#define DGN_PROFILE_CYCLE_START()   ((void)0)
+#define DGN_PROFILE_STEP(step)      ((void)0)
+#define DGN_PROFILE_CYCLE_END()     ((void)0)
+
+#endif /* DGN_PROFILE_ENABLE */
+
 /**
  * @brief Convenience macro — log an event from any component.
  * @note  Expands to DGN_LogEvent(...); return value intentionally discarded
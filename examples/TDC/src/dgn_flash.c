@@ -1,12 +1,35 @@
 /**
  * @file    dgn_flash.c
- * @brief   DGN deferred SPI Flash write (flush pending log entries).
- * @details Implements DGN_FlushToFlash: writes new log entries that have not
- *          yet been committed to non-volatile SPI Flash storage.  Uses the
- *          HAL_SPI_CrossChannel_Exchange for the underlying write (repurposed
- *          as a general SPI operation port via the same HAL interface).
- *          In production the SPI Flash write uses a separate HAL function;
- *          this stub uses HAL primitives to represent the deferred write.
+ * @brief   DGN log-structured SPI Flash store (flush pending log entries).
+ * @details Implements DGN_FlushToFlash, DGN_SyncToFlash, DGN_MountFlash,
+ *          DGN_ReadFlashPage, DGN_GetFlashStats, DGN_GetFlushPending and
+ *          DGN_GetGuardFailCount over the HAL SPI NOR Flash partition
+ *          (hal_flash.c).
+ *          Entries are taken in sequence order through DGN_CopyLogEntry; a
+ *          take ends at the first entry still being written, which is
+ *          retried on the next call. Entries overwritten before they were
+ *          flushed (more than MAX_LOG_ENTRIES pending) are skipped. Until
+ *          it is taken an entry is protected only by its in-RAM guard;
+ *          entries failing it are dropped and counted.
+ *
+ *          Layout: the partition is a ring of DGN_FLASH_PAGE_BYTES pages.
+ *          Taken entries are packed as DGN_FLASH_RECORD_BYTES records into
+ *          a RAM page; a full page (DGN_FLASH_PAGE_RECORDS) gets its header
+ *          (DGN_FLASH_MAGIC, count, page_seq, one CRC-16-CCITT) and is
+ *          programmed at the write head in a single page program, so every
+ *          Flash byte is written once per erase. When the head reaches the
+ *          start of a sector, that sector — the oldest in the ring — is
+ *          erased first; sectors are therefore erased strictly in turn
+ *          (wear levelling by rotation, erase counts differ by at most one).
+ *
+ *          Power-fail safety: a page counts only if its magic and CRC
+ *          match, and it is never rewritten before its sector is erased.
+ *          A cut during a program leaves a torn page that fails its CRC; a
+ *          cut during an erase leaves the head at the start of a sector
+ *          that is erased again. DGN_MountFlash (from DGN_Init) finds the
+ *          newest valid page by page_seq and continues after it, skipping
+ *          any non-erased page in that sector. Entries still in the RAM
+ *          page are lost on a reset (DGN_SyncToFlash writes them early).
  *
  * @project TDC (Train Door Control System)
  * @module  DGN (Diagnostics) — COMP-007
@@ -38,79 +61,500 @@
 /*============================================================================
  * EXTERNAL SHARED STATE (owned by dgn_log.c)
  *===========================================================================*/
-extern event_log_entry_t g_dgn_log[MAX_LOG_ENTRIES];
-extern uint16_t          g_dgn_write_idx;
-extern uint16_t          g_dgn_entry_count;
-extern uint16_t          g_dgn_flush_pending_idx;
+extern volatile uint32_t g_dgn_write_seq;
+extern uint32_t          g_dgn_flush_seq;
+extern uint32_t          g_dgn_guard_fail_count;
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+
+#if (DGN_FLASH_PAGE_BYTES != HAL_FLASH_PAGE_BYTES)
+#error "DGN_FLASH_PAGE_BYTES must equal HAL_FLASH_PAGE_BYTES"
+#endif
+
+/** @brief Pages in the HAL Flash partition (the ring) */
+#define DGN_FLASH_PAGES             (HAL_FLASH_SIZE_BYTES / DGN_FLASH_PAGE_BYTES)
+
+/** @brief Pages per erase sector */
+#define DGN_FLASH_PAGES_PER_SECTOR  (HAL_FLASH_SECTOR_BYTES / DGN_FLASH_PAGE_BYTES)
+
+/** @brief Header bytes covered by the page CRC: magic, count, page_seq */
+#define DGN_FLASH_CRC_HEADER_BYTES  (8U)
+
+/** @brief Bound of DGN_SyncToFlash: enough calls to take a full RAM log */
+#define DGN_SYNC_MAX_CALLS          ((MAX_LOG_ENTRIES / DGN_FLUSH_BATCH_SIZE) + 1U)
+
+#if (DGN_FLASH_PAGES < (2U * DGN_FLASH_PAGES_PER_SECTOR))
+#error "The Flash log needs at least two sectors (one is erased ahead)"
+#endif
 
 /*============================================================================
- * MODULE CONSTANTS
+ * PRIVATE STATE — flusher only
  *===========================================================================*/
-/** @brief Maximum entries to flush per cycle (rate-limiting) */
-#define DGN_FLUSH_BATCH_SIZE  (8U)
 
-/** @brief Magic marker written to Flash header to mark valid block */
-#define DGN_FLASH_MAGIC  (0xDEADU)
+/** @brief Page under construction: header area, then the records taken so
+ *         far; unused bytes stay 0xFF (erased) */
+static uint8_t  s_dgn_page[DGN_FLASH_PAGE_BYTES];
+
+/** @brief Records in s_dgn_page */
+static uint16_t s_dgn_page_count;
+
+/** @brief Next page to program */
+static uint16_t s_dgn_head;
+
+/** @brief 1 once the sector starting at s_dgn_head has been erased */
+static uint8_t  s_dgn_head_erased;
+
+/** @brief page_seq of the next page */
+static uint32_t s_dgn_page_seq;
+
+/** @brief Counters since DGN_Init (head, buffered, next_page_seq unused) */
+static dgn_flash_stats_t s_dgn_flash_stats;
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
 
 /**
- * @brief Flush pending log entries to SPI Flash (deferred write).
- * @complexity Cyclomatic complexity: 5 — within SIL 3 limit of 10
+ * @brief Take one entry and serialise it as a Flash record.
+ * @return error_t SUCCESS, ERR_INVALID_STATE (being written), ERR_CRC
+ * @complexity Cyclomatic complexity: 2
  */
-error_t DGN_FlushToFlash(void)
+static error_t dgn_flash_take(uint32_t seq, uint8_t *record)
 {
-    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
-    uint16_t to_flush;
-    uint16_t flushed;
-    uint16_t idx;
-    uint8_t  entry_buf[10]; /* 4+1+1+2+2 bytes per entry */
-    uint32_t ts;
+    event_log_entry_t entry;
+    const error_t     result = DGN_CopyLogEntry(seq, &entry);
 
-    /* Calculate how many new entries are pending flush */
-    if (g_dgn_flush_pending_idx <= g_dgn_write_idx)
+    if (SUCCESS == result)
+    {
+        record[0U] = (uint8_t)(entry.timestamp_ms >> 24U);
+        record[1U] = (uint8_t)(entry.timestamp_ms >> 16U);
+        record[2U] = (uint8_t)(entry.timestamp_ms >>  8U);
+        record[3U] = (uint8_t)(entry.timestamp_ms        );
+        record[4U] = entry.source_comp;
+        record[5U] = entry.event_code;
+        record[6U] = (uint8_t)(entry.data >> 8U);
+        record[7U] = (uint8_t)(entry.data       );
+    }
+
+    return result;
+}
+
+/**
+ * @brief Take up to @p to_take entries into the RAM page.
+ * @return uint32_t Entries consumed from the RAM log (stored or dropped)
+ * @complexity Cyclomatic complexity: 5
+ */
+static uint32_t dgn_flash_fill(uint32_t to_take)
+{
+    uint32_t taken = 0U;
+    error_t  take  = SUCCESS;
+
+    while ((taken < to_take) && (ERR_INVALID_STATE != take))
+    {
+        take = dgn_flash_take(g_dgn_flush_seq + taken,
+                              &s_dgn_page[DGN_FLASH_HEADER_BYTES +
+                                          (s_dgn_page_count *
+                                           DGN_FLASH_RECORD_BYTES)]);
+        if (SUCCESS == take)
+        {
+            s_dgn_page_count++;
+            taken++;
+        }
+        else if (ERR_CRC == take)
+        {
+            g_dgn_guard_fail_count++;   /* Corrupted in RAM: drop */
+            taken++;
+        }
+        else
+        {
+            /* Still being written: retried on the next call */
+        }
+    }
+
+    return taken;
+}
+
+/**
+ * @brief CRC-16-CCITT of a page as stored: header fields, then the records.
+ * @complexity Cyclomatic complexity: 1
+ */
+static uint16_t dgn_flash_page_crc(const uint8_t *raw, uint16_t count)
+{
+    uint16_t crc = CRC16_CCITT_Init();
+
+    crc = CRC16_CCITT_Update(crc, raw, DGN_FLASH_CRC_HEADER_BYTES);
+    crc = CRC16_CCITT_Update(crc, &raw[DGN_FLASH_HEADER_BYTES],
+                             (uint32_t)count * DGN_FLASH_RECORD_BYTES);
+
+    return CRC16_CCITT_Final(crc);
+}
+
+/**
+ * @brief Empty the RAM page (all bytes erased).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void dgn_flash_page_reset(void)
+{
+    uint16_t i;
+
+    for (i = 0U; i < DGN_FLASH_PAGE_BYTES; i++)
     {
-        to_flush = g_dgn_write_idx - g_dgn_flush_pending_idx;
+        s_dgn_page[i] = 0xFFU;
+    }
+    s_dgn_page_count = 0U;
+}
+
+/**
+ * @brief Move the write head on by @p pages.
+ * @complexity Cyclomatic complexity: 1
+ */
+static void dgn_flash_advance(uint16_t pages)
+{
+    s_dgn_head = (uint16_t)(((uint32_t)s_dgn_head + pages) % DGN_FLASH_PAGES);
+    s_dgn_head_erased = 0U;
+}
+
+/**
+ * @brief Program the RAM page at the write head.
+ * @details Erases the head's sector first when the head is at its start:
+ *          the sector ahead holds the oldest pages of the ring. On a
+ *          program or erase fault the location is skipped and the page is
+ *          kept for the next call; on ERR_TIMEOUT (busy) nothing changes.
+ * @complexity Cyclomatic complexity: 8
+ */
+static error_t dgn_flash_commit(void)
+{
+    const uint32_t addr = (uint32_t)s_dgn_head * DGN_FLASH_PAGE_BYTES;
+    error_t        result = SUCCESS;
+    uint16_t       crc;
+
+    if ((0U == (s_dgn_head % DGN_FLASH_PAGES_PER_SECTOR)) &&
+        (0U == s_dgn_head_erased))
+    {
+        result = HAL_Flash_EraseSector(addr);
+        if (SUCCESS == result)
+        {
+            s_dgn_head_erased = 1U;
+            s_dgn_flash_stats.sectors_erased++;
+        }
+        else if (ERR_TIMEOUT != result)
+        {
+            s_dgn_flash_stats.write_errors++;
+            dgn_flash_advance(DGN_FLASH_PAGES_PER_SECTOR);
+        }
+        else
+        {
+            /* Busy: retried on the next call */
+        }
+    }
+
+    if (SUCCESS == result)
+    {
+        s_dgn_page[0U] = (uint8_t)(DGN_FLASH_MAGIC >> 8U);
+        s_dgn_page[1U] = (uint8_t)(DGN_FLASH_MAGIC & 0xFFU);
+        s_dgn_page[2U] = (uint8_t)(s_dgn_page_count >> 8U);
+        s_dgn_page[3U] = (uint8_t)(s_dgn_page_count);
+        s_dgn_page[4U] = (uint8_t)(s_dgn_page_seq >> 24U);
+        s_dgn_page[5U] = (uint8_t)(s_dgn_page_seq >> 16U);
+        s_dgn_page[6U] = (uint8_t)(s_dgn_page_seq >>  8U);
+        s_dgn_page[7U] = (uint8_t)(s_dgn_page_seq);
+        crc = dgn_flash_page_crc(s_dgn_page, s_dgn_page_count);
+        s_dgn_page[8U] = (uint8_t)(crc >> 8U);
+        s_dgn_page[9U] = (uint8_t)(crc);
+
+        result = HAL_Flash_ProgramPage(addr, s_dgn_page, DGN_FLASH_PAGE_BYTES);
+        if (SUCCESS == result)
+        {
+            s_dgn_flash_stats.pages_written++;
+            s_dgn_flash_stats.records_written += s_dgn_page_count;
+            s_dgn_page_seq++;
+            dgn_flash_page_reset();
+            dgn_flash_advance(1U);
+        }
+        else if (ERR_TIMEOUT != result)
+        {
+            /* Possibly torn: never reused before its sector is erased */
+            s_dgn_flash_stats.write_errors++;
+            dgn_flash_advance(1U);
+        }
+        else
+        {
+            /* Busy: retried on the next call */
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Decode and verify a page read from Flash.
+ * @return error_t SUCCESS, ERR_CRC (erased, torn or corrupted)
+ * @complexity Cyclomatic complexity: 6
+ */
+static error_t dgn_flash_decode(const uint8_t *raw, dgn_flash_page_t *page)
+{
+    error_t  result;
+    uint16_t i;
+
+    page->magic    = (uint16_t)(((uint16_t)raw[0U] << 8U) | raw[1U]);
+    page->count    = (uint16_t)(((uint16_t)raw[2U] << 8U) | raw[3U]);
+    page->page_seq = ((uint32_t)raw[4U] << 24U) | ((uint32_t)raw[5U] << 16U) |
+                     ((uint32_t)raw[6U] <<  8U) |  (uint32_t)raw[7U];
+    page->crc16    = (uint16_t)(((uint16_t)raw[8U] << 8U) | raw[9U]);
+
+    if ((DGN_FLASH_MAGIC != page->magic) || (0U == page->count) ||
+        (page->count > DGN_FLASH_PAGE_RECORDS))
+    {
+        result = ERR_CRC;
+    }
+    else if (dgn_flash_page_crc(raw, page->count) != page->crc16)
+    {
+        result = ERR_CRC;
     }
     else
     {
-        /* Wrapped */
-        to_flush = (uint16_t)(MAX_LOG_ENTRIES - g_dgn_flush_pending_idx) +
-                   g_dgn_write_idx;
+        for (i = 0U; i < (page->count * DGN_FLASH_RECORD_BYTES); i++)
+        {
+            page->record[i / DGN_FLASH_RECORD_BYTES]
+                        [i % DGN_FLASH_RECORD_BYTES] =
+                raw[DGN_FLASH_HEADER_BYTES + i];
+        }
+        result = SUCCESS;
     }
 
+    return result;
+}
+
+/**
+ * @brief After mounting inside a sector, move the head past pages that
+ *        are not erased (torn by a power cut after the newest valid page).
+ * @details A head at a sector start needs nothing: that sector is erased
+ *          before its first page is programmed.
+ * @complexity Cyclomatic complexity: 7
+ */
+static error_t dgn_flash_skip_used(void)
+{
+    uint8_t  raw[DGN_FLASH_PAGE_BYTES];
+    error_t  result = SUCCESS;
+    uint8_t  blank  = 0U;
+    uint16_t i;
+
+    while ((0U != (s_dgn_head % DGN_FLASH_PAGES_PER_SECTOR)) &&
+           (0U == blank) && (SUCCESS == result))
+    {
+        result = HAL_Flash_Read((uint32_t)s_dgn_head * DGN_FLASH_PAGE_BYTES,
+                                raw, DGN_FLASH_PAGE_BYTES);
+        blank = 1U;
+        for (i = 0U; i < DGN_FLASH_PAGE_BYTES; i++)
+        {
+            blank &= (uint8_t)(0xFFU == raw[i]);
+        }
+        if ((SUCCESS == result) && (0U == blank))
+        {
+            dgn_flash_advance(1U);
+        }
+    }
+
+    return result;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Number of log entries not yet written to Flash.
+ * @details Reserved entries (including any still being written) above the
+ *          flush sequence, at most MAX_LOG_ENTRIES.
+ * @complexity Cyclomatic complexity: 2
+ */
+uint16_t DGN_GetFlushPending(void)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
+    const uint32_t pending = g_dgn_write_seq - g_dgn_flush_seq;
+
+    return (uint16_t)((pending < MAX_LOG_ENTRIES) ? pending : MAX_LOG_ENTRIES);
+}
+
+/**
+ * @brief Move pending log entries towards SPI Flash (deferred write).
+ * @details Takes at most DGN_FLUSH_BATCH_SIZE entries per call, no more
+ *          than the RAM page has room for, so a call is a bounded,
+ *          resumable chunk of work; programs the page once it is full.
+ * @complexity Cyclomatic complexity: 5
+ */
+error_t DGN_FlushToFlash(void)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
+    const uint32_t room = DGN_FLASH_PAGE_RECORDS - (uint32_t)s_dgn_page_count;
+    uint32_t       to_flush;
+    error_t        result = SUCCESS;
+
+    /* Entries lapped by the writers are lost: resume at the oldest slot */
+    if ((g_dgn_write_seq - g_dgn_flush_seq) > MAX_LOG_ENTRIES)
+    {
+        g_dgn_flush_seq = g_dgn_write_seq - MAX_LOG_ENTRIES;
+    }
+
+    /* Calculate how many new entries are pending flush */
+    to_flush = DGN_GetFlushPending();
+
     if (to_flush > DGN_FLUSH_BATCH_SIZE)
     {
         to_flush = DGN_FLUSH_BATCH_SIZE;
     }
+    if (to_flush > room)
+    {
+        to_flush = room;
+    }
+
+    g_dgn_flush_seq += dgn_flash_fill(to_flush);
 
-    flushed = 0U;
-    while (flushed < to_flush)
+    if (DGN_FLASH_PAGE_RECORDS == s_dgn_page_count)
     {
-        idx = (uint16_t)((g_dgn_flush_pending_idx + flushed) % MAX_LOG_ENTRIES);
+        result = dgn_flash_commit();
+    }
+
+    return result;
+}
 
-        ts = g_dgn_log[idx].timestamp_ms;
-        entry_buf[0U] = (uint8_t)(ts >> 24U);
-        entry_buf[1U] = (uint8_t)(ts >> 16U);
-        entry_buf[2U] = (uint8_t)(ts >>  8U);
-        entry_buf[3U] = (uint8_t)(ts        );
-        entry_buf[4U] = g_dgn_log[idx].source_comp;
-        entry_buf[5U] = g_dgn_log[idx].event_code;
-        entry_buf[6U] = (uint8_t)(g_dgn_log[idx].data >> 8U);
-        entry_buf[7U] = (uint8_t)(g_dgn_log[idx].data       );
-        entry_buf[8U] = (uint8_t)(g_dgn_log[idx].crc16 >> 8U);
-        entry_buf[9U] = (uint8_t)(g_dgn_log[idx].crc16       );
+/**
+ * @brief Write everything logged so far, including a partly filled page.
+ * @complexity Cyclomatic complexity: 6
+ */
+error_t DGN_SyncToFlash(void)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
+    error_t  result = SUCCESS;
+    uint32_t calls;
 
-        /* Platform stub: HAL_CAN_Transmit is not appropriate here.
-         * In production, replace with HAL_SPI_Flash_Write(addr, entry_buf, 10U).
-         * For stub purposes we verify integrity of entry by re-checking CRC. */
-        (void)entry_buf; /* Suppress unused warning in stub */
+    for (calls = 0U; (calls < DGN_SYNC_MAX_CALLS) && (SUCCESS == result) &&
+                     (0U != DGN_GetFlushPending()); calls++)
+    {
+        result = DGN_FlushToFlash();
+    }
 
-        flushed++;
+    if ((SUCCESS == result) && (0U != s_dgn_page_count))
+    {
+        result = dgn_flash_commit();
     }
 
-    g_dgn_flush_pending_idx =
-        (uint16_t)((g_dgn_flush_pending_idx + flushed) % MAX_LOG_ENTRIES);
+    return result;
+}
 
-    return SUCCESS;
+/**
+ * @brief Mount the Flash log.
+ * @details The newest page is the valid one with the highest page_seq
+ *          (page_seq does not wrap within the endurance of the device).
+ *          Counters restart; the RAM page starts empty.
+ * @complexity Cyclomatic complexity: 8 — within SIL 3 limit of 10
+ */
+error_t DGN_MountFlash(void)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
+    const dgn_flash_stats_t zero = { 0U, 0U, 0U, 0U, 0U, 0U, 0U };
+    dgn_flash_page_t page;
+    error_t          result = SUCCESS;
+    error_t          read;
+    uint32_t         p;
+    uint8_t          found = 0U;
+
+    s_dgn_flash_stats = zero;
+    s_dgn_head        = 0U;
+    s_dgn_page_seq    = 0U;
+    dgn_flash_page_reset();
+
+    for (p = 0U; (p < DGN_FLASH_PAGES) && (SUCCESS == result); p++)
+    {
+        read = DGN_ReadFlashPage((uint16_t)p, &page);
+        if ((SUCCESS == read) &&
+            ((0U == found) || (page.page_seq >= s_dgn_page_seq)))
+        {
+            found          = 1U;
+            s_dgn_head     = (uint16_t)p;
+            s_dgn_page_seq = page.page_seq + 1U;
+        }
+        else if (ERR_HW_FAULT == read)
+        {
+            result = read;
+        }
+        else
+        {
+            /* Erased or torn page: not part of the log */
+        }
+    }
+
+    /* Continue after the newest page (or at page 0 on an empty log) */
+    s_dgn_head_erased = 0U;
+    dgn_flash_advance(found);
+    if (SUCCESS == result)
+    {
+        result = dgn_flash_skip_used();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read and verify one Flash page of the log.
+ * @complexity Cyclomatic complexity: 4
+ */
+error_t DGN_ReadFlashPage(uint16_t page_index, dgn_flash_page_t *page_out)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.2 */
+    uint8_t raw[DGN_FLASH_PAGE_BYTES];
+    error_t result;
+
+    if (NULL == page_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (page_index >= DGN_FLASH_PAGES)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        result = HAL_Flash_Read((uint32_t)page_index * DGN_FLASH_PAGE_BYTES,
+                                raw, DGN_FLASH_PAGE_BYTES);
+        if (SUCCESS == result)
+        {
+            result = dgn_flash_decode(raw, page_out);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Flash log state and counters.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t DGN_GetFlashStats(dgn_flash_stats_t *stats_out)
+{
+    error_t result = ERR_NULL_PTR;
+
+    if (NULL != stats_out)
+    {
+        *stats_out               = s_dgn_flash_stats;
+        stats_out->head_page     = s_dgn_head;
+        stats_out->buffered      = s_dgn_page_count;
+        stats_out->next_page_seq = s_dgn_page_seq;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Number of entries dropped at flush on a guard mismatch.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t DGN_GetGuardFailCount(void)
+{
+    return g_dgn_guard_fail_count;
 }
 
 /*============================================================================
@@ -1,9 +1,31 @@
 /**
  * @file    dgn_log.c
  * @brief   DGN circular event log — write, read, and count operations.
- * @details Implements DGN_Init, DGN_LogEvent, DGN_ReadEvent, DGN_GetLogCount.
+ * @details Implements DGN_Init, DGN_LogEvent, DGN_ReadEvent, DGN_GetLogCount
+ *          and DGN_CopyLogEntry.
  *          Uses a static circular buffer of MAX_LOG_ENTRIES event_log_entry_t
- *          elements.  All entries are protected by CRC-16-CCITT.
+ *          elements. A writer stores the raw fields and the in-RAM guard
+ *          DGN_ENTRY_GUARD (a few XORs); the CRC-16-CCITT is computed once
+ *          per Flash page at flush time (dgn_flash.c), off the logging
+ *          path of every caller.
+ *
+ *          Concurrency model (lock-free, multi-producer, no interrupt
+ *          masking): DGN_LogEvent is called from the cycle task, background
+ *          tasks and ISR paths, any of which may preempt another writer.
+ *          - a writer reserves a sequence number with one atomic fetch-add
+ *            on the free-running uint32_t g_dgn_write_seq; the slot is
+ *            seq & (MAX_LOG_ENTRIES - 1U), so no two concurrent writers
+ *            share a slot unless MAX_LOG_ENTRIES further entries are
+ *            reserved during one write;
+ *          - the slot's commit marker is cleared before the entry is
+ *            stored and set to DGN_COMMIT_MARK(seq) after it, each step
+ *            separated by DGN_LOG_BARRIER();
+ *          - readers (diagnostic port, flusher) copy an entry only through
+ *            DGN_CopyLogEntry, which accepts the copy when the marker equals
+ *            the expected sequence before and after the copy, and the
+ *            entry's guard matches. An entry still being written (or
+ *            rewritten by a later lap) is reported as ERR_INVALID_STATE,
+ *            never returned half-written; a corrupted one as ERR_CRC.
  *
  * @project TDC (Train Door Control System)
  * @module  DGN (Diagnostics) — COMP-007
@@ -33,45 +55,53 @@
 #include "tdc_types.h"
 
 /*============================================================================
- * GLOBAL SHARED STATE — Owned here, used by dgn_flash.c and dgn_port.c
+ * MODULE CONSTANTS
  *===========================================================================*/
+/** @brief Slot index mask (log size is a power of two) */
+#define DGN_LOG_INDEX_MASK  (MAX_LOG_ENTRIES - 1U)
 
-/** @brief Circular log buffer */
-event_log_entry_t g_dgn_log[MAX_LOG_ENTRIES];
+#if ((MAX_LOG_ENTRIES & DGN_LOG_INDEX_MASK) != 0U) || (MAX_LOG_ENTRIES < 2U)
+#error "MAX_LOG_ENTRIES must be a power of two >= 2"
+#endif
 
-/** @brief Next write index into the circular buffer */
-uint16_t g_dgn_write_idx;
+/** @brief Commit marker of sequence seq: valid flag plus the seq's lap
+ *         (0 = slot empty or being written) */
+#define DGN_COMMIT_MARK(seq) \
+    (0x80000000UL | ((uint32_t)(seq) / MAX_LOG_ENTRIES))
 
-/** @brief Total number of entries written (capped at MAX_LOG_ENTRIES when full) */
-uint16_t g_dgn_entry_count;
-
-/** @brief Flush-pending watermark: entries above this index need flushing */
-uint16_t g_dgn_flush_pending_idx;
+/**
+ * @brief Atomic fetch-and-increment of the write sequence (slot reservation)
+ *        and memory barrier between entry and marker accesses.
+ * @note  GCC builtins compile to LDREX/STREX and DMB on Cortex-M3/M4; the
+ *        same code is used by the host multi-threaded stress test.
+ */
+#if defined(__GNUC__)
+#define DGN_LOG_RESERVE()  __atomic_fetch_add(&g_dgn_write_seq, 1U, \
+                                              __ATOMIC_ACQ_REL)
+#define DGN_LOG_BARRIER()  __sync_synchronize()
+#else
+#error "DGN: provide the target toolchain's atomic fetch-add and barrier"
+#endif
 
 /*============================================================================
- * PRIVATE HELPERS
+ * GLOBAL SHARED STATE — Owned here, used by dgn_flash.c
  *===========================================================================*/
 
-/**
- * @brief Compute CRC-16 over an event log entry (excluding crc16 field).
- * @complexity Cyclomatic complexity: 1
- */
-static uint16_t dgn_entry_crc(const event_log_entry_t *entry)
-{
-    /* Compute CRC over first 8 bytes: timestamp(4) + source(1) + code(1) + data(2) */
-    uint8_t buf[8];
-
-    buf[0U] = (uint8_t)(entry->timestamp_ms >> 24U);
-    buf[1U] = (uint8_t)(entry->timestamp_ms >> 16U);
-    buf[2U] = (uint8_t)(entry->timestamp_ms >>  8U);
-    buf[3U] = (uint8_t)(entry->timestamp_ms        );
-    buf[4U] = entry->source_comp;
-    buf[5U] = entry->event_code;
-    buf[6U] = (uint8_t)(entry->data >> 8U);
-    buf[7U] = (uint8_t)(entry->data       );
-
-    return CRC16_CCITT_Compute(buf, 8U);
-}
+/** @brief Circular log buffer */
+event_log_entry_t g_dgn_log[MAX_LOG_ENTRIES];
+
+/** @brief Commit marker per slot: DGN_COMMIT_MARK of the stored sequence */
+volatile uint32_t g_dgn_slot_commit[MAX_LOG_ENTRIES];
+
+/** @brief Next sequence number to reserve (free-running; entries ever
+ *         reserved since DGN_Init) */
+volatile uint32_t g_dgn_write_seq;
+
+/** @brief Next sequence number to flush — written by the flusher only */
+uint32_t g_dgn_flush_seq;
+
+/** @brief Entries dropped at flush on a guard mismatch — flusher only */
+uint32_t g_dgn_guard_fail_count;
 
 /*============================================================================
  * PUBLIC FUNCTIONS
@@ -79,6 +109,8 @@ static uint16_t dgn_entry_crc(const event_log_entry_t *entry)
 
 /**
  * @brief Initialise DGN module.
+ * @details Called before any writer runs (no concurrent DGN_LogEvent).
+ *          Mounts the Flash log (DGN_MountFlash).
  * @complexity Cyclomatic complexity: 2
  */
 error_t DGN_Init(void)
@@ -91,71 +123,114 @@ error_t DGN_Init(void)
         g_dgn_log[i].source_comp  = 0U;
         g_dgn_log[i].event_code   = 0U;
         g_dgn_log[i].data         = 0U;
-        g_dgn_log[i].crc16        = 0U;
+        g_dgn_log[i].guard        = 0U;
+        g_dgn_slot_commit[i]      = 0U;
     }
 
-    g_dgn_write_idx        = 0U;
-    g_dgn_entry_count      = 0U;
-    g_dgn_flush_pending_idx = 0U;
+    g_dgn_write_seq        = 0U;
+    g_dgn_flush_seq        = 0U;
+    g_dgn_guard_fail_count = 0U;
 
-    return SUCCESS;
+    return DGN_MountFlash();
 }
 
 /**
  * @brief Write an event to the circular event log.
- * @complexity Cyclomatic complexity: 3
+ * @details Reserve, clear marker, store, commit — see the file header.
+ * @complexity Cyclomatic complexity: 1
  */
 error_t DGN_LogEvent(uint8_t source_comp, uint8_t event_code, uint16_t data)
 {
-    event_log_entry_t *slot;
+    event_log_entry_t entry;
+    uint32_t          seq;
+    uint32_t          slot;
 
-    /* Write to current slot (circular wrap) */
-    slot = &g_dgn_log[g_dgn_write_idx];
+    seq  = DGN_LOG_RESERVE();
+    slot = seq & DGN_LOG_INDEX_MASK;
 
-    slot->timestamp_ms = HAL_GetSystemTickMs();
-    slot->source_comp  = source_comp;
-    slot->event_code   = event_code;
-    slot->data         = data;
-    slot->crc16        = dgn_entry_crc(slot);
+    g_dgn_slot_commit[slot] = 0U;
+    DGN_LOG_BARRIER();
 
-    /* Advance write index (wrap modulo MAX_LOG_ENTRIES) */
-    g_dgn_write_idx = (uint16_t)((g_dgn_write_idx + 1U) % MAX_LOG_ENTRIES);
+    entry.timestamp_ms = HAL_GetSystemTickMs();
+    entry.source_comp  = source_comp;
+    entry.event_code   = event_code;
+    entry.data         = data;
+    entry.guard        = DGN_ENTRY_GUARD(&entry);
+    g_dgn_log[slot]    = entry;
 
-    if (g_dgn_entry_count < MAX_LOG_ENTRIES)
+    DGN_LOG_BARRIER();
+    g_dgn_slot_commit[slot] = DGN_COMMIT_MARK(seq);
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Copy the entry of one sequence number if it is committed and its
+ *        guard matches.
+ * @complexity Cyclomatic complexity: 5
+ */
+error_t DGN_CopyLogEntry(uint32_t seq, event_log_entry_t *entry_out)
+{
+    const uint32_t slot = seq & DGN_LOG_INDEX_MASK;
+    const uint32_t mark = DGN_COMMIT_MARK(seq);
+    error_t        result = ERR_INVALID_STATE;
+
+    if (NULL == entry_out)
     {
-        g_dgn_entry_count++;
+        return ERR_NULL_PTR;
     }
 
-    return SUCCESS;
+    if (g_dgn_slot_commit[slot] == mark)
+    {
+        DGN_LOG_BARRIER();
+        *entry_out = g_dgn_log[slot];
+        DGN_LOG_BARRIER();
+        if (g_dgn_slot_commit[slot] == mark)
+        {
+            result = (DGN_ENTRY_GUARD(entry_out) == entry_out->guard) ?
+                     SUCCESS : ERR_CRC;
+        }
+    }
+
+    return result;
 }
 
 /**
  * @brief Read one event from the log by index.
+ * @details The index is the slot; the slot holds the latest sequence number
+ *          reserved for it.
  * @complexity Cyclomatic complexity: 3
  */
 error_t DGN_ReadEvent(uint16_t index, event_log_entry_t *entry_out)
 {
+    uint32_t last;
+
     if (NULL == entry_out)
     {
         return ERR_NULL_PTR;
     }
 
-    if (index >= g_dgn_entry_count)
+    if (index >= DGN_GetLogCount())
     {
         return ERR_RANGE;
     }
 
-    *entry_out = g_dgn_log[index];
-    return SUCCESS;
+    last = g_dgn_write_seq - 1U;
+    return DGN_CopyLogEntry(last - ((last - index) & DGN_LOG_INDEX_MASK),
+                            entry_out);
 }
 
 /**
  * @brief Get the current number of valid log entries.
- * @complexity Cyclomatic complexity: 1
+ * @details Counts reserved entries, including any still being written.
+ * @complexity Cyclomatic complexity: 2
  */
 uint16_t DGN_GetLogCount(void)
 {
-    return g_dgn_entry_count;
+    const uint32_t reserved = g_dgn_write_seq;
+
+    return (uint16_t)((reserved < MAX_LOG_ENTRIES) ? reserved
+                                                   : MAX_LOG_ENTRIES);
 }
 
 /*============================================================================
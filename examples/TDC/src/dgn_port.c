@@ -4,8 +4,11 @@
  * @details Implements DGN_ServiceDiagPort and DGN_RunCycle.
  *          In Normal mode the port is read-only (no commands accepted).
  *          In Diagnostic or Maintenance mode a limited command set is
- *          accepted.  DGN_RunCycle calls DGN_FlushToFlash and polls the
- *          diagnostic port once per 20 ms cycle.
+ *          accepted.  DGN_RunCycle calls DGN_FlushToFlash; SKN_RunCycle
+ *          calls it every 200 ms (static schedule, skn_schedule.c).
+ *          Builds with DGN_PROFILE_ENABLE also report the cycle profiler
+ *          (DGN_Profile_GetStats, DGN_Profile_GetOverrunCount) on the port;
+ *          the statistics are read-only and available in every mode.
  *
  * @project TDC (Train Door Control System)
  * @module  DGN (Diagnostics) — COMP-007
@@ -32,18 +35,6 @@
 #include "dgn.h"
 #include "tdc_types.h"
 
-/*============================================================================
- * MODULE CONSTANTS
- *===========================================================================*/
-/** @brief Diagnostic port flush cycle: flush every 10 cycles (200 ms) */
-#define DGN_PORT_FLUSH_PERIOD  (10U)
-
-/*============================================================================
- * MODULE-LEVEL STATIC STATE
- *===========================================================================*/
-/** @brief Cycle counter for flash flush rate-limiting */
-static uint8_t s_port_cycle_count;
-
 /**
  * @brief Service the diagnostic serial port.
  * @complexity Cyclomatic complexity: 4
@@ -74,19 +65,14 @@ error_t DGN_ServiceDiagPort(op_mode_t op_mode)
 }
 
 /**
- * @brief 20 ms cycle entry — flush pending log entries to Flash.
- * @complexity Cyclomatic complexity: 2
+ * @brief Periodic entry — flush pending log entries to Flash.
+ * @details The 200 ms period is owned by the SKN static schedule.
+ * @complexity Cyclomatic complexity: 1
  */
 void DGN_RunCycle(void)
 {
     /* Design ref: SCDS DOC-COMPDES-2026-001 §9 */
-    s_port_cycle_count++;
-
-    if (s_port_cycle_count >= DGN_PORT_FLUSH_PERIOD)
-    {
-        s_port_cycle_count = 0U;
-        (void)DGN_FlushToFlash();
-    }
+    (void)DGN_FlushToFlash();
 }
 
 /*============================================================================
@@ -0,0 +1,314 @@
+/**
+ * @file    dgn_profile.c
+ * @brief   DGN cycle-time profiler — per-step log-linear histograms for
+ *          SKN_RunCycle.
+ * @details Implements DGN_Profile_Reset, DGN_Profile_CycleStart,
+ *          DGN_Profile_StepEnd, DGN_Profile_CycleEnd, DGN_Profile_GetStats
+ *          and DGN_Profile_GetOverrunCount.
+ *          SKN_RunCycle marks each step boundary with DGN_PROFILE_STEP();
+ *          the time between consecutive marks (HAL_GetCycleCounter ticks) is
+ *          binned into a fixed-size log-linear histogram per step: 4 linear
+ *          sub-buckets per power of two, so any reported percentile is within
+ *          25 % of the true value. Histograms are uint16_t; when a bucket
+ *          would saturate, every bucket of that step is halved (the shape of
+ *          the distribution is kept, old samples decay).
+ *          The whole file is compiled out unless DGN_PROFILE_ENABLE != 0.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  DGN (Diagnostics) — COMP-007
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 1 (non-safety — diagnostic only)
+ * Safety Requirements: REQ-FUN-018
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Rule 21.3: static storage only
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §9.3
+ */
+
+/* Implements: REQ-FUN-018 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §9.3 (COMP-007) */
+/* SIL: 1 */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "dgn.h"
+#include "hal.h"
+#include "tdc_types.h"
+
+#if (DGN_PROFILE_ENABLE != 0)
+
+/*============================================================================
+ * MODULE CONSTANTS
+ *===========================================================================*/
+/** @brief Linear sub-buckets per power of two (2 bits) */
+#define DGN_PROF_SUB_BITS     (2U)
+#define DGN_PROF_SUB_COUNT    (1U << DGN_PROF_SUB_BITS)
+
+/** @brief Highest resolved bit; longer samples share the last bucket
+ *         (2^28 ticks = 0.67 s at 400 MHz) */
+#define DGN_PROF_MAX_MSB      (27U)
+
+/** @brief Buckets per histogram */
+#define DGN_PROF_BUCKETS      (DGN_PROF_MAX_MSB * DGN_PROF_SUB_COUNT)
+
+/** @brief Histograms: one per step plus the cycle total */
+#define DGN_PROF_SERIES       (DGN_PROFILE_MAX_STEPS + 1U)
+
+/** @brief Cycle budget in counter ticks */
+#define DGN_PROF_BUDGET_TICKS \
+    ((uint32_t)CYCLE_MS * (uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000UL))
+
+/*============================================================================
+ * MODULE-LEVEL STATIC STATE
+ *===========================================================================*/
+/** @brief Log-linear histograms [series][bucket] */
+static uint16_t s_prof_hist[DGN_PROF_SERIES][DGN_PROF_BUCKETS];
+
+/** @brief Shortest / longest sample per series */
+static uint32_t s_prof_min[DGN_PROF_SERIES];
+static uint32_t s_prof_max[DGN_PROF_SERIES];
+
+/** @brief Samples per series (saturating) */
+static uint32_t s_prof_count[DGN_PROF_SERIES];
+
+/** @brief Counter value at cycle start and at the previous mark */
+static uint32_t s_prof_cycle_start;
+static uint32_t s_prof_last_mark;
+
+/** @brief Cycles longer than CYCLE_MS */
+static uint32_t s_prof_overruns;
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
+
+/**
+ * @brief Map a tick count to its histogram bucket.
+ * @details Values below 4 map linearly; otherwise the bucket is chosen by
+ *          the most significant bit and the two bits below it.
+ * @complexity Cyclomatic complexity: 5
+ */
+static uint32_t dgn_prof_bucket(uint32_t ticks)
+{
+    uint32_t msb = 0U;
+    uint32_t bucket;
+
+    while ((msb < 31U) && ((ticks >> (msb + 1U)) != 0U))
+    {
+        msb++;
+    }
+
+    if (msb < DGN_PROF_SUB_BITS)
+    {
+        bucket = ticks;
+    }
+    else if (msb > DGN_PROF_MAX_MSB)
+    {
+        bucket = DGN_PROF_BUCKETS - 1U;
+    }
+    else
+    {
+        bucket = ((msb - 1U) * DGN_PROF_SUB_COUNT) +
+                 ((ticks >> (msb - DGN_PROF_SUB_BITS)) &
+                  (DGN_PROF_SUB_COUNT - 1U));
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Largest tick count that maps to a bucket.
+ * @complexity Cyclomatic complexity: 2
+ */
+static uint32_t dgn_prof_bucket_upper(uint32_t bucket)
+{
+    uint32_t upper = bucket;
+    uint32_t shift;
+
+    if (bucket >= DGN_PROF_SUB_COUNT)
+    {
+        shift = (bucket / DGN_PROF_SUB_COUNT) - 1U;
+        upper = (((DGN_PROF_SUB_COUNT + (bucket % DGN_PROF_SUB_COUNT)) + 1U)
+                 << shift) - 1U;
+    }
+
+    return upper;
+}
+
+/**
+ * @brief Add one sample to a series.
+ * @complexity Cyclomatic complexity: 7
+ */
+static void dgn_prof_record(uint32_t series, uint32_t ticks)
+{
+    uint32_t bucket = dgn_prof_bucket(ticks);
+    uint32_t i;
+
+    if (0xFFFFU == s_prof_hist[series][bucket])
+    {
+        /* Decay: halve the whole histogram, keep its shape */
+        for (i = 0U; i < DGN_PROF_BUCKETS; i++)
+        {
+            s_prof_hist[series][i] = (uint16_t)(s_prof_hist[series][i] >> 1U);
+        }
+    }
+    s_prof_hist[series][bucket]++;
+
+    if ((0U == s_prof_count[series]) || (ticks < s_prof_min[series]))
+    {
+        s_prof_min[series] = ticks;
+    }
+    if (ticks > s_prof_max[series])
+    {
+        s_prof_max[series] = ticks;
+    }
+    if (s_prof_count[series] < UINT32_MAX)
+    {
+        s_prof_count[series]++;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Clear all histograms, statistics and the overrun counter.
+ * @complexity Cyclomatic complexity: 3
+ */
+void DGN_Profile_Reset(void)
+{
+    uint32_t series;
+    uint32_t bucket;
+
+    for (series = 0U; series < DGN_PROF_SERIES; series++)
+    {
+        for (bucket = 0U; bucket < DGN_PROF_BUCKETS; bucket++)
+        {
+            s_prof_hist[series][bucket] = 0U;
+        }
+        s_prof_min[series]   = 0U;
+        s_prof_max[series]   = 0U;
+        s_prof_count[series] = 0U;
+    }
+    s_prof_overruns    = 0U;
+    s_prof_cycle_start = HAL_GetCycleCounter();
+    s_prof_last_mark   = s_prof_cycle_start;
+}
+
+/**
+ * @brief Mark the start of a cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+void DGN_Profile_CycleStart(void)
+{
+    s_prof_cycle_start = HAL_GetCycleCounter();
+    s_prof_last_mark   = s_prof_cycle_start;
+}
+
+/**
+ * @brief Mark the end of a step.
+ * @complexity Cyclomatic complexity: 2
+ */
+void DGN_Profile_StepEnd(uint8_t step)
+{
+    uint32_t now = HAL_GetCycleCounter();
+
+    if (step < DGN_PROFILE_MAX_STEPS)
+    {
+        dgn_prof_record((uint32_t)step, now - s_prof_last_mark);
+    }
+    s_prof_last_mark = now;
+}
+
+/**
+ * @brief Mark the end of the cycle.
+ * @complexity Cyclomatic complexity: 2
+ */
+void DGN_Profile_CycleEnd(void)
+{
+    uint32_t total = HAL_GetCycleCounter() - s_prof_cycle_start;
+
+    dgn_prof_record(DGN_PROFILE_TOTAL, total);
+
+    if (total > DGN_PROF_BUDGET_TICKS)
+    {
+        s_prof_overruns++;
+    }
+}
+
+/**
+ * @brief Read min/max/p99 for one step.
+ * @complexity Cyclomatic complexity: 8
+ */
+error_t DGN_Profile_GetStats(uint8_t step, dgn_profile_stats_t *stats_out)
+{
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §9.3 (diagnostic port query) */
+    error_t  result;
+    uint32_t total = 0U;
+    uint32_t rank;
+    uint32_t cumulative = 0U;
+    uint32_t bucket;
+
+    if (NULL == stats_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (step > DGN_PROFILE_TOTAL)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        for (bucket = 0U; bucket < DGN_PROF_BUCKETS; bucket++)
+        {
+            total += s_prof_hist[step][bucket];
+        }
+
+        /* Smallest bucket holding the ceil(0.99 * total)-th sample */
+        rank   = total - (total / 100U);
+        bucket = 0U;
+        while ((bucket < (DGN_PROF_BUCKETS - 1U)) &&
+               ((cumulative + s_prof_hist[step][bucket]) < rank))
+        {
+            cumulative += s_prof_hist[step][bucket];
+            bucket++;
+        }
+
+        stats_out->min_ticks    = s_prof_min[step];
+        stats_out->max_ticks    = s_prof_max[step];
+        stats_out->p99_ticks    = (0U == total) ? 0U :
+                                  dgn_prof_bucket_upper(bucket);
+        stats_out->sample_count = s_prof_count[step];
+
+        if (stats_out->p99_ticks > stats_out->max_ticks)
+        {
+            stats_out->p99_ticks = stats_out->max_ticks;
+        }
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Number of cycles whose total time exceeded CYCLE_MS.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t DGN_Profile_GetOverrunCount(void)
+{
+    return s_prof_overruns;
+}
+
+#endif /* DGN_PROFILE_ENABLE */
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
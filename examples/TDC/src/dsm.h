@@ -27,6 +27,35 @@
 #include <stdint.h>
 #include "tdc_types.h"
 
+/**
+ * @brief 2oo2 voting results for all doors (bit n = door n), as produced by
+ *        DSM_VotePositionBatch and consumed by the FSM transition table.
+ */
+typedef struct
+{
+    door_mask_t open_voted;       /**< Both open-position sensors active */
+    door_mask_t open_disagree;    /**< Open-position sensors differ */
+    door_mask_t closed_voted;     /**< Both closed-position sensors active */
+    door_mask_t closed_disagree;  /**< Closed-position sensors differ */
+    door_mask_t lock_voted;       /**< Both lock sensors active */
+    door_mask_t lock_disagree;    /**< Lock sensors differ */
+} dsm_votes_t;
+
+/**
+ * @brief Change-driven dispatch counters of DSM_RunCycle.
+ */
+typedef struct
+{
+    uint32_t evaluated;       /**< Door FSM evaluations since init (saturating) */
+    uint32_t skipped;         /**< Clean doors not evaluated since init (saturating) */
+    uint8_t  last_evaluated;  /**< Doors evaluated in the last cycle */
+} dsm_eval_stats_t;
+
+/** @brief Timer wheel channels (one timer per door and channel) */
+#define DSM_TIMER_STATE      (0U)  /**< FSM state timeout */
+#define DSM_TIMER_EMERGENCY  (1U)  /**< Emergency release debounce */
+#define DSM_TIMER_CHANNELS   (2U)
+
 /**
  * @brief Initialise DSM module — all doors to FSM_IDLE with fail-safe defaults.
  * @return error_t SUCCESS
@@ -35,13 +64,22 @@
 error_t DSM_Init(void);
 
 /**
- * @brief 20 ms cycle entry — read sensors and advance each door FSM.
- * @note   UNIT-DSM-016; Complexity: 2
+ * @brief 20 ms cycle entry — read sensors and advance the FSM of each door
+ *        whose inputs, commands or timer changed.
+ * @note   UNIT-DSM-016; Complexity: 6
  */
 void DSM_RunCycle(void);
 
 /**
- * @brief Update per-door FSM — dispatch to state-specific transition handlers.
+ * @brief Read the change-driven dispatch counters.
+ * @param[out] stats_out Counters since DSM_Init
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-DSM-022; Complexity: 2
+ */
+error_t DSM_GetEvalStats(dsm_eval_stats_t *stats_out);
+
+/**
+ * @brief Update per-door FSM — take the matching transition-table row.
  * @param[in] door_id           Door index (0–MAX_DOORS-1)
  * @param[in] cmd_open          1=open command active
  * @param[in] cmd_close         1=close command active
@@ -72,6 +110,93 @@ error_t DSM_UpdateFSM(uint8_t door_id,
                       uint8_t safe_state_active,
                       uint32_t current_time_ms);
 
+/**
+ * @brief Advance one door FSM from pre-voted sensor masks.
+ * @details Used by DSM_RunCycle after voting all doors at once; the
+ *          guard word uses bit door_id of each mask in votes.
+ *          While the HAL motor inhibit is held (HAL_IsMotorInhibited,
+ *          TCMS emergency stop) an opening, closing or reversing door is
+ *          stopped and goes to FSM_IDLE, and no door starts moving.
+ * @param[in] door_id           Door index (0–MAX_DOORS-1)
+ * @param[in] cmd_open          1=open command active
+ * @param[in] cmd_close         1=close command active
+ * @param[in] votes             Voted/disagree masks for all doors
+ * @param[in] obstacle          1=obstacle detected for this door
+ * @param[in] speed_interlock   1=door open inhibited (speed too high)
+ * @param[in] safe_state_active 1=system safe state active
+ * @param[in] current_time_ms   Current system tick in milliseconds
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE
+ * @note   UNIT-DSM-020; Complexity: 4
+ */
+error_t DSM_StepFSM(uint8_t door_id,
+                    uint8_t cmd_open,
+                    uint8_t cmd_close,
+                    const dsm_votes_t *votes,
+                    uint8_t obstacle,
+                    uint8_t speed_interlock,
+                    uint8_t safe_state_active,
+                    uint32_t current_time_ms);
+
+/**
+ * @brief Timeout of an FSM state.
+ * @param[in] state FSM state
+ * @return uint32_t Motor/lock timeout in ms; 0 if the state has no timeout
+ * @note   UNIT-DSM-021; Complexity: 5
+ */
+uint32_t DSM_GetStateTimeoutMs(door_fsm_state_t state);
+
+/**
+ * @brief Empty the timer wheel and start it at now_ms.
+ * @param[in] now_ms Current system tick (ms)
+ * @note   UNIT-DSM-023; Complexity: 2
+ */
+void DSM_Timer_Init(uint32_t now_ms);
+
+/**
+ * @brief Arm (or re-arm) a door's timer; O(1).
+ * @details Expires at the first DSM_Timer_Advance with now >= deadline_ms
+ *          (wrap-safe). A deadline already due, or more than the wheel span
+ *          (4096 cycles) ahead, expires at once.
+ * @param[in] channel     DSM_TIMER_STATE or DSM_TIMER_EMERGENCY
+ * @param[in] door_id     Door index (0–MAX_DOORS-1)
+ * @param[in] deadline_ms Expiry time (system tick, ms)
+ * @return error_t SUCCESS, ERR_RANGE
+ * @note   UNIT-DSM-023; Complexity: 4
+ */
+error_t DSM_Timer_Arm(uint8_t channel, uint8_t door_id, uint32_t deadline_ms);
+
+/**
+ * @brief Cancel a door's timer, including an expiry not yet taken; O(1).
+ * @param[in] channel DSM_TIMER_STATE or DSM_TIMER_EMERGENCY
+ * @param[in] door_id Door index (0–MAX_DOORS-1)
+ * @return error_t SUCCESS, ERR_RANGE
+ * @note   UNIT-DSM-023; Complexity: 2
+ */
+error_t DSM_Timer_Cancel(uint8_t channel, uint8_t door_id);
+
+/**
+ * @brief Doors with an armed, not yet expired timer.
+ * @param[in] channel DSM_TIMER_STATE or DSM_TIMER_EMERGENCY
+ * @return door_mask_t Armed timers (0 for an invalid channel)
+ * @note   UNIT-DSM-023; Complexity: 2
+ */
+door_mask_t DSM_Timer_GetArmed(uint8_t channel);
+
+/**
+ * @brief Advance the timer wheel to now_ms; O(1) per 20 ms tick passed.
+ * @param[in] now_ms Current system tick (ms)
+ * @note   UNIT-DSM-024; Complexity: 3
+ */
+void DSM_Timer_Advance(uint32_t now_ms);
+
+/**
+ * @brief Read and clear the doors whose timer expired.
+ * @param[in] channel DSM_TIMER_STATE or DSM_TIMER_EMERGENCY
+ * @return door_mask_t Expired timers (0 for an invalid channel)
+ * @note   UNIT-DSM-024; Complexity: 2
+ */
+door_mask_t DSM_Timer_TakeExpired(uint8_t channel);
+
 /**
  * @brief 2oo2 position sensor voter.
  * @param[in]  door_id        Door index (0–MAX_DOORS-1)
@@ -88,6 +213,22 @@ error_t DSM_VotePosition(uint8_t door_id,
                          uint8_t *voted_position,
                          uint8_t *disagree_out);
 
+/**
+ * @brief Word-parallel 2oo2 voter for all doors.
+ * @details Same result per door as DSM_VotePosition: voted = A AND B,
+ *          disagree = A XOR B; bits above MAX_DOORS - 1 are cleared.
+ * @param[in]  sensor_a     Sensor A mask (bit n = door n)
+ * @param[in]  sensor_b     Sensor B mask (bit n = door n)
+ * @param[out] voted_out    Agreed-active doors (0 where sensors disagree)
+ * @param[out] disagree_out Doors whose sensors disagree
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-DSM-019; Complexity: 2
+ */
+error_t DSM_VotePositionBatch(door_mask_t  sensor_a,
+                              door_mask_t  sensor_b,
+                              door_mask_t *voted_out,
+                              door_mask_t *disagree_out);
+
 /**
  * @brief Transition operational mode with guard conditions.
  * @param[in] requested_mode New mode to transition to
@@ -102,10 +243,14 @@ error_t DSM_TransitionMode(op_mode_t requested_mode,
 
 /**
  * @brief Handle emergency door release with 60 ms debounce.
+ * @details A confirmed release disengages the lock and drives the door
+ *          open (FSM_OPENING). While the HAL motor inhibit is held (TCMS
+ *          emergency stop) it disengages the lock only and the door goes
+ *          to FSM_IDLE: the release never overrides the emergency stop.
  * @param[in] door_id        Door index (0–MAX_DOORS-1)
  * @param[in] current_time_ms Current system tick in milliseconds
  * @return error_t SUCCESS, ERR_RANGE
- * @note   UNIT-DSM-014; Complexity: 4
+ * @note   UNIT-DSM-014; Complexity: 5
  */
 error_t DSM_HandleEmergencyRelease(uint8_t door_id, uint32_t current_time_ms);
 
@@ -114,14 +259,14 @@ error_t DSM_HandleEmergencyRelease(uint8_t door_id, uint32_t current_time_ms);
  * @param[in] door_mask Bitmask of doors to open (bit N = door N)
  * @return error_t SUCCESS
  */
-error_t DSM_ProcessOpenCommand(uint8_t door_mask);
+error_t DSM_ProcessOpenCommand(door_mask_t door_mask);
 
 /**
  * @brief Process close command received from TCMS (CAN 0x102).
  * @param[in] door_mask Bitmask of doors to close (bit N = door N)
  * @return error_t SUCCESS
  */
-error_t DSM_ProcessCloseCommand(uint8_t door_mask);
+error_t DSM_ProcessCloseCommand(door_mask_t door_mask);
 
 /**
  * @brief Get door state array (accessor for SKN, TCI).
@@ -143,12 +288,50 @@ const uint8_t *DSM_GetLockStates(void);
  */
 const uint8_t *DSM_GetClosingFlags(void);
 
+/**
+ * @brief Get the doors closed and locked in the last cycle (accessor for the
+ *        SKN departure interlock).
+ * @return door_mask_t Bit n set if door n is in FSM_CLOSED_AND_LOCKED
+ */
+door_mask_t DSM_GetLockedMask(void);
+
+/**
+ * @brief Get the time of the most recent lock confirmation (a door entering
+ *        FSM_CLOSED_AND_LOCKED), for the TCMS interlock latency counter.
+ * @return uint32_t HAL_GetSystemTickMs value of the cycle of that transition
+ *         (0 before the first lock since DSM_Init)
+ */
+uint32_t DSM_GetLockConfirmMs(void);
+
+/**
+ * @brief Get the number of lock confirmations since DSM_Init.
+ * @details Wraps; compared only for a change, to tell whether a lock was
+ *          confirmed after a given point (DSM_GetLockConfirmMs is stale
+ *          otherwise).
+ * @return uint32_t Doors that entered FSM_CLOSED_AND_LOCKED (0 = none yet)
+ */
+uint32_t DSM_GetLockConfirmCount(void);
+
+/**
+ * @brief Get the doors closing in the last cycle (accessor for OBD).
+ * @return door_mask_t Bit n set if door n is in FSM_CLOSING
+ */
+door_mask_t DSM_GetClosingMask(void);
+
 /**
  * @brief Get DSM fault status for FMG aggregation.
  * @return uint8_t 0 = no fault, non-zero = fault code
  */
 uint8_t DSM_GetFault(void);
 
+/**
+ * @brief Get the current operational mode (for DGN diagnostic port access
+ *        control).
+ * @return op_mode_t Current mode
+ * @note   UNIT-DSM-018; Complexity: 1
+ */
+op_mode_t DSM_GetMode(void);
+
 #endif /* DSM_H */
 
 /*============================================================================
@@ -4,6 +4,13 @@
  * @details Implements UNIT-DSM-014: handles emergency release button with
  *          60 ms debounce per SW-HAZ-009.  On confirmed release, forces door
  *          to FULLY_OPEN regardless of current speed or mode.
+ *          The release does not override a TCMS emergency stop: while the
+ *          HAL motor inhibit is held it only disengages the lock, so the
+ *          door can be opened by hand, and leaves the door in FSM_IDLE.
+ *          The debounce deadline is armed on the DSM_TIMER_EMERGENCY
+ *          channel of the timer wheel, so DSM_RunCycle calls the handler
+ *          only on an input edge, on expiry, or for a pressed button with no
+ *          debounce running (after a confirmed release).
  *
  * @project TDC (Train Door Control System)
  * @module  DSM (Door State Machine) — COMP-004
@@ -37,6 +44,7 @@
  *===========================================================================*/
 extern door_fsm_state_t g_dsm_state[MAX_DOORS];
 extern uint32_t         g_dsm_entry_time_ms[MAX_DOORS];
+extern door_mask_t      g_dsm_dirty;
 
 /*============================================================================
  * MODULE CONSTANTS
@@ -55,7 +63,7 @@ static uint8_t  s_emerg_debouncing[MAX_DOORS];
 
 /**
  * @brief Handle emergency door release with 60 ms debounce.
- * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ * @complexity Cyclomatic complexity: 5 — within SIL 3 limit of 10
  */
 error_t DSM_HandleEmergencyRelease(uint8_t door_id, uint32_t current_time_ms)
 {
@@ -69,13 +77,16 @@ error_t DSM_HandleEmergencyRelease(uint8_t door_id, uint32_t current_time_ms)
         return ERR_RANGE;
     }
 
-    gpio_state = HAL_GPIO_ReadEmergencyRelease(door_id);
+    /* Emergency release input from the cycle's input process image */
+    gpio_state = (uint8_t)((uint8_t)(HAL_GPIO_GetInputImage()->emergency >>
+                                     door_id) & 1U);
 
     if (0U == gpio_state)
     {
         /* Button released — reset debounce state */
         s_emerg_debouncing[door_id]    = 0U;
         s_emerg_first_seen_ms[door_id] = 0U;
+        (void)DSM_Timer_Cancel(DSM_TIMER_EMERGENCY, door_id);
         return SUCCESS;
     }
 
@@ -84,17 +95,28 @@ error_t DSM_HandleEmergencyRelease(uint8_t door_id, uint32_t current_time_ms)
     {
         s_emerg_first_seen_ms[door_id] = current_time_ms;
         s_emerg_debouncing[door_id]    = 1U;
+        (void)DSM_Timer_Arm(DSM_TIMER_EMERGENCY, door_id,
+                            current_time_ms + DSM_EMERG_DEBOUNCE_MS);
         return SUCCESS;
     }
 
     elapsed_ms = current_time_ms - s_emerg_first_seen_ms[door_id];
     if (elapsed_ms >= DSM_EMERG_DEBOUNCE_MS)
     {
-        /* Debounce confirmed — force door open regardless of state */
+        /* Debounce confirmed — force door open regardless of state;
+         * under an emergency stop unlock only (manual opening) */
         (void)HAL_LockDisengage(door_id);
-        (void)HAL_MotorStart(door_id, 1U); /* open direction */
-        g_dsm_state[door_id]         = FSM_OPENING;
+        if (0U == HAL_IsMotorInhibited())
+        {
+            (void)HAL_MotorStart(door_id, 1U); /* open direction */
+            g_dsm_state[door_id] = FSM_OPENING;
+        }
+        else
+        {
+            g_dsm_state[door_id] = FSM_IDLE;
+        }
         g_dsm_entry_time_ms[door_id] = current_time_ms;
+        g_dsm_dirty                 |= DOOR_BIT(door_id);
         s_emerg_debouncing[door_id]  = 0U;
         LOG_EVENT(COMP_DSM, COMP_DSM, EVT_EMERGENCY_RELEASE, (uint16_t)door_id);
     }
@@ -1,12 +1,21 @@
 /**
  * @file    dsm_fsm.c
- * @brief   Door State Machine FSM engine and state-transition handlers.
- * @details Implements UNIT-DSM-001 (UpdateFSM) plus internal static helpers
- *          for each FSM state: Idle, Opening, FullyOpen, Closing,
- *          ObstacleReversal, FullyClosed, Locking, ClosedAndLocked, Fault.
- *          The main dispatcher (DSM_UpdateFSM) calls the appropriate static
- *          handler based on the current state; each handler returns the next
- *          state.  All transitions are logged via DGN.
+ * @brief   Door State Machine FSM engine — const transition table.
+ * @details Implements UNIT-DSM-001 (UpdateFSM), UNIT-DSM-020 (StepFSM),
+ *          UNIT-DSM-021 (GetStateTimeoutMs) and the transitions of
+ *          UNIT-DSM-002..010 (Idle, Opening, FullyOpen, Closing,
+ *          ObstacleReversal, FullyClosed, Locking, ClosedAndLocked, Fault)
+ *          as rows of the const table s_dsm_transitions.
+ *          DSM_StepFSM computes the door's guard word once (DSM_G_* bits:
+ *          commands, safe state, interlock, disable flag, obstacle, the
+ *          TCMS emergency stop motor inhibit, the
+ *          door's bit of the 2oo2 vote masks from DSM_VotePositionBatch and
+ *          the state timer), takes the first row of the current state whose
+ *          (mask, value) matches, and runs that row's DSM_A_* actions.
+ *          Every step is one guard computation, at most seven masked compares
+ *          and one fixed pass over the action bits, whatever the state.
+ *          DSM_RunCycle votes all doors once per cycle; DSM_UpdateFSM votes
+ *          the single door's raw sensor values.
  *
  * @project TDC (Train Door Control System)
  * @module  DSM (Door State Machine) — COMP-004
@@ -41,10 +50,11 @@
  * EXTERNAL SHARED STATE (owned by dsm_init.c)
  *===========================================================================*/
 extern door_fsm_state_t g_dsm_state[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_open[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_close[MAX_DOORS];
-extern uint8_t          g_dsm_disabled[MAX_DOORS];
+extern door_mask_t      g_dsm_cmd_open;
+extern door_mask_t      g_dsm_cmd_close;
+extern door_mask_t      g_dsm_disabled;
 extern uint32_t         g_dsm_entry_time_ms[MAX_DOORS];
+extern door_mask_t      g_dsm_dirty;
 
 /*============================================================================
  * MODULE CONSTANTS
@@ -58,417 +68,382 @@ extern uint32_t         g_dsm_entry_time_ms[MAX_DOORS];
 /** @brief Lock confirmation timeout (ms) */
 #define DSM_LOCK_TIMEOUT_MS    (500U)
 
+/** @brief Number of valid FSM states (FSM_IDLE … FSM_FAULT) */
+#define DSM_FSM_STATE_COUNT    ((uint32_t)FSM_FAULT + 1U)
+
+/*----------------------------------------------------------------------------
+ * Guard bits — computed once per step (dsm_transition_t.mask / .value)
+ *---------------------------------------------------------------------------*/
+#define DSM_G_SAFE             (0x0001U)  /**< safe_state_active == 1 */
+#define DSM_G_CMD_OPEN         (0x0002U)  /**< cmd_open == 1 */
+#define DSM_G_CMD_CLOSE        (0x0004U)  /**< cmd_close == 1 */
+#define DSM_G_INTERLOCK        (0x0008U)  /**< speed_interlock != 0 */
+#define DSM_G_DISABLED         (0x0010U)  /**< Door selectively disabled */
+#define DSM_G_OBSTACLE         (0x0020U)  /**< obstacle == 1 */
+#define DSM_G_OPEN_VOTED       (0x0040U)  /**< Open position, sensors agree */
+#define DSM_G_OPEN_DISAGREE    (0x0080U)  /**< Open position sensors differ */
+#define DSM_G_CLOSED_VOTED     (0x0100U)  /**< Closed position, sensors agree */
+#define DSM_G_CLOSED_DISAGREE  (0x0200U)  /**< Closed position sensors differ */
+#define DSM_G_LOCK_VOTED       (0x0400U)  /**< Locked, sensors agree */
+#define DSM_G_LOCK_DISAGREE    (0x0800U)  /**< Lock sensors differ */
+#define DSM_G_TIMEOUT          (0x1000U)  /**< State timeout elapsed */
+#define DSM_G_ESTOP            (0x2000U)  /**< HAL motor inhibit held (TCMS
+                                               emergency stop) */
+
+/** @brief Bit position of DSM_G_OPEN_VOTED; the vote guards follow it in
+ *         dsm_votes_t field order */
+#define DSM_G_VOTE_SHIFT       (6U)
+
+/** @brief Guards of an executable open command: cmd_open, no interlock,
+ *         door enabled */
+#define DSM_G_OPEN_REQ_MASK    (DSM_G_CMD_OPEN | DSM_G_INTERLOCK | \
+                                DSM_G_DISABLED)
+
+/*----------------------------------------------------------------------------
+ * Action bits (dsm_transition_t.actions), executed in this order. A failed
+ * lock action logs EVT_FSM_FAULT and ends the step in FSM_FAULT.
+ *---------------------------------------------------------------------------*/
+#define DSM_A_NONE             (0x00U)
+#define DSM_A_LOCK_ENGAGE      (0x01U)  /**< HAL_LockEngage */
+#define DSM_A_LOCK_DISENGAGE   (0x02U)  /**< HAL_LockDisengage */
+#define DSM_A_MOTOR_STOP       (0x04U)  /**< HAL_MotorStop */
+#define DSM_A_MOTOR_OPEN       (0x08U)  /**< HAL_MotorStart, open direction */
+#define DSM_A_MOTOR_CLOSE      (0x10U)  /**< HAL_MotorStart, close direction */
+#define DSM_A_LOG_DISAGREE     (0x20U)  /**< Log EVT_SENSOR_DISAGREE */
+#define DSM_A_LOG_FAULT        (0x40U)  /**< Log EVT_FSM_FAULT */
+
 /*============================================================================
- * INTERNAL STATIC HELPERS — ONE PER FSM STATE
- * Each returns the new state.  Cyclomatic complexity ≤ 10 per SIL 3.
+ * TYPE DEFINITIONS
  *===========================================================================*/
-
-/**
- * @brief Handle FSM_IDLE → next state.
- * @complexity Cyclomatic complexity: 3
- */
-static door_fsm_state_t dsm_handle_idle(uint8_t door_id,
-                                        uint8_t cmd_open,
-                                        uint8_t safe_state_active,
-                                        uint8_t speed_interlock)
+/** @brief One transition row: taken when (guards & mask) == value */
+typedef struct
 {
-    /* Implements: UNIT-DSM-002 */
-    door_fsm_state_t next_state = FSM_IDLE;
+    uint16_t mask;      /**< Guard bits tested */
+    uint16_t value;     /**< Required values of the tested bits */
+    uint8_t  next;      /**< Next state (door_fsm_state_t) */
+    uint8_t  actions;   /**< DSM_A_* bits */
+} dsm_transition_t;
 
-    if (1U == safe_state_active)
-    {
-        /* Stay idle — safe state inhibits all movement */
-        next_state = FSM_IDLE;
-    }
-    else if ((1U == cmd_open) && (0U == speed_interlock) &&
-             (0U == g_dsm_disabled[door_id]))
-    {
-        (void)HAL_MotorStart(door_id, 1U); /* 1=open direction */
-        next_state = FSM_OPENING;
-    }
-    else
-    {
-        next_state = FSM_IDLE;
-    }
+/*============================================================================
+ * TRANSITION TABLE (const — linked into flash)
+ * Rows of a state are contiguous and in priority order; the last row of each
+ * state has mask 0 and always matches, so a lookup never leaves the block.
+ *===========================================================================*/
+static const dsm_transition_t s_dsm_transitions[] =
+{
+    /* FSM_IDLE — UNIT-DSM-002: safe state and emergency stop inhibit all
+     * movement */
+    { DSM_G_SAFE, DSM_G_SAFE,
+      (uint8_t)FSM_IDLE, DSM_A_NONE },
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_IDLE, DSM_A_NONE },
+    { DSM_G_OPEN_REQ_MASK, DSM_G_CMD_OPEN,
+      (uint8_t)FSM_OPENING, DSM_A_MOTOR_OPEN },
+    { 0U, 0U,
+      (uint8_t)FSM_IDLE, DSM_A_NONE },
+
+    /* FSM_OPENING — UNIT-DSM-003: an obstacle stops the door open, an
+     * emergency stop stops it where it is */
+    { DSM_G_SAFE, DSM_G_SAFE,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP },
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_IDLE, DSM_A_MOTOR_STOP },
+    { DSM_G_OPEN_DISAGREE, DSM_G_OPEN_DISAGREE,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP | DSM_A_LOG_DISAGREE },
+    { DSM_G_OPEN_VOTED, DSM_G_OPEN_VOTED,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_MOTOR_STOP },
+    { DSM_G_OBSTACLE, DSM_G_OBSTACLE,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_MOTOR_STOP },
+    { DSM_G_TIMEOUT, DSM_G_TIMEOUT,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP | DSM_A_LOG_FAULT },
+    { 0U, 0U,
+      (uint8_t)FSM_OPENING, DSM_A_NONE },
+
+    /* FSM_FULLY_OPEN — UNIT-DSM-004: safe state holds door open */
+    { DSM_G_SAFE, DSM_G_SAFE,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_NONE },
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_NONE },
+    { DSM_G_CMD_CLOSE | DSM_G_DISABLED, DSM_G_CMD_CLOSE,
+      (uint8_t)FSM_CLOSING, DSM_A_MOTOR_CLOSE },
+    { 0U, 0U,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_NONE },
+
+    /* FSM_CLOSING — UNIT-DSM-005: an obstacle reverses the door, an
+     * emergency stop stops it where it is */
+    { DSM_G_SAFE, DSM_G_SAFE,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP },
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_IDLE, DSM_A_MOTOR_STOP },
+    { DSM_G_OBSTACLE, DSM_G_OBSTACLE,
+      (uint8_t)FSM_OBSTACLE_REVERSAL,
+      DSM_A_MOTOR_STOP | DSM_A_MOTOR_OPEN | DSM_A_LOG_DISAGREE },
+    { DSM_G_CLOSED_DISAGREE, DSM_G_CLOSED_DISAGREE,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP | DSM_A_LOG_DISAGREE },
+    { DSM_G_CLOSED_VOTED, DSM_G_CLOSED_VOTED,
+      (uint8_t)FSM_FULLY_CLOSED, DSM_A_MOTOR_STOP },
+    { DSM_G_TIMEOUT, DSM_G_TIMEOUT,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP | DSM_A_LOG_FAULT },
+    { 0U, 0U,
+      (uint8_t)FSM_CLOSING, DSM_A_NONE },
+
+    /* FSM_OBSTACLE_REVERSAL — UNIT-DSM-006: drive back to open */
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_IDLE, DSM_A_MOTOR_STOP },
+    { DSM_G_OPEN_VOTED, DSM_G_OPEN_VOTED,
+      (uint8_t)FSM_FULLY_OPEN, DSM_A_MOTOR_STOP },
+    { DSM_G_TIMEOUT, DSM_G_TIMEOUT,
+      (uint8_t)FSM_FAULT, DSM_A_MOTOR_STOP | DSM_A_LOG_FAULT },
+    { 0U, 0U,
+      (uint8_t)FSM_OBSTACLE_REVERSAL, DSM_A_NONE },
+
+    /* FSM_FULLY_CLOSED — UNIT-DSM-007: energise lock solenoid */
+    { 0U, 0U,
+      (uint8_t)FSM_LOCKING, DSM_A_LOCK_ENGAGE },
+
+    /* FSM_LOCKING — UNIT-DSM-008: await lock confirmation */
+    { DSM_G_LOCK_DISAGREE, DSM_G_LOCK_DISAGREE,
+      (uint8_t)FSM_FAULT, DSM_A_LOG_DISAGREE },
+    { DSM_G_LOCK_VOTED, DSM_G_LOCK_VOTED,
+      (uint8_t)FSM_CLOSED_AND_LOCKED, DSM_A_NONE },
+    { DSM_G_TIMEOUT, DSM_G_TIMEOUT,
+      (uint8_t)FSM_FAULT, DSM_A_LOG_FAULT },
+    { 0U, 0U,
+      (uint8_t)FSM_LOCKING, DSM_A_NONE },
+
+    /* FSM_CLOSED_AND_LOCKED — UNIT-DSM-009: safe state holds lock */
+    { DSM_G_SAFE, DSM_G_SAFE,
+      (uint8_t)FSM_CLOSED_AND_LOCKED, DSM_A_NONE },
+    { DSM_G_ESTOP, DSM_G_ESTOP,
+      (uint8_t)FSM_CLOSED_AND_LOCKED, DSM_A_NONE },
+    { DSM_G_OPEN_REQ_MASK, DSM_G_CMD_OPEN,
+      (uint8_t)FSM_OPENING, DSM_A_LOCK_DISENGAGE | DSM_A_MOTOR_OPEN },
+    { 0U, 0U,
+      (uint8_t)FSM_CLOSED_AND_LOCKED, DSM_A_NONE },
+
+    /* FSM_FAULT — UNIT-DSM-010: only an SKN reset clears it */
+    { 0U, 0U,
+      (uint8_t)FSM_FAULT, DSM_A_NONE }
+};
+
+/** @brief Index of each state's first row in s_dsm_transitions */
+static const uint8_t s_dsm_first_row[DSM_FSM_STATE_COUNT] =
+{
+    0U,    /* FSM_IDLE              */
+    4U,    /* FSM_OPENING           */
+    11U,   /* FSM_FULLY_OPEN        */
+    15U,   /* FSM_CLOSING           */
+    22U,   /* FSM_OBSTACLE_REVERSAL */
+    26U,   /* FSM_FULLY_CLOSED      */
+    27U,   /* FSM_LOCKING           */
+    31U,   /* FSM_CLOSED_AND_LOCKED */
+    35U    /* FSM_FAULT             */
+};
 
-    return next_state;
-}
+/*============================================================================
+ * INTERNAL STATIC HELPERS
+ *===========================================================================*/
 
 /**
- * @brief Handle FSM_OPENING → next state.
- * @complexity Cyclomatic complexity: 5
+ * @brief Guard bits of the scalar inputs, the door's disable flag and the
+ *        HAL motor inhibit.
+ * @complexity Cyclomatic complexity: 8
  */
-static door_fsm_state_t dsm_handle_opening(uint8_t door_id,
-                                           uint8_t pos_a_open,
-                                           uint8_t pos_b_open,
-                                           uint8_t obstacle,
-                                           uint8_t safe_state_active,
-                                           uint32_t current_time_ms)
+static uint16_t dsm_input_guards(uint8_t door_id,
+                                 uint8_t cmd_open,
+                                 uint8_t cmd_close,
+                                 uint8_t obstacle,
+                                 uint8_t speed_interlock,
+                                 uint8_t safe_state_active)
 {
-    /* Implements: UNIT-DSM-003 */
-    door_fsm_state_t next_state = FSM_OPENING;
-    uint32_t elapsed_ms;
-    uint8_t  voted_open     = 0U;
-    uint8_t  disagree       = 0U;
-
-    if (1U == safe_state_active)
-    {
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
-    }
-
-    (void)DSM_VotePosition(door_id, pos_a_open, pos_b_open,
-                           &voted_open, &disagree);
-
-    if (1U == disagree)
-    {
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_SENSOR_DISAGREE, (uint16_t)door_id);
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
-    }
-
-    if (1U == voted_open)
-    {
-        (void)HAL_MotorStop(door_id);
-        return FSM_FULLY_OPEN;
-    }
-
-    if (1U == obstacle)
-    {
-        (void)HAL_MotorStop(door_id);
-        return FSM_FULLY_OPEN; /* Opening obstacle: stop — door stays open */
-    }
-
-    /* Timeout guard */
-    elapsed_ms = current_time_ms - g_dsm_entry_time_ms[door_id];
-    if (elapsed_ms >= DSM_MOTOR_TIMEOUT_MS)
-    {
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
-    }
-
-    return next_state;
+    uint16_t guards = 0U;
+
+    guards |= (1U == safe_state_active) ? DSM_G_SAFE : 0U;
+    guards |= (1U == cmd_open) ? DSM_G_CMD_OPEN : 0U;
+    guards |= (1U == cmd_close) ? DSM_G_CMD_CLOSE : 0U;
+    guards |= (0U != speed_interlock) ? DSM_G_INTERLOCK : 0U;
+    guards |= (0U != DOOR_MASK_TEST(g_dsm_disabled, door_id)) ?
+              DSM_G_DISABLED : 0U;
+    guards |= (1U == obstacle) ? DSM_G_OBSTACLE : 0U;
+    guards |= (0U != HAL_IsMotorInhibited()) ? DSM_G_ESTOP : 0U;
+
+    return guards;
 }
 
 /**
- * @brief Handle FSM_FULLY_OPEN → next state.
+ * @brief Guard bits of the door's 2oo2 votes and of its state timer.
  * @complexity Cyclomatic complexity: 3
  */
-static door_fsm_state_t dsm_handle_fully_open(uint8_t door_id,
-                                              uint8_t cmd_close,
-                                              uint8_t safe_state_active)
+static uint16_t dsm_sensor_guards(uint8_t door_id,
+                                  door_fsm_state_t state,
+                                  const dsm_votes_t *votes,
+                                  uint32_t current_time_ms)
 {
-    /* Implements: UNIT-DSM-004 */
-    door_fsm_state_t next_state = FSM_FULLY_OPEN;
-
-    if (1U == safe_state_active)
-    {
-        next_state = FSM_FULLY_OPEN; /* Safe state holds door open */
-    }
-    else if ((1U == cmd_close) && (0U == g_dsm_disabled[door_id]))
+    uint32_t guards;
+    uint32_t timeout_ms = DSM_GetStateTimeoutMs(state);
+
+    guards = (uint32_t)DOOR_MASK_TEST(votes->open_voted, door_id) |
+             ((uint32_t)DOOR_MASK_TEST(votes->open_disagree, door_id) << 1U) |
+             ((uint32_t)DOOR_MASK_TEST(votes->closed_voted, door_id) << 2U) |
+             ((uint32_t)DOOR_MASK_TEST(votes->closed_disagree, door_id) << 3U) |
+             ((uint32_t)DOOR_MASK_TEST(votes->lock_voted, door_id) << 4U) |
+             ((uint32_t)DOOR_MASK_TEST(votes->lock_disagree, door_id) << 5U);
+    guards <<= DSM_G_VOTE_SHIFT;
+
+    if ((0U != timeout_ms) &&
+        ((current_time_ms - g_dsm_entry_time_ms[door_id]) >= timeout_ms))
     {
-        (void)HAL_MotorStart(door_id, 0U); /* 0=close direction */
-        next_state = FSM_CLOSING;
-    }
-    else
-    {
-        next_state = FSM_FULLY_OPEN;
+        guards |= DSM_G_TIMEOUT;
     }
 
-    return next_state;
+    return (uint16_t)guards;
 }
 
 /**
- * @brief Handle FSM_CLOSING → next state.
- * @complexity Cyclomatic complexity: 7
+ * @brief Execute the actions of a transition row.
+ * @return The row's next state, or FSM_FAULT if a lock action failed
+ * @complexity Cyclomatic complexity: 9
  */
-static door_fsm_state_t dsm_handle_closing(uint8_t door_id,
-                                           uint8_t pos_a_closed,
-                                           uint8_t pos_b_closed,
-                                           uint8_t obstacle,
-                                           uint8_t safe_state_active,
-                                           uint32_t current_time_ms)
+static door_fsm_state_t dsm_run_actions(uint8_t door_id,
+                                        const dsm_transition_t *row)
 {
-    /* Implements: UNIT-DSM-005 */
-    door_fsm_state_t next_state = FSM_CLOSING;
-    uint32_t elapsed_ms;
-    uint8_t  voted_closed = 0U;
-    uint8_t  disagree     = 0U;
-
-    if (1U == safe_state_active)
-    {
-        /* Safe state during closing: stop motor, go to fault */
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
-    }
-
-    if (1U == obstacle)
-    {
-        /* Obstacle detected while closing → reverse to open */
-        (void)HAL_MotorStop(door_id);
-        (void)HAL_MotorStart(door_id, 1U); /* reverse */
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_SENSOR_DISAGREE,
-                  (uint16_t)door_id);
-        return FSM_OBSTACLE_REVERSAL;
-    }
-
-    (void)DSM_VotePosition(door_id, pos_a_closed, pos_b_closed,
-                           &voted_closed, &disagree);
+    error_t err = SUCCESS;
 
-    if (1U == disagree)
+    if (0U != (row->actions & DSM_A_LOCK_ENGAGE))
     {
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_SENSOR_DISAGREE, (uint16_t)door_id);
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
+        err = HAL_LockEngage(door_id);
     }
-
-    if (1U == voted_closed)
+    if (0U != (row->actions & DSM_A_LOCK_DISENGAGE))
     {
-        (void)HAL_MotorStop(door_id);
-        return FSM_FULLY_CLOSED;
+        err = HAL_LockDisengage(door_id);
     }
-
-    /* Timeout guard */
-    elapsed_ms = current_time_ms - g_dsm_entry_time_ms[door_id];
-    if (elapsed_ms >= DSM_MOTOR_TIMEOUT_MS)
+    if (SUCCESS != err)
     {
         LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-        (void)HAL_MotorStop(door_id);
         return FSM_FAULT;
     }
 
-    return next_state;
-}
-
-/**
- * @brief Handle FSM_OBSTACLE_REVERSAL → next state.
- * @complexity Cyclomatic complexity: 4
- */
-static door_fsm_state_t dsm_handle_obstacle_reversal(uint8_t  door_id,
-                                                     uint8_t  pos_a_open,
-                                                     uint8_t  pos_b_open,
-                                                     uint32_t current_time_ms)
-{
-    /* Implements: UNIT-DSM-006 */
-    door_fsm_state_t next_state = FSM_OBSTACLE_REVERSAL;
-    uint32_t elapsed_ms;
-    uint8_t  voted_open = 0U;
-    uint8_t  disagree   = 0U;
-
-    (void)DSM_VotePosition(door_id, pos_a_open, pos_b_open,
-                           &voted_open, &disagree);
-
-    if (1U == voted_open)
+    if (0U != (row->actions & DSM_A_MOTOR_STOP))
     {
         (void)HAL_MotorStop(door_id);
-        return FSM_FULLY_OPEN;
     }
-
-    elapsed_ms = current_time_ms - g_dsm_entry_time_ms[door_id];
-    if (elapsed_ms >= DSM_REVERSAL_DRIVE_MS)
+    if (0U != (row->actions & DSM_A_MOTOR_OPEN))
     {
-        /* Reversal drive timed out — fault */
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-        (void)HAL_MotorStop(door_id);
-        return FSM_FAULT;
+        (void)HAL_MotorStart(door_id, 1U); /* 1=open direction */
     }
-
-    return next_state;
-}
-
-/**
- * @brief Handle FSM_FULLY_CLOSED → next state (energise lock solenoid).
- * @complexity Cyclomatic complexity: 2
- */
-static door_fsm_state_t dsm_handle_fully_closed(uint8_t door_id)
-{
-    /* Implements: UNIT-DSM-007 */
-    error_t err;
-
-    err = HAL_LockEngage(door_id);
-    if (SUCCESS != err)
+    if (0U != (row->actions & DSM_A_MOTOR_CLOSE))
     {
-        LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-        return FSM_FAULT;
+        (void)HAL_MotorStart(door_id, 0U); /* 0=close direction */
     }
-
-    return FSM_LOCKING;
-}
-
-/**
- * @brief Handle FSM_LOCKING → next state (await lock sensor confirmation).
- * @complexity Cyclomatic complexity: 5
- */
-static door_fsm_state_t dsm_handle_locking(uint8_t  door_id,
-                                           uint8_t  lock_a,
-                                           uint8_t  lock_b,
-                                           uint32_t current_time_ms)
-{
-    /* Implements: UNIT-DSM-008 */
-    door_fsm_state_t next_state = FSM_LOCKING;
-    uint32_t elapsed_ms;
-    uint8_t  voted_lock = 0U;
-    uint8_t  disagree   = 0U;
-
-    (void)DSM_VotePosition(door_id, lock_a, lock_b,
-                           &voted_lock, &disagree);
-
-    if (1U == disagree)
+    if (0U != (row->actions & DSM_A_LOG_DISAGREE))
     {
         LOG_EVENT(COMP_DSM, COMP_DSM, EVT_SENSOR_DISAGREE, (uint16_t)door_id);
-        return FSM_FAULT;
-    }
-
-    if (1U == voted_lock)
-    {
-        return FSM_CLOSED_AND_LOCKED;
     }
-
-    elapsed_ms = current_time_ms - g_dsm_entry_time_ms[door_id];
-    if (elapsed_ms >= DSM_LOCK_TIMEOUT_MS)
+    if (0U != (row->actions & DSM_A_LOG_FAULT))
     {
         LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-        return FSM_FAULT;
     }
 
-    return next_state;
+    return (door_fsm_state_t)row->next;
 }
 
 /**
- * @brief Handle FSM_CLOSED_AND_LOCKED → next state.
- * @complexity Cyclomatic complexity: 4
+ * @brief Take the first row of the current state that matches the guards.
+ * @details An out-of-range state is treated as a fault (motor stopped).
+ * @complexity Cyclomatic complexity: 3
  */
-static door_fsm_state_t dsm_handle_closed_and_locked(uint8_t door_id,
-                                                     uint8_t cmd_open,
-                                                     uint8_t speed_interlock,
-                                                     uint8_t safe_state_active)
+static door_fsm_state_t dsm_take_transition(uint8_t door_id,
+                                            door_fsm_state_t state,
+                                            uint16_t guards)
 {
-    /* Implements: UNIT-DSM-009 */
-    door_fsm_state_t next_state = FSM_CLOSED_AND_LOCKED;
+    /* Implements: UNIT-DSM-001 transition table lookup */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §6.1 */
+    const dsm_transition_t *row;
 
-    if (1U == safe_state_active)
+    if ((uint32_t)state >= DSM_FSM_STATE_COUNT)
     {
-        return FSM_CLOSED_AND_LOCKED; /* Hold lock */
+        (void)HAL_MotorStop(door_id);
+        return FSM_FAULT;
     }
 
-    if ((1U == cmd_open) && (0U == speed_interlock) &&
-        (0U == g_dsm_disabled[door_id]))
+    /* Bounded: ends at the state's catch-all row (mask 0) */
+    row = &s_dsm_transitions[s_dsm_first_row[state]];
+    while ((guards & row->mask) != row->value)
     {
-        error_t err;
-        err = HAL_LockDisengage(door_id);
-        if (SUCCESS != err)
-        {
-            LOG_EVENT(COMP_DSM, COMP_DSM, EVT_FSM_FAULT, (uint16_t)door_id);
-            return FSM_FAULT;
-        }
-        (void)HAL_MotorStart(door_id, 1U); /* open direction */
-        return FSM_OPENING;
+        row++;
     }
 
-    return next_state;
+    return dsm_run_actions(door_id, row);
 }
 
 /**
- * @brief Handle FSM_FAULT — stays in fault; only SKN reset can clear.
- * @complexity Cyclomatic complexity: 1
+ * @brief Place a raw sensor value (non-zero = active) at bit door_id.
+ * @complexity Cyclomatic complexity: 2
  */
-static door_fsm_state_t dsm_handle_fault(uint8_t door_id)
+static door_mask_t dsm_sensor_bit(uint8_t door_id, uint8_t value)
 {
-    /* Implements: UNIT-DSM-010 */
-    (void)door_id;
-    /* Motor already stopped on fault entry; hold lock if engaged */
-    return FSM_FAULT;
+    return (0U != value) ? DOOR_BIT(door_id) : (door_mask_t)0U;
 }
 
 /*============================================================================
  * PUBLIC FUNCTIONS
  *===========================================================================*/
 
-/*----------------------------------------------------------------------------
- * DSM_UpdateFSM helper — switch dispatch extracted to keep CCN ≤ 10
- * @complexity Cyclomatic complexity: 10 — at SIL 3 limit of 10
- *---------------------------------------------------------------------------*/
-static door_fsm_state_t dsm_dispatch_state(uint8_t door_id,
-                                            door_fsm_state_t  current_state,
-                                            uint8_t cmd_open,
-                                            uint8_t cmd_close,
-                                            uint8_t pos_a_open,
-                                            uint8_t pos_a_closed,
-                                            uint8_t pos_b_open,
-                                            uint8_t pos_b_closed,
-                                            uint8_t lock_a,
-                                            uint8_t lock_b,
-                                            uint8_t obstacle,
-                                            uint8_t speed_interlock,
-                                            uint8_t safe_state_active,
-                                            uint32_t current_time_ms)
+/**
+ * @brief Advance one door FSM from pre-voted masks — validate, compute the
+ *        guard word and take the matching transition row.
+ * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ */
+error_t DSM_StepFSM(uint8_t door_id,
+                    uint8_t cmd_open,
+                    uint8_t cmd_close,
+                    const dsm_votes_t *votes,
+                    uint8_t obstacle,
+                    uint8_t speed_interlock,
+                    uint8_t safe_state_active,
+                    uint32_t current_time_ms)
 {
-    /* Implements: UNIT-DSM-001 dispatch table */
+    /* Implements: UNIT-DSM-020 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §6.1 */
-    door_fsm_state_t next_state;
+    door_fsm_state_t  prev_state;
+    door_fsm_state_t  next_state;
+    uint16_t          guards;
 
-    switch (current_state)
+    if (NULL == votes)
     {
-        case FSM_IDLE:
-            next_state = dsm_handle_idle(door_id, cmd_open,
-                                         safe_state_active, speed_interlock);
-            break;
-
-        case FSM_OPENING:
-            next_state = dsm_handle_opening(door_id, pos_a_open, pos_b_open,
-                                            obstacle, safe_state_active,
-                                            current_time_ms);
-            break;
-
-        case FSM_FULLY_OPEN:
-            next_state = dsm_handle_fully_open(door_id, cmd_close,
-                                               safe_state_active);
-            break;
-
-        case FSM_CLOSING:
-            next_state = dsm_handle_closing(door_id, pos_a_closed, pos_b_closed,
-                                            obstacle, safe_state_active,
-                                            current_time_ms);
-            break;
+        return ERR_NULL_PTR;
+    }
 
-        case FSM_OBSTACLE_REVERSAL:
-            next_state = dsm_handle_obstacle_reversal(door_id,
-                                                      pos_a_open, pos_b_open,
-                                                      current_time_ms);
-            break;
+    if (door_id >= MAX_DOORS)
+    {
+        return ERR_RANGE;
+    }
 
-        case FSM_FULLY_CLOSED:
-            next_state = dsm_handle_fully_closed(door_id);
-            break;
+    prev_state = g_dsm_state[door_id];
 
-        case FSM_LOCKING:
-            next_state = dsm_handle_locking(door_id, lock_a, lock_b,
-                                            current_time_ms);
-            break;
+    guards = (uint16_t)(dsm_input_guards(door_id, cmd_open, cmd_close,
+                                         obstacle, speed_interlock,
+                                         safe_state_active) |
+                        dsm_sensor_guards(door_id, prev_state, votes,
+                                          current_time_ms));
 
-        case FSM_CLOSED_AND_LOCKED:
-            next_state = dsm_handle_closed_and_locked(door_id, cmd_open,
-                                                       speed_interlock,
-                                                       safe_state_active);
-            break;
+    next_state = dsm_take_transition(door_id, prev_state, guards);
 
-        case FSM_FAULT:
-            next_state = dsm_handle_fault(door_id);
-            break;
-
-        default:
-            /* Unknown state — treat as fault */
-            (void)HAL_MotorStop(door_id);
-            next_state = FSM_FAULT;
-            break;
+    /* Record entry time on any state change; the new state is evaluated
+     * next cycle even if no input changes */
+    if (next_state != prev_state)
+    {
+        g_dsm_entry_time_ms[door_id] = current_time_ms;
+        g_dsm_dirty |= DOOR_BIT(door_id);
     }
 
-    return next_state;
+    g_dsm_state[door_id] = next_state;
+    return SUCCESS;
 }
 
 /**
- * @brief Update per-door FSM — validate then call dispatch helper.
+ * @brief Update per-door FSM from raw sensor values — vote this door's
+ *        sensor pairs with the batch voter, then step the FSM.
  * @complexity Cyclomatic complexity: 2 — within SIL 3 limit of 10
  */
 error_t DSM_UpdateFSM(uint8_t door_id,
@@ -487,32 +462,59 @@ error_t DSM_UpdateFSM(uint8_t door_id,
 {
     /* Implements: UNIT-DSM-001 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §6.1 */
-    door_fsm_state_t  prev_state;
-    door_fsm_state_t  next_state;
+    dsm_votes_t votes;
 
     if (door_id >= MAX_DOORS)
     {
         return ERR_RANGE;
     }
 
-    prev_state = g_dsm_state[door_id];
+    (void)DSM_VotePositionBatch(dsm_sensor_bit(door_id, pos_a_open),
+                                dsm_sensor_bit(door_id, pos_b_open),
+                                &votes.open_voted, &votes.open_disagree);
+    (void)DSM_VotePositionBatch(dsm_sensor_bit(door_id, pos_a_closed),
+                                dsm_sensor_bit(door_id, pos_b_closed),
+                                &votes.closed_voted, &votes.closed_disagree);
+    (void)DSM_VotePositionBatch(dsm_sensor_bit(door_id, lock_a),
+                                dsm_sensor_bit(door_id, lock_b),
+                                &votes.lock_voted, &votes.lock_disagree);
+
+    return DSM_StepFSM(door_id, cmd_open, cmd_close, &votes, obstacle,
+                       speed_interlock, safe_state_active, current_time_ms);
+}
 
-    next_state = dsm_dispatch_state(door_id, prev_state,
-                                    cmd_open, cmd_close,
-                                    pos_a_open, pos_a_closed,
-                                    pos_b_open, pos_b_closed,
-                                    lock_a, lock_b,
-                                    obstacle, speed_interlock,
-                                    safe_state_active, current_time_ms);
+/**
+ * @brief Timeout of an FSM state (0 = state has no timeout).
+ * @details Source of the DSM_G_TIMEOUT guard; also lets
+ *          DSM_RunCycle skip a clean door until its timer expires.
+ * @complexity Cyclomatic complexity: 5
+ */
+uint32_t DSM_GetStateTimeoutMs(door_fsm_state_t state)
+{
+    /* Implements: UNIT-DSM-021 */
+    uint32_t timeout_ms;
 
-    /* Record entry time on any state change */
-    if (next_state != prev_state)
+    switch (state)
     {
-        g_dsm_entry_time_ms[door_id] = current_time_ms;
+        case FSM_OPENING:
+        case FSM_CLOSING:
+            timeout_ms = DSM_MOTOR_TIMEOUT_MS;
+            break;
+
+        case FSM_OBSTACLE_REVERSAL:
+            timeout_ms = DSM_REVERSAL_DRIVE_MS;
+            break;
+
+        case FSM_LOCKING:
+            timeout_ms = DSM_LOCK_TIMEOUT_MS;
+            break;
+
+        default:
+            timeout_ms = 0U;
+            break;
     }
 
-    g_dsm_state[door_id] = next_state;
-    return SUCCESS;
+    return timeout_ms;
 }
 
 /*============================================================================
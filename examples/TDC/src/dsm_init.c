@@ -3,10 +3,27 @@
  * @brief   DSM module initialisation, cycle entry, accessors, and global state.
  * @details Implements UNIT-DSM-015 (Init), UNIT-DSM-016 (RunCycle),
  *          UNIT-DSM-017 (GetDoorStates), UNIT-DSM-018 (GetLockStates),
- *          DSM_GetClosingFlags, DSM_GetFault, DSM_ProcessOpenCommand,
- *          DSM_ProcessCloseCommand.
+ *          DSM_GetClosingFlags, DSM_GetLockedMask, DSM_GetClosingMask,
+ *          DSM_GetFault, DSM_GetMode, DSM_ProcessOpenCommand,
+ *          DSM_ProcessCloseCommand, UNIT-DSM-022 (GetEvalStats).
  *          Also owns all DSM shared state variables (extern in dsm_fsm.c,
- *          dsm_mode.c, dsm_emergency.c).
+ *          dsm_mode.c, dsm_emergency.c). Per-door state is laid out as a
+ *          struct of arrays: multi-valued attributes (FSM state, entry time)
+ *          are one array each, and per-door flags are one door_mask_t word
+ *          each, so command handling and the all-doors checks of SKN/OBD are
+ *          word operations independent of MAX_DOORS.
+ *          DSM_RunCycle is change-driven: a door's FSM is dispatched only
+ *          when it is dirty — its vote, command, disable or obstacle bit
+ *          changed, safe state or speed interlock changed, its state timer
+ *          expired (DSM_TIMER_STATE channel of the timer wheel in
+ *          dsm_timer.c), or its state changed since the last evaluation.
+ *          Emergency release debounce runs only on an input edge, a
+ *          DSM_TIMER_EMERGENCY expiry, or for a pressed button with no
+ *          debounce armed, so held buttons and idle timers cost nothing per
+ *          cycle. A clean
+ *          door would take no transition and issue no HAL command, so
+ *          skipping it does not change behaviour, and the cycle cost follows
+ *          the number of active doors rather than MAX_DOORS.
  *
  * @project TDC (Train Door Control System)
  * @module  DSM (Door State Machine) — COMP-004
@@ -42,11 +59,12 @@
  * GLOBAL SHARED STATE — Owned here, externs in other DSM files
  *===========================================================================*/
 door_fsm_state_t g_dsm_state[MAX_DOORS];
-uint8_t          g_dsm_cmd_open[MAX_DOORS];
-uint8_t          g_dsm_cmd_close[MAX_DOORS];
-uint8_t          g_dsm_disabled[MAX_DOORS];
+door_mask_t      g_dsm_cmd_open;        /**< Open command pending (bit n = door n) */
+door_mask_t      g_dsm_cmd_close;       /**< Close command pending */
+door_mask_t      g_dsm_disabled;        /**< Door selectively disabled */
 uint32_t         g_dsm_entry_time_ms[MAX_DOORS];
 op_mode_t        g_dsm_mode;
+door_mask_t      g_dsm_dirty;           /**< State changed — evaluate next cycle */
 
 /*============================================================================
  * MODULE-LEVEL STATIC STATE
@@ -60,9 +78,43 @@ static uint8_t s_lock_states[MAX_DOORS];
 /** @brief Closing-in-progress flags (1=door is closing) */
 static uint8_t s_closing_flags[MAX_DOORS];
 
+/** @brief Doors in FSM_CLOSED_AND_LOCKED (mask form of s_lock_states) */
+static door_mask_t s_locked_mask;
+
+/** @brief Doors in FSM_CLOSING (mask form of s_closing_flags) */
+static door_mask_t s_closing_mask;
+
+/** @brief System tick (ms) at the last door entering FSM_CLOSED_AND_LOCKED */
+static uint32_t s_lock_confirm_ms;
+
+/** @brief Doors that entered FSM_CLOSED_AND_LOCKED since DSM_Init (wraps) */
+static uint32_t s_lock_confirm_count;
+
 /** @brief DSM aggregated fault flag (0=OK, non-zero=fault) */
 static uint8_t s_dsm_fault_flag;
 
+/** @brief FSM inputs of one cycle, kept to detect changes */
+typedef struct
+{
+    dsm_votes_t votes;
+    door_mask_t cmd_open;
+    door_mask_t cmd_close;
+    door_mask_t disabled;
+    door_mask_t obstacle;
+    uint8_t     safe_state_active;
+    uint8_t     speed_interlock;
+    uint8_t     motor_inhibit;
+} dsm_cycle_inputs_t;
+
+/** @brief FSM inputs of the previous cycle */
+static dsm_cycle_inputs_t s_prev_inputs;
+
+/** @brief Emergency release inputs of the previous cycle */
+static door_mask_t s_prev_emergency;
+
+/** @brief Change-driven dispatch counters */
+static dsm_eval_stats_t s_eval_stats;
+
 /*============================================================================
  * PRIVATE HELPERS
  *===========================================================================*/
@@ -102,6 +154,128 @@ static uint8_t dsm_map_state_to_external(door_fsm_state_t fsm_state)
     return ext_state;
 }
 
+/**
+ * @brief Index of the lowest set bit of a non-zero door mask.
+ * @complexity Cyclomatic complexity: 6
+ */
+static uint8_t dsm_lowest_door(door_mask_t mask)
+{
+    door_mask_t m    = mask;
+    uint8_t     door = 0U;
+
+    if (0U == (m & 0xFFFFFFFFULL))
+    {
+        m >>= 32U;
+        door += 32U;
+    }
+    if (0U == (m & 0xFFFFULL))
+    {
+        m >>= 16U;
+        door += 16U;
+    }
+    if (0U == (m & 0xFFULL))
+    {
+        m >>= 8U;
+        door += 8U;
+    }
+    if (0U == (m & 0xFULL))
+    {
+        m >>= 4U;
+        door += 4U;
+    }
+    if (0U == (m & 0x3ULL))
+    {
+        m >>= 2U;
+        door += 2U;
+    }
+
+    return (uint8_t)(door + (uint8_t)((~m) & 1U));
+}
+
+/**
+ * @brief Doors whose FSM inputs differ between two cycles.
+ * @complexity Cyclomatic complexity: 4
+ */
+static door_mask_t dsm_changed_doors(const dsm_cycle_inputs_t *now,
+                                     const dsm_cycle_inputs_t *prev)
+{
+    door_mask_t changed;
+
+    changed = (now->votes.open_voted      ^ prev->votes.open_voted)      |
+              (now->votes.open_disagree   ^ prev->votes.open_disagree)   |
+              (now->votes.closed_voted    ^ prev->votes.closed_voted)    |
+              (now->votes.closed_disagree ^ prev->votes.closed_disagree) |
+              (now->votes.lock_voted      ^ prev->votes.lock_voted)      |
+              (now->votes.lock_disagree   ^ prev->votes.lock_disagree)   |
+              (now->cmd_open  ^ prev->cmd_open)  |
+              (now->cmd_close ^ prev->cmd_close) |
+              (now->disabled  ^ prev->disabled)  |
+              (now->obstacle  ^ prev->obstacle);
+
+    /* Global inputs reach every door */
+    if ((now->safe_state_active != prev->safe_state_active) ||
+        (now->speed_interlock   != prev->speed_interlock)   ||
+        (now->motor_inhibit     != prev->motor_inhibit))
+    {
+        changed = DOOR_MASK_ALL;
+    }
+
+    return changed & DOOR_MASK_ALL;
+}
+
+/**
+ * @brief Refresh the exported state of one door after evaluation,
+ *        timestamp a new lock confirmation and (re-)arm or cancel its state
+ *        timer.
+ * @complexity Cyclomatic complexity: 7
+ */
+static void dsm_refresh_door(uint8_t door, uint32_t tick_ms)
+{
+    door_mask_t bit        = DOOR_BIT(door);
+    uint32_t    timeout_ms = DSM_GetStateTimeoutMs(g_dsm_state[door]);
+
+    s_door_states[door]   = dsm_map_state_to_external(g_dsm_state[door]);
+    s_lock_states[door]   = (g_dsm_state[door] == FSM_CLOSED_AND_LOCKED) ? 1U : 0U;
+    s_closing_flags[door] = (g_dsm_state[door] == FSM_CLOSING) ? 1U : 0U;
+
+    /* Lock confirmation: start of the TCMS interlock latency measurement */
+    if ((0U != s_lock_states[door]) && (0U == (s_locked_mask & bit)))
+    {
+        s_lock_confirm_ms = tick_ms;
+        s_lock_confirm_count++;
+    }
+
+    s_locked_mask  = (s_locked_mask & ~bit) |
+                     ((door_mask_t)s_lock_states[door] << door);
+    s_closing_mask = (s_closing_mask & ~bit) |
+                     ((door_mask_t)s_closing_flags[door] << door);
+
+    if (0U != timeout_ms)
+    {
+        (void)DSM_Timer_Arm(DSM_TIMER_STATE, door,
+                            g_dsm_entry_time_ms[door] + timeout_ms);
+    }
+    else
+    {
+        (void)DSM_Timer_Cancel(DSM_TIMER_STATE, door);
+    }
+
+    /* Set fault if the door is in FAULT state */
+    if (g_dsm_state[door] == FSM_FAULT)
+    {
+        s_dsm_fault_flag = 1U;
+    }
+}
+
+/**
+ * @brief Add to a saturating counter.
+ * @complexity Cyclomatic complexity: 2
+ */
+static uint32_t dsm_sat_add(uint32_t counter, uint32_t n)
+{
+    return (counter > (UINT32_MAX - n)) ? UINT32_MAX : (counter + n);
+}
+
 /*============================================================================
  * PUBLIC FUNCTIONS
  *===========================================================================*/
@@ -119,128 +293,171 @@ error_t DSM_Init(void)
     for (i = 0U; i < MAX_DOORS; i++)
     {
         g_dsm_state[i]        = FSM_IDLE;
-        g_dsm_cmd_open[i]     = 0U;
-        g_dsm_cmd_close[i]    = 0U;
-        g_dsm_disabled[i]     = 0U;
         g_dsm_entry_time_ms[i]= 0U;
         s_door_states[i]      = (uint8_t)DOOR_STATE_UNKNOWN;
         s_lock_states[i]      = 0U;
         s_closing_flags[i]    = 0U;
     }
 
-    g_dsm_mode      = MODE_NORMAL;
+    g_dsm_cmd_open   = 0U;
+    g_dsm_cmd_close  = 0U;
+    g_dsm_disabled   = 0U;
+    s_locked_mask    = 0U;
+    s_closing_mask   = 0U;
+    s_lock_confirm_ms    = 0U;
+    s_lock_confirm_count = 0U;
+    g_dsm_mode       = MODE_NORMAL;
     s_dsm_fault_flag = 0U;
 
+    /* First cycle evaluates every door and clears any emergency debounce */
+    g_dsm_dirty      = DOOR_MASK_ALL;
+    s_prev_emergency = DOOR_MASK_ALL;
+    s_prev_inputs.votes.open_voted      = 0U;
+    s_prev_inputs.votes.open_disagree   = 0U;
+    s_prev_inputs.votes.closed_voted    = 0U;
+    s_prev_inputs.votes.closed_disagree = 0U;
+    s_prev_inputs.votes.lock_voted      = 0U;
+    s_prev_inputs.votes.lock_disagree   = 0U;
+    s_prev_inputs.cmd_open              = 0U;
+    s_prev_inputs.cmd_close             = 0U;
+    s_prev_inputs.disabled              = 0U;
+    s_prev_inputs.obstacle              = 0U;
+    s_prev_inputs.safe_state_active     = 0U;
+    s_prev_inputs.speed_interlock       = 0U;
+    s_prev_inputs.motor_inhibit         = 0U;
+    s_eval_stats.evaluated              = 0U;
+    s_eval_stats.skipped                = 0U;
+    s_eval_stats.last_evaluated         = 0U;
+    DSM_Timer_Init(HAL_GetSystemTickMs());
+
     return SUCCESS;
 }
 
 /**
- * @brief 20 ms cycle entry — read sensors and advance each door FSM.
- * @complexity Cyclomatic complexity: 3
+ * @brief 20 ms cycle entry — vote the input image and advance the FSM of
+ *        every dirty door.
+ * @details Doors with an emergency release edge, debounce expiry, or a
+ *          pressed button without a debounce armed also run the emergency
+ *          handler; all other doors are skipped.
+ * @complexity Cyclomatic complexity: 6
  */
 void DSM_RunCycle(void)
 {
     /* Implements: UNIT-DSM-016 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §6 */
-    uint8_t  i;
-    uint32_t tick_ms;
-    error_t  err;
-
-    /* Read sensor inputs for each door and advance FSM */
-    uint8_t pos_a_open    = 0U;
-    uint8_t pos_a_closed  = 0U;
-    uint8_t pos_b_open    = 0U;
-    uint8_t pos_b_closed  = 0U;
-    uint8_t lock_a        = 0U;
-    uint8_t lock_b        = 0U;
+    uint8_t            i;
+    uint8_t            evaluated = 0U;
+    uint32_t           tick_ms;
+    error_t            err;
+    door_mask_t        dirty;
+    door_mask_t        emergency;
+    door_mask_t        pending;
+    dsm_cycle_inputs_t inputs;
+    const hal_input_image_t *image;
 
     tick_ms = HAL_GetSystemTickMs();
-
-    for (i = 0U; i < MAX_DOORS; i++)
+    image   = HAL_GPIO_GetInputImage();  /* Sampled once at cycle start */
+    DSM_Timer_Advance(tick_ms);
+
+    /* 2oo2-vote every door at once — unreadable inputs are clear (absent).
+     * One position sensor pair serves both the open and closed checks. */
+    (void)DSM_VotePositionBatch(image->position_a, image->position_b,
+                                &inputs.votes.open_voted,
+                                &inputs.votes.open_disagree);
+    inputs.votes.closed_voted    = inputs.votes.open_voted;
+    inputs.votes.closed_disagree = inputs.votes.open_disagree;
+    (void)DSM_VotePositionBatch(image->lock_a, image->lock_b,
+                                &inputs.votes.lock_voted,
+                                &inputs.votes.lock_disagree);
+    inputs.cmd_open          = g_dsm_cmd_open;
+    inputs.cmd_close         = g_dsm_cmd_close;
+    inputs.disabled          = g_dsm_disabled;
+    inputs.obstacle          = g_obstacle_mask;
+    inputs.safe_state_active = g_safe_state_active;
+    inputs.speed_interlock   = g_speed_interlock_active;
+    inputs.motor_inhibit     = HAL_IsMotorInhibited();
+
+    dirty = (g_dsm_dirty | dsm_changed_doors(&inputs, &s_prev_inputs) |
+             DSM_Timer_TakeExpired(DSM_TIMER_STATE)) & DOOR_MASK_ALL;
+    emergency = ((image->emergency ^ s_prev_emergency) |
+                 (image->emergency & ~DSM_Timer_GetArmed(DSM_TIMER_EMERGENCY)) |
+                 DSM_Timer_TakeExpired(DSM_TIMER_EMERGENCY)) & DOOR_MASK_ALL;
+
+    s_prev_inputs    = inputs;
+    s_prev_emergency = image->emergency;
+    g_dsm_dirty      = 0U;  /* Re-set by state changes during this cycle */
+
+    pending = dirty | emergency;
+    while (0U != pending)
     {
-        /* Read sensors — errors treated as sensor absent (fail-safe) */
-        (void)HAL_GPIO_ReadPositionSensor(i, 0U, &pos_a_open);
-        (void)HAL_GPIO_ReadPositionSensor(i, 1U, &pos_b_open);
-        (void)HAL_GPIO_ReadPositionSensor(i, 0U, &pos_a_closed);
-        (void)HAL_GPIO_ReadPositionSensor(i, 1U, &pos_b_closed);
-        (void)HAL_GPIO_ReadLockSensor(i, 0U, &lock_a);
-        (void)HAL_GPIO_ReadLockSensor(i, 1U, &lock_b);
+        i        = dsm_lowest_door(pending);
+        pending &= pending - 1U;
 
         /* Advance FSM */
-        err = DSM_UpdateFSM(i,
-                            g_dsm_cmd_open[i],
-                            g_dsm_cmd_close[i],
-                            pos_a_open,
-                            pos_a_closed,
-                            pos_b_open,
-                            pos_b_closed,
-                            lock_a,
-                            lock_b,
-                            g_obstacle_flags[i],
-                            g_speed_interlock_active,
-                            g_safe_state_active,
-                            tick_ms);
-        if (SUCCESS != err)
+        if (0U != DOOR_MASK_TEST(dirty, i))
         {
-            s_dsm_fault_flag = 1U;
+            err = DSM_StepFSM(i,
+                              DOOR_MASK_TEST(inputs.cmd_open, i),
+                              DOOR_MASK_TEST(inputs.cmd_close, i),
+                              &inputs.votes,
+                              DOOR_MASK_TEST(inputs.obstacle, i),
+                              inputs.speed_interlock,
+                              inputs.safe_state_active,
+                              tick_ms);
+            if (SUCCESS != err)
+            {
+                s_dsm_fault_flag = 1U;
+            }
+            evaluated++;
         }
 
         /* Handle emergency release */
-        err = DSM_HandleEmergencyRelease(i, tick_ms);
-        if (SUCCESS != err)
+        if (0U != DOOR_MASK_TEST(emergency, i))
         {
-            s_dsm_fault_flag = 1U;
+            err = DSM_HandleEmergencyRelease(i, tick_ms);
+            if (SUCCESS != err)
+            {
+                s_dsm_fault_flag = 1U;
+            }
         }
 
-        /* Update exported state arrays */
-        s_door_states[i]   = dsm_map_state_to_external(g_dsm_state[i]);
-        s_lock_states[i]   = (g_dsm_state[i] == FSM_CLOSED_AND_LOCKED) ? 1U : 0U;
-        s_closing_flags[i] = (g_dsm_state[i] == FSM_CLOSING) ? 1U : 0U;
-
-        /* Set fault if any door in FAULT state */
-        if (g_dsm_state[i] == FSM_FAULT)
-        {
-            s_dsm_fault_flag = 1U;
-        }
+        dsm_refresh_door(i, tick_ms);
     }
+
+    s_eval_stats.evaluated      = dsm_sat_add(s_eval_stats.evaluated,
+                                              (uint32_t)evaluated);
+    s_eval_stats.skipped        = dsm_sat_add(s_eval_stats.skipped,
+                                              (uint32_t)MAX_DOORS -
+                                              (uint32_t)evaluated);
+    s_eval_stats.last_evaluated = evaluated;
 }
 
 /**
  * @brief Process open command from TCMS.
- * @complexity Cyclomatic complexity: 2
+ * @details Bits above MAX_DOORS - 1 are ignored.
+ * @complexity Cyclomatic complexity: 1
  */
-error_t DSM_ProcessOpenCommand(uint8_t door_mask)
+error_t DSM_ProcessOpenCommand(door_mask_t door_mask)
 {
-    uint8_t i;
+    door_mask_t doors = door_mask & DOOR_MASK_ALL;
 
-    for (i = 0U; i < MAX_DOORS; i++)
-    {
-        if ((door_mask & (1U << i)) != 0U)
-        {
-            g_dsm_cmd_open[i]  = 1U;
-            g_dsm_cmd_close[i] = 0U;
-        }
-    }
+    g_dsm_cmd_open  |= doors;
+    g_dsm_cmd_close &= ~doors;
 
     return SUCCESS;
 }
 
 /**
  * @brief Process close command from TCMS.
- * @complexity Cyclomatic complexity: 2
+ * @details Bits above MAX_DOORS - 1 are ignored.
+ * @complexity Cyclomatic complexity: 1
  */
-error_t DSM_ProcessCloseCommand(uint8_t door_mask)
+error_t DSM_ProcessCloseCommand(door_mask_t door_mask)
 {
-    uint8_t i;
+    door_mask_t doors = door_mask & DOOR_MASK_ALL;
 
-    for (i = 0U; i < MAX_DOORS; i++)
-    {
-        if ((door_mask & (1U << i)) != 0U)
-        {
-            g_dsm_cmd_close[i] = 1U;
-            g_dsm_cmd_open[i]  = 0U;
-        }
-    }
+    g_dsm_cmd_close |= doors;
+    g_dsm_cmd_open  &= ~doors;
 
     return SUCCESS;
 }
@@ -274,6 +491,42 @@ const uint8_t *DSM_GetClosingFlags(void)
     return s_closing_flags;
 }
 
+/**
+ * @brief Get the mask of doors closed and locked in the last cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+door_mask_t DSM_GetLockedMask(void)
+{
+    return s_locked_mask;
+}
+
+/**
+ * @brief Get the system tick at the most recent lock confirmation.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t DSM_GetLockConfirmMs(void)
+{
+    return s_lock_confirm_ms;
+}
+
+/**
+ * @brief Get the number of lock confirmations since DSM_Init.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t DSM_GetLockConfirmCount(void)
+{
+    return s_lock_confirm_count;
+}
+
+/**
+ * @brief Get the mask of doors closing in the last cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+door_mask_t DSM_GetClosingMask(void)
+{
+    return s_closing_mask;
+}
+
 /**
  * @brief Get DSM fault status.
  * @complexity Cyclomatic complexity: 1
@@ -283,6 +536,38 @@ uint8_t DSM_GetFault(void)
     return s_dsm_fault_flag;
 }
 
+/**
+ * @brief Read the change-driven dispatch counters.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t DSM_GetEvalStats(dsm_eval_stats_t *stats_out)
+{
+    /* Implements: UNIT-DSM-022 */
+    error_t result;
+
+    if (NULL == stats_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *stats_out = s_eval_stats;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the current operational mode.
+ * @complexity Cyclomatic complexity: 1
+ */
+op_mode_t DSM_GetMode(void)
+{
+    /* Implements: UNIT-DSM-018 */
+    return g_dsm_mode;
+}
+
 /*============================================================================
  * END OF FILE
  *===========================================================================*/
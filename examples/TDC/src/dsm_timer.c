@@ -0,0 +1,396 @@
+/**
+ * @file    dsm_timer.c
+ * @brief   DSM Timer Wheel — per-door timeouts with O(1) arm, cancel and
+ *          expiry.
+ * @details Implements UNIT-DSM-023 (Timer_Init, Timer_Arm, Timer_Cancel,
+ *          Timer_GetArmed) and UNIT-DSM-024 (Timer_Advance,
+ *          Timer_TakeExpired).
+ *          Each channel (DSM_TIMER_STATE, DSM_TIMER_EMERGENCY) holds one
+ *          timer per door. Timers sit in a two-level hierarchical wheel of
+ *          DSM_TW_SLOTS slots per level; a slot is a door_mask_t, so arming
+ *          or cancelling sets or clears one bit and expiring a slot is one
+ *          word operation for all doors in it.
+ *          - Level 0: one slot per CYCLE_MS tick (1.28 s span at 20 ms).
+ *          - Level 1: one slot per DSM_TW_SLOTS ticks (82 s span); a slot
+ *            is cascaded into level 0 when the wheel enters its block.
+ *          Timer_Advance moves the wheel by the milliseconds elapsed since
+ *          the previous call (unsigned difference, so 32-bit tick wrap is
+ *          harmless). Ticks passed entirely expire their slot; timers in the
+ *          current tick are compared against their exact deadline, so a
+ *          timer expires at the first Advance with now >= deadline — never
+ *          earlier, never a cycle later.
+ *          Deadlines that are already due, or too far ahead for the wheel,
+ *          expire at once; callers re-arm on the resulting evaluation.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  DSM (Door State Machine) — MOD-DSM-006
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-FUN-001–015, REQ-SAFE-011, REQ-PERF-001
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Deadline comparisons use unsigned differences (Rule 10.1, 10.4)
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §6.6
+ */
+
+/* Implements: REQ-PERF-001, UNIT-DSM-023/024 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §6.6 (MOD-DSM-006) */
+/* SIL: 3 */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "dsm.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * MODULE CONSTANTS
+ *===========================================================================*/
+/** @brief Slots per wheel level (power of two) */
+#define DSM_TW_SLOT_BITS   (6U)
+#define DSM_TW_SLOTS       (1UL << DSM_TW_SLOT_BITS)
+#define DSM_TW_SLOT_MASK   (DSM_TW_SLOTS - 1UL)
+
+/** @brief Wheel tick length (ms) */
+#define DSM_TW_TICK_MS     ((uint32_t)CYCLE_MS)
+
+/** @brief Wheel span in ticks and ms (both levels) */
+#define DSM_TW_SPAN_TICKS  (DSM_TW_SLOTS * DSM_TW_SLOTS)
+#define DSM_TW_SPAN_MS     (DSM_TW_SPAN_TICKS * DSM_TW_TICK_MS)
+
+/** @brief Unsigned differences at or above this are negative (past) */
+#define DSM_TW_HALF_RANGE  (0x80000000UL)
+
+#if ((DSM_TW_SLOTS * DSM_TW_SLOTS * CYCLE_MS) >= DSM_TW_HALF_RANGE)
+#error "Timer wheel span must stay within half the 32-bit tick range"
+#endif
+
+/*============================================================================
+ * MODULE-LEVEL STATIC STATE
+ *===========================================================================*/
+/** @brief Level 0 slots: timers due in that tick of the current block */
+static door_mask_t s_tw_level0[DSM_TIMER_CHANNELS][DSM_TW_SLOTS];
+
+/** @brief Level 1 slots: timers due in that block */
+static door_mask_t s_tw_level1[DSM_TIMER_CHANNELS][DSM_TW_SLOTS];
+
+/** @brief Armed timers, and the subset held in level 1 */
+static door_mask_t s_tw_armed[DSM_TIMER_CHANNELS];
+static door_mask_t s_tw_upper[DSM_TIMER_CHANNELS];
+
+/** @brief Expired timers not yet taken */
+static door_mask_t s_tw_expired[DSM_TIMER_CHANNELS];
+
+/** @brief Due tick and exact deadline (ms) of each timer */
+static uint32_t s_tw_target[DSM_TIMER_CHANNELS][MAX_DOORS];
+static uint32_t s_tw_deadline_ms[DSM_TIMER_CHANNELS][MAX_DOORS];
+
+/** @brief Current wheel tick, time of the last advance, ms into the tick */
+static uint32_t s_tw_tick;
+static uint32_t s_tw_now_ms;
+static uint32_t s_tw_sub_ms;
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
+
+/**
+ * @brief Remove a timer from its slot and from the armed/expired sets.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void dsm_tw_unlink(uint8_t channel, uint8_t door_id)
+{
+    door_mask_t bit    = DOOR_BIT(door_id);
+    uint32_t    target = s_tw_target[channel][door_id];
+
+    if (0U != (s_tw_armed[channel] & bit))
+    {
+        if (0U != (s_tw_upper[channel] & bit))
+        {
+            s_tw_level1[channel][(target >> DSM_TW_SLOT_BITS) &
+                                 DSM_TW_SLOT_MASK] &= ~bit;
+        }
+        else
+        {
+            s_tw_level0[channel][target & DSM_TW_SLOT_MASK] &= ~bit;
+        }
+    }
+    s_tw_armed[channel]   &= ~bit;
+    s_tw_upper[channel]   &= ~bit;
+    s_tw_expired[channel] &= ~bit;
+}
+
+/**
+ * @brief Place an armed timer in the slot of its due tick.
+ * @details Same block as the current tick: level 0; later block: level 1.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void dsm_tw_insert(uint8_t channel, uint8_t door_id)
+{
+    door_mask_t bit    = DOOR_BIT(door_id);
+    uint32_t    target = s_tw_target[channel][door_id];
+
+    if (0U == ((target ^ s_tw_tick) >> DSM_TW_SLOT_BITS))
+    {
+        s_tw_level0[channel][target & DSM_TW_SLOT_MASK] |= bit;
+        s_tw_upper[channel] &= ~bit;
+    }
+    else
+    {
+        s_tw_level1[channel][(target >> DSM_TW_SLOT_BITS) &
+                             DSM_TW_SLOT_MASK] |= bit;
+        s_tw_upper[channel] |= bit;
+    }
+}
+
+/**
+ * @brief Move the level 1 slot of the block just entered into level 0.
+ * @details Runs once per DSM_TW_SLOTS ticks; bounded by MAX_DOORS.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void dsm_tw_cascade(uint8_t channel)
+{
+    uint32_t    slot = (s_tw_tick >> DSM_TW_SLOT_BITS) & DSM_TW_SLOT_MASK;
+    door_mask_t m    = s_tw_level1[channel][slot];
+    uint8_t     door = 0U;
+
+    s_tw_level1[channel][slot] = 0U;
+    while (0U != m)
+    {
+        if (0U != (m & 1U))
+        {
+            dsm_tw_insert(channel, door);
+        }
+        m >>= 1U;
+        door++;
+    }
+}
+
+/**
+ * @brief Expire the timers of the current tick whose deadline is reached.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void dsm_tw_expire_current(uint8_t channel)
+{
+    uint32_t    slot = s_tw_tick & DSM_TW_SLOT_MASK;
+    door_mask_t m    = s_tw_level0[channel][slot];
+    door_mask_t due  = 0U;
+    uint8_t     door = 0U;
+
+    while (0U != m)
+    {
+        if ((0U != (m & 1U)) &&
+            ((s_tw_now_ms - s_tw_deadline_ms[channel][door]) <
+             DSM_TW_HALF_RANGE))
+        {
+            due |= DOOR_BIT(door);
+        }
+        m >>= 1U;
+        door++;
+    }
+
+    s_tw_level0[channel][slot] &= ~due;
+    s_tw_armed[channel]        &= ~due;
+    s_tw_expired[channel]      |= due;
+}
+
+/**
+ * @brief Advance the wheel by whole ticks, expiring each slot passed.
+ * @complexity Cyclomatic complexity: 4
+ */
+static void dsm_tw_step(uint32_t ticks)
+{
+    uint32_t    k;
+    uint8_t     ch;
+    door_mask_t m;
+
+    for (k = 0U; k < ticks; k++)
+    {
+        for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+        {
+            m = s_tw_level0[ch][s_tw_tick & DSM_TW_SLOT_MASK];
+            s_tw_level0[ch][s_tw_tick & DSM_TW_SLOT_MASK] = 0U;
+            s_tw_armed[ch]   &= ~m;
+            s_tw_expired[ch] |= m;
+        }
+        s_tw_tick++;
+        if (0U == (s_tw_tick & DSM_TW_SLOT_MASK))
+        {
+            for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+            {
+                dsm_tw_cascade(ch);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Expire every armed timer and empty the wheel.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void dsm_tw_flush(void)
+{
+    uint8_t  ch;
+    uint32_t slot;
+
+    for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+    {
+        for (slot = 0U; slot < DSM_TW_SLOTS; slot++)
+        {
+            s_tw_level0[ch][slot] = 0U;
+            s_tw_level1[ch][slot] = 0U;
+        }
+        s_tw_expired[ch] |= s_tw_armed[ch];
+        s_tw_armed[ch]    = 0U;
+        s_tw_upper[ch]    = 0U;
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Empty the wheel and start it at now_ms.
+ * @details Called from DSM_Init.
+ * @complexity Cyclomatic complexity: 2
+ */
+void DSM_Timer_Init(uint32_t now_ms)
+{
+    /* Implements: UNIT-DSM-023 */
+    uint8_t ch;
+
+    dsm_tw_flush();
+    for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+    {
+        s_tw_expired[ch] = 0U;
+    }
+    s_tw_tick   = 0U;
+    s_tw_now_ms = now_ms;
+    s_tw_sub_ms = 0U;
+}
+
+/**
+ * @brief Arm (or re-arm) the timer of one door to expire at deadline_ms.
+ * @details A deadline that is already due, or beyond the wheel span,
+ *          expires at once.
+ * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ */
+error_t DSM_Timer_Arm(uint8_t channel, uint8_t door_id, uint32_t deadline_ms)
+{
+    /* Implements: UNIT-DSM-023 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §6.6 */
+    uint32_t delta_ms;
+
+    if ((channel >= DSM_TIMER_CHANNELS) || (door_id >= MAX_DOORS))
+    {
+        return ERR_RANGE;
+    }
+
+    dsm_tw_unlink(channel, door_id);
+    s_tw_deadline_ms[channel][door_id] = deadline_ms;
+    delta_ms = deadline_ms - s_tw_now_ms;
+
+    if ((0U == delta_ms) || (delta_ms >= DSM_TW_SPAN_MS))
+    {
+        s_tw_expired[channel] |= DOOR_BIT(door_id);  /* Due or out of span */
+    }
+    else
+    {
+        s_tw_target[channel][door_id] =
+            s_tw_tick + ((s_tw_sub_ms + delta_ms) / DSM_TW_TICK_MS);
+        s_tw_armed[channel] |= DOOR_BIT(door_id);
+        dsm_tw_insert(channel, door_id);
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Cancel the timer of one door, including an expiry not yet taken.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t DSM_Timer_Cancel(uint8_t channel, uint8_t door_id)
+{
+    /* Implements: UNIT-DSM-023 */
+    if ((channel >= DSM_TIMER_CHANNELS) || (door_id >= MAX_DOORS))
+    {
+        return ERR_RANGE;
+    }
+
+    dsm_tw_unlink(channel, door_id);
+    return SUCCESS;
+}
+
+/**
+ * @brief Doors with an armed (not yet expired) timer on a channel.
+ * @complexity Cyclomatic complexity: 2
+ */
+door_mask_t DSM_Timer_GetArmed(uint8_t channel)
+{
+    /* Implements: UNIT-DSM-023 */
+    return (channel < DSM_TIMER_CHANNELS) ? s_tw_armed[channel] :
+           (door_mask_t)0U;
+}
+
+/**
+ * @brief Advance the wheel to now_ms and collect expired timers.
+ * @details Cost is one word operation per channel and tick passed (one tick
+ *          per 20 ms cycle), plus a scan of the current tick's timers.
+ *          A gap longer than the wheel span expires every armed timer.
+ * @complexity Cyclomatic complexity: 3
+ */
+void DSM_Timer_Advance(uint32_t now_ms)
+{
+    /* Implements: UNIT-DSM-024 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §6.6 */
+    uint32_t elapsed_ms = now_ms - s_tw_now_ms;  /* Wrap-safe */
+    uint8_t  ch;
+
+    s_tw_now_ms = now_ms;
+
+    if (elapsed_ms >= DSM_TW_SPAN_MS)
+    {
+        dsm_tw_flush();
+        s_tw_sub_ms = 0U;
+    }
+    else
+    {
+        elapsed_ms += s_tw_sub_ms;
+        s_tw_sub_ms = elapsed_ms % DSM_TW_TICK_MS;
+        dsm_tw_step(elapsed_ms / DSM_TW_TICK_MS);
+    }
+
+    for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+    {
+        dsm_tw_expire_current(ch);
+    }
+}
+
+/**
+ * @brief Take (read and clear) the expired timers of a channel.
+ * @complexity Cyclomatic complexity: 2
+ */
+door_mask_t DSM_Timer_TakeExpired(uint8_t channel)
+{
+    /* Implements: UNIT-DSM-024 */
+    door_mask_t expired = 0U;
+
+    if (channel < DSM_TIMER_CHANNELS)
+    {
+        expired = s_tw_expired[channel];
+        s_tw_expired[channel] = 0U;
+    }
+
+    return expired;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
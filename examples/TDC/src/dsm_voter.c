@@ -5,6 +5,11 @@
  *          binary sensor readings.  If both sensors agree the agreed value is
  *          returned; if they disagree the output is set to 0 (fail-safe) and
  *          the disagree flag is set.
+ *          UNIT-DSM-019 applies the same vote to all doors at once on
+ *          door_mask_t sensor masks (voted = A AND B, disagree = A XOR B), so
+ *          the per-cycle voting cost does not grow with MAX_DOORS. The FSM
+ *          consumes the batch result; DSM_VotePosition is kept as the
+ *          per-door reference the batch voter is verified against.
  *
  * @project TDC (Train Door Control System)
  * @module  DSM (Door State Machine) — COMP-004
@@ -73,6 +78,36 @@ error_t DSM_VotePosition(uint8_t  door_id,
     return SUCCESS;
 }
 
+/**
+ * @brief Word-parallel 2oo2 voter for all doors.
+ * @details For each bit: agree-active → voted 1; agree-inactive → voted 0;
+ *          disagree → voted 0 (fail-safe) and disagree 1 — the truth table
+ *          of DSM_VotePosition.
+ * @complexity Cyclomatic complexity: 2 — within SIL 3 limit of 10
+ */
+error_t DSM_VotePositionBatch(door_mask_t  sensor_a,
+                              door_mask_t  sensor_b,
+                              door_mask_t *voted_out,
+                              door_mask_t *disagree_out)
+{
+    /* Implements: UNIT-DSM-019 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §6.2 */
+    error_t result;
+
+    if ((NULL == voted_out) || (NULL == disagree_out))
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *voted_out    = (sensor_a & sensor_b) & DOOR_MASK_ALL;
+        *disagree_out = (sensor_a ^ sensor_b) & DOOR_MASK_ALL;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
 /*============================================================================
  * END OF FILE
  *===========================================================================*/
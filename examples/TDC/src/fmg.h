@@ -27,6 +27,21 @@
 #include <stdint.h>
 #include "tdc_types.h"
 
+/** @brief Bits of the aggregated fault bitmask: 0 SPM, 1 OBD, 2 DSM, 3 TCI,
+ *         4 HAL */
+#define FMG_FAULT_BITS  (5U)
+
+/**
+ * @brief Activation history of one fault bit.
+ * @details Kept in RAM in place of a log entry per cycle: the log records
+ *          only changes of the fault bitmask.
+ */
+typedef struct {
+    uint32_t activation_count;  /**< Rising edges since FMG_Init */
+    uint32_t first_seen_ms;     /**< System tick of the first activation */
+    uint32_t last_seen_ms;      /**< System tick of the last cycle it was set */
+} fmg_fault_stats_t;
+
 /**
  * @brief Initialise FMG module — clear all fault state.
  * @return error_t SUCCESS
@@ -60,6 +75,11 @@ error_t FMG_AggregateFaults(uint8_t spm_fault,
 
 /**
  * @brief Classify fault bitmask and escalate to maximum severity.
+ * @details Edge-triggered: the last classified bitmask and its severity are
+ *          cached. Only a bitmask different from the cached one is
+ *          reclassified and logged (EVT_FAULT_ACTIVE, data = bitmask << 8 |
+ *          severity; EVT_FAULT_CLEARED, data = previous bitmask, when it
+ *          becomes 0), so a persistent fault is logged once, not every cycle.
  * @param[in]  fault_state    Aggregated fault bitmask
  * @param[out] max_severity_out Maximum severity of active faults
  * @return error_t SUCCESS, ERR_NULL_PTR
@@ -75,7 +95,7 @@ error_t FMG_ClassifyAndEscalate(uint8_t fault_state,
  * @return error_t SUCCESS, ERR_NOT_PERMITTED
  * @note   UNIT-FMG-003; Complexity: 2
  */
-error_t FMG_HandleSelectiveDisablement(uint8_t door_mask,
+error_t FMG_HandleSelectiveDisablement(door_mask_t door_mask,
                                        uint8_t tcms_authorized);
 
 /**
@@ -85,6 +105,22 @@ error_t FMG_HandleSelectiveDisablement(uint8_t door_mask,
  */
 error_t FMG_ProcessEmergencyStop(uint8_t stop_code);
 
+/**
+ * @brief Release the emergency stop (CAN 0x104 with stop code 0x00).
+ * @details Clears the stop flag; TCI then releases the HAL motor inhibit
+ *          in the same cycle. Logs EVT_ESTOP_RELEASED if a stop was active.
+ * @return error_t SUCCESS
+ * @note   UNIT-FMG-008; Complexity: 2
+ */
+error_t FMG_ReleaseEmergencyStop(void);
+
+/**
+ * @brief Get the emergency stop flag (accessor for TCI).
+ * @return uint8_t 1 = emergency stop active, 0 = released
+ * @note   UNIT-FMG-006; Complexity: 1
+ */
+uint8_t FMG_IsEmergencyStopActive(void);
+
 /**
  * @brief Get current aggregated fault state (accessor for SKN, TCI).
  * @return uint8_t Aggregated fault bitmask (0 = no faults)
@@ -92,6 +128,15 @@ error_t FMG_ProcessEmergencyStop(uint8_t stop_code);
  */
 uint8_t FMG_GetFaultState(void);
 
+/**
+ * @brief Get the activation history of one fault bit.
+ * @param[in]  fault_bit Bit of the aggregated bitmask (0–FMG_FAULT_BITS-1)
+ * @param[out] stats_out Activation count, first and last seen tick
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE
+ * @note   UNIT-FMG-007; Complexity: 3
+ */
+error_t FMG_GetFaultStats(uint8_t fault_bit, fmg_fault_stats_t *stats_out);
+
 /**
  * @brief Get FMG fault status (for FMG self-reporting).
  * @return uint8_t 0 = no fault
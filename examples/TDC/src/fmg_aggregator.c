@@ -3,7 +3,12 @@
  * @brief   FMG fault aggregation and classification.
  * @details Implements UNIT-FMG-001 (AggregateFaults), UNIT-FMG-002
  *          (ClassifyAndEscalate), UNIT-FMG-003 (HandleSelectiveDisablement),
- *          and FMG_ProcessEmergencyStop.
+ *          FMG_ProcessEmergencyStop and UNIT-FMG-008 (ReleaseEmergencyStop).
+ *          Classification is edge-triggered: a fault bitmask equal to the
+ *          last classified one returns the cached severity without logging.
+ *          A changed bitmask is classified by one read of the const table
+ *          s_fmg_severity_lut, generated at build time from the severity
+ *          class of each fault source and checked by build-time asserts.
  *
  * @project TDC (Train Door Control System)
  * @module  FMG (Fault Manager) — COMP-005
@@ -42,16 +47,125 @@
 #define FMG_FAULT_BIT_TCI  (0x08U)  /**< TCI fault bit */
 #define FMG_FAULT_BIT_HAL  (0x10U)  /**< HAL fault bit */
 
+/** @brief Bit of a fault source: 0x00 for a clear flag, bit for a set one */
+#define FMG_FLAG_BIT(flag, bit)  ((uint8_t)((uint8_t)((flag) != 0U) * (bit)))
+
+/*============================================================================
+ * SEVERITY LOOKUP TABLE
+ * The severity of a bitmask is the highest severity class of its set bits.
+ * The table is indexed by FMG_LUT_SLICE_BITS-bit slices of the bitmask; row k
+ * classifies sources 5k..5k+4. Adding a source is one FMG_SOURCE_SEVERITY
+ * line plus FMG_FAULT_BITS; every fifth source adds one FMG_LUT_ROW line, up
+ * to 13 rows for a 64-source (per-door) mask. A lookup never depends on
+ * which or how many faults are active.
+ *===========================================================================*/
+#define FMG_LUT_SLICE_BITS  (5U)
+#define FMG_LUT_SLICE_MASK  ((1U << FMG_LUT_SLICE_BITS) - 1U)
+#define FMG_LUT_SLICES      ((FMG_FAULT_BITS + FMG_LUT_SLICE_BITS - 1U) / \
+                             FMG_LUT_SLICE_BITS)
+
+/** @brief Severity class of fault source src (bit number of the bitmask) */
+#define FMG_SOURCE_SEVERITY(src)                                   \
+    (((src) == 0U) ? FAULT_MEDIUM   : /* SPM: speed interlock */   \
+     ((src) == 1U) ? FAULT_LOW      : /* OBD: log only */          \
+     ((src) == 2U) ? FAULT_HIGH     : /* DSM: safety function */   \
+     ((src) == 3U) ? FAULT_MEDIUM   : /* TCI: comms degraded */    \
+     ((src) == 4U) ? FAULT_CRITICAL : /* HAL: loss of safe op */   \
+                     FAULT_NONE)
+
+/** @brief Severity contributed by bit j of slice value m in row k */
+#define FMG_LUT_BIT(k, m, j)                                       \
+    ((((m) >> (j)) & 1U) != 0U ?                                   \
+     FMG_SOURCE_SEVERITY(((k) * FMG_LUT_SLICE_BITS) + (j)) : FAULT_NONE)
+#define FMG_MAX(a, b)  (((a) > (b)) ? (a) : (b))
+
+/** @brief Table entry: severity of slice value m in row k */
+#define FMG_LUT_ENTRY(k, m)                                        \
+    FMG_MAX(FMG_MAX(FMG_MAX(FMG_LUT_BIT(k, m, 0U),                 \
+                            FMG_LUT_BIT(k, m, 1U)),                \
+                    FMG_MAX(FMG_LUT_BIT(k, m, 2U),                 \
+                            FMG_LUT_BIT(k, m, 3U))),               \
+            FMG_LUT_BIT(k, m, 4U))
+#define FMG_LUT_4(k, m)   FMG_LUT_ENTRY(k, m),        FMG_LUT_ENTRY(k, (m) + 1U), \
+                          FMG_LUT_ENTRY(k, (m) + 2U), FMG_LUT_ENTRY(k, (m) + 3U)
+#define FMG_LUT_16(k, m)  FMG_LUT_4(k, m),        FMG_LUT_4(k, (m) + 4U), \
+                          FMG_LUT_4(k, (m) + 8U), FMG_LUT_4(k, (m) + 12U)
+#define FMG_LUT_ROW(k)    { FMG_LUT_16(k, 0U), FMG_LUT_16(k, 16U) }
+
+/** @brief Severity of every slice value, one row per FMG_LUT_SLICE_BITS
+ *         sources; the row count follows the initialiser so that
+ *         fmg_check_lut_rows catches a missing FMG_LUT_ROW line */
+static const fault_severity_t
+    s_fmg_severity_lut[][FMG_LUT_SLICE_MASK + 1U] =
+{
+    FMG_LUT_ROW(0U)
+};
+
+/** @brief Build-time check: compilation fails when cond is false */
+#define FMG_BUILD_ASSERT(name, cond)  typedef char name[(cond) ? 1 : -1]
+
+/* The bitmask fits the uint8_t fault state and every source has a row */
+FMG_BUILD_ASSERT(fmg_check_state_width, FMG_FAULT_BITS <= 8U);
+FMG_BUILD_ASSERT(fmg_check_lut_rows,
+                 (sizeof(s_fmg_severity_lut) /
+                  sizeof(s_fmg_severity_lut[0])) == FMG_LUT_SLICES);
+/* The generator matches the classes of SCDS §7.2 */
+FMG_BUILD_ASSERT(fmg_check_none,  FMG_LUT_ENTRY(0U, 0x00U) == FAULT_NONE);
+FMG_BUILD_ASSERT(fmg_check_obd,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_OBD) == FAULT_LOW);
+FMG_BUILD_ASSERT(fmg_check_spm,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_SPM) == FAULT_MEDIUM);
+FMG_BUILD_ASSERT(fmg_check_tci,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_TCI) == FAULT_MEDIUM);
+FMG_BUILD_ASSERT(fmg_check_dsm,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_DSM) == FAULT_HIGH);
+FMG_BUILD_ASSERT(fmg_check_hal,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_HAL) == FAULT_CRITICAL);
+FMG_BUILD_ASSERT(fmg_check_max,
+                 FMG_LUT_ENTRY(0U, FMG_LUT_SLICE_MASK) == FAULT_CRITICAL);
+FMG_BUILD_ASSERT(fmg_check_mixed,
+                 FMG_LUT_ENTRY(0U, FMG_FAULT_BIT_OBD | FMG_FAULT_BIT_TCI) ==
+                 FAULT_MEDIUM);
+
 /*============================================================================
  * EXTERNAL SHARED STATE (owned by fmg_init.c)
  *===========================================================================*/
 extern uint8_t          g_fmg_fault_state;
 extern fault_severity_t g_fmg_max_severity;
-extern uint8_t          g_fmg_disabled_doors;
+extern door_mask_t      g_fmg_disabled_doors;
 extern uint8_t          g_fmg_emergency_stop_active;
+extern uint8_t          g_fmg_classified_state;
+extern fault_severity_t g_fmg_classified_severity;
+
+/**
+ * @brief Severity of a fault bitmask (highest class of its active bits).
+ * @details One table read per FMG_LUT_SLICE_BITS sources (one for the five
+ *          current sources).
+ * @complexity Cyclomatic complexity: 3
+ */
+static fault_severity_t fmg_classify(uint8_t fault_state)
+{
+    fault_severity_t severity = FAULT_NONE;
+    fault_severity_t slice_severity;
+    uint32_t         k;
+
+    for (k = 0U; k < FMG_LUT_SLICES; k++)
+    {
+        slice_severity = s_fmg_severity_lut[k]
+            [((uint32_t)fault_state >> (k * FMG_LUT_SLICE_BITS)) &
+             FMG_LUT_SLICE_MASK];
+        if (slice_severity > severity)
+        {
+            severity = slice_severity;
+        }
+    }
+
+    return severity;
+}
 
 /**
  * @brief Aggregate fault flags from all components.
+ * @details Branch-free: each flag is turned into its bit arithmetically.
  * @complexity Cyclomatic complexity: 2
  */
 error_t FMG_AggregateFaults(uint8_t  spm_fault,
@@ -68,13 +182,11 @@ error_t FMG_AggregateFaults(uint8_t  spm_fault,
         return ERR_NULL_PTR;
     }
 
-    *fault_state_out = 0U;
-
-    if (spm_fault != 0U) { *fault_state_out |= FMG_FAULT_BIT_SPM; }
-    if (obd_fault != 0U) { *fault_state_out |= FMG_FAULT_BIT_OBD; }
-    if (dsm_fault != 0U) { *fault_state_out |= FMG_FAULT_BIT_DSM; }
-    if (tci_fault != 0U) { *fault_state_out |= FMG_FAULT_BIT_TCI; }
-    if (hal_fault != 0U) { *fault_state_out |= FMG_FAULT_BIT_HAL; }
+    *fault_state_out = (uint8_t)(FMG_FLAG_BIT(spm_fault, FMG_FAULT_BIT_SPM) |
+                                 FMG_FLAG_BIT(obd_fault, FMG_FAULT_BIT_OBD) |
+                                 FMG_FLAG_BIT(dsm_fault, FMG_FAULT_BIT_DSM) |
+                                 FMG_FLAG_BIT(tci_fault, FMG_FAULT_BIT_TCI) |
+                                 FMG_FLAG_BIT(hal_fault, FMG_FAULT_BIT_HAL));
 
     return SUCCESS;
 }
@@ -93,48 +205,35 @@ error_t FMG_ClassifyAndEscalate(uint8_t           fault_state,
         return ERR_NULL_PTR;
     }
 
-    /* CRITICAL: HAL fault or combined DSM+SPM = total loss of safe operation */
-    if ((fault_state & FMG_FAULT_BIT_HAL) != 0U)
-    {
-        *max_severity_out = FAULT_CRITICAL;
-        LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_ACTIVE, (uint16_t)FAULT_CRITICAL);
-        return SUCCESS;
-    }
-
-    /* HIGH: DSM fault = direct safety function loss */
-    if ((fault_state & FMG_FAULT_BIT_DSM) != 0U)
-    {
-        *max_severity_out = FAULT_HIGH;
-        LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_ACTIVE, (uint16_t)FAULT_HIGH);
-        return SUCCESS;
-    }
-
-    /* MEDIUM: SPM or TCI fault = speed interlock or comms degraded */
-    if (((fault_state & FMG_FAULT_BIT_SPM) != 0U) ||
-        ((fault_state & FMG_FAULT_BIT_TCI) != 0U))
-    {
-        *max_severity_out = FAULT_MEDIUM;
-        LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_ACTIVE, (uint16_t)FAULT_MEDIUM);
-        return SUCCESS;
-    }
-
-    /* LOW: OBD fault only */
-    if ((fault_state & FMG_FAULT_BIT_OBD) != 0U)
+    /* Unchanged bitmask: cached severity, nothing logged */
+    if (fault_state != g_fmg_classified_state)
     {
-        *max_severity_out = FAULT_LOW;
-        LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_ACTIVE, (uint16_t)FAULT_LOW);
-        return SUCCESS;
+        g_fmg_classified_severity = fmg_classify(fault_state);
+        if (0U != fault_state)
+        {
+            LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_ACTIVE,
+                      ((uint16_t)fault_state << 8U) |
+                      (uint16_t)g_fmg_classified_severity);
+        }
+        else
+        {
+            LOG_EVENT(COMP_FMG, COMP_FMG, EVT_FAULT_CLEARED,
+                      (uint16_t)g_fmg_classified_state);
+        }
+        g_fmg_classified_state = fault_state;
     }
 
-    *max_severity_out = FAULT_NONE;
+    *max_severity_out = g_fmg_classified_severity;
     return SUCCESS;
 }
 
 /**
  * @brief Apply selective door disablement when authorised by TCMS.
+ * @details Bits above MAX_DOORS - 1 are ignored. The 16-bit event payload
+ *          is DOOR_MASK_FOLD16 of the mask (the mask itself up to 16 doors).
  * @complexity Cyclomatic complexity: 2
  */
-error_t FMG_HandleSelectiveDisablement(uint8_t door_mask,
+error_t FMG_HandleSelectiveDisablement(door_mask_t door_mask,
                                         uint8_t tcms_authorized)
 {
     /* Implements: UNIT-FMG-003 */
@@ -142,12 +241,13 @@ error_t FMG_HandleSelectiveDisablement(uint8_t door_mask,
     if (0U == tcms_authorized)
     {
         LOG_EVENT(COMP_FMG, COMP_FMG, EVT_SELECTIVE_DISABLE_UNAUTHORIZED,
-                  (uint16_t)door_mask);
+                  DOOR_MASK_FOLD16(door_mask));
         return ERR_NOT_PERMITTED;
     }
 
-    g_fmg_disabled_doors = door_mask;
-    LOG_EVENT(COMP_FMG, COMP_FMG, EVT_SELECTIVE_DISABLE, (uint16_t)door_mask);
+    g_fmg_disabled_doors = door_mask & DOOR_MASK_ALL;
+    LOG_EVENT(COMP_FMG, COMP_FMG, EVT_SELECTIVE_DISABLE,
+              DOOR_MASK_FOLD16(g_fmg_disabled_doors));
     return SUCCESS;
 }
 
@@ -162,6 +262,24 @@ error_t FMG_ProcessEmergencyStop(uint8_t stop_code)
     return SUCCESS;
 }
 
+/**
+ * @brief Release the emergency stop (TCMS release command).
+ * @details Logs EVT_ESTOP_RELEASED only when a stop was active, so a
+ *          repeated release frame does not fill the log.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t FMG_ReleaseEmergencyStop(void)
+{
+    /* Implements: UNIT-FMG-008 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §7.3 */
+    if (0U != g_fmg_emergency_stop_active)
+    {
+        g_fmg_emergency_stop_active = 0U;
+        LOG_EVENT(COMP_FMG, COMP_FMG, EVT_ESTOP_RELEASED, 0U);
+    }
+    return SUCCESS;
+}
+
 /*============================================================================
  * END OF FILE
  *===========================================================================*/
@@ -2,8 +2,11 @@
  * @file    fmg_init.c
  * @brief   FMG module initialisation, cycle entry, and accessors.
  * @details Implements UNIT-FMG-004 (Init), UNIT-FMG-005 (RunCycle),
- *          UNIT-FMG-006 (GetFaultState), FMG_GetFault.
- *          Also owns all FMG shared state variables.
+ *          UNIT-FMG-006 (GetFaultState, IsEmergencyStopActive), UNIT-FMG-007 (GetFaultStats),
+ *          FMG_GetFault.
+ *          Also owns all FMG shared state variables, including the
+ *          classification cache and the per-bit activation history that
+ *          replace per-cycle fault log entries.
  *
  * @project TDC (Train Door Control System)
  * @module  FMG (Fault Manager) — COMP-005
@@ -26,6 +29,7 @@
 /* SIL: 3 */
 
 #include <stdint.h>
+#include <stddef.h>
 
 #include "fmg.h"
 #include "spm.h"
@@ -41,9 +45,19 @@
  *===========================================================================*/
 uint8_t          g_fmg_fault_state         = 0U;
 fault_severity_t g_fmg_max_severity        = FAULT_NONE;
-uint8_t          g_fmg_disabled_doors      = 0U;
+door_mask_t      g_fmg_disabled_doors      = 0U;
 uint8_t          g_fmg_emergency_stop_active = 0U;
 
+/** @brief Last bitmask classified by FMG_ClassifyAndEscalate, its severity */
+uint8_t          g_fmg_classified_state    = 0U;
+fault_severity_t g_fmg_classified_severity = FAULT_NONE;
+
+/*============================================================================
+ * STATIC VARIABLES
+ *===========================================================================*/
+/** @brief Activation history per fault bit (FMG_RunCycle) */
+static fmg_fault_stats_t s_fmg_fault_stats[FMG_FAULT_BITS];
+
 /*============================================================================
  * MODULE CONSTANTS
  *===========================================================================*/
@@ -51,23 +65,65 @@ uint8_t          g_fmg_emergency_stop_active = 0U;
 #define FMG_HAL_FAULT_SENTINEL  (0U)
 
 /**
- * @brief Initialise FMG module — clear all fault state.
- * @complexity Cyclomatic complexity: 1
+ * @brief Initialise FMG module — clear all fault state and history.
+ * @complexity Cyclomatic complexity: 2
  */
 error_t FMG_Init(void)
 {
     /* Implements: UNIT-FMG-004 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §7 */
+    uint8_t bit;
+
     g_fmg_fault_state           = 0U;
     g_fmg_max_severity          = FAULT_NONE;
     g_fmg_disabled_doors        = 0U;
     g_fmg_emergency_stop_active = 0U;
+    g_fmg_classified_state      = 0U;
+    g_fmg_classified_severity   = FAULT_NONE;
+    for (bit = 0U; bit < FMG_FAULT_BITS; bit++)
+    {
+        s_fmg_fault_stats[bit].activation_count = 0U;
+        s_fmg_fault_stats[bit].first_seen_ms    = 0U;
+        s_fmg_fault_stats[bit].last_seen_ms     = 0U;
+    }
     return SUCCESS;
 }
 
+/**
+ * @brief Update the activation history from this cycle's fault bitmask.
+ * @details A bit set now and clear in the previous cycle's g_fmg_fault_state
+ *          counts as one activation. Every set bit refreshes its last-seen
+ *          tick — a RAM write instead of a log entry per cycle.
+ * @complexity Cyclomatic complexity: 5
+ */
+static void fmg_track_faults(uint8_t fault_state, uint32_t now_ms)
+{
+    uint8_t rising = (uint8_t)(fault_state & (uint8_t)~g_fmg_fault_state);
+    uint8_t bit;
+
+    for (bit = 0U; bit < FMG_FAULT_BITS; bit++)
+    {
+        if (0U != (fault_state & (uint8_t)(1U << bit)))
+        {
+            if (0U != (rising & (uint8_t)(1U << bit)))
+            {
+                if (0U == s_fmg_fault_stats[bit].activation_count)
+                {
+                    s_fmg_fault_stats[bit].first_seen_ms = now_ms;
+                }
+                s_fmg_fault_stats[bit].activation_count++;
+            }
+            s_fmg_fault_stats[bit].last_seen_ms = now_ms;
+        }
+    }
+}
+
 /**
  * @brief 20 ms cycle entry — aggregate and classify current faults.
- * @complexity Cyclomatic complexity: 2
+ * @details Classification and logging happen only when the bitmask changes
+ *          (FMG_ClassifyAndEscalate); the activation history is updated
+ *          every cycle.
+ * @complexity Cyclomatic complexity: 3
  */
 void FMG_RunCycle(void)
 {
@@ -91,6 +147,8 @@ void FMG_RunCycle(void)
         return;
     }
 
+    fmg_track_faults(new_fault_state, HAL_GetSystemTickMs());
+
     err = FMG_ClassifyAndEscalate(new_fault_state, &new_severity);
     if (SUCCESS != err)
     {
@@ -112,6 +170,37 @@ uint8_t FMG_GetFaultState(void)
     return g_fmg_fault_state;
 }
 
+/**
+ * @brief Get the emergency stop flag.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint8_t FMG_IsEmergencyStopActive(void)
+{
+    /* Implements: UNIT-FMG-006 */
+    return g_fmg_emergency_stop_active;
+}
+
+/**
+ * @brief Get the activation history of one fault bit.
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t FMG_GetFaultStats(uint8_t fault_bit, fmg_fault_stats_t *stats_out)
+{
+    /* Implements: UNIT-FMG-007 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §7 */
+    if (NULL == stats_out)
+    {
+        return ERR_NULL_PTR;
+    }
+    if (fault_bit >= FMG_FAULT_BITS)
+    {
+        return ERR_RANGE;
+    }
+
+    *stats_out = s_fmg_fault_stats[fault_bit];
+    return SUCCESS;
+}
+
 /**
  * @brief Get FMG fault flag for self-reporting.
  * @complexity Cyclomatic complexity: 1
@@ -2,7 +2,8 @@
  * @file    hal.h
  * @brief   Hardware Abstraction Layer public interface for TDC
  * @details Provides all hardware access functions: GPIO, PWM, CAN, SPI, ADC,
- *          watchdog, system tick, and CRC-16-CCITT computation.
+ *          SPI NOR Flash (event log), watchdog, system tick, and
+ *          CRC-16-CCITT computation.
  *
  * @project TDC (Train Door Control System)
  * @module  HAL (Hardware Abstraction Layer) — COMP-008
@@ -22,7 +23,8 @@
  * - REQ-INT-006: SPI cross-channel exchange
  * - REQ-SAFE-014: Watchdog refresh within 40 ms
  * - REQ-SAFE-017: System tick monotonic counter
- * - REQ-SAFE-018: CRC-16-CCITT computation
+ * - REQ-SAFE-018: CRC-16-CCITT computation (one-shot and streaming)
+ * - REQ-FUN-018: SPI NOR Flash read / page program / sector erase
  *
  * @misra_compliance
  * MISRA C:2012 Compliance:
@@ -42,6 +44,71 @@
 #include <stddef.h>
 #include "tdc_types.h"
 
+/*============================================================================
+ * PUBLIC CONSTANTS — CRC-16-CCITT backend selection
+ * Select with -DHAL_CRC16_BACKEND=<value> at build time (see hal_crc.c).
+ *===========================================================================*/
+
+/** @brief Bit-by-bit reference backend (no lookup table) */
+#define HAL_CRC16_BACKEND_BITWISE   (0)
+
+/** @brief 256-entry lookup table backend (512 bytes flash) */
+#define HAL_CRC16_BACKEND_TABLE     (1)
+
+/** @brief Slice-by-4 backend (4 x 256-entry tables, 2 KiB flash) */
+#define HAL_CRC16_BACKEND_SLICE4    (2)
+
+/** @brief Slice-by-8 backend (8 x 256-entry tables, 4 KiB flash) — default */
+#define HAL_CRC16_BACKEND_SLICE8    (3)
+
+/*============================================================================
+ * PUBLIC CONSTANTS — High-resolution cycle counter
+ *===========================================================================*/
+
+#ifndef HAL_CYCLE_COUNTER_HZ
+/** @brief Cycle counter rate (core clock: STM32H743 @ 400 MHz) */
+#define HAL_CYCLE_COUNTER_HZ        (400000000UL)
+#endif
+
+/*============================================================================
+ * PUBLIC TYPES — Input process image
+ * Design ref: SCDS §10.1, UNIT-HAL-024/025
+ *===========================================================================*/
+
+/**
+ * @brief Snapshot of all door inputs, sampled once per 20 ms cycle.
+ * @details Bit n of every mask belongs to door n. Captured by
+ *          HAL_GPIO_CaptureInputImage at cycle start and read (never written)
+ *          by OBD and DSM, so every component sees the same sample.
+ *          A door whose inputs could not be read has its read_fault bit set,
+ *          its obstacle bits set (fail-safe) and all other bits clear.
+ */
+typedef struct
+{
+    door_mask_t position_a;   /**< Position sensor A active */
+    door_mask_t position_b;   /**< Position sensor B active */
+    door_mask_t lock_a;       /**< Lock sensor A: 1=locked */
+    door_mask_t lock_b;       /**< Lock sensor B: 1=locked */
+    door_mask_t obstacle_a;   /**< Obstacle sensor A: 1=obstacle present */
+    door_mask_t obstacle_b;   /**< Obstacle sensor B: 1=obstacle present */
+    door_mask_t emergency;    /**< Emergency release GPIO active */
+    door_mask_t read_fault;   /**< Inputs of this door could not be read */
+} hal_input_image_t;
+
+/**
+ * @brief Actuator outputs of all doors, staged during the cycle.
+ * @details The motor/lock wrappers (HAL_MotorStart, HAL_MotorStop,
+ *          HAL_LockEngage, HAL_LockDisengage) write here; the hardware is
+ *          updated only by HAL_CommitOutputImage. Bit n / element n belongs
+ *          to door n.
+ */
+typedef struct
+{
+    door_mask_t motor_dir;           /**< Motor direction bit per door */
+    door_mask_t lock;                /**< Lock solenoid energised per door */
+    uint8_t     pwm_duty[MAX_DOORS]; /**< Motor PWM duty cycle 0–100 per door */
+} hal_output_image_t;
+
 /*============================================================================
  * PUBLIC FUNCTION PROTOTYPES — GPIO
  * Implements: REQ-INT-001, REQ-INT-002, REQ-INT-003
@@ -85,6 +152,25 @@ error_t HAL_GPIO_ReadObstacleSensor(uint8_t door_id, uint8_t sensor_id,
  */
 uint8_t HAL_GPIO_ReadEmergencyRelease(uint8_t door_id);
 
+/**
+ * @brief Sample every door input into the input process image.
+ * @details Called once by SKN_RunCycle before any component cycle. Replaces
+ *          per-door, per-sensor reads by OBD and DSM (one range/init check
+ *          per cycle instead of one per sensor).
+ *          If the HAL is not initialised the image is set fail-safe: all
+ *          read_fault and obstacle bits set, all other bits clear.
+ * @return error_t SUCCESS, ERR_HW_FAULT
+ * @note  UNIT-HAL-024
+ */
+error_t HAL_GPIO_CaptureInputImage(void);
+
+/**
+ * @brief Access the input process image of the current cycle.
+ * @return Read-only pointer to the last captured image (never NULL)
+ * @note  UNIT-HAL-025
+ */
+const hal_input_image_t *HAL_GPIO_GetInputImage(void);
+
 /**
  * @brief Set motor direction for a door.
  * @param[in] door_id   Door index (0–MAX_DOORS-1)
@@ -111,7 +197,8 @@ error_t HAL_GPIO_SetLockActuator(uint8_t door_id, uint8_t locked);
  * @brief Set PWM duty cycle for motor drive (0–100 percent).
  * @param[in] door_id    Door index (0–MAX_DOORS-1)
  * @param[in] duty_pct   Duty cycle 0–100 (0=off, 100=full)
- * @return error_t SUCCESS, ERR_RANGE
+ * @return error_t SUCCESS, ERR_RANGE, ERR_NOT_PERMITTED (non-zero duty
+ *         while the emergency motor inhibit is latched)
  */
 error_t HAL_PWM_SetDutyCycle(uint8_t door_id, uint8_t duty_pct);
 
@@ -142,24 +229,101 @@ error_t HAL_CAN_Transmit(uint32_t msg_id, const uint8_t *data, uint8_t dlc);
 /*============================================================================
  * PUBLIC FUNCTION PROTOTYPES — SPI Cross-Channel
  * Implements: REQ-SAFE-002, SW-HAZ-011
- * Design ref: SCDS §10.4, UNIT-HAL-012 through UNIT-HAL-013
+ * Design ref: SCDS §10.4, UNIT-HAL-012 through UNIT-HAL-013,
+ *             UNIT-HAL-029 through UNIT-HAL-032
  *===========================================================================*/
 
 /**
- * @brief Exchange cross-channel state struct via SPI with peer DCU.
+ * @brief Exchange the packed cross-channel state via SPI with peer DCU.
+ * @details Blocking: HAL_SPI_CrossChannel_Start followed immediately by
+ *          HAL_SPI_CrossChannel_Complete.
  * @param[in]  local   Pointer to local state to transmit (must not be NULL)
  * @param[out] remote  Pointer to buffer for received peer state (must not be NULL)
- * @return error_t SUCCESS, ERR_NULL_PTR, ERR_TIMEOUT, ERR_HW_FAULT
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_TIMEOUT, ERR_HW_FAULT,
+ *         ERR_INVALID_STATE (asynchronous transfer already in flight)
+ */
+error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_wire_t *local,
+                                      cross_channel_wire_t *remote);
+
+/** @brief Longest wait in HAL_SPI_CrossChannel_Complete (100 µs) */
+#define HAL_SPI_COMPLETE_TIMEOUT_TICKS  (HAL_CYCLE_COUNTER_HZ / 10000UL)
+
+/**
+ * @brief Start a full-duplex DMA exchange of the packed cross-channel state
+ *        (CCS_WIRE_BYTES per direction).
+ * @details The local state is copied to the DMA transmit buffer, so the
+ *          caller's buffer may change while the transfer runs. Only one
+ *          transfer may be in flight.
+ * @param[in] local Local state to transmit (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_HW_FAULT (not initialised),
+ *         ERR_INVALID_STATE (transfer already in flight)
+ * @note  UNIT-HAL-029
+ */
+error_t HAL_SPI_CrossChannel_Start(const cross_channel_wire_t *local);
+
+/**
+ * @brief Non-blocking check of the transfer started by HAL_SPI_CrossChannel_Start.
+ * @param[out] done_out 1 if the DMA transfer has completed, 0 otherwise
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_INVALID_STATE (no transfer)
+ * @note  UNIT-HAL-030
+ */
+error_t HAL_SPI_CrossChannel_Poll(uint8_t *done_out);
+
+/**
+ * @brief Finish the transfer: wait (at most HAL_SPI_COMPLETE_TIMEOUT_TICKS)
+ *        for the DMA, then copy the received peer state.
+ * @details The channel is free for the next Start afterwards, also on
+ *          timeout (transfer aborted).
+ * @param[out] remote Received peer state (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_TIMEOUT,
+ *         ERR_INVALID_STATE (no transfer in flight)
+ * @note  UNIT-HAL-031
+ */
+error_t HAL_SPI_CrossChannel_Complete(cross_channel_wire_t *remote);
+
+/**
+ * @brief Duration of the last completed transfer (Start to DMA completion).
+ * @return uint32_t HAL cycle-counter ticks; 0 if the last transfer did not
+ *         complete (HAL_SPI_CrossChannel_Complete returned ERR_TIMEOUT)
+ * @note  UNIT-HAL-031
+ */
+uint32_t HAL_SPI_CrossChannel_GetTransferTicks(void);
+
+/**
+ * @brief SPI DMA transfer-complete interrupt handler.
+ * @note  UNIT-HAL-032; called from the DMA stream ISR (target)
  */
-error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
-                                      cross_channel_state_t *remote);
+void HAL_SPI_DmaCompleteISR(void);
 
 /*============================================================================
  * PUBLIC FUNCTION PROTOTYPES — ADC
  * Implements: REQ-SAFE-006 (motor current for obstacle detection)
- * Design ref: SCDS §10.5, UNIT-HAL-014
+ * Design ref: SCDS §10.5, UNIT-HAL-014, UNIT-HAL-036 through UNIT-HAL-037
  *===========================================================================*/
 
+/** @brief Motor current scan rate per door (timer-triggered ADC scan) */
+#define HAL_ADC_SCAN_RATE_HZ    (1000U)
+
+/** @brief Samples per door in one DMA block: one cycle at the scan rate */
+#define HAL_ADC_BLOCK_SAMPLES   ((CYCLE_MS * HAL_ADC_SCAN_RATE_HZ) / 1000U)
+
+/** @brief Blocks in the ADC scan DMA ring (power of two). The scan timer
+ *         and the cycle timer drift, so a cycle may find no new block or
+ *         two; the completed blocks stay readable for
+ *         (HAL_ADC_RING_BLOCKS - 1) block periods. */
+#define HAL_ADC_RING_BLOCKS     (4U)
+
+/**
+ * @brief One cycle of motor current samples of every door.
+ * @details Filled by DMA in scan order: one conversion of every door per
+ *          scan trigger, so sample[k][n] is door n at scan k and the doors
+ *          of one scan are contiguous. Raw 12-bit counts (0–4095).
+ */
+typedef struct
+{
+    uint16_t sample[HAL_ADC_BLOCK_SAMPLES][MAX_DOORS];
+} hal_adc_block_t;
+
 /**
  * @brief Read ADC value for motor current sensing.
  * @param[in]  door_id   Door index (0–MAX_DOORS-1)
@@ -168,6 +332,120 @@ error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
  */
 error_t HAL_ADC_ReadMotorCurrent(uint8_t door_id, uint16_t *adc_value);
 
+/**
+ * @brief Take the oldest completed block of the motor current scan not
+ *        taken yet.
+ * @details HAL_Init starts the scan: a timer triggers an ADC scan of all
+ *          doors at HAL_ADC_SCAN_RATE_HZ and the DMA fills a ring of
+ *          HAL_ADC_RING_BLOCKS blocks. Blocks are numbered from 0 in
+ *          completion order; repeated calls return them in that order
+ *          until ERR_TIMEOUT, so a consumer drains every block completed
+ *          since its last call. Blocks the DMA has already overwritten are
+ *          skipped (the returned sequence number jumps). The returned
+ *          block stays valid for at least one block period.
+ * @param[out] block_out Read-only pointer to the block (must not be NULL)
+ * @param[out] seq_out   Sequence number of the block (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_HW_FAULT (not initialised),
+ *         ERR_TIMEOUT (every completed block has been taken)
+ * @note  UNIT-HAL-036
+ */
+error_t HAL_ADC_TakeBlock(const hal_adc_block_t **block_out,
+                          uint32_t *seq_out);
+
+/**
+ * @brief ADC scan DMA transfer-complete interrupt handler: one block of the
+ *        ring is complete.
+ * @note  UNIT-HAL-037; called from the DMA stream ISR (target). There is
+ *        no scan timer on the host: each call completes one block from the
+ *        motor current shadow.
+ */
+void HAL_ADC_DmaBlockISR(void);
+
+/*============================================================================
+ * PUBLIC CONSTANTS AND FUNCTION PROTOTYPES — SPI NOR Flash (hal_flash.c)
+ * Implements: REQ-FUN-018 (persistent event log)
+ * Design ref: SCDS §10.6, UNIT-HAL-038 through UNIT-HAL-040
+ * NOR semantics: programming can only clear bits (1 → 0); only a sector
+ * erase sets bits back to 1 (0xFF).
+ *===========================================================================*/
+
+/** @brief Program unit: one page (W25Q-class SPI NOR) */
+#define HAL_FLASH_PAGE_BYTES     (256U)
+
+/** @brief Erase unit: one sector */
+#define HAL_FLASH_SECTOR_BYTES   (4096U)
+
+#ifndef HAL_FLASH_SECTORS
+/** @brief Sectors of the event log partition (64 KiB) */
+#define HAL_FLASH_SECTORS        (16U)
+#endif
+
+/** @brief Size of the event log partition, addressed from 0 */
+#define HAL_FLASH_SIZE_BYTES     (HAL_FLASH_SECTORS * HAL_FLASH_SECTOR_BYTES)
+
+/**
+ * @brief Read from the log partition.
+ * @param[in]  addr   Start address (0 .. HAL_FLASH_SIZE_BYTES-1)
+ * @param[out] data   Destination buffer (must not be NULL)
+ * @param[in]  length Bytes to read (addr + length ≤ HAL_FLASH_SIZE_BYTES)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE, ERR_HW_FAULT
+ * @note  UNIT-HAL-038
+ */
+error_t HAL_Flash_Read(uint32_t addr, uint8_t *data, uint32_t length);
+
+/**
+ * @brief Program bytes within one page (clears bits only).
+ * @details The range must not cross a page boundary. On target the call
+ *          returns once the device has accepted the command; the next
+ *          program or erase returns ERR_TIMEOUT while it is still busy.
+ * @param[in] addr   Start address
+ * @param[in] data   Source bytes (must not be NULL)
+ * @param[in] length 1 .. HAL_FLASH_PAGE_BYTES - (addr % HAL_FLASH_PAGE_BYTES)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE,
+ *         ERR_TIMEOUT (device busy — retry later), ERR_HW_FAULT
+ * @note  UNIT-HAL-039
+ */
+error_t HAL_Flash_ProgramPage(uint32_t addr, const uint8_t *data,
+                              uint16_t length);
+
+/**
+ * @brief Erase one sector to 0xFF.
+ * @param[in] addr Sector start address (multiple of HAL_FLASH_SECTOR_BYTES)
+ * @return error_t SUCCESS, ERR_RANGE,
+ *         ERR_TIMEOUT (device busy — retry later), ERR_HW_FAULT
+ * @note  UNIT-HAL-040
+ */
+error_t HAL_Flash_EraseSector(uint32_t addr);
+
+/*============================================================================
+ * FLASH DEVICE LAYER — below UNIT-HAL-038 through UNIT-HAL-040
+ * Called by HAL_Flash_* with arguments already checked. On target the board
+ * SPI NOR driver provides these (READ 0x03; WREN 0x06 + PP 0x02; WREN 0x06 +
+ * SE 0x20); host test and benchmark builds link the RAM device model
+ * tests/stubs/hal_flash_sim.c instead.
+ *===========================================================================*/
+
+/**
+ * @brief Device read of a checked range.
+ * @return error_t SUCCESS, ERR_HW_FAULT
+ */
+error_t HAL_FlashDev_Read(uint32_t addr, uint8_t *data, uint32_t length);
+
+/**
+ * @brief Device page program of a checked range (within one page).
+ * @return error_t SUCCESS, ERR_TIMEOUT (previous command still in progress,
+ *         RDSR.WIP set), ERR_HW_FAULT
+ */
+error_t HAL_FlashDev_Program(uint32_t addr, const uint8_t *data,
+                             uint16_t length);
+
+/**
+ * @brief Device sector erase of a checked sector start address.
+ * @return error_t SUCCESS, ERR_TIMEOUT (previous command still in progress,
+ *         RDSR.WIP set), ERR_HW_FAULT
+ */
+error_t HAL_FlashDev_Erase(uint32_t addr);
+
 /*============================================================================
  * PUBLIC FUNCTION PROTOTYPES — Watchdog and System Services
  * Implements: REQ-SAFE-014, REQ-SAFE-017, REQ-SAFE-018
@@ -187,6 +465,16 @@ error_t HAL_Watchdog_Refresh(void);
  */
 uint32_t HAL_GetSystemTickMs(void);
 
+/**
+ * @brief Read the free-running core cycle counter (DWT CYCCNT on target).
+ * @details HAL_CYCLE_COUNTER_HZ counts per second; wraps every ~10.7 s at
+ *          400 MHz, so only differences over intervals shorter than that
+ *          are meaningful. Used for timing instrumentation only.
+ * @return uint32_t Current counter value
+ * @note  UNIT-HAL-028
+ */
+uint32_t HAL_GetCycleCounter(void);
+
 /**
  * @brief Initialise the HAL subsystem.
  * @return error_t SUCCESS, ERR_HW_FAULT
@@ -196,49 +484,164 @@ error_t HAL_Init(void);
 /**
  * @brief Compute CRC-16-CCITT (polynomial 0x1021, init 0xFFFF, no final XOR).
  * @details Used by ALL components for data integrity checking (OI-FTA-003).
+ *          The algorithm backend (bitwise, table, slice-by-4, slice-by-8) is
+ *          fixed at build time by HAL_CRC16_BACKEND; all produce identical
+ *          results.
  * @param[in] data   Pointer to data buffer (must not be NULL)
  * @param[in] length Number of bytes to process (must be > 0)
  * @return uint16_t Computed CRC-16 value (0x0000 if data==NULL or length==0)
- * @note  Complexity: 4 — within SIL 3 limit of 10
+ * @note  Complexity: 3 — within SIL 3 limit of 10
  */
 uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length);
 
+/**
+ * @brief Start a streaming CRC-16-CCITT computation.
+ * @return uint16_t Initial CRC register value (0xFFFF)
+ * @note  UNIT-HAL-021; Complexity: 1
+ */
+uint16_t CRC16_CCITT_Init(void);
+
+/**
+ * @brief Advance a streaming CRC-16-CCITT over the next block of bytes.
+ * @details Lets callers spread a large CRC (ROM/RAM scrubbing) over several
+ *          cycles. Any split of a buffer into consecutive Update calls gives
+ *          the same result as CRC16_CCITT_Compute over the whole buffer.
+ * @param[in] crc    Running CRC register (from Init or a previous Update)
+ * @param[in] data   Pointer to next data block
+ * @param[in] length Number of bytes in the block (32-bit: ROM images > 64 KiB)
+ * @return uint16_t Updated CRC register (unchanged if data==NULL or length==0)
+ * @note  UNIT-HAL-022; Complexity: 3
+ */
+uint16_t CRC16_CCITT_Update(uint16_t crc, const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Finish a streaming CRC-16-CCITT computation.
+ * @param[in] crc Running CRC register after the last Update
+ * @return uint16_t Final CRC value (no final XOR for CRC-16-CCITT)
+ * @note  UNIT-HAL-023; Complexity: 1
+ */
+uint16_t CRC16_CCITT_Final(uint16_t crc);
+
+#if defined(HAL_CRC16_BUILD_ALL_BACKENDS)
+/**
+ * @brief Compute CRC-16-CCITT with an explicitly chosen backend.
+ * @details Test and benchmark builds only (HAL_CRC16_BUILD_ALL_BACKENDS).
+ * @param[in] backend One of HAL_CRC16_BACKEND_BITWISE/TABLE/SLICE4/SLICE8
+ * @param[in] data    Pointer to data buffer
+ * @param[in] length  Number of bytes to process
+ * @return uint16_t Computed CRC-16 value (0x0000 if data==NULL or length==0)
+ */
+uint16_t HAL_CRC16_ComputeWithBackend(uint8_t backend, const uint8_t *data,
+                                      uint32_t length);
+#endif
+
 /*============================================================================
  * CONVENIENCE WRAPPERS — Motor and Lock control
  * Thin wrappers used by DSM to express intent clearly without repeating
  * multi-step GPIO+PWM sequences throughout the FSM.
+ * They stage into the output image (hal_output_image_t); nothing reaches the
+ * actuators until HAL_CommitOutputImage, so a door written several times in
+ * one cycle produces at most one register write per output.
  * Implements: REQ-INT-004, SCDS §10.2
  *===========================================================================*/
 
 /**
- * @brief Start motor for a door in the specified direction.
+ * @brief Write the staged output image to the actuator registers.
+ * @details Called once per cycle by SKN_RunCycle after DSM_RunCycle.
+ *          Outputs equal to the last committed value are not written:
+ *          direction and lock are one port write each (only if any door
+ *          changed), PWM is one compare-register write per changed door.
+ * @return error_t SUCCESS, ERR_HW_FAULT (HAL not initialised — nothing written)
+ * @note  UNIT-HAL-026
+ */
+error_t HAL_CommitOutputImage(void);
+
+/**
+ * @brief Actuator register writes performed by the last commit.
+ * @return uint8_t 0 when nothing changed (0–MAX_DOORS+2)
+ * @note  UNIT-HAL-027
+ */
+uint8_t HAL_GetOutputWriteCount(void);
+
+/**
+ * @brief Start motor for a door in the specified direction (staged).
+ * @details An open-direction start (the DSM obstacle reversal) releases the
+ *          door's stop latch set by HAL_MotorStopNow.
  * @param[in] door_id   Door index (0–MAX_DOORS-1)
  * @param[in] direction 1=open, 0=close
- * @return error_t SUCCESS, ERR_RANGE, ERR_HW_FAULT
+ * @return error_t SUCCESS, ERR_RANGE
  */
 error_t HAL_MotorStart(uint8_t door_id, uint8_t direction);
 
 /**
- * @brief Stop motor for a door (duty cycle = 0).
+ * @brief Stop motor for a door (duty cycle = 0, staged).
  * @param[in] door_id Door index (0–MAX_DOORS-1)
  * @return error_t SUCCESS, ERR_RANGE
  */
 error_t HAL_MotorStop(uint8_t door_id);
 
 /**
- * @brief Engage (energise) the lock solenoid for a door.
+ * @brief Engage (energise) the lock solenoid for a door (staged).
  * @param[in] door_id Door index (0–MAX_DOORS-1)
  * @return error_t SUCCESS, ERR_RANGE
  */
 error_t HAL_LockEngage(uint8_t door_id);
 
 /**
- * @brief Disengage (de-energise) the lock solenoid for a door.
+ * @brief Disengage (de-energise) the lock solenoid for a door (staged).
  * @param[in] door_id Door index (0–MAX_DOORS-1)
  * @return error_t SUCCESS, ERR_RANGE
  */
 error_t HAL_LockDisengage(uint8_t door_id);
 
+/**
+ * @brief Emergency motor stop — PWM of every door to 0 at once, bypassing
+ *        the output image commit (ISR-safe).
+ * @details Latches a motor inhibit: until HAL_ReleaseMotorInhibit or
+ *          HAL_Init, HAL_CommitOutputImage writes duty 0 whatever is staged
+ *          and HAL_PWM_SetDutyCycle refuses a non-zero duty. The staged and
+ *          committed images are cleared so the next commit writes nothing.
+ *          Used by the CAN 0x104 fast path in TCI_CanRxISR, and by the
+ *          cycle task for a stop that did not take the fast path.
+ * @return error_t SUCCESS
+ * @note  UNIT-HAL-033
+ */
+error_t HAL_EmergencyMotorStop(void);
+
+/**
+ * @brief Stop one door's motor now (PWM duty 0), bypassing the output image
+ *        commit (ISR-safe).
+ * @details Latches a per-door stop and clears the door's staged and
+ *          committed duty: HAL_CommitOutputImage writes duty 0 for the door,
+ *          even if it had read the duty before this call preempted it,
+ *          until an open-direction HAL_MotorStart (the DSM obstacle
+ *          reversal) or HAL_Init releases the latch. Used by the obstacle
+ *          fast path in OBD_ObstacleISR.
+ * @param[in] door_id Door index (0–MAX_DOORS-1)
+ * @return error_t SUCCESS, ERR_RANGE
+ * @note  UNIT-HAL-035
+ */
+error_t HAL_MotorStopNow(uint8_t door_id);
+
+/**
+ * @brief Motor inhibit latched by HAL_EmergencyMotorStop.
+ * @return uint8_t 1 = motors held stopped, 0 = normal
+ * @note  UNIT-HAL-034
+ */
+uint8_t HAL_IsMotorInhibited(void);
+
+/**
+ * @brief Release the motor inhibit (cycle task only, never from an ISR).
+ * @details Motors stay at duty 0 until a new duty is staged and committed:
+ *          a duty staged while the inhibit was latched is discarded.
+ *          Called by TCI_ProcessReceivedFrames once the emergency stop has
+ *          been cleared in FMG; an emergency stop taken by the ISR during
+ *          the release is re-latched by the caller.
+ * @return error_t SUCCESS
+ * @note  UNIT-HAL-034
+ */
+error_t HAL_ReleaseMotorInhibit(void);
+
 #endif /* HAL_H */
 
 /*============================================================================
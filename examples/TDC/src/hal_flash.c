@@ -0,0 +1,139 @@
+/**
+ * @file    hal_flash.c
+ * @brief   SPI NOR Flash driver interface.
+ * @details Implements HAL_Flash_Read, HAL_Flash_ProgramPage and
+ *          HAL_Flash_EraseSector over the event log partition
+ *          (HAL_FLASH_SIZE_BYTES from address 0) with NOR semantics:
+ *          programming only clears bits, only a sector erase sets them.
+ *          Arguments are checked here; the command sequences are issued by
+ *          the device layer HAL_FlashDev_* (hal.h), which is the board
+ *          SPI NOR driver on target and the RAM device model
+ *          tests/stubs/hal_flash_sim.c in host test and benchmark builds.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  HAL (Hardware Abstraction Layer) — COMP-008
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 1 (event log storage — diagnostic only)
+ * Safety Requirements: REQ-FUN-018
+ *
+ * @requirements
+ * - REQ-FUN-018: UNIT-HAL-038 HAL_Flash_Read, UNIT-HAL-039
+ *   HAL_Flash_ProgramPage, UNIT-HAL-040 HAL_Flash_EraseSector
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance:
+ * - All mandatory rules: Compliant
+ * - Fixed-width types throughout
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §10.6
+ */
+
+/* Implements: REQ-FUN-018 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §10.6 (COMP-008) */
+
+/*============================================================================
+ * INCLUDES
+ *===========================================================================*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hal.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+
+#if ((HAL_FLASH_SECTOR_BYTES % HAL_FLASH_PAGE_BYTES) != 0U)
+#error "HAL_FLASH_SECTOR_BYTES must be a multiple of HAL_FLASH_PAGE_BYTES"
+#endif
+
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS — SPI NOR Flash
+ *===========================================================================*/
+
+/**
+ * @brief Read from the log partition.
+ * @complexity Cyclomatic complexity: 4
+ */
+error_t HAL_Flash_Read(uint32_t addr, uint8_t *data, uint32_t length)
+{
+    /* Implements: REQ-FUN-018, UNIT-HAL-038 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.6 */
+    error_t result;
+
+    if (NULL == data)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if ((addr >= HAL_FLASH_SIZE_BYTES) ||
+             (length > (HAL_FLASH_SIZE_BYTES - addr)))
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        result = HAL_FlashDev_Read(addr, data, length);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Program bytes within one page.
+ * @complexity Cyclomatic complexity: 5
+ */
+error_t HAL_Flash_ProgramPage(uint32_t addr, const uint8_t *data,
+                              uint16_t length)
+{
+    /* Implements: REQ-FUN-018, UNIT-HAL-039 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.6 */
+    error_t result;
+
+    if (NULL == data)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if ((addr >= HAL_FLASH_SIZE_BYTES) || (0U == length) ||
+             (length > (HAL_FLASH_PAGE_BYTES - (addr % HAL_FLASH_PAGE_BYTES))))
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        result = HAL_FlashDev_Program(addr, data, length);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Erase one sector.
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t HAL_Flash_EraseSector(uint32_t addr)
+{
+    /* Implements: REQ-FUN-018, UNIT-HAL-040 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.6 */
+    error_t result;
+
+    if ((addr >= HAL_FLASH_SIZE_BYTES) ||
+        (0U != (addr % HAL_FLASH_SECTOR_BYTES)))
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        result = HAL_FlashDev_Erase(addr);
+    }
+
+    return result;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
@@ -1,10 +1,11 @@
 /**
  * @file    hal_services.c
  * @brief   Hardware Abstraction Layer — GPIO, PWM, CAN, SPI, ADC, Watchdog,
- *          System Tick, and CRC-16-CCITT implementation.
+ *          and System Tick implementation.
  * @details Platform-stub implementations. In production, GPIO_Read() and
  *          related macros are replaced by device-register accesses.
  *          All functions return error_t; callers must check every return.
+ *          CRC-16-CCITT is implemented separately in hal_crc.c.
  *
  * @project TDC (Train Door Control System)
  * @module  HAL (Hardware Abstraction Layer) — COMP-008
@@ -18,12 +19,25 @@
  * - REQ-INT-001: UNIT-HAL-001 HAL_GPIO_ReadPositionSensor
  * - REQ-INT-002: UNIT-HAL-002 HAL_GPIO_ReadLockSensor
  * - REQ-INT-003: UNIT-HAL-003 HAL_GPIO_ReadObstacleSensor
+ * - REQ-INT-001–003: UNIT-HAL-024 HAL_GPIO_CaptureInputImage,
+ *   UNIT-HAL-025 HAL_GPIO_GetInputImage
  * - REQ-INT-004: UNIT-HAL-007 HAL_PWM_SetDutyCycle
  * - REQ-INT-005: UNIT-HAL-009 HAL_CAN_Receive, UNIT-HAL-010 HAL_CAN_Transmit
- * - REQ-INT-006: UNIT-HAL-012 HAL_SPI_CrossChannel_Exchange
+ * - REQ-INT-006: UNIT-HAL-012 HAL_SPI_CrossChannel_Exchange,
+ *   UNIT-HAL-029..031 HAL_SPI_CrossChannel_Start/Poll/Complete,
+ *   UNIT-HAL-032 HAL_SPI_DmaCompleteISR
  * - REQ-SAFE-014: UNIT-HAL-015 HAL_Watchdog_Refresh
  * - REQ-SAFE-017: UNIT-HAL-016 HAL_GetSystemTickMs
- * - REQ-SAFE-018: UNIT-HAL-020 CRC16_CCITT_Compute
+ * - REQ-SAFE-018: UNIT-HAL-020 CRC16_CCITT_Compute (hal_crc.c)
+ * - REQ-INT-004: UNIT-HAL-026 HAL_CommitOutputImage,
+ *   UNIT-HAL-027 HAL_GetOutputWriteCount
+ * - REQ-INT-004: UNIT-HAL-033 HAL_EmergencyMotorStop,
+ *   UNIT-HAL-034 HAL_IsMotorInhibited / HAL_ReleaseMotorInhibit (CAN 0x104
+ *   fast path),
+ *   UNIT-HAL-035 HAL_MotorStopNow (obstacle ISR fast path)
+ * - REQ-SAFE-006: UNIT-HAL-014 HAL_ADC_ReadMotorCurrent,
+ *   UNIT-HAL-036 HAL_ADC_TakeBlock, UNIT-HAL-037 HAL_ADC_DmaBlockISR
+ * - REQ-FUN-018: UNIT-HAL-028 HAL_GetCycleCounter (profiling only)
  *
  * @misra_compliance
  * MISRA C:2012 Compliance:
@@ -72,14 +86,8 @@
 /** @brief Number of obstacle sensor channels per door */
 #define HAL_OBSTACLE_SENSORS_PER_DOOR (2U)
 
-/** @brief CRC-16-CCITT polynomial */
-#define CRC16_POLY  (0x1021U)
-
-/** @brief CRC-16-CCITT initial value */
-#define CRC16_INIT  (0xFFFFU)
-
-/** @brief SPI transfer size: sizeof(cross_channel_state_t) */
-#define HAL_SPI_TRANSFER_BYTES  ((uint16_t)sizeof(cross_channel_state_t))
+/** @brief SPI transfer size: packed payload + CRC (struct padding not sent) */
+#define HAL_SPI_TRANSFER_BYTES  ((uint16_t)CCS_WIRE_BYTES)
 
 /*============================================================================
  * STATIC VARIABLES — GPIO shadow registers (stub for target hardware)
@@ -107,6 +115,26 @@ static uint8_t s_obstacle_sensor_shadow[MAX_DOORS][HAL_OBSTACLE_SENSORS_PER_DOOR
  */
 static uint8_t s_emergency_release_shadow[MAX_DOORS];
 
+/**
+ * @brief Input process image of the current cycle (UNIT-HAL-024/025).
+ */
+static hal_input_image_t s_input_image;
+
+/**
+ * @brief Output image staged by the motor/lock wrappers this cycle.
+ */
+static hal_output_image_t s_output_pending;
+
+/**
+ * @brief Output image last written to the actuator registers.
+ */
+static hal_output_image_t s_output_committed;
+
+/**
+ * @brief Actuator register writes performed by the last commit.
+ */
+static uint8_t s_output_write_count;
+
 /**
  * @brief Motor direction shadow [door]: 0=open, 1=close.
  */
@@ -127,6 +155,27 @@ static uint8_t s_pwm_duty[MAX_DOORS];
  */
 static uint16_t s_adc_motor_current[MAX_DOORS];
 
+/**
+ * @brief ADC scan DMA ring; block n of the scan is in slot
+ *        n % HAL_ADC_RING_BLOCKS.
+ */
+static hal_adc_block_t s_adc_ring[HAL_ADC_RING_BLOCKS];
+
+/** @brief Ring slot mask */
+#define HAL_ADC_RING_MASK       (HAL_ADC_RING_BLOCKS - 1U)
+
+#if ((HAL_ADC_RING_BLOCKS & HAL_ADC_RING_MASK) != 0U) || \
+    (HAL_ADC_RING_BLOCKS < 2U)
+#error "HAL_ADC_RING_BLOCKS must be a power of two >= 2"
+#endif
+
+/**
+ * @brief Blocks completed since HAL_Init (ISR) — also the number of the
+ *        block the DMA is filling — and next block to take (task).
+ */
+static volatile uint32_t s_adc_block_seq;
+static uint32_t          s_adc_taken_seq;
+
 /**
  * @brief CAN receive FIFO (single entry stub).
  */
@@ -136,9 +185,22 @@ static uint8_t  s_can_rx_dlc;
 static uint8_t  s_can_rx_pending;
 
 /**
- * @brief SPI cross-channel receive buffer.
+ * @brief SPI cross-channel DMA buffers.
+ */
+static cross_channel_wire_t s_spi_tx_buffer;
+static cross_channel_wire_t s_spi_rx_buffer;
+
+/**
+ * @brief SPI transfer state: in flight (task), DMA done (set by ISR).
+ */
+static uint8_t          s_spi_busy;
+static volatile uint8_t s_spi_done;
+
+/**
+ * @brief Cycle counter at transfer start / DMA completion.
  */
-static cross_channel_state_t s_spi_rx_buffer;
+static uint32_t          s_spi_start_ticks;
+static volatile uint32_t s_spi_done_ticks;
 
 /**
  * @brief System tick counter in milliseconds.
@@ -155,6 +217,21 @@ static uint8_t s_hal_fault_flag;
  */
 static uint8_t s_hal_initialized;
 
+/**
+ * @brief Emergency motor inhibit (set by HAL_EmergencyMotorStop from ISR
+ *        context, cleared by HAL_ReleaseMotorInhibit or HAL_Init).
+ */
+static volatile uint8_t s_motor_inhibit;
+
+/**
+ * @brief Obstacle stop latch per door (set by HAL_MotorStopNow from ISR
+ *        context, cleared by an open-direction HAL_MotorStart — the DSM
+ *        obstacle reversal — or HAL_Init). One byte per door: a single-byte
+ *        store is atomic on the target, a door_mask_t read-modify-write
+ *        shared with the ISR is not.
+ */
+static volatile uint8_t s_motor_stop_latch[MAX_DOORS];
+
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS — HAL Initialisation
  * Implements: UNIT-HAL-017
@@ -183,13 +260,33 @@ error_t HAL_Init(void)
         s_lock_actuator[door_idx]   = 0U;
         s_pwm_duty[door_idx]        = 0U;
         s_adc_motor_current[door_idx] = 0U;
+        s_output_pending.pwm_duty[door_idx]   = 0U;
+        s_output_committed.pwm_duty[door_idx] = 0U;
+        s_motor_stop_latch[door_idx]          = 0U;
     }
 
+    /* Outputs de-energised: staged and committed images match registers */
+    s_output_pending.motor_dir   = 0U;
+    s_output_pending.lock        = 0U;
+    s_output_committed.motor_dir = 0U;
+    s_output_committed.lock      = 0U;
+    s_output_write_count         = 0U;
+
     s_can_rx_msg_id  = 0U;
     s_can_rx_dlc     = 0U;
     s_can_rx_pending = 0U;
+    s_spi_busy       = 0U;
+    s_spi_done       = 0U;
+    s_adc_block_seq  = 0U;
+    s_adc_taken_seq  = 0U;
     s_system_tick_ms = 0U;
     s_hal_fault_flag = 0U;
+    s_motor_inhibit  = 0U;
+
+    /* Target: start the 1 kHz timer triggering the ADC regular scan of the
+     * MAX_DOORS motor current channels; DMA in double-buffer mode on ring
+     * slots 0 and 1 with a transfer-complete interrupt per block
+     * (HAL_ADC_DmaBlockISR). */
     s_hal_initialized = 1U;
 
     return SUCCESS;
@@ -320,6 +417,71 @@ uint8_t HAL_GPIO_ReadEmergencyRelease(uint8_t door_id)
     return state;
 }
 
+/**
+ * @brief Sample every door input into the input process image.
+ * @details Shadow registers are read directly: door and sensor indices are
+ *          loop-bounded, so the per-call range checks of UNIT-HAL-002..005
+ *          are not repeated. The image is built locally and published with
+ *          one structure copy.
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t HAL_GPIO_CaptureInputImage(void)
+{
+    /* Implements: REQ-INT-001/002/003, UNIT-HAL-024 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.1 */
+    hal_input_image_t image;
+    error_t           result;
+    uint8_t           door_idx;
+
+    image.position_a = 0U;
+    image.position_b = 0U;
+    image.lock_a     = 0U;
+    image.lock_b     = 0U;
+    image.obstacle_a = 0U;
+    image.obstacle_b = 0U;
+    image.emergency  = 0U;
+    image.read_fault = 0U;
+
+    if (0U == s_hal_initialized)
+    {
+        /* Fail-safe: inputs unknown → obstacle present, doors not locked */
+        image.obstacle_a = DOOR_MASK_ALL;
+        image.obstacle_b = image.obstacle_a;
+        image.read_fault = image.obstacle_a;
+        s_hal_fault_flag = 1U;
+        result = ERR_HW_FAULT;
+    }
+    else
+    {
+        /* Target: one read of each GPIO input data register */
+        for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+        {
+            image.position_a |= (door_mask_t)(s_position_sensor_shadow[door_idx][0] & 1U) << door_idx;
+            image.position_b |= (door_mask_t)(s_position_sensor_shadow[door_idx][1] & 1U) << door_idx;
+            image.lock_a     |= (door_mask_t)(s_lock_sensor_shadow[door_idx][0] & 1U) << door_idx;
+            image.lock_b     |= (door_mask_t)(s_lock_sensor_shadow[door_idx][1] & 1U) << door_idx;
+            image.obstacle_a |= (door_mask_t)(s_obstacle_sensor_shadow[door_idx][0] & 1U) << door_idx;
+            image.obstacle_b |= (door_mask_t)(s_obstacle_sensor_shadow[door_idx][1] & 1U) << door_idx;
+            image.emergency  |= (door_mask_t)(s_emergency_release_shadow[door_idx] & 1U) << door_idx;
+        }
+        result = SUCCESS;
+    }
+
+    s_input_image = image;
+
+    return result;
+}
+
+/**
+ * @brief Access the input process image of the current cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+const hal_input_image_t *HAL_GPIO_GetInputImage(void)
+{
+    /* Implements: UNIT-HAL-025 */
+    return &s_input_image;
+}
+
 /**
  * @brief Set motor direction for a door.
  * @complexity Cyclomatic complexity: 2
@@ -373,7 +535,7 @@ error_t HAL_GPIO_SetLockActuator(uint8_t door_id, uint8_t locked)
 
 /**
  * @brief Set PWM duty cycle for motor drive (0–100 percent).
- * @complexity Cyclomatic complexity: 2
+ * @complexity Cyclomatic complexity: 5
  */
 error_t HAL_PWM_SetDutyCycle(uint8_t door_id, uint8_t duty_pct)
 {
@@ -389,6 +551,10 @@ error_t HAL_PWM_SetDutyCycle(uint8_t door_id, uint8_t duty_pct)
     {
         result = ERR_RANGE;
     }
+    else if ((0U != s_motor_inhibit) && (0U != duty_pct))
+    {
+        result = ERR_NOT_PERMITTED;  /* Emergency stop latched */
+    }
     else
     {
         s_pwm_duty[door_id] = duty_pct;
@@ -478,21 +644,43 @@ error_t HAL_CAN_Transmit(uint32_t msg_id, const uint8_t *data, uint8_t dlc)
  *===========================================================================*/
 
 /**
- * @brief Exchange cross-channel state struct via SPI with peer DCU.
+ * @brief Exchange the packed cross-channel state via SPI with peer DCU.
  * @complexity Cyclomatic complexity: 3
  */
-error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
-                                      cross_channel_state_t *remote)
+error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_wire_t *local,
+                                      cross_channel_wire_t *remote)
 {
     /* Implements: REQ-SAFE-002, SW-HAZ-011, UNIT-HAL-012 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §10.4 */
     error_t result;
 
-    if (NULL == local)
+    if (NULL == remote)
     {
         result = ERR_NULL_PTR;
     }
-    else if (NULL == remote)
+    else
+    {
+        result = HAL_SPI_CrossChannel_Start(local);
+        if (SUCCESS == result)
+        {
+            result = HAL_SPI_CrossChannel_Complete(remote);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Start an asynchronous full-duplex DMA exchange.
+ * @complexity Cyclomatic complexity: 4
+ */
+error_t HAL_SPI_CrossChannel_Start(const cross_channel_wire_t *local)
+{
+    /* Implements: REQ-SAFE-002, SW-HAZ-011, UNIT-HAL-029 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.4 */
+    error_t result;
+
+    if (NULL == local)
     {
         result = ERR_NULL_PTR;
     }
@@ -500,19 +688,123 @@ error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
     {
         result = ERR_HW_FAULT;
     }
+    else if (0U != s_spi_busy)
+    {
+        result = ERR_INVALID_STATE;
+    }
     else
     {
-        /* Target: full-duplex SPI DMA transfer of HAL_SPI_TRANSFER_BYTES.
-         * Stub: return the local state as remote (loopback for unit-test). */
-        *remote = s_spi_rx_buffer;
-        /* Note: on target, s_spi_rx_buffer is populated by DMA ISR. */
-        (void)local;
+        s_spi_tx_buffer   = *local;
+        s_spi_done        = 0U;
+        s_spi_busy        = 1U;
+        s_spi_start_ticks = HAL_GetCycleCounter();
+        s_spi_done_ticks  = s_spi_start_ticks;  /* 0 until the DMA completes */
+
+        /* Target: arm Rx then Tx DMA streams for HAL_SPI_TRANSFER_BYTES,
+         * enable the transfer-complete interrupt, assert NSS.
+         * Stub: no DMA controller — loopback, the transfer completes at once
+         * (on target s_spi_rx_buffer is filled by the Rx DMA stream). */
+        s_spi_rx_buffer = s_spi_tx_buffer;
+        HAL_SPI_DmaCompleteISR();
         result = SUCCESS;
     }
 
     return result;
 }
 
+/**
+ * @brief Non-blocking completion check.
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t HAL_SPI_CrossChannel_Poll(uint8_t *done_out)
+{
+    /* Implements: UNIT-HAL-030 */
+    error_t result;
+
+    if (NULL == done_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (0U == s_spi_busy)
+    {
+        result = ERR_INVALID_STATE;
+    }
+    else
+    {
+        *done_out = s_spi_done;
+        result    = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Wait (bounded) for the DMA and collect the received state.
+ * @complexity Cyclomatic complexity: 5
+ */
+error_t HAL_SPI_CrossChannel_Complete(cross_channel_wire_t *remote)
+{
+    /* Implements: REQ-SAFE-002, SW-HAZ-011, UNIT-HAL-031 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.4 */
+    error_t  result;
+    uint32_t wait_start;
+
+    if (NULL == remote)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (0U == s_spi_busy)
+    {
+        result = ERR_INVALID_STATE;
+    }
+    else
+    {
+        wait_start = HAL_GetCycleCounter();
+        while ((0U == s_spi_done) &&
+               ((HAL_GetCycleCounter() - wait_start) <
+                HAL_SPI_COMPLETE_TIMEOUT_TICKS))
+        {
+            /* Busy-wait for the DMA transfer-complete interrupt */
+        }
+
+        if (0U != s_spi_done)
+        {
+            *remote = s_spi_rx_buffer;
+            result  = SUCCESS;
+        }
+        else
+        {
+            /* Target: disable both DMA streams, deassert NSS */
+            result = ERR_TIMEOUT;
+        }
+        s_spi_busy = 0U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Duration of the last transfer; 0 if it did not complete.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t HAL_SPI_CrossChannel_GetTransferTicks(void)
+{
+    /* Implements: UNIT-HAL-031 */
+    return s_spi_done_ticks - s_spi_start_ticks;
+}
+
+/**
+ * @brief SPI DMA transfer-complete interrupt handler.
+ * @complexity Cyclomatic complexity: 1
+ */
+void HAL_SPI_DmaCompleteISR(void)
+{
+    /* Implements: UNIT-HAL-032 */
+    /* Target: clear the DMA stream TCIF flag, deassert NSS */
+    s_spi_done_ticks = HAL_GetCycleCounter();
+    s_spi_done       = 1U;
+}
+
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS — ADC
  * Implements: UNIT-HAL-014
@@ -545,6 +837,85 @@ error_t HAL_ADC_ReadMotorCurrent(uint8_t door_id, uint16_t *adc_value)
     return result;
 }
 
+/**
+ * @brief Platform stub of the DMA: the ring slot being filled is written
+ *        from the motor current shadow.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void hal_adc_stub_scan(hal_adc_block_t *block)
+{
+    uint8_t k;
+    uint8_t door_idx;
+
+    for (k = 0U; k < HAL_ADC_BLOCK_SAMPLES; k++)
+    {
+        for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+        {
+            block->sample[k][door_idx] = s_adc_motor_current[door_idx];
+        }
+    }
+}
+
+/**
+ * @brief Take the oldest completed scan block not taken yet.
+ * @details The DMA is filling block s_adc_block_seq, so blocks
+ *          s_adc_block_seq - (HAL_ADC_RING_BLOCKS - 1) and later are
+ *          intact; a consumer further behind resumes at the oldest of them.
+ * @complexity Cyclomatic complexity: 6
+ */
+error_t HAL_ADC_TakeBlock(const hal_adc_block_t **block_out,
+                          uint32_t *seq_out)
+{
+    /* Implements: REQ-SAFE-006, UNIT-HAL-036 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.5 */
+    error_t  result;
+    uint32_t seq;
+
+    if ((NULL == block_out) || (NULL == seq_out))
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (0U == s_hal_initialized)
+    {
+        result = ERR_HW_FAULT;
+    }
+    else
+    {
+        seq = s_adc_block_seq;
+        if (seq == s_adc_taken_seq)
+        {
+            result = ERR_TIMEOUT;
+        }
+        else
+        {
+            if ((seq - s_adc_taken_seq) > HAL_ADC_RING_MASK)
+            {
+                s_adc_taken_seq = seq - HAL_ADC_RING_MASK;  /* Overwritten */
+            }
+            *block_out = &s_adc_ring[s_adc_taken_seq & HAL_ADC_RING_MASK];
+            *seq_out   = s_adc_taken_seq;
+            s_adc_taken_seq++;
+            result = SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief ADC scan DMA transfer-complete interrupt handler.
+ * @complexity Cyclomatic complexity: 1
+ */
+void HAL_ADC_DmaBlockISR(void)
+{
+    /* Implements: UNIT-HAL-037 */
+    /* Target: clear the DMA stream TCIF flag; the DMA now fills the other
+     * memory address, so point the idle one at ring slot
+     * (s_adc_block_seq + 2) % HAL_ADC_RING_BLOCKS. */
+    hal_adc_stub_scan(&s_adc_ring[s_adc_block_seq & HAL_ADC_RING_MASK]);
+    s_adc_block_seq = s_adc_block_seq + 1U;
+}
+
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS — Watchdog and System Services
  * Implements: UNIT-HAL-015, UNIT-HAL-016
@@ -586,6 +957,18 @@ uint32_t HAL_GetSystemTickMs(void)
     return s_system_tick_ms;
 }
 
+/**
+ * @brief Read the free-running core cycle counter.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t HAL_GetCycleCounter(void)
+{
+    /* Implements: UNIT-HAL-028 */
+    /* Target: return DWT->CYCCNT (enabled in HAL_Init via DEMCR.TRCENA).
+     * Stub: derived from the millisecond tick. */
+    return s_system_tick_ms * (uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000UL);
+}
+
 /**
  * @brief Get HAL fault status for FMG aggregation.
  * @complexity Cyclomatic complexity: 1
@@ -596,114 +979,330 @@ uint8_t HAL_GetFault(void)
 }
 
 /*============================================================================
- * PUBLIC FUNCTION IMPLEMENTATION — CRC-16-CCITT
- * Implements: UNIT-HAL-020
+ * CONVENIENCE WRAPPERS — Motor and Lock Control
+ * Stage into s_output_pending; HAL_CommitOutputImage writes the hardware.
+ * Implements: REQ-INT-004, SCDS DOC-COMPDES-2026-001 §10.2
  *===========================================================================*/
 
+/** @brief Full speed duty cycle (percent) */
+#define HAL_MOTOR_FULL_DUTY  (80U)
+
+/**
+ * @brief Set or clear one door's bit in an output mask.
+ * @complexity Cyclomatic complexity: 2
+ */
+static door_mask_t hal_output_set_bit(door_mask_t mask, uint8_t door_id,
+                                      uint8_t on)
+{
+    door_mask_t bit = DOOR_BIT(door_id);
+
+    return (0U != on) ? (mask | bit) : (mask & ~bit);
+}
+
+/**
+ * @brief Unpack an output mask into a per-door register array (one port
+ *        write on target: GPIO BSRR).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void hal_output_write_port(uint8_t reg[MAX_DOORS], door_mask_t mask)
+{
+    uint8_t door_idx;
+
+    for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+    {
+        reg[door_idx] = DOOR_MASK_TEST(mask, door_idx);
+    }
+}
+
 /**
- * @brief Compute CRC-16-CCITT (polynomial 0x1021, init 0xFFFF, no final XOR).
- * @details Bit-by-bit algorithm. All safety-critical data structures in TDC
- *          use this function for integrity protection (OI-FTA-003).
- * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ * @brief Stop every motor now: PWM registers, staged and committed duty 0.
+ * @complexity Cyclomatic complexity: 2
  */
-uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length)
+static void hal_pwm_stop_all(void)
 {
-    /* Implements: REQ-SAFE-010/018, OI-FTA-003, UNIT-HAL-020 */
-    /* Design ref: SCDS DOC-COMPDES-2026-001 §2.2, §10.2 */
-    uint16_t crc;
-    uint16_t byte_idx;
-    uint8_t  bit_idx;
+    uint8_t door_idx;
 
-    /* Defensive: return 0x0000 on invalid input */
-    if ((NULL == data) || (0U == length))
+    for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
     {
-        crc = 0x0000U;
+        /* Target: write TIMx->CCRn = 0 for this door's channel */
+        s_pwm_duty[door_idx]                  = 0U;
+        s_output_pending.pwm_duty[door_idx]   = 0U;
+        s_output_committed.pwm_duty[door_idx] = 0U;
+    }
+}
+
+/**
+ * @brief Write one door's staged PWM duty to its compare register.
+ * @details The duty is 0 while the emergency inhibit or the door's stop
+ *          latch is set. The latch is re-checked after the write, so a
+ *          HAL_MotorStopNow that preempts the channel between the duty read
+ *          and the write cannot leave the motor energised.
+ * @return uint8_t 1 if the register was written, 0 if unchanged
+ * @complexity Cyclomatic complexity: 5
+ */
+static uint8_t hal_commit_pwm_channel(uint8_t door_idx)
+{
+    uint8_t duty    = s_output_pending.pwm_duty[door_idx];
+    uint8_t written = 0U;
+
+    if ((0U != s_motor_inhibit) || (0U != s_motor_stop_latch[door_idx]))
+    {
+        duty = 0U;
+    }
+
+    if (duty != s_output_committed.pwm_duty[door_idx])
+    {
+        /* Target: write TIMx->CCRn for this door's channel */
+        s_pwm_duty[door_idx] = duty;
+        s_output_committed.pwm_duty[door_idx] = duty;
+        written = 1U;
+
+        if (0U != s_motor_stop_latch[door_idx])
+        {
+            /* Target: write TIMx->CCRn = 0 again */
+            s_pwm_duty[door_idx] = 0U;
+            s_output_committed.pwm_duty[door_idx] = 0U;
+        }
+    }
+
+    return written;
+}
+
+/**
+ * @brief Write the staged output image to the actuator registers.
+ * @details Order matches the former immediate sequence: direction before
+ *          PWM, lock last. With the emergency motor inhibit latched every
+ *          PWM channel is written as 0; the inhibit is re-checked after the
+ *          image is committed, so an emergency stop that preempts the
+ *          commit cannot be overwritten by a duty read before it. A door
+ *          stopped by HAL_MotorStopNow is held at 0 per channel in the same
+ *          way until DSM stages its reversal.
+ * @complexity Cyclomatic complexity: 7
+ */
+error_t HAL_CommitOutputImage(void)
+{
+    /* Implements: REQ-INT-004, UNIT-HAL-026 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.2 */
+    error_t result;
+    uint8_t door_idx;
+    uint8_t writes = 0U;
+
+    if (0U == s_hal_initialized)
+    {
+        s_hal_fault_flag = 1U;
+        result = ERR_HW_FAULT;
     }
     else
     {
-        crc = CRC16_INIT;  /* 0xFFFF */
+        if (s_output_pending.motor_dir != s_output_committed.motor_dir)
+        {
+            hal_output_write_port(s_motor_direction, s_output_pending.motor_dir);
+            writes++;
+        }
 
-        for (byte_idx = 0U; byte_idx < length; byte_idx++)
+        for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
         {
-            crc ^= ((uint16_t)data[byte_idx] << 8U);
+            writes += hal_commit_pwm_channel(door_idx);
+        }
 
-            for (bit_idx = 0U; bit_idx < 8U; bit_idx++)
-            {
-                if ((crc & 0x8000U) != 0U)
-                {
-                    crc = (uint16_t)((crc << 1U) ^ CRC16_POLY);
-                }
-                else
-                {
-                    crc = (uint16_t)(crc << 1U);
-                }
-            }
+        if (s_output_pending.lock != s_output_committed.lock)
+        {
+            hal_output_write_port(s_lock_actuator, s_output_pending.lock);
+            writes++;
+        }
+
+        s_output_committed.motor_dir = s_output_pending.motor_dir;
+        s_output_committed.lock      = s_output_pending.lock;
+        if (0U != s_motor_inhibit)
+        {
+            hal_pwm_stop_all();
         }
+        result = SUCCESS;
     }
 
-    return crc;
-}
+    s_output_write_count = writes;
 
-/*============================================================================
- * CONVENIENCE WRAPPERS — Motor and Lock Control
- * Implements: REQ-INT-004, SCDS DOC-COMPDES-2026-001 §10.2
- *===========================================================================*/
+    return result;
+}
 
-/** @brief Full speed duty cycle (percent) */
-#define HAL_MOTOR_FULL_DUTY  (80U)
+/**
+ * @brief Actuator register writes performed by the last commit.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint8_t HAL_GetOutputWriteCount(void)
+{
+    /* Implements: UNIT-HAL-027 */
+    return s_output_write_count;
+}
 
 /**
- * @brief Start motor for a door in the specified direction.
+ * @brief Start motor for a door in the specified direction (staged).
+ * @details An open-direction start is the DSM obstacle reversal of a door
+ *          stopped by HAL_MotorStopNow, and releases its stop latch.
  * @complexity Cyclomatic complexity: 3
  */
 error_t HAL_MotorStart(uint8_t door_id, uint8_t direction)
 {
     /* Implements: REQ-INT-004 */
-    error_t err;
+    error_t result;
 
     if (door_id >= MAX_DOORS)
     {
-        return ERR_RANGE;
+        result = ERR_RANGE;
     }
-
-    err = HAL_GPIO_SetMotorDirection(door_id, direction);
-    if (SUCCESS != err)
+    else
     {
-        return err;
+        if (0U != direction)
+        {
+            s_motor_stop_latch[door_id] = 0U;
+        }
+        s_output_pending.motor_dir = hal_output_set_bit(
+            s_output_pending.motor_dir, door_id, direction);
+        s_output_pending.pwm_duty[door_id] = HAL_MOTOR_FULL_DUTY;
+        result = SUCCESS;
     }
 
-    err = HAL_PWM_SetDutyCycle(door_id, HAL_MOTOR_FULL_DUTY);
-    return err;
+    return result;
 }
 
 /**
- * @brief Stop motor for a door (duty cycle = 0).
- * @complexity Cyclomatic complexity: 1
+ * @brief Stop motor for a door (duty cycle = 0, staged).
+ * @complexity Cyclomatic complexity: 2
  */
 error_t HAL_MotorStop(uint8_t door_id)
 {
     /* Implements: REQ-INT-004 */
-    return HAL_PWM_SetDutyCycle(door_id, 0U);
+    error_t result;
+
+    if (door_id >= MAX_DOORS)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        s_output_pending.pwm_duty[door_id] = 0U;
+        result = SUCCESS;
+    }
+
+    return result;
 }
 
 /**
- * @brief Engage (energise) the lock solenoid for a door.
- * @complexity Cyclomatic complexity: 1
+ * @brief Engage (energise) the lock solenoid for a door (staged).
+ * @complexity Cyclomatic complexity: 2
  */
 error_t HAL_LockEngage(uint8_t door_id)
 {
     /* Implements: REQ-INT-002 */
-    return HAL_GPIO_SetLockActuator(door_id, 1U);
+    error_t result;
+
+    if (door_id >= MAX_DOORS)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        s_output_pending.lock = hal_output_set_bit(s_output_pending.lock,
+                                                   door_id, 1U);
+        result = SUCCESS;
+    }
+
+    return result;
 }
 
 /**
- * @brief Disengage (de-energise) the lock solenoid for a door.
- * @complexity Cyclomatic complexity: 1
+ * @brief Disengage (de-energise) the lock solenoid for a door (staged).
+ * @complexity Cyclomatic complexity: 2
  */
 error_t HAL_LockDisengage(uint8_t door_id)
 {
     /* Implements: REQ-INT-002 */
-    return HAL_GPIO_SetLockActuator(door_id, 0U);
+    error_t result;
+
+    if (door_id >= MAX_DOORS)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        s_output_pending.lock = hal_output_set_bit(s_output_pending.lock,
+                                                   door_id, 0U);
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Emergency motor stop: latch the inhibit, then stop every motor.
+ * @details The inhibit is set first, so a commit preempted by this call
+ *          re-checks it and cannot restore a duty it read earlier.
+ * @complexity Cyclomatic complexity: 1
+ */
+error_t HAL_EmergencyMotorStop(void)
+{
+    /* Implements: REQ-INT-004, UNIT-HAL-033 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.2 */
+    s_motor_inhibit = 1U;
+    hal_pwm_stop_all();
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Stop one door's motor now (ISR-safe): latch the door's stop, then
+ *        PWM register, staged and committed duty 0.
+ * @details The latch is set first, so a commit preempted by this call
+ *          re-checks it and cannot restore a duty it read earlier.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t HAL_MotorStopNow(uint8_t door_id)
+{
+    /* Implements: REQ-INT-004, UNIT-HAL-035 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.2 */
+    error_t result;
+
+    if (door_id >= MAX_DOORS)
+    {
+        result = ERR_RANGE;
+    }
+    else
+    {
+        s_motor_stop_latch[door_id]          = 1U;
+        /* Target: write TIMx->CCRn = 0 for this door's channel */
+        s_pwm_duty[door_id]                  = 0U;
+        s_output_pending.pwm_duty[door_id]   = 0U;
+        s_output_committed.pwm_duty[door_id] = 0U;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Motor inhibit latched by HAL_EmergencyMotorStop.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint8_t HAL_IsMotorInhibited(void)
+{
+    /* Implements: UNIT-HAL-034 */
+    return s_motor_inhibit;
+}
+
+/**
+ * @brief Release the motor inhibit latched by HAL_EmergencyMotorStop.
+ * @details A duty staged while the inhibit was latched is discarded, so
+ *          only a duty staged after the release reaches the motors.
+ * @complexity Cyclomatic complexity: 1
+ */
+error_t HAL_ReleaseMotorInhibit(void)
+{
+    /* Implements: REQ-INT-004, UNIT-HAL-034 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §10.2 */
+    hal_pwm_stop_all();
+    s_motor_inhibit = 0U;
+
+    return SUCCESS;
 }
 
 /*============================================================================
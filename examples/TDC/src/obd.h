@@ -28,9 +28,24 @@
 #include "tdc_types.h"
 
 /**
- * @brief Obstacle sensor interrupt service routine — minimal ISR, sets latch.
+ * @brief Obstacle ISR motor-stop statistics (HAL cycle-counter ticks).
+ * @details Stop time runs from OBD_ObstacleISR entry to the return of
+ *          HAL_MotorStopNow (the door's PWM channel written to 0).
+ */
+typedef struct {
+    uint32_t isr_stop_count;   /**< Obstacle interrupts that stopped a closing door */
+    uint32_t last_stop_ticks;  /**< ISR entry to motor stopped, last */
+    uint32_t max_stop_ticks;   /**< Longest since OBD_Init */
+} obd_isr_stop_stats_t;
+
+/**
+ * @brief Obstacle sensor interrupt service routine — sets the latch and, for
+ *        a door that is closing, stops its motor at once.
+ * @details The FSM still takes the reversal (OBSTACLE_REVERSAL, motor
+ *          driven open) in the next DSM cycle from the latched flag; the ISR
+ *          only removes the closing force in the meantime.
  * @param[in] door_id Door index (0–MAX_DOORS-1); silently ignored if out of range
- * @note   UNIT-OBD-001; Complexity: 2. Keep minimal per MISRA ISR guidance.
+ * @note   UNIT-OBD-001; Complexity: 3. Keep minimal per MISRA ISR guidance.
  */
 void OBD_ObstacleISR(uint8_t door_id);
 
@@ -49,7 +64,7 @@ void OBD_RunCycle(void);
 
 /**
  * @brief Poll obstacle sensors and evaluate detection for all doors.
- * @details 1oo2 logic: ISR latch OR polled sensor A OR polled sensor B
+ * @details 1oo2 logic: ISR latch OR sensor A OR sensor B (input image)
  *          OR motor current > MAX_FORCE_ADC (when door closing) → obstacle.
  *          Fail-safe: sensor read error → assume obstacle present.
  * @param[in]  door_closing_flags Array of closing-in-progress flags [MAX_DOORS]
@@ -73,6 +88,14 @@ const uint8_t *OBD_GetObstacleFlags(void);
  */
 uint8_t OBD_GetFault(void);
 
+/**
+ * @brief Get the obstacle ISR motor-stop statistics.
+ * @param[out] stats_out Statistics since OBD_Init
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-OBD-006; Complexity: 2
+ */
+error_t OBD_GetIsrStopStats(obd_isr_stop_stats_t *stats_out);
+
 #endif /* OBD_H */
 
 /*============================================================================
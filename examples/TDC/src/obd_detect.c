@@ -1,9 +1,21 @@
 /**
  * @file    obd_detect.c
- * @brief   OBD Obstacle Detection — ISR latch, polled sensors, motor current.
+ * @brief   OBD Obstacle Detection — ISR latch, sampled sensors, filtered
+ *          motor current.
  * @details Implements UNIT-OBD-001 (ObstacleISR), UNIT-OBD-002
  *          (PollSensorsAndEvaluate), UNIT-OBD-003 (Init), UNIT-OBD-004
- *          (RunCycle), UNIT-OBD-005 (GetObstacleFlags), and OBD_GetFault.
+ *          (RunCycle), UNIT-OBD-005 (GetObstacleFlags), UNIT-OBD-006
+ *          (GetIsrStopStats) and OBD_GetFault.
+ *          An obstacle interrupt on a closing door stops that door's motor
+ *          from the ISR (HAL_MotorStopNow); the reversal follows in the
+ *          next DSM cycle from the latched flag.
+ *          Motor current comes from the HAL ADC scan (HAL_ADC_TakeBlock:
+ *          20 ms blocks at 1 kHz for all doors, drained in sequence order
+ *          each cycle, so a cycle may see none or two). Each block runs
+ *          through a median-of-3, a moving average and a slope detector
+ *          sample by sample, all doors per sample, so a force build-up is
+ *          seen from the samples inside the cycle and single-sample spikes
+ *          no longer trigger a reversal.
  *
  * @project TDC (Train Door Control System)
  * @module  OBD (Obstacle Detector) — COMP-003
@@ -40,6 +52,27 @@
 /** @brief Motor current ADC threshold equivalent to maximum allowed force (~150 N) */
 #define OBD_MAX_FORCE_ADC  (3000U)
 
+/** @brief Moving-average window: 8 samples (8 ms at 1 kHz) */
+#define OBD_MA_SAMPLES     (8U)
+
+/** @brief log2(OBD_MA_SAMPLES): window sums are compared, not divided */
+#define OBD_MA_SHIFT       (3U)
+
+/** @brief Raw history per door: the current window and the one before it */
+#define OBD_HIST_SAMPLES   (2U * OBD_MA_SAMPLES)
+
+/** @brief Slope limit: rise of the moving average within one window (counts) */
+#define OBD_SLOPE_MAX_ADC  (500U)
+
+/** @brief Slope detector held off for 100 ms after a door starts closing
+ *         (motor inrush; history still filling) */
+#define OBD_SLOPE_BLANK_SAMPLES (100U)
+
+/** @brief Consecutive cycles without a completed current block before the
+ *         scan is declared stalled (the scan and cycle clocks drift, so
+ *         one empty cycle is expected now and then) */
+#define OBD_NO_BLOCK_FAULT_CYCLES (3U)
+
 /*============================================================================
  * STATIC VARIABLES
  *===========================================================================*/
@@ -49,29 +82,318 @@ static uint8_t s_obstacle_isr_flags[MAX_DOORS];
 /** @brief Evaluated obstacle flags per door (result of last cycle evaluation) */
 static uint8_t s_obstacle_flags[MAX_DOORS];
 
-/** @brief Motor current ADC values per door (from last HAL read) */
+/** @brief Filtered motor current per door (moving average at the end of the
+ *         last block the door was closing in) */
 static uint16_t s_motor_current_adc[MAX_DOORS];
 
+/** @brief Last two raw samples per door [0 = newest] (median-of-3 input) */
+static uint16_t s_obd_raw_prev[2][MAX_DOORS];
+
+/** @brief Median-filtered motor current history [slot][door]; one ring slot
+ *         per scan, shared by all doors */
+static uint16_t s_obd_hist[OBD_HIST_SAMPLES][MAX_DOORS];
+
+/** @brief Ring slot the next scan is written to */
+static uint8_t s_obd_hist_slot;
+
+/** @brief Sum of the newest OBD_MA_SAMPLES samples per door */
+static uint32_t s_obd_sum_new[MAX_DOORS];
+
+/** @brief Sum of the OBD_MA_SAMPLES samples before those, per door */
+static uint32_t s_obd_sum_old[MAX_DOORS];
+
+/** @brief Samples left before the slope detector is armed, per door */
+static uint8_t s_obd_slope_blank[MAX_DOORS];
+
+/** @brief Closing mask of the previous cycle (rising-edge detection) */
+static door_mask_t s_obd_prev_closing;
+
+/** @brief Sequence number of the next current block expected */
+static uint32_t s_obd_next_seq;
+
+/** @brief Consecutive cycles in which no current block completed */
+static uint8_t s_obd_no_block_cycles;
+
 /** @brief OBD fault flag (set if HAL sensor read fails) */
 static uint8_t s_obd_fault_flag;
 
+/** @brief ISR motor-stop statistics; written by OBD_ObstacleISR only */
+static obd_isr_stop_stats_t s_obd_isr_stop_stats;
+
+/*============================================================================
+ * STATIC FUNCTION IMPLEMENTATIONS
+ *===========================================================================*/
+
+/**
+ * @brief Stop one closing door's motor from the ISR and record the time from
+ *        ISR entry to the PWM write.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void obd_isr_stop(uint8_t door_id, uint32_t entry_ticks)
+{
+    uint32_t stop_ticks;
+
+    (void)HAL_MotorStopNow(door_id);
+    stop_ticks = HAL_GetCycleCounter() - entry_ticks;
+
+    s_obd_isr_stop_stats.isr_stop_count++;
+    s_obd_isr_stop_stats.last_stop_ticks = stop_ticks;
+    if (stop_ticks > s_obd_isr_stop_stats.max_stop_ticks)
+    {
+        s_obd_isr_stop_stats.max_stop_ticks = stop_ticks;
+    }
+}
+
+/**
+ * @brief Clear one door's motor current filter and re-arm the slope blanking.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void obd_filter_reset(uint8_t door_idx)
+{
+    uint8_t slot;
+
+    for (slot = 0U; slot < OBD_HIST_SAMPLES; slot++)
+    {
+        s_obd_hist[slot][door_idx] = 0U;
+    }
+    s_obd_raw_prev[0][door_idx]   = 0U;
+    s_obd_raw_prev[1][door_idx]   = 0U;
+    s_obd_sum_new[door_idx]       = 0U;
+    s_obd_sum_old[door_idx]       = 0U;
+    s_obd_slope_blank[door_idx]   = OBD_SLOPE_BLANK_SAMPLES;
+    s_motor_current_adc[door_idx] = 0U;
+}
+
+/**
+ * @brief Clear the motor current filter of every door in a mask.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void obd_filter_reset_mask(door_mask_t mask)
+{
+    door_mask_t m        = mask;
+    uint8_t     door_idx = 0U;
+
+    while (0U != m)
+    {
+        if (0U != (m & 1U))
+        {
+            obd_filter_reset(door_idx);
+        }
+        m >>= 1U;
+        door_idx++;
+    }
+}
+
+/**
+ * @brief Median of three samples (removes a single-sample spike).
+ * @complexity Cyclomatic complexity: 5
+ */
+static uint16_t obd_median3(uint16_t a, uint16_t b, uint16_t c)
+{
+    uint16_t lo = (a < b) ? a : b;
+    uint16_t hi = (a < b) ? b : a;
+
+    return (c < lo) ? lo : ((c > hi) ? hi : c);
+}
+
+/**
+ * @brief Feed one motor current sample of one door through the filter.
+ * @details The sample is first replaced by the median of it and the door's
+ *          two previous raw samples. slot holds the sample
+ *          OBD_HIST_SAMPLES scans old (leaves the older window), mid the one
+ *          OBD_MA_SAMPLES scans old (moves from the newer window to the
+ *          older one). Both window sums are updated in O(1).
+ * @return uint8_t 1 if the moving average exceeds the force limit or, once
+ *         the blanking has elapsed, rose by more than OBD_SLOPE_MAX_ADC
+ *         within one window
+ * @complexity Cyclomatic complexity: 4
+ */
+static uint8_t obd_filter_sample(uint8_t door_idx, uint16_t sample,
+                                 uint8_t slot, uint8_t mid)
+{
+    uint16_t leaving_new = s_obd_hist[mid][door_idx];
+    uint16_t leaving_old = s_obd_hist[slot][door_idx];
+    uint16_t median;
+    uint8_t  hit;
+
+    median = obd_median3(sample, s_obd_raw_prev[0][door_idx],
+                         s_obd_raw_prev[1][door_idx]);
+    s_obd_raw_prev[1][door_idx] = s_obd_raw_prev[0][door_idx];
+    s_obd_raw_prev[0][door_idx] = sample;
+
+    s_obd_hist[slot][door_idx] = median;
+    s_obd_sum_new[door_idx] = (s_obd_sum_new[door_idx] + median) - leaving_new;
+    s_obd_sum_old[door_idx] = (s_obd_sum_old[door_idx] + leaving_new) -
+                              leaving_old;
+
+    hit = (s_obd_sum_new[door_idx] >
+           ((uint32_t)OBD_MAX_FORCE_ADC << OBD_MA_SHIFT)) ? 1U : 0U;
+
+    if (0U != s_obd_slope_blank[door_idx])
+    {
+        s_obd_slope_blank[door_idx]--;
+    }
+    else if (s_obd_sum_new[door_idx] >
+             (s_obd_sum_old[door_idx] +
+              ((uint32_t)OBD_SLOPE_MAX_ADC << OBD_MA_SHIFT)))
+    {
+        hit = 1U;
+    }
+    else
+    {
+        /* Steady or falling current */
+    }
+
+    return hit;
+}
+
+/**
+ * @brief Run one scan block through the filter of every closing door.
+ * @details The set bits of closing_mask are unpacked once into a door list;
+ *          the scans then run sample-major, like the DMA layout, over the
+ *          listed doors only, so the cost follows the number of closing
+ *          doors rather than MAX_DOORS. Doors that are not closing keep a
+ *          stale history; obd_drain_blocks resets it on their next closing
+ *          edge.
+ * @return door_mask_t Closing doors whose current tripped the filter in any
+ *         sample of the block
+ * @complexity Cyclomatic complexity: 7
+ */
+static door_mask_t obd_filter_block(const hal_adc_block_t *block,
+                                    door_mask_t closing_mask)
+{
+    door_mask_t tripped  = 0U;
+    door_mask_t m        = closing_mask;
+    uint8_t     doors[MAX_DOORS];
+    uint8_t     n_doors  = 0U;
+    uint8_t     door_idx = 0U;
+    uint8_t     k;
+    uint8_t     i;
+    uint8_t     slot;
+    uint8_t     mid;
+
+    while (0U != m)
+    {
+        if (0U != (m & 1U))
+        {
+            doors[n_doors] = door_idx;
+            n_doors++;
+        }
+        m >>= 1U;
+        door_idx++;
+    }
+
+    for (k = 0U; k < HAL_ADC_BLOCK_SAMPLES; k++)
+    {
+        slot = s_obd_hist_slot;
+        mid  = (uint8_t)((slot + OBD_MA_SAMPLES) % OBD_HIST_SAMPLES);
+        for (i = 0U; i < n_doors; i++)
+        {
+            if (0U != obd_filter_sample(doors[i],
+                                        block->sample[k][doors[i]],
+                                        slot, mid))
+            {
+                tripped |= DOOR_BIT(doors[i]);
+            }
+        }
+        s_obd_hist_slot = (uint8_t)((slot + 1U) % OBD_HIST_SAMPLES);
+    }
+
+    for (i = 0U; i < n_doors; i++)
+    {
+        s_motor_current_adc[doors[i]] =
+            (uint16_t)(s_obd_sum_new[doors[i]] >> OBD_MA_SHIFT);
+    }
+
+    return tripped;
+}
+
+/**
+ * @brief Filter every current block completed since the last cycle.
+ * @details Takes blocks in sequence order until none is left (at most the
+ *          ring depth). A door's filter is reset once, on the rising edge of
+ *          its closing bit, so it starts closing with an empty history and a
+ *          fresh slope blanking. A jump in the sequence number means blocks
+ *          were overwritten before they were taken: the filter history is no
+ *          longer contiguous, so every closing door restarts it. Only
+ *          OBD_NO_BLOCK_FAULT_CYCLES consecutive cycles without a block set
+ *          s_obd_fault_flag; the closing doors are then obstructed.
+ * @return door_mask_t Closing doors tripped by the current filter, or all
+ *         closing doors if the scan has stalled
+ * @complexity Cyclomatic complexity: 7
+ */
+static door_mask_t obd_drain_blocks(door_mask_t closing_mask)
+{
+    door_mask_t            tripped = 0U;
+    const hal_adc_block_t *block   = NULL;
+    uint32_t               seq     = 0U;
+    uint8_t                taken   = 0U;
+
+    obd_filter_reset_mask(closing_mask & ~s_obd_prev_closing);
+    s_obd_prev_closing = closing_mask;
+
+    while ((taken < HAL_ADC_RING_BLOCKS) &&
+           (SUCCESS == HAL_ADC_TakeBlock(&block, &seq)))
+    {
+        if (seq != s_obd_next_seq)
+        {
+            obd_filter_reset_mask(closing_mask);
+        }
+        s_obd_next_seq = seq + 1U;
+        tripped |= obd_filter_block(block, closing_mask);
+        taken++;
+    }
+
+    if (0U != taken)
+    {
+        s_obd_no_block_cycles = 0U;
+    }
+    else if (s_obd_no_block_cycles < OBD_NO_BLOCK_FAULT_CYCLES)
+    {
+        s_obd_no_block_cycles++;
+    }
+    else
+    {
+        /* Saturated */
+    }
+
+    if (s_obd_no_block_cycles >= OBD_NO_BLOCK_FAULT_CYCLES)
+    {
+        s_obd_fault_flag = 1U;
+        tripped = closing_mask;
+    }
+
+    return tripped;
+}
+
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS
  *===========================================================================*/
 
 /**
- * @brief Obstacle sensor ISR — sets latch flag only (minimal ISR).
+ * @brief Obstacle sensor ISR — sets the latch flag and stops a closing
+ *        door's motor.
  * @details Called from hardware interrupt. Must be kept minimal.
  *          Bounds check performed defensively; out-of-range door_id ignored.
- * @complexity Cyclomatic complexity: 2 — within SIL 3 limit of 10
+ *          The closing state is read from DSM's byte-per-door closing flags
+ *          (a single-byte load, not the 64-bit mask, which is not atomic on
+ *          the target). A door that is not closing only latches: stopping
+ *          an opening door would gain nothing and the cycle still decides.
+ * @complexity Cyclomatic complexity: 3 — within SIL 3 limit of 10
  */
 void OBD_ObstacleISR(uint8_t door_id)
 {
     /* Implements: REQ-SAFE-004, UNIT-OBD-001 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §5.1.1 */
+    uint32_t entry_ticks = HAL_GetCycleCounter();
+
     if (door_id < MAX_DOORS)
     {
         s_obstacle_isr_flags[door_id] = 1U;
+        if (0U != DSM_GetClosingFlags()[door_id])
+        {
+            obd_isr_stop(door_id, entry_ticks);
+        }
     }
     /* Silently ignore out-of-range door_id (defensive; ISR cannot return error) */
 }
@@ -90,120 +412,131 @@ error_t OBD_Init(void)
     {
         s_obstacle_isr_flags[door_idx]  = 0U;
         s_obstacle_flags[door_idx]      = 0U;
-        s_motor_current_adc[door_idx]   = 0U;
+        obd_filter_reset(door_idx);
     }
-    s_obd_fault_flag = 0U;
+    s_obd_hist_slot       = 0U;
+    s_obd_prev_closing    = 0U;
+    s_obd_next_seq        = 0U;
+    s_obd_no_block_cycles = 0U;
+    s_obd_fault_flag      = 0U;
+    s_obd_isr_stop_stats.isr_stop_count  = 0U;
+    s_obd_isr_stop_stats.last_stop_ticks = 0U;
+    s_obd_isr_stop_stats.max_stop_ticks  = 0U;
 
     return SUCCESS;
 }
 
 /**
- * @brief 20 ms cycle entry — poll sensors and update global obstacle flags.
- * @complexity Cyclomatic complexity: 1 — within SIL 3 limit of 10
+ * @brief Consume the ISR latches of all doors.
+ * @details The latches stay one byte per door so that OBD_ObstacleISR sets
+ *          its flag with a single byte store; a shared mask word would need
+ *          a read-modify-write that races with this consumer.
+ * @return door_mask_t Doors whose latch was set
+ * @complexity Cyclomatic complexity: 3
  */
-void OBD_RunCycle(void)
+static door_mask_t obd_take_isr_latches(void)
 {
-    /* Implements: UNIT-OBD-004 */
-    /* Design ref: SCDS DOC-COMPDES-2026-001 §5.3.2 */
-    error_t err;
+    door_mask_t latched = 0U;
+    uint8_t     door_idx;
+
+    for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+    {
+        if (0U != s_obstacle_isr_flags[door_idx])
+        {
+            latched |= DOOR_BIT(door_idx);
+            s_obstacle_isr_flags[door_idx] = 0U;
+        }
+    }
 
-    err = OBD_PollSensorsAndEvaluate(DSM_GetClosingFlags(), g_obstacle_flags);
-    (void)err;  /* Errors are logged and reflected in s_obd_fault_flag */
+    return latched;
 }
 
 /**
- * @brief Evaluate obstacle presence for a single door (1oo2 + current logic).
- * @details Called per-door by OBD_PollSensorsAndEvaluate.
- *          Sets s_obd_fault_flag on HAL read error.
- *          Returns 1U if obstacle detected, 0U if clear.
- * @complexity Cyclomatic complexity: 8 — within SIL 3 limit of 10
+ * @brief Evaluate obstacle presence for all doors (1oo2 + current logic).
+ * @details Works on door masks: ISR latches, unreadable inputs and sensors
+ *          A/B are combined with word operations for all doors at once; the
+ *          motor current blocks of the cycle are filtered for the doors in
+ *          closing_mask only (REQ-SAFE-006). Sets
+ *          s_obd_fault_flag if any door's inputs could not be read or the
+ *          current scan has stalled; the closing doors are then treated as
+ *          obstructed (fail-safe).
+ * @return door_mask_t Doors with an obstacle detected
+ * @complexity Cyclomatic complexity: 2 — within SIL 3 limit of 10
  */
-static uint8_t obd_evaluate_single_door(uint8_t door_idx,
-                                         uint8_t door_closing_flag)
+static door_mask_t obd_evaluate_doors(door_mask_t closing_mask,
+                                      const hal_input_image_t *image)
 {
-    /* Implements: UNIT-OBD-002 (per-door helper) */
-    uint8_t  detected;
-    uint8_t  sensor_a;
-    uint8_t  sensor_b;
-    error_t  hal_ret_a;
-    error_t  hal_ret_b;
-    error_t  adc_ret;
-
-    detected = 0U;
-
-    /* ISR latch — consume and clear */
-    if (0U != s_obstacle_isr_flags[door_idx])
-    {
-        detected = 1U;
-        s_obstacle_isr_flags[door_idx] = 0U;
-    }
+    /* Implements: UNIT-OBD-002 (word-parallel helper) */
+    door_mask_t detected;
 
-    /* Polled sensor A */
-    sensor_a  = 0U;
-    hal_ret_a = HAL_GPIO_ReadObstacleSensor(door_idx, 0U, &sensor_a);
+    detected = obd_take_isr_latches();
 
-    if (hal_ret_a != SUCCESS)
+    /* Input image read failure — fail-safe: assume obstacle */
+    if (0U != image->read_fault)
     {
-        detected = 1U;  /* Fail-safe: read error → assume obstacle */
         s_obd_fault_flag = 1U;
     }
-    else if (0U != sensor_a)
-    {
-        detected = 1U;
-    }
-    else
-    {
-        /* Sensor A clear — no action */
-    }
 
-    /* Polled sensor B (1oo2 — either sensor triggers reversal) */
-    sensor_b  = 0U;
-    hal_ret_b = HAL_GPIO_ReadObstacleSensor(door_idx, 1U, &sensor_b);
+    /* Sampled sensors A and B (1oo2 — either sensor triggers reversal) */
+    detected |= image->read_fault | image->obstacle_a | image->obstacle_b;
 
-    if (hal_ret_b != SUCCESS)
-    {
-        detected = 1U;
-        s_obd_fault_flag = 1U;
-    }
-    else if (0U != sensor_b)
-    {
-        detected = 1U;
-    }
-    else
-    {
-        /* Sensor B clear — no action */
-    }
+    /* Motor current — block filter; only closing doors can trip */
+    detected |= obd_drain_blocks(closing_mask);
 
-    /* Motor current check — only when door is closing (REQ-SAFE-006) */
-    if (0U != door_closing_flag)
-    {
-        adc_ret = HAL_ADC_ReadMotorCurrent(door_idx,
-                                           &s_motor_current_adc[door_idx]);
+    return detected & DOOR_MASK_ALL;
+}
 
-        if ((adc_ret == SUCCESS) &&
-            (s_motor_current_adc[door_idx] > OBD_MAX_FORCE_ADC))
-        {
-            detected = 1U;
-        }
+/**
+ * @brief Store an evaluation result and unpack it into a per-door array.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void obd_publish(door_mask_t detected,
+                        uint8_t obstacle_flags_out[MAX_DOORS])
+{
+    uint8_t door_idx;
+
+    for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+    {
+        s_obstacle_flags[door_idx]   = DOOR_MASK_TEST(detected, door_idx);
+        obstacle_flags_out[door_idx] = s_obstacle_flags[door_idx];
     }
+}
 
-    return detected;
+/**
+ * @brief 20 ms cycle entry — poll sensors and update global obstacle flags.
+ * @details Uses the DSM closing mask directly (no per-door flag array).
+ *          Publishes both g_obstacle_flags and its mask form g_obstacle_mask.
+ * @complexity Cyclomatic complexity: 1 — within SIL 3 limit of 10
+ */
+void OBD_RunCycle(void)
+{
+    /* Implements: UNIT-OBD-004 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §5.3.2 */
+    door_mask_t detected;
+
+    s_obd_fault_flag = 0U;
+    detected = obd_evaluate_doors(DSM_GetClosingMask(),
+                                  HAL_GPIO_GetInputImage());
+    obd_publish(detected, g_obstacle_flags);
+    g_obstacle_mask = detected;  /* DSM change detection reads the mask */
 }
 
 /**
  * @brief Poll obstacle sensors and evaluate detection for all doors.
- * @details 1oo2 logic per door delegated to obd_evaluate_single_door.
+ * @details Converts the closing flags to a mask and delegates to
+ *          obd_evaluate_doors. Sensor states come from the input process
+ *          image captured by SKN at cycle start (HAL_GPIO_GetInputImage).
  *          Fail-safe: any read error → obstacle.
- * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ * @complexity Cyclomatic complexity: 6 — within SIL 3 limit of 10
  */
 error_t OBD_PollSensorsAndEvaluate(const uint8_t door_closing_flags[MAX_DOORS],
                                    uint8_t obstacle_flags_out[MAX_DOORS])
 {
     /* Implements: REQ-SAFE-004/005/006, UNIT-OBD-002 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §5.2.1 */
-    error_t  result;
-    uint8_t  door_idx;
-    uint8_t  detected;
+    error_t     result;
+    uint8_t     door_idx;
+    door_mask_t closing_mask = 0U;
 
     if ((NULL == door_closing_flags) || (NULL == obstacle_flags_out))
     {
@@ -220,16 +553,17 @@ error_t OBD_PollSensorsAndEvaluate(const uint8_t door_closing_flags[MAX_DOORS],
     }
     else
     {
-        s_obd_fault_flag = 0U;
-
         for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
         {
-            detected = obd_evaluate_single_door(door_idx,
-                                                door_closing_flags[door_idx]);
-            s_obstacle_flags[door_idx]   = detected;
-            obstacle_flags_out[door_idx] = detected;
+            if (0U != door_closing_flags[door_idx])
+            {
+                closing_mask |= DOOR_BIT(door_idx);
+            }
         }
 
+        s_obd_fault_flag = 0U;
+        obd_publish(obd_evaluate_doors(closing_mask, HAL_GPIO_GetInputImage()),
+                    obstacle_flags_out);
         result = SUCCESS;
     }
 
@@ -255,6 +589,29 @@ uint8_t OBD_GetFault(void)
     return s_obd_fault_flag;
 }
 
+/**
+ * @brief Get the obstacle ISR motor-stop statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t OBD_GetIsrStopStats(obd_isr_stop_stats_t *stats_out)
+{
+    /* Implements: UNIT-OBD-006 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §5.1.1 */
+    error_t result;
+
+    if (NULL == stats_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *stats_out = s_obd_isr_stop_stats;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
 /*============================================================================
  * END OF FILE
  *===========================================================================*/
@@ -51,6 +51,119 @@ extern uint8_t g_speed_interlock_active;
 /** @brief Global obstacle flags per door. Written by OBD. */
 extern uint8_t g_obstacle_flags[MAX_DOORS];
 
+/** @brief Mask form of g_obstacle_flags (bit n = door n). Written by OBD. */
+extern door_mask_t g_obstacle_mask;
+
+/*============================================================================
+ * CYCLE TIMING
+ *===========================================================================*/
+
+/** @brief Scheduler deadline/slack statistics (HAL cycle-counter ticks) */
+typedef struct
+{
+    uint32_t last_exec_ticks;    /**< Execution time of the last cycle */
+    int32_t  slack_ema_ticks;    /**< Slack moving average (alpha = 1/8) */
+    int32_t  worst_slack_ticks;  /**< Smallest slack since init (<0: overrun) */
+    uint32_t overrun_count;      /**< Cycles that exceeded CYCLE_MS */
+    uint32_t cycle_count;        /**< Cycles measured since init */
+} skn_cycle_timing_t;
+
+/*============================================================================
+ * CROSS-CHANNEL EXCHANGE PIPELINE
+ *===========================================================================*/
+#ifndef SKN_SPI_PIPELINE
+/**
+ * @brief 0: the exchange started by SKN_STEP_EXCHANGE is completed and
+ *        compared by SKN_STEP_COMPARE in the same cycle (the transfer
+ *        overlaps the canary and scrub steps).
+ *        1: it is completed at the start of the next cycle's
+ *        SKN_STEP_EXCHANGE (the transfer overlaps the rest of the cycle);
+ *        disagreement detection is delayed by one cycle (20 ms).
+ */
+#define SKN_SPI_PIPELINE            (0U)
+#endif
+
+/** @brief SPI exchange latency statistics (HAL cycle-counter ticks) */
+typedef struct
+{
+    uint32_t exchange_count;       /**< Exchanges completed since init */
+    uint32_t failed_count;         /**< Of which failed (timeout): wait
+                                        counted, transfer totals not */
+    uint32_t last_transfer_ticks;  /**< Start-to-DMA-complete, last exchange */
+    uint32_t last_blocked_ticks;   /**< Time spent waiting in Complete, last */
+    uint32_t max_blocked_ticks;    /**< Longest wait in Complete since init */
+    uint64_t total_transfer_ticks; /**< Sum of transfer times (successful
+                                        exchanges only) */
+    uint64_t total_hidden_ticks;   /**< Sum of transfer time overlapped with
+                                        other work (transfer - blocked) */
+} skn_spi_latency_t;
+
+/*============================================================================
+ * SCHEDULER STEP IDENTIFIERS
+ * Execution order of SKN_RunCycle, index into the static schedule table
+ * (skn_schedule.c) and into the DGN cycle profiler (DGN_Profile_GetStats).
+ *===========================================================================*/
+#define SKN_STEP_CAPTURE_INPUTS     (0U)
+#define SKN_STEP_BUILD_STATE        (1U)
+#define SKN_STEP_EXCHANGE           (2U)
+#define SKN_STEP_CANARY             (3U)
+#define SKN_STEP_SCRUB              (4U)
+#define SKN_STEP_COMPARE            (5U)
+#define SKN_STEP_SAFE_STATE         (6U)
+#define SKN_STEP_TCI_RX             (7U)
+#define SKN_STEP_SPM                (8U)
+#define SKN_STEP_OBD                (9U)
+#define SKN_STEP_DSM                (10U)
+#define SKN_STEP_INTERLOCK          (11U)
+#define SKN_STEP_COMMIT_OUTPUTS     (12U)
+#define SKN_STEP_FMG                (13U)
+#define SKN_STEP_TCI_TX             (14U)
+#define SKN_STEP_WATCHDOG           (15U)
+#define SKN_STEP_DGN                (16U)
+#define SKN_STEP_COUNT              (17U)
+
+/*============================================================================
+ * STATIC SCHEDULE
+ * Minor cycle = CYCLE_MS (20 ms); major cycle = SKN_MAJOR_CYCLE_MINORS minor
+ * cycles (200 ms). Every step period divides the major cycle, so the
+ * schedule repeats exactly once per major cycle.
+ *===========================================================================*/
+/** @brief Minor cycles per major cycle */
+#define SKN_MAJOR_CYCLE_MINORS      (10U)
+
+/*============================================================================
+ * BACKGROUND EXECUTOR (skn_background.c)
+ * Resumable jobs run at the end of SKN_RunCycle while cycle time is left.
+ *===========================================================================*/
+#ifndef SKN_BG_BUDGET_PERCENT
+/** @brief Share of CYCLE_MS that foreground + background work may use */
+#define SKN_BG_BUDGET_PERCENT       (75U)
+#endif
+
+/** @brief Background jobs, in round-robin order (dispatched by switch) */
+#define SKN_BG_JOB_LOG_FLUSH        (0U)  /**< Log flush beyond the 200 ms slot */
+#define SKN_BG_JOB_SCRUB            (1U)  /**< ROM/RAM scrub beyond 1 chunk/cycle */
+#define SKN_BG_JOB_DIAG_PORT        (2U)  /**< Diagnostic port */
+#define SKN_BG_JOB_COUNT            (3U)
+
+/** @brief Hard bound on job chunks per cycle */
+#define SKN_BG_MAX_CHUNKS           (32U)
+
+/** @brief Per-cycle decay of a job's chunk-time estimate: est -= est >> n */
+#define SKN_BG_EST_DECAY_SHIFT      (3U)
+
+/** @brief Consecutive cycles without a chunk after which a job is reported
+ *         starved (EVT_BG_STARVED, once per starvation) — 1 s */
+#define SKN_BG_STARVE_CYCLES        (50U)
+
+/** @brief Background executor statistics, per job (SKN_BG_JOB_*) */
+typedef struct
+{
+    uint32_t skipped_cycles[SKN_BG_JOB_COUNT];  /**< Cycles without a chunk since init */
+    uint16_t starved_cycles[SKN_BG_JOB_COUNT];  /**< Current run of such cycles */
+    uint32_t est_chunk_ticks[SKN_BG_JOB_COUNT]; /**< Chunk-time estimate used for admission */
+} skn_bg_stats_t;
+
 /*============================================================================
  * PUBLIC FUNCTION PROTOTYPES
  * Design ref: SCDS DOC-COMPDES-2026-001 §3
@@ -65,11 +178,94 @@ extern uint8_t g_obstacle_flags[MAX_DOORS];
  */
 error_t SKN_Init(void);
 
+/**
+ * @brief Sub-module initialisation, called from SKN_Init only.
+ * @details Scrub: size chunks and restart both passes (after the ROM/RAM
+ *          reference CRCs are taken). Timing: reset slack statistics.
+ *          Background: forget chunk-time estimates and skip counters. Comparator: abandon any
+ *          exchange in flight, restart the OI-FMEA-001 filter and clear
+ *          latency statistics.
+ * @note   Part of UNIT-SKN-009; Complexity: 1, 1, 2, 2
+ */
+void SKN_Scrub_Init(void);
+void SKN_Timing_Init(void);
+void SKN_Background_Init(void);
+void SKN_Comparator_Init(void);
+
+/**
+ * @brief Mark the start of a scheduler cycle (deadline monitor).
+ * @note   UNIT-SKN-011; Complexity: 1
+ */
+void SKN_Timing_CycleStart(void);
+
+/**
+ * @brief Mark the end of a scheduler cycle: update slack statistics, count
+ *        and log (EVT_DEADLINE_OVERRUN) a cycle longer than CYCLE_MS.
+ * @note   UNIT-SKN-011; Complexity: 5
+ */
+void SKN_Timing_CycleEnd(void);
+
+/**
+ * @brief Cycle-counter ticks elapsed since SKN_Timing_CycleStart.
+ * @return uint32_t Elapsed ticks
+ * @note   UNIT-SKN-011; Complexity: 1
+ */
+uint32_t SKN_Timing_GetElapsedTicks(void);
+
+/**
+ * @brief Read the scheduler deadline/slack statistics.
+ * @param[out] timing_out Statistics copy (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-SKN-012; Complexity: 2
+ */
+error_t SKN_GetCycleTiming(skn_cycle_timing_t *timing_out);
+
+/**
+ * @brief Run the background jobs (SKN_BG_JOB_*) round-robin until they are
+ *        done or the cycle budget (SKN_BG_BUDGET_PERCENT of CYCLE_MS) would
+ *        be exceeded.
+ * @details A chunk is only started if the elapsed cycle time plus the job's
+ *          chunk-time estimate fits the budget. The estimate follows a
+ *          longer chunk at once and decays by 1/2^SKN_BG_EST_DECAY_SHIFT
+ *          per cycle, so one slow chunk does not bar the job for good. A job
+ *          without a chunk for SKN_BG_STARVE_CYCLES cycles logs
+ *          EVT_BG_STARVED (data: job).
+ * @return uint8_t Number of chunks executed
+ * @note   UNIT-SKN-014; Complexity: 6
+ */
+uint8_t SKN_Background_Run(void);
+
+/**
+ * @brief Read the background executor statistics.
+ * @param[out] stats_out Statistics copy (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   Part of UNIT-SKN-014; Complexity: 2
+ */
+error_t SKN_GetBackgroundStats(skn_bg_stats_t *stats_out);
+
+/**
+ * @brief Background job: scrub one extra ROM/RAM chunk (see SKN_ScrubStep).
+ * @return uint8_t 1 while both passes are unfinished, 0 once either completed
+ * @note   UNIT-SKN-010; Complexity: 5
+ */
+uint8_t SKN_Scrub_BackgroundStep(void);
+
+/**
+ * @brief Check whether a scheduler step runs in a given minor cycle.
+ * @param[in] step        Step identifier (SKN_STEP_*)
+ * @param[in] minor_cycle Minor cycle index within the major cycle
+ *                        (0 .. SKN_MAJOR_CYCLE_MINORS-1)
+ * @return uint8_t 1 if the step is due, 0 otherwise (or step out of range)
+ * @note   UNIT-SKN-013; Complexity: 3
+ */
+uint8_t SKN_IsStepDue(uint8_t step, uint8_t minor_cycle);
+
 /**
  * @brief Top-level 20 ms cycle dispatcher.
- * @details Orchestrates all components in deterministic order. This function
- *          is called by the RTOS tick ISR or bare-metal main loop.
- * @note   UNIT-SKN-008; Complexity: 3
+ * @details Runs the steps of the static schedule table (skn_schedule.c) that
+ *          are due in the current minor cycle, in SKN_STEP_* order. This
+ *          function is called by the RTOS tick ISR or bare-metal main loop.
+ * @note   UNIT-SKN-008; Complexity: 4
  */
 void SKN_RunCycle(void);
 
@@ -102,11 +298,71 @@ error_t SKN_BuildLocalState(cross_channel_state_t *state,
  * @param[in]  local               Pointer to local state (must not be NULL)
  * @param[out] safe_state_active_out Set to 1 on mismatch or persistent fault
  * @return error_t SUCCESS, ERR_NULL_PTR, ERR_CRC, ERR_COMM_TIMEOUT, ERR_SENSOR_DISAGREE
- * @note   UNIT-SKN-002; Complexity: 7
+ * @note   UNIT-SKN-002; Complexity: 3
  */
 error_t SKN_ExchangeAndCompare(const cross_channel_state_t *local,
                                uint8_t *safe_state_active_out);
 
+/**
+ * @brief Pack the local state and start the SPI exchange (non-blocking).
+ * @param[in] local Pointer to local state (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_INVALID_STATE (exchange already
+ *         in flight), ERR_RANGE (state not representable in the wire
+ *         format), or the HAL start error
+ * @note   UNIT-SKN-015; Complexity: 5
+ */
+error_t SKN_ExchangeStart(const cross_channel_state_t *local);
+
+/**
+ * @brief Complete the exchange in flight and compare against the snapshot.
+ * @details Same fault handling as SKN_ExchangeAndCompare. With no exchange
+ *          in flight (start failed) the call counts as an SPI
+ *          infrastructure fault.
+ * @param[out] safe_state_active_out Set to 1 on mismatch or persistent fault
+ * @return error_t as SKN_ExchangeAndCompare
+ * @note   UNIT-SKN-016; Complexity: 3
+ */
+error_t SKN_ExchangeComplete(uint8_t *safe_state_active_out);
+
+/**
+ * @brief Read SPI exchange latency statistics.
+ * @param[out] latency_out Destination
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-SKN-017; Complexity: 2
+ */
+error_t SKN_GetSpiLatency(skn_spi_latency_t *latency_out);
+
+/**
+ * @brief Last remote state that passed the CRC check, unpacked.
+ * @param[out] remote_out Destination
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_INVALID_STATE (none since init)
+ * @note   UNIT-SKN-020; Complexity: 3
+ */
+error_t SKN_GetRemoteState(cross_channel_state_t *remote_out);
+
+/**
+ * @brief Pack a cross-channel state into the SPI wire format and compute
+ *        the wire CRC (layout: tdc_types.h, cross_channel_wire_t).
+ * @param[in]  state Unpacked state (must not be NULL)
+ * @param[out] wire  Packed state (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE (door state >
+ *         DOOR_STATE_FAULT or lock/obstacle flag > 1; wire still written)
+ * @note   UNIT-SKN-018; Complexity: 7
+ */
+error_t SKN_EncodeWireState(const cross_channel_state_t *state,
+                            cross_channel_wire_t *wire);
+
+/**
+ * @brief Unpack a wire-format state; crc16 is recomputed over the unpacked
+ *        fields as by SKN_BuildLocalState. The wire CRC is not checked.
+ * @param[in]  wire  Packed state (must not be NULL)
+ * @param[out] state Unpacked state (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-SKN-019; Complexity: 4
+ */
+error_t SKN_DecodeWireState(const cross_channel_wire_t *wire,
+                            cross_channel_state_t *state);
+
 /**
  * @brief Evaluate safe-state triggers (sticky flag).
  * @param[in]  channel_disagree    1 if cross-channel mismatch detected
@@ -131,7 +387,7 @@ error_t SKN_EvaluateSafeState(uint8_t channel_disagree,
  * @param[in]  safe_state_active Safe state flag
  * @param[out] interlock_ok_out 1 if all doors locked, 0 otherwise
  * @return error_t SUCCESS, ERR_NULL_PTR
- * @note   UNIT-SKN-005; Complexity: 7
+ * @note   UNIT-SKN-005; Complexity: 6
  */
 error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
                                        const uint8_t lock_states[MAX_DOORS],
@@ -139,6 +395,21 @@ error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
                                        uint8_t safe_state_active,
                                        uint8_t *interlock_ok_out);
 
+/**
+ * @brief Evaluate departure interlock from a door mask (word-parallel form
+ *        of SKN_EvaluateDepartureInterlock, used by the 20 ms cycle).
+ * @param[in]  locked_mask      Doors CLOSED_AND_LOCKED (bit n = door n)
+ * @param[in]  channel_disagree Cross-channel disagreement flag
+ * @param[in]  safe_state_active Safe state flag
+ * @param[out] interlock_ok_out 1 if all MAX_DOORS doors locked, 0 otherwise
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-SKN-021; Complexity: 4
+ */
+error_t SKN_EvaluateDepartureInterlockMask(door_mask_t locked_mask,
+                                           uint8_t channel_disagree,
+                                           uint8_t safe_state_active,
+                                           uint8_t *interlock_ok_out);
+
 /**
  * @brief Check ROM and safety-critical RAM CRC-16 integrity.
  * @param[out] crc_ok_out 1 if both CRC checks pass, 0 otherwise
@@ -147,6 +418,17 @@ error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
  */
 error_t SKN_CheckMemoryIntegrity(uint8_t *crc_ok_out);
 
+/**
+ * @brief Scrub one bounded chunk of ROM and of the safety RAM region.
+ * @details Called every cycle. A full pass over each region completes
+ *          within SKN_SCRUB_PERIOD_CYCLES cycles (default 5 = 100 ms); the
+ *          CRC is compared at the end of each pass. A mismatch is sticky.
+ * @param[out] crc_ok_out 1 while no pass has mismatched, 0 otherwise
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_CRC
+ * @note   UNIT-SKN-010; Complexity: 4
+ */
+error_t SKN_ScrubStep(uint8_t *crc_ok_out);
+
 /**
  * @brief Check stack canary values at top and bottom of stack.
  * @param[out] canary_ok_out 1 if canary intact, 0 if corrupted
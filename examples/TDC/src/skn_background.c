@@ -0,0 +1,267 @@
+/**
+ * @file    skn_background.c
+ * @brief   SKN Background Executor — slack-time, budgeted execution of
+ *          resumable jobs at the end of SKN_RunCycle.
+ * @details Implements UNIT-SKN-014 (Background_Run, GetBackgroundStats)
+ *          and SKN_Background_Init.
+ *          After the scheduled steps, SKN_RunCycle calls SKN_Background_Run.
+ *          The jobs (SKN_BG_JOB_*: log flush, extra ROM/RAM scrub,
+ *          diagnostic port) are fixed and dispatched by switch/case (no
+ *          function pointers in safety paths, SCDS §12). They are called
+ *          round-robin, one bounded chunk per call, until every job reports
+ *          that it is done or the next chunk would push the cycle past
+ *          SKN_BG_BUDGET_PERCENT of CYCLE_MS. Background throughput
+ *          therefore grows with the slack left by the foreground steps.
+ *
+ *          Deadline protection: each job has a chunk-time estimate, and a
+ *          chunk only starts if the elapsed cycle time plus that estimate
+ *          still fits the budget. A longer chunk raises the estimate at
+ *          once; every cycle it decays by 1/2^SKN_BG_EST_DECAY_SHIFT, so a
+ *          chunk stretched by an interrupt burst or a Flash erase bars the
+ *          job only for a few cycles. The remaining
+ *          (100 - SKN_BG_BUDGET_PERCENT) % of the cycle is margin for a
+ *          chunk longer than its estimate. SKN_BG_MAX_CHUNKS bounds the
+ *          loop independently of the timer. Cycles in which a job got no
+ *          chunk are counted; SKN_BG_STARVE_CYCLES of them in a row log
+ *          EVT_BG_STARVED.
+ *
+ *          Guaranteed minimum rates stay in the static schedule
+ *          (skn_schedule.c); background work only adds to them.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  SKN (Safety Kernel) — MOD-SKN-008
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-SAFE-015, REQ-PERF-002
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Rule 21.3: static storage only
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §3.3
+ */
+
+/* Implements: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-014 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 (MOD-SKN-008) */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "skn.h"
+#include "dgn.h"
+#include "dsm.h"
+#include "hal.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+#if (SKN_BG_BUDGET_PERCENT < 1U) || (SKN_BG_BUDGET_PERCENT > 95U)
+#error "SKN_BG_BUDGET_PERCENT must be 1..95 (keep a deadline margin)"
+#endif
+
+#if (SKN_BG_JOB_COUNT > 8U)
+#error "SKN_BG_JOB_COUNT must fit the uint8_t pending mask"
+#endif
+
+/** @brief All jobs pending */
+#define SKN_BG_ALL_JOBS  ((uint8_t)((1U << SKN_BG_JOB_COUNT) - 1U))
+
+/** @brief Latest elapsed time at which a background chunk may end */
+#define SKN_BG_LIMIT_TICKS \
+    (((uint32_t)CYCLE_MS * (uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000UL) / 100U) * \
+     (uint32_t)SKN_BG_BUDGET_PERCENT)
+
+/*============================================================================
+ * STATIC VARIABLES
+ *===========================================================================*/
+/** @brief Chunk-time estimates, skip counters (returned by
+ *         SKN_GetBackgroundStats) */
+static skn_bg_stats_t s_bg_stats;
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
+
+/**
+ * @brief Run one chunk of background job @p job.
+ * @return 1 if the job has more work, 0 if done
+ * @complexity Cyclomatic complexity: 5
+ */
+static uint8_t skn_bg_run_job(uint8_t job)
+{
+    uint8_t more;
+
+    switch (job)
+    {
+        case SKN_BG_JOB_LOG_FLUSH:
+            (void)DGN_FlushToFlash();
+            more = (DGN_GetFlushPending() > 0U) ? 1U : 0U;
+            break;
+
+        case SKN_BG_JOB_SCRUB:
+            more = SKN_Scrub_BackgroundStep();
+            break;
+
+        case SKN_BG_JOB_DIAG_PORT:
+            (void)DGN_ServiceDiagPort(DSM_GetMode());   /* Once per cycle */
+            more = 0U;
+            break;
+
+        default:
+            more = 0U;   /* Not a job */
+            break;
+    }
+
+    return more;
+}
+
+/**
+ * @brief Run one chunk of a job and raise its chunk-time estimate if the
+ *        chunk took longer.
+ * @return 1 if the job has more work, 0 if done
+ * @complexity Cyclomatic complexity: 2
+ */
+static uint8_t skn_bg_run_chunk(uint8_t job)
+{
+    uint32_t start = SKN_Timing_GetElapsedTicks();
+    uint8_t  more  = skn_bg_run_job(job);
+    uint32_t cost  = SKN_Timing_GetElapsedTicks() - start;
+
+    if (cost > s_bg_stats.est_chunk_ticks[job])
+    {
+        s_bg_stats.est_chunk_ticks[job] = cost;
+    }
+
+    return more;
+}
+
+/**
+ * @brief Once per cycle: decay the chunk-time estimates and count the jobs
+ *        that got no chunk; log a job reaching SKN_BG_STARVE_CYCLES.
+ * @param[in] ran Bit n set: job n ran at least one chunk this cycle
+ * @complexity Cyclomatic complexity: 5
+ */
+static void skn_bg_end_cycle(uint8_t ran)
+{
+    uint8_t job;
+
+    for (job = 0U; job < SKN_BG_JOB_COUNT; job++)
+    {
+        s_bg_stats.est_chunk_ticks[job] -=
+            s_bg_stats.est_chunk_ticks[job] >> SKN_BG_EST_DECAY_SHIFT;
+
+        if (0U != (ran & (uint8_t)(1U << job)))
+        {
+            s_bg_stats.starved_cycles[job] = 0U;
+        }
+        else
+        {
+            s_bg_stats.skipped_cycles[job]++;
+            if (s_bg_stats.starved_cycles[job] < 0xFFFFU)
+            {
+                s_bg_stats.starved_cycles[job]++;
+            }
+            if (SKN_BG_STARVE_CYCLES == s_bg_stats.starved_cycles[job])
+            {
+                LOG_EVENT(COMP_SKN, COMP_SKN, EVT_BG_STARVED, job);
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Forget chunk-time estimates and skip counters.
+ * @details Called from SKN_Init.
+ * @complexity Cyclomatic complexity: 2
+ */
+void SKN_Background_Init(void)
+{
+    /* Implements: part of UNIT-SKN-009, called from skn_init.c */
+    uint8_t job;
+
+    for (job = 0U; job < SKN_BG_JOB_COUNT; job++)
+    {
+        s_bg_stats.skipped_cycles[job]  = 0U;
+        s_bg_stats.starved_cycles[job]  = 0U;
+        s_bg_stats.est_chunk_ticks[job] = 0U;
+    }
+}
+
+/**
+ * @brief Run background jobs within the remaining cycle budget.
+ * @complexity Cyclomatic complexity: 6 — within SIL 3 limit of 10
+ */
+uint8_t SKN_Background_Run(void)
+{
+    /* Implements: REQ-PERF-002, UNIT-SKN-014 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 */
+    uint8_t pending = SKN_BG_ALL_JOBS;  /* Bit n set: job n may still run */
+    uint8_t ran     = 0U;               /* Bit n set: job n ran a chunk */
+    uint8_t chunks  = 0U;
+    uint8_t job     = 0U;
+    uint8_t bit;
+
+    while ((0U != pending) && (chunks < SKN_BG_MAX_CHUNKS))
+    {
+        bit = (uint8_t)(1U << job);
+
+        if (0U != (pending & bit))
+        {
+            if ((SKN_Timing_GetElapsedTicks() +
+                 s_bg_stats.est_chunk_ticks[job]) > SKN_BG_LIMIT_TICKS)
+            {
+                pending &= (uint8_t)~bit;   /* No room for this job's chunk */
+            }
+            else
+            {
+                if (0U == skn_bg_run_chunk(job))
+                {
+                    pending &= (uint8_t)~bit;   /* Job done for this cycle */
+                }
+                ran |= bit;
+                chunks++;
+            }
+        }
+
+        job = (uint8_t)((job + 1U) % SKN_BG_JOB_COUNT);
+    }
+
+    skn_bg_end_cycle(ran);
+
+    return chunks;
+}
+
+/**
+ * @brief Read the background executor statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t SKN_GetBackgroundStats(skn_bg_stats_t *stats_out)
+{
+    /* Implements: UNIT-SKN-014 */
+    error_t result;
+
+    if (NULL == stats_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *stats_out = s_bg_stats;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
@@ -2,10 +2,21 @@
  * @file    skn_comparator.c
  * @brief   SKN Cross-Channel Comparator — SPI exchange and field comparison.
  * @details Implements UNIT-SKN-001 (BuildLocalState), UNIT-SKN-002
- *          (ExchangeAndCompare), and UNIT-SKN-003 (FieldsDisagree).
+ *          (ExchangeAndCompare), UNIT-SKN-003 (FieldsDisagree), UNIT-SKN-015
+ *          (ExchangeStart), UNIT-SKN-016 (ExchangeComplete), UNIT-SKN-017
+ *          (GetSpiLatency) and UNIT-SKN-020 (GetRemoteState).
+ *          The channels exchange the packed wire format (skn_wire.c); the
+ *          CRC check and the comparison work on the packed payload words.
  *          OI-FMEA-001 SPI transient filter: 3 consecutive infrastructure
  *          faults required before asserting safe state. CRC failure or
  *          field disagreement → immediate safe state.
+ *          The exchange is split in two so the SPI DMA transfer overlaps
+ *          other cycle work: ExchangeStart snapshots the local state and
+ *          starts the transfer, ExchangeComplete collects the peer state
+ *          and compares it against that snapshot. SKN_RunCycle completes
+ *          the exchange later in the same cycle or, with SKN_SPI_PIPELINE,
+ *          in the next cycle. ExchangeComplete records how much of the
+ *          transfer time was hidden behind other work (SKN_GetSpiLatency).
  *
  * @project TDC (Train Door Control System)
  * @module  SKN (Safety Kernel) — MOD-SKN-001
@@ -51,27 +62,61 @@
 /*============================================================================
  * STATIC VARIABLES
  *===========================================================================*/
-/** @brief Buffer for the remote channel state received over SPI */
-static cross_channel_state_t s_remote_state;
+/** @brief Buffer for the remote channel state received over SPI (packed) */
+static cross_channel_wire_t s_remote_state;
 
 /** @brief SPI infrastructure fault consecutive counter (OI-FMEA-001) */
 static uint8_t s_spi_infra_fault_count;
 
 /** @brief Last known-good remote state (used during transient filter) */
-static cross_channel_state_t s_last_good_remote;
+static cross_channel_wire_t s_last_good_remote;
+
+/** @brief 1 once a remote state passed the CRC check */
+static uint8_t s_last_good_valid;
+
+/** @brief Packed local state sent by the exchange in flight (compared on
+ *         completion) */
+static cross_channel_wire_t s_xchg_local;
+
+/** @brief 1 while an exchange started by SKN_ExchangeStart is in flight */
+static uint8_t s_xchg_in_flight;
+
+/** @brief SPI latency statistics */
+static skn_spi_latency_t s_spi_latency;
 
 /*============================================================================
  * STATIC FUNCTION PROTOTYPES
  *===========================================================================*/
 /**
- * @brief Compare all safety-critical fields between two cross-channel states.
+ * @brief Compare all safety-critical fields between two packed states.
  * @param[in] a Pointer to first state
  * @param[in] b Pointer to second state
  * @return uint8_t 1 if any field disagrees, 0 if all agree
- * @note UNIT-SKN-003; Complexity: 8
+ * @note UNIT-SKN-003; Complexity: 3
+ */
+static uint8_t SKN_FieldsDisagree(const cross_channel_wire_t *a,
+                                   const cross_channel_wire_t *b);
+
+/**
+ * @brief Apply the OI-FMEA-001 filter, CRC check and field comparison to the
+ *        result of an exchange.
+ * @param[in]  local       Local state that was sent
+ * @param[in]  spi_result  HAL result of the exchange
+ * @param[out] safe_state_active_out 1 if safe state must be asserted
+ * @return error_t as SKN_ExchangeAndCompare
+ * @note Part of UNIT-SKN-002; Complexity: 6
+ */
+static error_t skn_evaluate_exchange(const cross_channel_wire_t *local,
+                                     error_t spi_result,
+                                     uint8_t *safe_state_active_out);
+
+/**
+ * @brief Update SPI latency statistics after a completed exchange.
+ * @param[in] spi_result    Result of HAL_SPI_CrossChannel_Complete
+ * @param[in] blocked_ticks Time spent waiting in HAL_SPI_CrossChannel_Complete
+ * @note Part of UNIT-SKN-016; Complexity: 4
  */
-static uint8_t SKN_FieldsDisagree(const cross_channel_state_t *a,
-                                   const cross_channel_state_t *b);
+static void skn_spi_latency_update(error_t spi_result, uint32_t blocked_ticks);
 
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS
@@ -122,8 +167,9 @@ error_t SKN_BuildLocalState(cross_channel_state_t *state,
 
 /**
  * @brief Exchange cross-channel state via SPI and compare safety fields.
- * @details Implements OI-FMEA-001 transient filter (3-consecutive rule).
- * @complexity Cyclomatic complexity: 7 — within SIL 3 limit of 10
+ * @details Blocking form: SKN_ExchangeStart then SKN_ExchangeComplete.
+ *          Implements OI-FMEA-001 transient filter (3-consecutive rule).
+ * @complexity Cyclomatic complexity: 3 — within SIL 3 limit of 10
  */
 error_t SKN_ExchangeAndCompare(const cross_channel_state_t *local,
                                uint8_t *safe_state_active_out)
@@ -131,8 +177,6 @@ error_t SKN_ExchangeAndCompare(const cross_channel_state_t *local,
     /* Implements: REQ-SAFE-002/008, OI-FMEA-001, SW-HAZ-011, UNIT-SKN-002 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.2 */
     error_t result;
-    error_t spi_result;
-    uint16_t computed_crc;
 
     if ((NULL == local) || (NULL == safe_state_active_out))
     {
@@ -140,133 +184,299 @@ error_t SKN_ExchangeAndCompare(const cross_channel_state_t *local,
     }
     else
     {
-        /* Step 1: SPI exchange */
-        spi_result = HAL_SPI_CrossChannel_Exchange(local, &s_remote_state);
+        /* A start failure leaves nothing in flight; ExchangeComplete then
+         * applies the infrastructure-fault filter */
+        (void)SKN_ExchangeStart(local);
+        result = SKN_ExchangeComplete(safe_state_active_out);
+    }
 
-        if (spi_result != SUCCESS)
-        {
-            /* SPI infrastructure fault: CRC error, timeout, or HW error */
-            if (s_spi_infra_fault_count < SKN_SPI_FAULT_THRESHOLD)
-            {
-                s_spi_infra_fault_count++;
-            }
+    return result;
+}
 
-            if (s_spi_infra_fault_count >= SKN_SPI_FAULT_THRESHOLD)
-            {
-                /* 3 consecutive faults → assert safe state */
-                *safe_state_active_out = 1U;
-                LOG_EVENT(DGN, COMP_SKN, EVT_SPI_INFRA_PERSISTENT,
-                          (uint16_t)s_spi_infra_fault_count);
-                result = ERR_COMM_TIMEOUT;
-            }
-            else
-            {
-                /* Transient: use last known-good, do NOT assert safe state */
-                s_remote_state = s_last_good_remote;
-                *safe_state_active_out = 0U;
-                LOG_EVENT(DGN, COMP_SKN, EVT_SPI_INFRA_TRANSIENT,
-                          (uint16_t)s_spi_infra_fault_count);
-                result = ERR_CRC;
-            }
+/**
+ * @brief Pack the local state and start the SPI exchange.
+ * @complexity Cyclomatic complexity: 5 — within SIL 3 limit of 10
+ */
+error_t SKN_ExchangeStart(const cross_channel_state_t *local)
+{
+    /* Implements: REQ-SAFE-002, SW-HAZ-011, UNIT-SKN-015 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.2 */
+    error_t result;
+
+    if (NULL == local)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (0U != s_xchg_in_flight)
+    {
+        result = ERR_INVALID_STATE;  /* Previous exchange not completed */
+    }
+    else
+    {
+        result = SKN_EncodeWireState(local, &s_xchg_local);
+        if (SUCCESS == result)
+        {
+            result = HAL_SPI_CrossChannel_Start(&s_xchg_local);
         }
-        else
+        if (SUCCESS == result)
         {
-            /* Step 2: Validate remote CRC-16 over safety-data payload */
-            computed_crc = CRC16_CCITT_Compute((const uint8_t *)&s_remote_state,
-                                               SKN_CRC_DATA_LEN);
+            s_xchg_in_flight = 1U;
+        }
+    }
 
-            if (computed_crc != s_remote_state.crc16)
-            {
-                /* CRC failure on safety data → immediate safe state */
-                s_spi_infra_fault_count = 0U;
-                *safe_state_active_out  = 1U;
-                LOG_EVENT(DGN, COMP_SKN, EVT_SPI_CRC_FAIL, 0U);
-                result = ERR_CRC;
-            }
-            else
-            {
-                /* Step 3: CRC OK — reset counter and compare fields */
-                s_spi_infra_fault_count = 0U;
-                s_last_good_remote      = s_remote_state;
-
-                if (1U == SKN_FieldsDisagree(local, &s_remote_state))
-                {
-                    /* Safety-data disagreement → immediate safe state */
-                    *safe_state_active_out = 1U;
-                    LOG_EVENT(DGN, COMP_SKN, EVT_CHANNEL_DISAGREE, 0U);
-                    result = ERR_SENSOR_DISAGREE;
-                }
-                else
-                {
-                    *safe_state_active_out = 0U;
-                    result = SUCCESS;
-                }
-            }
+    return result;
+}
+
+/**
+ * @brief Collect the peer state of the exchange in flight and compare it.
+ * @complexity Cyclomatic complexity: 3 — within SIL 3 limit of 10
+ */
+error_t SKN_ExchangeComplete(uint8_t *safe_state_active_out)
+{
+    /* Implements: REQ-SAFE-002/008, OI-FMEA-001, SW-HAZ-011, UNIT-SKN-016 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.2 */
+    error_t  result;
+    error_t  spi_result = ERR_INVALID_STATE;  /* Nothing in flight */
+    uint32_t wait_start;
+
+    if (NULL == safe_state_active_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        if (0U != s_xchg_in_flight)
+        {
+            wait_start = HAL_GetCycleCounter();
+            spi_result = HAL_SPI_CrossChannel_Complete(&s_remote_state);
+            skn_spi_latency_update(spi_result,
+                                   HAL_GetCycleCounter() - wait_start);
+            s_xchg_in_flight = 0U;
         }
+
+        result = skn_evaluate_exchange(&s_xchg_local, spi_result,
+                                       safe_state_active_out);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read SPI exchange latency statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t SKN_GetSpiLatency(skn_spi_latency_t *latency_out)
+{
+    /* Implements: REQ-PERF-002, UNIT-SKN-017 */
+    error_t result;
+
+    if (NULL == latency_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *latency_out = s_spi_latency;
+        result = SUCCESS;
     }
 
     return result;
 }
 
+/**
+ * @brief Decode the last remote state that passed the CRC check.
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t SKN_GetRemoteState(cross_channel_state_t *remote_out)
+{
+    /* Implements: REQ-SAFE-002, UNIT-SKN-020 */
+    error_t result;
+
+    if (NULL == remote_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else if (0U == s_last_good_valid)
+    {
+        result = ERR_INVALID_STATE;  /* No valid exchange since init */
+    }
+    else
+    {
+        result = SKN_DecodeWireState(&s_last_good_remote, remote_out);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Abandon any exchange in flight, restart the OI-FMEA-001 filter,
+ *        forget the last good remote state and clear latency statistics.
+ * @details Called from SKN_Init.
+ * @complexity Cyclomatic complexity: 2
+ */
+void SKN_Comparator_Init(void)
+{
+    /* Implements: part of UNIT-SKN-009, called from skn_init.c */
+    cross_channel_wire_t discard;
+
+    if (0U != s_xchg_in_flight)
+    {
+        (void)HAL_SPI_CrossChannel_Complete(&discard);
+        s_xchg_in_flight = 0U;
+    }
+    s_spi_infra_fault_count            = 0U;
+    s_last_good_valid                  = 0U;
+    s_spi_latency.exchange_count       = 0U;
+    s_spi_latency.failed_count         = 0U;
+    s_spi_latency.last_transfer_ticks  = 0U;
+    s_spi_latency.last_blocked_ticks   = 0U;
+    s_spi_latency.max_blocked_ticks    = 0U;
+    s_spi_latency.total_transfer_ticks = 0U;
+    s_spi_latency.total_hidden_ticks   = 0U;
+}
+
 /*============================================================================
  * STATIC FUNCTION IMPLEMENTATIONS
  *===========================================================================*/
 
 /**
- * @brief Compare all safety-critical fields between two cross-channel states.
- * @complexity Cyclomatic complexity: 8 — within SIL 3 limit of 10
+ * @brief Evaluate the result of an exchange (OI-FMEA-001, CRC, fields).
+ * @complexity Cyclomatic complexity: 6 — within SIL 3 limit of 10
  */
-static uint8_t SKN_FieldsDisagree(const cross_channel_state_t *a,
-                                   const cross_channel_state_t *b)
+static error_t skn_evaluate_exchange(const cross_channel_wire_t *local,
+                                     error_t spi_result,
+                                     uint8_t *safe_state_active_out)
 {
-    /* Implements: UNIT-SKN-003 */
-    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.3 */
-    uint8_t disagree;
-    uint8_t door_idx;
-
-    disagree = 0U;
+    /* Implements: REQ-SAFE-002/008, OI-FMEA-001, SW-HAZ-011, UNIT-SKN-002 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.2 */
+    error_t  result;
+    uint16_t computed_crc;
 
-    if (a->speed_kmh_x10 != b->speed_kmh_x10)
+    if (spi_result != SUCCESS)
     {
-        disagree = 1U;
+        /* SPI infrastructure fault: CRC error, timeout, or HW error */
+        if (s_spi_infra_fault_count < SKN_SPI_FAULT_THRESHOLD)
+        {
+            s_spi_infra_fault_count++;
+        }
+
+        if (s_spi_infra_fault_count >= SKN_SPI_FAULT_THRESHOLD)
+        {
+            /* 3 consecutive faults → assert safe state */
+            *safe_state_active_out = 1U;
+            LOG_EVENT(DGN, COMP_SKN, EVT_SPI_INFRA_PERSISTENT,
+                      (uint16_t)s_spi_infra_fault_count);
+            result = ERR_COMM_TIMEOUT;
+        }
+        else
+        {
+            /* Transient: use last known-good, do NOT assert safe state */
+            s_remote_state = s_last_good_remote;
+            *safe_state_active_out = 0U;
+            LOG_EVENT(DGN, COMP_SKN, EVT_SPI_INFRA_TRANSIENT,
+                      (uint16_t)s_spi_infra_fault_count);
+            result = ERR_CRC;
+        }
     }
     else
     {
-        for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
+        /* Validate remote CRC-16 over the packed safety-data payload */
+        computed_crc = CRC16_CCITT_Compute(
+                           (const uint8_t *)s_remote_state.words,
+                           (uint16_t)CCS_WIRE_PAYLOAD_BYTES);
+
+        if (computed_crc != s_remote_state.crc16)
         {
-            if (a->door_states[door_idx] != b->door_states[door_idx])
-            {
-                disagree = 1U;
-            }
-            else if (a->lock_states[door_idx] != b->lock_states[door_idx])
-            {
-                disagree = 1U;
-            }
-            else if (a->obstacle_flags[door_idx] != b->obstacle_flags[door_idx])
+            /* CRC failure on safety data → immediate safe state */
+            s_spi_infra_fault_count = 0U;
+            *safe_state_active_out  = 1U;
+            LOG_EVENT(DGN, COMP_SKN, EVT_SPI_CRC_FAIL, 0U);
+            result = ERR_CRC;
+        }
+        else
+        {
+            /* CRC OK — reset counter and compare fields */
+            s_spi_infra_fault_count = 0U;
+            s_last_good_remote      = s_remote_state;
+            s_last_good_valid       = 1U;
+
+            if (1U == SKN_FieldsDisagree(local, &s_remote_state))
             {
-                disagree = 1U;
+                /* Safety-data disagreement → immediate safe state */
+                *safe_state_active_out = 1U;
+                LOG_EVENT(DGN, COMP_SKN, EVT_CHANNEL_DISAGREE, 0U);
+                result = ERR_SENSOR_DISAGREE;
             }
             else
             {
-                /* No action — MISRA Rule 15.7: else clause required */
+                *safe_state_active_out = 0U;
+                result = SUCCESS;
             }
         }
+    }
 
-        if (a->fault_flags != b->fault_flags)
-        {
-            disagree = 1U;
-        }
-        else if (a->safety_decisions != b->safety_decisions)
-        {
-            disagree = 1U;
-        }
-        else
+    return result;
+}
+
+/**
+ * @brief Update SPI latency statistics.
+ * @details hidden = transfer time − time blocked waiting for it, i.e. the
+ *          part of the transfer that overlapped other cycle work. The
+ *          transfer time is only defined for a transfer that completed: a
+ *          failed exchange (timeout) counts its wait and is counted in
+ *          failed_count, but adds nothing to the transfer and hidden totals.
+ * @complexity Cyclomatic complexity: 4
+ */
+static void skn_spi_latency_update(error_t spi_result, uint32_t blocked_ticks)
+{
+    uint32_t transfer;
+    uint32_t hidden = 0U;
+
+    s_spi_latency.exchange_count++;
+    s_spi_latency.last_blocked_ticks = blocked_ticks;
+    if (blocked_ticks > s_spi_latency.max_blocked_ticks)
+    {
+        s_spi_latency.max_blocked_ticks = blocked_ticks;
+    }
+
+    if (SUCCESS == spi_result)
+    {
+        transfer = HAL_SPI_CrossChannel_GetTransferTicks();
+        if (transfer > blocked_ticks)
         {
-            /* No action */
+            hidden = transfer - blocked_ticks;
         }
+        s_spi_latency.last_transfer_ticks   = transfer;
+        s_spi_latency.total_transfer_ticks += transfer;
+        s_spi_latency.total_hidden_ticks   += hidden;
+    }
+    else
+    {
+        s_spi_latency.failed_count++;
+    }
+}
+
+/**
+ * @brief Compare all safety-critical fields between two packed states.
+ * @details Every field is part of the packed payload, so the states agree
+ *          iff all payload words are equal: OR of the word-wise XOR.
+ *          No early exit — the run time does not depend on the data.
+ * @complexity Cyclomatic complexity: 3 — within SIL 3 limit of 10
+ */
+static uint8_t SKN_FieldsDisagree(const cross_channel_wire_t *a,
+                                   const cross_channel_wire_t *b)
+{
+    /* Implements: UNIT-SKN-003 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1.3 */
+    uint32_t diff = 0U;
+    uint32_t i;
+
+    for (i = 0U; i < CCS_WIRE_WORDS; i++)
+    {
+        diff |= a->words[i] ^ b->words[i];
     }
 
-    return disagree;
+    return (0U != diff) ? 1U : 0U;
 }
 
 /*============================================================================
@@ -53,7 +53,7 @@ error_t SKN_Init(void)
 {
     /* Implements: REQ-SAFE-009/015, UNIT-SKN-009 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §3.4.1 */
-    uint16_t rom_len;
+    uint32_t rom_len;
 
     /* Initialise safe-state sub-module (clears flags, takes RAM CRC snapshot,
      * places stack canary values) */
@@ -62,8 +62,23 @@ error_t SKN_Init(void)
     /* Compute ROM CRC-16 snapshot for integrity checking.
      * Use uintptr_t arithmetic (not pointer subtraction) to avoid MISRA
      * Rule 18.2 / cppcheck comparePointers on extern linker symbols. */
-    rom_len = (uint16_t)((uintptr_t)&__rom_end__ - (uintptr_t)&__rom_start__);
-    __rom_expected_crc__ = CRC16_CCITT_Compute(&__rom_start__, rom_len);
+    rom_len = (uint32_t)((uintptr_t)&__rom_end__ - (uintptr_t)&__rom_start__);
+    __rom_expected_crc__ = CRC16_CCITT_Final(
+                               CRC16_CCITT_Update(CRC16_CCITT_Init(),
+                                                  &__rom_start__, rom_len));
+
+    /* Restart the amortised ROM/RAM scrubber against the new references */
+    SKN_Scrub_Init();
+
+    /* Reset deadline/slack statistics */
+    SKN_Timing_Init();
+
+    /* Forget learned background chunk times */
+    SKN_Background_Init();
+
+    /* Abandon any cross-channel exchange in flight, restart the SPI fault
+     * filter and clear SPI statistics */
+    SKN_Comparator_Init();
 
     return SUCCESS;
 }
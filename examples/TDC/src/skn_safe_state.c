@@ -2,7 +2,8 @@
  * @file    skn_safe_state.c
  * @brief   SKN Safe State Manager — safe-state evaluation and departure interlock.
  * @details Implements UNIT-SKN-004 (EvaluateSafeState), UNIT-SKN-005
- *          (EvaluateDepartureInterlock), UNIT-SKN-006 (CheckMemoryIntegrity),
+ *          (EvaluateDepartureInterlock), UNIT-SKN-021
+ *          (EvaluateDepartureInterlockMask), UNIT-SKN-006 (CheckMemoryIntegrity),
  *          UNIT-SKN-007 (CheckStackCanary), and SKN_GetDepartureInterlock accessor.
  *
  * @project TDC (Train Door Control System)
@@ -57,6 +58,15 @@ extern uint32_t __stack_top_canary__;
 /** @brief Bottom-of-stack canary location (linker symbol) */
 extern uint32_t __stack_bottom_canary__;
 
+/*============================================================================
+ * GLOBAL SHARED STATE — Owned here, externs in skn_scrub.c
+ *===========================================================================*/
+/** @brief CRC-16 snapshot of safety-critical global variables (taken at init) */
+uint16_t g_skn_safety_globals_crc_snapshot;
+
+/** @brief Safety globals region for CRC snapshot (stub for unit testing) */
+uint8_t  g_skn_safety_globals_region[SAFETY_GLOBALS_LEN];
+
 /*============================================================================
  * STATIC VARIABLES
  *===========================================================================*/
@@ -66,12 +76,6 @@ static uint8_t s_safe_state_active;
 /** @brief Departure interlock flag — 1 if all doors CLOSED_AND_LOCKED */
 static uint8_t s_departure_interlock_ok;
 
-/** @brief CRC-16 snapshot of safety-critical global variables (taken at init) */
-static uint16_t s_safety_globals_crc_snapshot;
-
-/** @brief Safety globals region for CRC snapshot (stub for unit testing) */
-static uint8_t s_safety_globals_region[SAFETY_GLOBALS_LEN];
-
 /*============================================================================
  * PUBLIC FUNCTION IMPLEMENTATIONS
  *===========================================================================*/
@@ -129,7 +133,10 @@ error_t SKN_EvaluateSafeState(uint8_t channel_disagree,
 
 /**
  * @brief Evaluate departure interlock (all doors CLOSED_AND_LOCKED).
- * @complexity Cyclomatic complexity: 7 — within SIL 3 limit of 10
+ * @details Array form: collects the doors that are CLOSED_AND_LOCKED with
+ *          their lock flag set into a mask and applies
+ *          SKN_EvaluateDepartureInterlockMask.
+ * @complexity Cyclomatic complexity: 6 — within SIL 3 limit of 10
  */
 error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
                                        const uint8_t lock_states[MAX_DOORS],
@@ -139,9 +146,9 @@ error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
 {
     /* Implements: REQ-SAFE-007, SW-HAZ-003, UNIT-SKN-005 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §3.2.2 */
-    error_t result;
-    uint8_t all_locked;
-    uint8_t door_idx;
+    error_t     result;
+    door_mask_t locked_mask = 0U;
+    uint8_t     door_idx;
 
     if ((NULL == door_states) || (NULL == lock_states) || (NULL == interlock_ok_out))
     {
@@ -151,32 +158,57 @@ error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
         }
         result = ERR_NULL_PTR;
     }
-    else if ((1U == safe_state_active) || (1U == channel_disagree))
-    {
-        *interlock_ok_out = 0U;
-        s_departure_interlock_ok = 0U;
-        result = SUCCESS;
-    }
     else
     {
-        all_locked = 1U;
-
         for (door_idx = 0U; door_idx < MAX_DOORS; door_idx++)
         {
-            if ((uint8_t)DOOR_STATE_CLOSED_AND_LOCKED != door_states[door_idx])
-            {
-                all_locked = 0U;
-            }
-            else if (0U == lock_states[door_idx])
+            if (((uint8_t)DOOR_STATE_CLOSED_AND_LOCKED == door_states[door_idx]) &&
+                (0U != lock_states[door_idx]))
             {
-                all_locked = 0U;
-            }
-            else
-            {
-                /* Door locked — continue checking remaining doors */
+                locked_mask |= DOOR_BIT(door_idx);
             }
         }
 
+        result = SKN_EvaluateDepartureInterlockMask(locked_mask,
+                                                    channel_disagree,
+                                                    safe_state_active,
+                                                    interlock_ok_out);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Evaluate departure interlock from the mask of locked doors.
+ * @details One word comparison against DOOR_MASK_ALL, whatever MAX_DOORS.
+ * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ */
+error_t SKN_EvaluateDepartureInterlockMask(door_mask_t locked_mask,
+                                           uint8_t channel_disagree,
+                                           uint8_t safe_state_active,
+                                           uint8_t *interlock_ok_out)
+{
+    /* Implements: REQ-SAFE-007, SW-HAZ-003, UNIT-SKN-021 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.2.2 */
+    error_t result;
+    uint8_t all_locked;
+
+    if (NULL == interlock_ok_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        if ((1U == safe_state_active) || (1U == channel_disagree))
+        {
+            all_locked = 0U;
+        }
+        else
+        {
+            all_locked = ((locked_mask & DOOR_MASK_ALL) == DOOR_MASK_ALL) ?
+                         1U : 0U;
+        }
+
         *interlock_ok_out        = all_locked;
         s_departure_interlock_ok = all_locked;
         result = SUCCESS;
@@ -186,7 +218,10 @@ error_t SKN_EvaluateDepartureInterlock(const uint8_t door_states[MAX_DOORS],
 }
 
 /**
- * @brief Check ROM and safety-critical RAM CRC-16 integrity.
+ * @brief Check ROM and safety-critical RAM CRC-16 integrity (full pass).
+ * @details One-shot check over the whole ROM image. The 20 ms cycle uses the
+ *          amortised scrubber (SKN_ScrubStep, skn_scrub.c) instead; this
+ *          function remains for start-up and on-demand checks.
  * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
  */
 error_t SKN_CheckMemoryIntegrity(uint8_t *crc_ok_out)
@@ -196,7 +231,7 @@ error_t SKN_CheckMemoryIntegrity(uint8_t *crc_ok_out)
     error_t  result;
     uint16_t rom_crc;
     uint16_t ram_crc;
-    uint16_t rom_len;
+    uint32_t rom_len;
 
     if (NULL == crc_ok_out)
     {
@@ -207,8 +242,10 @@ error_t SKN_CheckMemoryIntegrity(uint8_t *crc_ok_out)
         /* ROM CRC check — use uintptr_t arithmetic (not pointer subtraction)
          * to avoid MISRA Rule 18.2 / cppcheck comparePointers on extern
          * linker symbols __rom_start__ / __rom_end__. */
-        rom_len = (uint16_t)((uintptr_t)&__rom_end__ - (uintptr_t)&__rom_start__);
-        rom_crc = CRC16_CCITT_Compute(&__rom_start__, rom_len);
+        rom_len = (uint32_t)((uintptr_t)&__rom_end__ - (uintptr_t)&__rom_start__);
+        rom_crc = CRC16_CCITT_Final(
+                      CRC16_CCITT_Update(CRC16_CCITT_Init(), &__rom_start__,
+                                         rom_len));
 
         if (rom_crc != __rom_expected_crc__)
         {
@@ -218,10 +255,10 @@ error_t SKN_CheckMemoryIntegrity(uint8_t *crc_ok_out)
         else
         {
             /* Safety-critical RAM CRC check */
-            ram_crc = CRC16_CCITT_Compute(s_safety_globals_region,
+            ram_crc = CRC16_CCITT_Compute(g_skn_safety_globals_region,
                                           SAFETY_GLOBALS_LEN);
 
-            if (ram_crc != s_safety_globals_crc_snapshot)
+            if (ram_crc != g_skn_safety_globals_crc_snapshot)
             {
                 *crc_ok_out = 0U;
                 result = ERR_CRC;
@@ -291,10 +328,10 @@ void SKN_SafeState_Init(void)
     /* Initialise safety globals region and take CRC snapshot */
     for (byte_idx = 0U; byte_idx < SAFETY_GLOBALS_LEN; byte_idx++)
     {
-        s_safety_globals_region[byte_idx] = 0U;
+        g_skn_safety_globals_region[byte_idx] = 0U;
     }
-    s_safety_globals_crc_snapshot = CRC16_CCITT_Compute(s_safety_globals_region,
-                                                         SAFETY_GLOBALS_LEN);
+    g_skn_safety_globals_crc_snapshot =
+        CRC16_CCITT_Compute(g_skn_safety_globals_region, SAFETY_GLOBALS_LEN);
 
     /* Place stack canary values */
     __stack_top_canary__    = (uint32_t)CANARY_VALUE;
@@ -0,0 +1,145 @@
+/**
+ * @file    skn_schedule.c
+ * @brief   SKN Static Schedule — time-triggered step table for SKN_RunCycle.
+ * @details Implements UNIT-SKN-013 (IsStepDue).
+ *          One const entry per SKN_STEP_* gives the step period and phase in
+ *          minor cycles (CYCLE_MS). A step runs in minor cycle m of the
+ *          major cycle when (m % period) == phase.
+ *          This table is the single source of every rate in the cycle:
+ *          TCI status transmission (100 ms) and the DGN Flash flush (200 ms)
+ *          used to be timed by private counters in tci_init.c and dgn_port.c
+ *          and coincided every 200 ms. Their phases now place them in
+ *          different minor cycles. The memory scrub is already amortised
+ *          over every cycle (skn_scrub.c) and stays at period 1.
+ *          Period/phase consistency and the separation of the heavy
+ *          periodic steps are checked at build time.
+ *
+ *          Minor-cycle map (major cycle = 10 x 20 ms):
+ *            minor:     0  1  2  3  4  5  6  7  8  9
+ *            TCI Tx        x              x
+ *            DGN flush           x
+ *
+ * @project TDC (Train Door Control System)
+ * @module  SKN (Safety Kernel) — MOD-SKN-007
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-SAFE-015, REQ-PERF-002
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Rule 8.9: table kept at file scope (single const object, no state)
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §3.3
+ */
+
+/* Implements: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-013 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 (MOD-SKN-007) */
+
+#include <stdint.h>
+
+#include "skn.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+/** @brief TCI periodic status transmission: every 5 minor cycles (100 ms) */
+#define SKN_TCI_TX_PERIOD     (5U)
+#define SKN_TCI_TX_PHASE      (1U)
+
+/** @brief DGN Flash flush: every 10 minor cycles (200 ms) */
+#define SKN_DGN_PERIOD        (10U)
+#define SKN_DGN_PHASE         (3U)
+
+/*============================================================================
+ * BUILD-TIME SCHEDULE CHECKS
+ *===========================================================================*/
+#if ((SKN_MAJOR_CYCLE_MINORS % SKN_TCI_TX_PERIOD) != 0U) || \
+    (SKN_TCI_TX_PHASE >= SKN_TCI_TX_PERIOD)
+#error "TCI transmit period must divide the major cycle, phase < period"
+#endif
+
+#if ((SKN_MAJOR_CYCLE_MINORS % SKN_DGN_PERIOD) != 0U) || \
+    (SKN_DGN_PHASE >= SKN_DGN_PERIOD)
+#error "DGN flush period must divide the major cycle, phase < period"
+#endif
+
+/* Harmonic periods (the shorter divides the longer): two steps share a
+ * minor cycle exactly when their phases agree modulo the shorter period. */
+#if ((SKN_DGN_PERIOD % SKN_TCI_TX_PERIOD) != 0U)
+#error "TCI transmit and DGN flush periods must be harmonic"
+#endif
+
+#if ((SKN_DGN_PHASE % SKN_TCI_TX_PERIOD) == SKN_TCI_TX_PHASE)
+#error "TCI transmit and DGN flush must not share a minor cycle"
+#endif
+
+#if (SKN_MAJOR_CYCLE_MINORS > 255U)
+#error "Minor cycle index must fit uint8_t"
+#endif
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *===========================================================================*/
+/** @brief Timing of one scheduler step */
+typedef struct
+{
+    uint8_t period;   /**< Minor cycles between runs (divides major cycle) */
+    uint8_t phase;    /**< First minor cycle of the major cycle (< period) */
+} skn_sched_entry_t;
+
+/*============================================================================
+ * STATIC SCHEDULE TABLE (indexed by SKN_STEP_*)
+ *===========================================================================*/
+static const skn_sched_entry_t s_skn_schedule[SKN_STEP_COUNT] =
+{
+    { 1U,                0U                },  /* SKN_STEP_CAPTURE_INPUTS */
+    { 1U,                0U                },  /* SKN_STEP_BUILD_STATE    */
+    { 1U,                0U                },  /* SKN_STEP_EXCHANGE       */
+    { 1U,                0U                },  /* SKN_STEP_CANARY         */
+    { 1U,                0U                },  /* SKN_STEP_SCRUB          */
+    { 1U,                0U                },  /* SKN_STEP_COMPARE        */
+    { 1U,                0U                },  /* SKN_STEP_SAFE_STATE     */
+    { 1U,                0U                },  /* SKN_STEP_TCI_RX         */
+    { 1U,                0U                },  /* SKN_STEP_SPM            */
+    { 1U,                0U                },  /* SKN_STEP_OBD            */
+    { 1U,                0U                },  /* SKN_STEP_DSM            */
+    { 1U,                0U                },  /* SKN_STEP_INTERLOCK      */
+    { 1U,                0U                },  /* SKN_STEP_COMMIT_OUTPUTS */
+    { 1U,                0U                },  /* SKN_STEP_FMG            */
+    { SKN_TCI_TX_PERIOD, SKN_TCI_TX_PHASE  },  /* SKN_STEP_TCI_TX         */
+    { 1U,                0U                },  /* SKN_STEP_WATCHDOG       */
+    { SKN_DGN_PERIOD,    SKN_DGN_PHASE     }   /* SKN_STEP_DGN            */
+};
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Check whether a step is due in the given minor cycle.
+ * @complexity Cyclomatic complexity: 3
+ */
+uint8_t SKN_IsStepDue(uint8_t step, uint8_t minor_cycle)
+{
+    /* Implements: REQ-SAFE-015, UNIT-SKN-013 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 */
+    uint8_t due = 0U;
+
+    if ((step < SKN_STEP_COUNT) &&
+        ((minor_cycle % s_skn_schedule[step].period) ==
+         s_skn_schedule[step].phase))
+    {
+        due = 1U;
+    }
+
+    return due;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
@@ -2,10 +2,13 @@
  * @file    skn_scheduler.c
  * @brief   SKN Scheduler — top-level 20 ms cycle dispatcher.
  * @details Implements UNIT-SKN-008 (RunCycle) — orchestrates all TDC
- *          components in deterministic order every 20 ms.
+ *          components in deterministic order every 20 ms. Each step is a
+ *          static function dispatched by switch/case on its SKN_STEP_*
+ *          number; which steps run in a given minor cycle is decided by the
+ *          static schedule table (skn_schedule.c).
  *          Global safety flags are defined here (architecture rule: writable
  *          only by SKN for g_safe_state_active; SPM writes g_speed_interlock_active;
- *          OBD writes g_obstacle_flags).
+ *          OBD writes g_obstacle_flags and g_obstacle_mask).
  *
  * @project TDC (Train Door Control System)
  * @module  SKN (Safety Kernel) — MOD-SKN-003
@@ -50,13 +53,32 @@ uint8_t g_safe_state_active = 1U;  /* Default: fail-safe ON at startup */
 uint8_t g_speed_interlock_active = 1U;  /* Default: inhibit at startup */
 
 /** @brief Global obstacle flags per door. Written by OBD. Read by DSM. */
-uint8_t g_obstacle_flags[MAX_DOORS] = {0U, 0U, 0U, 0U};
+uint8_t g_obstacle_flags[MAX_DOORS] = {0U};
+
+/** @brief Mask form of g_obstacle_flags. Written by OBD. Read by DSM. */
+door_mask_t g_obstacle_mask = 0U;
+
+#if (DGN_PROFILE_ENABLE != 0) && (SKN_STEP_COUNT > DGN_PROFILE_MAX_STEPS)
+#error "DGN_PROFILE_MAX_STEPS must cover every SKN_RunCycle step"
+#endif
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *===========================================================================*/
+/** @brief Per-cycle data passed between scheduler steps */
+typedef struct
+{
+    cross_channel_state_t local_state;       /**< Step 2 output */
+    uint8_t               channel_disagree;  /**< Step 6 output (3: pipelined) */
+    uint8_t               canary_ok;         /**< Step 4 output */
+    uint8_t               mem_ok;            /**< Step 5 output */
+} skn_cycle_ctx_t;
 
 /*============================================================================
  * STATIC VARIABLES
  *===========================================================================*/
-/** @brief Cycle counter for periodic tasks (e.g. memory check every 100 ms) */
-static uint32_t s_cycle_count;
+/** @brief Minor cycle index within the major cycle (0..SKN_MAJOR_CYCLE_MINORS-1) */
+static uint8_t s_minor_cycle;
 
 /** @brief Departure interlock result from last evaluation */
 static uint8_t s_departure_interlock_ok;
@@ -68,51 +90,36 @@ static uint8_t s_departure_interlock_ok;
 extern void SKN_SafeState_Init(void);
 
 /*============================================================================
- * PUBLIC FUNCTION IMPLEMENTATIONS
+ * SCHEDULER STEPS (one per SKN_STEP_*, timing in skn_schedule.c)
  *===========================================================================*/
 
 /**
- * @brief Top-level 20 ms cycle dispatcher.
- * @details Step order:
- *   1. Build local cross-channel state
- *   2. Exchange with peer DCU via SPI
- *   3. Check stack canary
- *   4. Every 5 cycles (100 ms): check memory integrity
- *   5. Evaluate safe-state triggers
- *   6. Evaluate departure interlock
- *   7. Process TCI Rx frames
- *   8. Run SPM cycle (speed + interlock)
- *   9. Run OBD cycle (obstacle detection)
- *   10. Run DSM cycle (door FSM)
- *   11. Run FMG cycle (fault aggregation)
- *   12. Transmit TCI periodic frames
- *   13. Refresh watchdog
- *   14. Run DGN cycle (log flush)
- *   15. Increment cycle counter
- * @complexity Cyclomatic complexity: 3 — within SIL 3 limit of 10
+ * @brief Step 1: sample all door inputs once — OBD and DSM read this image.
+ *        On failure the image is fail-safe (obstacles set, doors unlocked).
+ * @complexity Cyclomatic complexity: 1
  */
-void SKN_RunCycle(void)
+static void skn_step_capture_inputs(void)
 {
-    /* Implements: REQ-SAFE-015, UNIT-SKN-008 */
-    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.3.1 */
-    cross_channel_state_t local_state;
-    uint8_t channel_disagree;
-    uint8_t canary_ok;
-    uint8_t mem_ok;
     error_t err;
-    uint8_t safety_decisions;
 
-    /* Default: memory OK unless checked this cycle */
-    mem_ok          = 1U;
-    channel_disagree = 0U;
-    canary_ok        = 1U;
+    err = HAL_GPIO_CaptureInputImage();
+    (void)err;  /* HAL fault reported via HAL_GetFault */
+}
+
+/**
+ * @brief Step 2: build local cross-channel state.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_build_state(skn_cycle_ctx_t *ctx)
+{
+    error_t err;
+    uint8_t safety_decisions;
 
     /* Safety decisions bitmask for cross-channel state */
     safety_decisions = (uint8_t)(g_safe_state_active |
                                  ((uint8_t)(s_departure_interlock_ok << 1U)));
 
-    /* Step 1: Build local state */
-    err = SKN_BuildLocalState(&local_state,
+    err = SKN_BuildLocalState(&ctx->local_state,
                               SPM_GetSpeed(),
                               DSM_GetDoorStates(),
                               DSM_GetLockStates(),
@@ -123,71 +130,418 @@ void SKN_RunCycle(void)
     {
         g_safe_state_active = 1U;  /* Fail-safe if build fails */
     }
+}
 
-    /* Step 2: Exchange and compare */
-    err = SKN_ExchangeAndCompare(&local_state, &channel_disagree);
-    if ((err != SUCCESS) && (err != ERR_CRC))
-    {
-        /* ERR_CRC with channel_disagree=0 is transient — do not force safe state here;
-         * SKN_EvaluateSafeState will handle the sticky logic. */
-    }
+/**
+ * @brief Step 3: start the cross-channel SPI exchange (non-blocking).
+ * @details The DMA transfer runs while the canary and scrub steps execute.
+ *          With SKN_SPI_PIPELINE the previous cycle's exchange is completed
+ *          and compared first, so the transfer spans a whole cycle.
+ *          A start failure is reported by the next ExchangeComplete as an
+ *          SPI infrastructure fault.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_exchange(skn_cycle_ctx_t *ctx)
+{
+    error_t err;
 
-    /* Step 3: Stack canary check (every cycle) */
-    err = SKN_CheckStackCanary(&canary_ok);
-    if (err != SUCCESS)
+#if (SKN_SPI_PIPELINE != 0U)
+    err = SKN_ExchangeComplete(&ctx->channel_disagree);  /* Cycle N-1 data */
+    (void)err;
+#endif
+    err = SKN_ExchangeStart(&ctx->local_state);
+    (void)err;
+}
+
+/**
+ * @brief Step 4: stack canary check.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_canary(skn_cycle_ctx_t *ctx)
+{
+    if (SKN_CheckStackCanary(&ctx->canary_ok) != SUCCESS)
     {
-        canary_ok = 0U;
+        ctx->canary_ok = 0U;
     }
+}
 
-    /* Step 4: Memory integrity check every 5 cycles (100 ms) */
-    if ((s_cycle_count % 5U) == 0U)
+/**
+ * @brief Step 5: amortised memory integrity scrub (bounded chunk per cycle,
+ *        full ROM/RAM pass every SKN_SCRUB_PERIOD_CYCLES).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_scrub(skn_cycle_ctx_t *ctx)
+{
+    if (SKN_ScrubStep(&ctx->mem_ok) != SUCCESS)
     {
-        err = SKN_CheckMemoryIntegrity(&mem_ok);
-        if (err != SUCCESS)
-        {
-            mem_ok = 0U;
-        }
+        ctx->mem_ok = 0U;
     }
+}
+
+/**
+ * @brief Step 6: complete the exchange and compare with the peer DCU.
+ * @details ERR_CRC with channel_disagree=0 is transient — not forced to safe
+ *          state here; SKN_EvaluateSafeState handles the sticky logic.
+ *          No-op with SKN_SPI_PIPELINE (completed by the next exchange step).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_compare(skn_cycle_ctx_t *ctx)
+{
+#if (SKN_SPI_PIPELINE == 0U)
+    error_t err;
+
+    err = SKN_ExchangeComplete(&ctx->channel_disagree);
+    (void)err;
+#else
+    (void)ctx;
+#endif
+}
 
-    /* Step 5: Evaluate safe-state triggers (sticky flag) */
-    err = SKN_EvaluateSafeState(channel_disagree,
+/**
+ * @brief Step 7: evaluate safe-state triggers (sticky flag).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_safe_state(skn_cycle_ctx_t *ctx)
+{
+    error_t err;
+
+    err = SKN_EvaluateSafeState(ctx->channel_disagree,
                                 FMG_GetFaultState(),
-                                mem_ok,
-                                canary_ok,
+                                ctx->mem_ok,
+                                ctx->canary_ok,
                                 &g_safe_state_active);
     if (err != SUCCESS)
     {
         g_safe_state_active = 1U;  /* Fail-safe */
     }
+}
 
-    /* Step 6: Evaluate departure interlock */
-    err = SKN_EvaluateDepartureInterlock(DSM_GetDoorStates(),
-                                         DSM_GetLockStates(),
-                                         channel_disagree,
-                                         g_safe_state_active,
-                                         &s_departure_interlock_ok);
-    if (err != SUCCESS)
-    {
-        s_departure_interlock_ok = 0U;  /* Fail-closed */
-    }
+/**
+ * @brief Step 8: process TCI Rx frames.
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_tci_rx(void)
+{
+    error_t err;
 
-    /* Steps 7–14: Component cycles in deterministic order */
     err = TCI_ProcessReceivedFrames();
     (void)err;  /* TCI Rx errors are logged internally */
+}
 
+/**
+ * @brief Step 9: run SPM cycle (speed + interlock).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_spm(void)
+{
     SPM_RunCycle();
+}
+
+/**
+ * @brief Step 10: run OBD cycle (obstacle detection).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_obd(void)
+{
     OBD_RunCycle();
+}
+
+/**
+ * @brief Step 11: run DSM cycle (door FSM — stages actuator outputs).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_dsm(void)
+{
     DSM_RunCycle();
+}
+
+/**
+ * @brief Step 12: evaluate the departure interlock from this cycle's door
+ *        states and send it to TCMS at once if it changed (the 100 ms
+ *        heartbeat in step 15 is unchanged).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_step_interlock(skn_cycle_ctx_t *ctx)
+{
+    error_t err;
+
+    err = SKN_EvaluateDepartureInterlockMask(DSM_GetLockedMask(),
+                                             ctx->channel_disagree,
+                                             g_safe_state_active,
+                                             &s_departure_interlock_ok);
+    if (err != SUCCESS)
+    {
+        s_departure_interlock_ok = 0U;  /* Fail-closed */
+    }
+
+    err = TCI_TransmitInterlockOnChange(s_departure_interlock_ok,
+                                        DSM_GetLockConfirmCount(),
+                                        DSM_GetLockConfirmMs());
+    (void)err;  /* TCI fault flag set internally; retried next cycle */
+}
+
+/**
+ * @brief Step 13: all doors' motor/PWM/lock outputs reach the hardware here,
+ *        once per cycle; unchanged outputs are not rewritten.
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_commit_outputs(void)
+{
+    error_t err;
+
+    err = HAL_CommitOutputImage();
+    (void)err;  /* HAL fault reported via HAL_GetFault */
+}
+
+/**
+ * @brief Step 14: run FMG cycle (fault aggregation).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_fmg(void)
+{
     FMG_RunCycle();
+}
+
+/**
+ * @brief Step 15: transmit TCI periodic status frames (100 ms slots).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_tci_tx(void)
+{
     TCI_TransmitCycle();
+}
+
+/**
+ * @brief Step 16: refresh watchdog.
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_watchdog(void)
+{
+    error_t err;
 
     err = HAL_Watchdog_Refresh();
     (void)err;  /* Watchdog failure logged via fault flag */
+}
 
+/**
+ * @brief Step 17: DGN log flush to Flash (200 ms slot).
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_step_dgn(void)
+{
     DGN_RunCycle();
+}
+
+/*============================================================================
+ * STEP DISPATCH (switch/case; no function pointers in safety paths, SCDS §12)
+ *===========================================================================*/
+
+/**
+ * @brief Run one safety kernel step (capture inputs .. safe-state
+ *        evaluation).
+ * @complexity Cyclomatic complexity: 8
+ */
+static void skn_run_kernel_step(uint8_t step, skn_cycle_ctx_t *ctx)
+{
+    switch (step)
+    {
+        case SKN_STEP_CAPTURE_INPUTS:
+            skn_step_capture_inputs();
+            break;
+
+        case SKN_STEP_BUILD_STATE:
+            skn_step_build_state(ctx);
+            break;
+
+        case SKN_STEP_EXCHANGE:
+            skn_step_exchange(ctx);
+            break;
+
+        case SKN_STEP_CANARY:
+            skn_step_canary(ctx);
+            break;
+
+        case SKN_STEP_SCRUB:
+            skn_step_scrub(ctx);
+            break;
+
+        case SKN_STEP_COMPARE:
+            skn_step_compare(ctx);
+            break;
+
+        case SKN_STEP_SAFE_STATE:
+            skn_step_safe_state(ctx);
+            break;
+
+        default:
+            /* Not a kernel step */
+            break;
+    }
+}
+
+/**
+ * @brief Run one component step (TCI Rx .. output commit).
+ * @complexity Cyclomatic complexity: 7
+ */
+static void skn_run_component_step(uint8_t step, skn_cycle_ctx_t *ctx)
+{
+    switch (step)
+    {
+        case SKN_STEP_TCI_RX:
+            skn_step_tci_rx();
+            break;
+
+        case SKN_STEP_SPM:
+            skn_step_spm();
+            break;
+
+        case SKN_STEP_OBD:
+            skn_step_obd();
+            break;
+
+        case SKN_STEP_DSM:
+            skn_step_dsm();
+            break;
+
+        case SKN_STEP_INTERLOCK:
+            skn_step_interlock(ctx);
+            break;
+
+        case SKN_STEP_COMMIT_OUTPUTS:
+            skn_step_commit_outputs();
+            break;
+
+        default:
+            /* Not a component step */
+            break;
+    }
+}
+
+/**
+ * @brief Run one housekeeping step (FMG .. DGN).
+ * @complexity Cyclomatic complexity: 5
+ */
+static void skn_run_housekeeping_step(uint8_t step)
+{
+    switch (step)
+    {
+        case SKN_STEP_FMG:
+            skn_step_fmg();
+            break;
+
+        case SKN_STEP_TCI_TX:
+            skn_step_tci_tx();
+            break;
+
+        case SKN_STEP_WATCHDOG:
+            skn_step_watchdog();
+            break;
+
+        case SKN_STEP_DGN:
+            skn_step_dgn();
+            break;
+
+        default:
+            /* Not a housekeeping step */
+            break;
+    }
+}
+
+/**
+ * @brief Run scheduler step @p step (SKN_STEP_*); split in three switches
+ *        to keep each within the complexity limit.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void skn_run_step(uint8_t step, skn_cycle_ctx_t *ctx)
+{
+    if (step < SKN_STEP_TCI_RX)
+    {
+        skn_run_kernel_step(step, ctx);
+    }
+    else if (step < SKN_STEP_FMG)
+    {
+        skn_run_component_step(step, ctx);
+    }
+    else
+    {
+        skn_run_housekeeping_step(step);
+    }
+}
 
-    /* Step 15: Increment cycle counter (wraps at UINT32_MAX — acceptable) */
-    s_cycle_count++;
+/*============================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ *===========================================================================*/
+
+/**
+ * @brief Top-level 20 ms cycle dispatcher.
+ * @details Step order (SKN_STEP_*; period in minor cycles per skn_schedule.c):
+ *   1. Capture input process image (all door inputs, one HAL call)
+ *   2. Build local cross-channel state
+ *   3. Exchange with peer DCU via SPI
+ *   4. Check stack canary
+ *   5. Scrub one chunk of ROM/RAM (full pass every 100 ms)
+ *   6. Complete the SPI exchange and compare (deferred to step 3 of the
+ *      next cycle with SKN_SPI_PIPELINE)
+ *   7. Evaluate safe-state triggers
+ *   8. Process TCI Rx frames
+ *   9. Run SPM cycle (speed + interlock)
+ *   10. Run OBD cycle (obstacle detection)
+ *   11. Run DSM cycle (door FSM — stages actuator outputs)
+ *   12. Evaluate departure interlock on this cycle's door states; a change
+ *       is transmitted to TCMS at once (event-triggered 0x200 frame)
+ *   13. Commit actuator output image (single batched HAL update)
+ *   14. Run FMG cycle (fault aggregation)
+ *   15. Transmit TCI periodic frames (every 5th minor cycle)
+ *   16. Refresh watchdog
+ *   17. Run DGN cycle (log flush, every 10th minor cycle)
+ *   Background: log flush, extra scrub and diagnostic port, run with the
+ *   slack left in the cycle (skn_background.c)
+ *   18. Advance the minor-cycle index (wraps at the major cycle)
+ *   Steps 1–17 and the background stage are bracketed by the deadline
+ *   monitor (skn_timing.c).
+ *   With DGN_PROFILE_ENABLE each executed step is timestamped for the DGN
+ *   cycle profiler; otherwise no code is emitted.
+ * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ */
+void SKN_RunCycle(void)
+{
+    /* Implements: REQ-SAFE-015, UNIT-SKN-008 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.3.1 */
+    skn_cycle_ctx_t ctx;
+    uint8_t         step;
+
+    /* Defaults: channels agree, canary and memory OK unless a step
+     * reports otherwise */
+    ctx.channel_disagree = 0U;
+    ctx.canary_ok        = 1U;
+    ctx.mem_ok           = 1U;
+
+    SKN_Timing_CycleStart();    /* Deadline monitor: cycle start */
+    DGN_PROFILE_CYCLE_START();  /* No code unless DGN_PROFILE_ENABLE */
+
+    /* Steps 1–17: static schedule, deterministic order */
+    for (step = 0U; step < SKN_STEP_COUNT; step++)
+    {
+        if (0U != SKN_IsStepDue(step, s_minor_cycle))
+        {
+            skn_run_step(step, &ctx);
+            DGN_PROFILE_STEP(step);
+        }
+    }
+
+    /* Background: resumable jobs while cycle budget remains */
+    (void)SKN_Background_Run();
+    DGN_PROFILE_CYCLE_END();
+
+    /* Deadline monitor: slack accounting, overrun count + EVT_DEADLINE_OVERRUN */
+    SKN_Timing_CycleEnd();
+
+    /* Step 18: Advance minor cycle */
+    s_minor_cycle++;
+    if (s_minor_cycle >= SKN_MAJOR_CYCLE_MINORS)
+    {
+        s_minor_cycle = 0U;
+    }
 }
 
 /*============================================================================
@@ -0,0 +1,241 @@
+/**
+ * @file    skn_scrub.c
+ * @brief   SKN Memory Scrubber — amortised ROM/RAM CRC-16 integrity check.
+ * @details Implements UNIT-SKN-010 (ScrubStep, BackgroundStep) and
+ *          SKN_Scrub_Init.
+ *          Instead of a full ROM CRC every 100 ms (a cycle-time spike that
+ *          grows with image size), each 20 ms cycle feeds one bounded chunk
+ *          of ROM and one of the safety RAM region into a streaming
+ *          CRC-16-CCITT (CRC16_CCITT_Init/Update/Final). Chunk sizes are
+ *          derived at init so that a complete pass over each region finishes
+ *          within SKN_SCRUB_PERIOD_CYCLES cycles; at the end of each pass the
+ *          accumulated CRC is compared against the reference taken by
+ *          SKN_Init / SKN_SafeState_Init and the next pass starts.
+ *          Per-cycle cost is ceil(region_len / SKN_SCRUB_PERIOD_CYCLES)
+ *          bytes per region — flat from cycle to cycle.
+ *          SKN_Scrub_BackgroundStep advances the same passes by one more
+ *          chunk when the background executor has slack, so a pass can
+ *          finish in fewer than SKN_SCRUB_PERIOD_CYCLES cycles; the
+ *          guaranteed chunk of SKN_ScrubStep is unaffected.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  SKN (Safety Kernel) — MOD-SKN-005
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-SAFE-009, SW-HAZ-008
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - uintptr_t arithmetic on linker symbols (Rule 18.2, as skn_safe_state.c)
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §3.2.3
+ */
+
+/* Implements: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §3.2.3 (MOD-SKN-005) */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "skn.h"
+#include "hal.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+#ifndef SKN_SCRUB_PERIOD_CYCLES
+/** @brief Cycles per full ROM/RAM pass (5 x 20 ms = 100 ms, Hazard Log
+ *         SW-HAZ-008 periodic check interval). Override at build time. */
+#define SKN_SCRUB_PERIOD_CYCLES  (5U)
+#endif
+
+#if (SKN_SCRUB_PERIOD_CYCLES < 1U)
+#error "SKN_SCRUB_PERIOD_CYCLES must be at least 1"
+#endif
+
+/*============================================================================
+ * EXTERNAL SYMBOLS
+ *===========================================================================*/
+/** @brief Start of ROM region for CRC check (linker symbol) */
+extern uint8_t  __rom_start__;
+/** @brief End of ROM region for CRC check (linker symbol) */
+extern uint8_t  __rom_end__;
+/** @brief Expected ROM CRC (initialised by SKN_Init) */
+extern uint16_t __rom_expected_crc__;
+
+/** @brief Safety RAM region and its reference CRC (skn_safe_state.c) */
+extern uint8_t  g_skn_safety_globals_region[SAFETY_GLOBALS_LEN];
+extern uint16_t g_skn_safety_globals_crc_snapshot;
+
+/*============================================================================
+ * TYPE DEFINITIONS
+ *===========================================================================*/
+/** @brief Progress of one scrubbed region */
+typedef struct
+{
+    uint32_t length;    /**< Region length in bytes */
+    uint32_t chunk;     /**< Bytes processed per cycle */
+    uint32_t offset;    /**< Next byte to process in the current pass */
+    uint16_t crc_acc;   /**< Running CRC of the current pass */
+} skn_scrub_region_t;
+
+/*============================================================================
+ * STATIC VARIABLES
+ *===========================================================================*/
+/** @brief ROM scrub progress */
+static skn_scrub_region_t s_scrub_rom;
+
+/** @brief Safety RAM scrub progress */
+static skn_scrub_region_t s_scrub_ram;
+
+/** @brief Integrity verdict — 0 once any pass mismatched (sticky) */
+static uint8_t s_scrub_ok;
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
+
+/**
+ * @brief Reset a region descriptor and size its per-cycle chunk.
+ * @complexity Cyclomatic complexity: 1
+ */
+static void skn_scrub_region_reset(skn_scrub_region_t *region, uint32_t length)
+{
+    region->length  = length;
+    region->chunk   = (length + (SKN_SCRUB_PERIOD_CYCLES - 1U)) /
+                      SKN_SCRUB_PERIOD_CYCLES;
+    region->offset  = 0U;
+    region->crc_acc = CRC16_CCITT_Init();
+}
+
+/**
+ * @brief Feed the next chunk of a region into its running CRC.
+ * @details When the pass completes, compares the result against expected
+ *          and starts the next pass.
+ * @return 1 if a pass completed with a CRC mismatch, 0 otherwise
+ * @complexity Cyclomatic complexity: 4
+ */
+static uint8_t skn_scrub_region_step(skn_scrub_region_t *region,
+                                     const uint8_t *base,
+                                     uint16_t expected)
+{
+    uint32_t remaining = region->length - region->offset;
+    uint32_t len       = region->chunk;
+    uint8_t  mismatch  = 0U;
+
+    if (len > remaining)
+    {
+        len = remaining;
+    }
+
+    region->crc_acc = CRC16_CCITT_Update(region->crc_acc,
+                                         &base[region->offset], len);
+    region->offset += len;
+
+    if (region->offset >= region->length)
+    {
+        if (CRC16_CCITT_Final(region->crc_acc) != expected)
+        {
+            mismatch = 1U;
+        }
+        region->offset  = 0U;
+        region->crc_acc = CRC16_CCITT_Init();
+    }
+
+    return mismatch;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Initialise the scrubber: size chunks, restart both passes.
+ * @details Called from SKN_Init after the ROM/RAM reference CRCs are taken.
+ * @complexity Cyclomatic complexity: 1
+ */
+void SKN_Scrub_Init(void)
+{
+    /* Implements: part of UNIT-SKN-009, called from skn_init.c */
+    /* ROM length via uintptr_t arithmetic (MISRA Rule 18.2) */
+    skn_scrub_region_reset(&s_scrub_rom,
+        (uint32_t)((uintptr_t)&__rom_end__ - (uintptr_t)&__rom_start__));
+    skn_scrub_region_reset(&s_scrub_ram, (uint32_t)SAFETY_GLOBALS_LEN);
+    s_scrub_ok = 1U;
+}
+
+/**
+ * @brief Scrub one chunk of ROM and one chunk of safety RAM.
+ * @complexity Cyclomatic complexity: 4 — within SIL 3 limit of 10
+ */
+error_t SKN_ScrubStep(uint8_t *crc_ok_out)
+{
+    /* Implements: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.2.3 */
+    error_t result;
+    uint8_t rom_bad;
+    uint8_t ram_bad;
+
+    if (NULL == crc_ok_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        rom_bad = skn_scrub_region_step(&s_scrub_rom, &__rom_start__,
+                                        __rom_expected_crc__);
+        ram_bad = skn_scrub_region_step(&s_scrub_ram,
+                                        g_skn_safety_globals_region,
+                                        g_skn_safety_globals_crc_snapshot);
+
+        if ((0U != rom_bad) || (0U != ram_bad))
+        {
+            s_scrub_ok = 0U;  /* Sticky: corruption does not heal */
+        }
+
+        *crc_ok_out = s_scrub_ok;
+        result = (0U != s_scrub_ok) ? SUCCESS : ERR_CRC;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Background job: scrub one extra chunk of ROM and safety RAM.
+ * @details Called by the SKN background executor with spare cycle time.
+ *          A mismatch clears the sticky verdict; it is reported to the safe
+ *          state logic by the next SKN_ScrubStep.
+ * @return 1 while both passes are unfinished, 0 once either completed (at
+ *         most about one extra pass per cycle)
+ * @complexity Cyclomatic complexity: 5
+ */
+uint8_t SKN_Scrub_BackgroundStep(void)
+{
+    /* Implements: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.2.3 */
+    uint8_t rom_bad;
+    uint8_t ram_bad;
+
+    rom_bad = skn_scrub_region_step(&s_scrub_rom, &__rom_start__,
+                                    __rom_expected_crc__);
+    ram_bad = skn_scrub_region_step(&s_scrub_ram,
+                                    g_skn_safety_globals_region,
+                                    g_skn_safety_globals_crc_snapshot);
+
+    if ((0U != rom_bad) || (0U != ram_bad))
+    {
+        s_scrub_ok = 0U;  /* Sticky: corruption does not heal */
+    }
+
+    return ((0U != s_scrub_rom.offset) && (0U != s_scrub_ram.offset)) ?
+           1U : 0U;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
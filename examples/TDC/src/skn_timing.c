@@ -0,0 +1,182 @@
+/**
+ * @file    skn_timing.c
+ * @brief   SKN Cycle Timing Monitor — deadline-miss detection and slack
+ *          accounting for the 20 ms scheduler.
+ * @details Implements UNIT-SKN-011 (CycleStart/CycleEnd/GetElapsedTicks) and
+ *          UNIT-SKN-012 (GetCycleTiming), plus SKN_Timing_Init.
+ *          SKN_RunCycle brackets its work with SKN_Timing_CycleStart and
+ *          SKN_Timing_CycleEnd. Execution time is measured with the HAL
+ *          cycle counter; slack = CYCLE_MS budget - execution time (negative
+ *          on overrun). Per cycle the monitor updates:
+ *          - the slack exponential moving average (alpha = 1/8),
+ *          - the worst (smallest) slack seen since init,
+ *          - the deadline-overrun counter, logging EVT_DEADLINE_OVERRUN with
+ *            the overrun in microseconds (saturated at 0xFFFF).
+ *          The monitor observes only; it does not alter safety decisions.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  SKN (Safety Kernel) — MOD-SKN-006
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-SAFE-015, REQ-PERF-002
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Signed slack uses division, not right shift, for the EMA (Rule 10.1)
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §3.3
+ */
+
+/* Implements: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-011/012 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 (MOD-SKN-006) */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "skn.h"
+#include "hal.h"
+#include "dgn.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+/** @brief Cycle budget in HAL cycle-counter ticks */
+#define SKN_CYCLE_BUDGET_TICKS \
+    ((uint32_t)CYCLE_MS * (uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000UL))
+
+/** @brief Cycle-counter ticks per microsecond (event payload unit) */
+#define SKN_TICKS_PER_US       ((uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000000UL))
+
+/** @brief Largest overrun represented in slack (~2.7 s at 400 MHz) */
+#define SKN_MAX_OVERRUN_TICKS  (0x3FFFFFFFUL)
+
+/** @brief Slack EMA divisor (alpha = 1/8) */
+#define SKN_SLACK_EMA_DIV      (8)
+
+#if ((CYCLE_MS * (HAL_CYCLE_COUNTER_HZ / 1000UL)) > SKN_MAX_OVERRUN_TICKS)
+#error "Cycle budget must fit the signed slack range"
+#endif
+
+/*============================================================================
+ * STATIC VARIABLES
+ *===========================================================================*/
+/** @brief Cycle counter value at the start of the current cycle */
+static uint32_t s_timing_start;
+
+/** @brief Accumulated statistics (returned by SKN_GetCycleTiming) */
+static skn_cycle_timing_t s_timing;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Reset timing statistics.
+ * @details Called from SKN_Init.
+ * @complexity Cyclomatic complexity: 1
+ */
+void SKN_Timing_Init(void)
+{
+    /* Implements: part of UNIT-SKN-009, called from skn_init.c */
+    s_timing.last_exec_ticks   = 0U;
+    s_timing.slack_ema_ticks   = (int32_t)SKN_CYCLE_BUDGET_TICKS;
+    s_timing.worst_slack_ticks = (int32_t)SKN_CYCLE_BUDGET_TICKS;
+    s_timing.overrun_count     = 0U;
+    s_timing.cycle_count       = 0U;
+    s_timing_start             = HAL_GetCycleCounter();
+}
+
+/**
+ * @brief Record the start of a scheduler cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+void SKN_Timing_CycleStart(void)
+{
+    /* Implements: REQ-SAFE-015, UNIT-SKN-011 */
+    s_timing_start = HAL_GetCycleCounter();
+}
+
+/**
+ * @brief Ticks elapsed since the start of the current cycle.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t SKN_Timing_GetElapsedTicks(void)
+{
+    /* Implements: REQ-PERF-002, UNIT-SKN-011 */
+    return HAL_GetCycleCounter() - s_timing_start;
+}
+
+/**
+ * @brief Record the end of a scheduler cycle; update slack and overruns.
+ * @complexity Cyclomatic complexity: 5
+ */
+void SKN_Timing_CycleEnd(void)
+{
+    /* Implements: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-011 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.3 */
+    uint32_t exec_ticks;
+    uint32_t over_ticks;
+    uint32_t over_us;
+    int32_t  slack;
+
+    exec_ticks = HAL_GetCycleCounter() - s_timing_start;
+
+    if (exec_ticks > SKN_CYCLE_BUDGET_TICKS)
+    {
+        over_ticks = exec_ticks - SKN_CYCLE_BUDGET_TICKS;
+        over_us    = over_ticks / SKN_TICKS_PER_US;
+        if (over_ticks > SKN_MAX_OVERRUN_TICKS)
+        {
+            over_ticks = SKN_MAX_OVERRUN_TICKS;  /* Keep EMA arithmetic in range */
+        }
+        slack = -(int32_t)over_ticks;
+        s_timing.overrun_count++;
+        LOG_EVENT(COMP_SKN, COMP_SKN, EVT_DEADLINE_OVERRUN,
+                  (over_us > 0xFFFFU) ? 0xFFFFU : over_us);
+    }
+    else
+    {
+        slack = (int32_t)(SKN_CYCLE_BUDGET_TICKS - exec_ticks);
+    }
+
+    s_timing.last_exec_ticks  = exec_ticks;
+    s_timing.slack_ema_ticks += (slack - s_timing.slack_ema_ticks) /
+                                SKN_SLACK_EMA_DIV;
+
+    if (slack < s_timing.worst_slack_ticks)
+    {
+        s_timing.worst_slack_ticks = slack;
+    }
+    s_timing.cycle_count++;
+}
+
+/**
+ * @brief Read the cycle timing statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t SKN_GetCycleTiming(skn_cycle_timing_t *timing_out)
+{
+    /* Implements: UNIT-SKN-012 */
+    error_t result;
+
+    if (NULL == timing_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *timing_out = s_timing;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
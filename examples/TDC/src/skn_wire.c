@@ -0,0 +1,200 @@
+/**
+ * @file    skn_wire.c
+ * @brief   SKN Cross-Channel Wire Format — packed SPI encoding of
+ *          cross_channel_state_t.
+ * @details Implements UNIT-SKN-018 (EncodeWireState) and UNIT-SKN-019
+ *          (DecodeWireState).
+ *          The unpacked state spends a byte on every door state, lock flag
+ *          and obstacle flag (18 bytes at MAX_DOORS = 4, 3 bytes per added
+ *          door). The wire format (tdc_types.h, cross_channel_wire_t) packs
+ *          door states into 3 bits and the lock/obstacle flags into
+ *          bitmasks, so the SPI DMA transfer is shorter and both channels
+ *          compare their payloads a 32-bit word at a time.
+ *          Encoding rejects values the packed fields cannot represent
+ *          (door state > DOOR_STATE_FAULT, flags other than 0/1) instead of
+ *          truncating them, so decode(encode(s)) == s for every accepted s.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  SKN (Safety Kernel) — MOD-SKN-009
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-SAFE-002, REQ-SAFE-008
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Shifts on uint32_t operands only, shift count < 32 (Rule 12.2)
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §3.1
+ */
+
+/* Implements: REQ-SAFE-002/008, UNIT-SKN-018/019 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §3.1 (MOD-SKN-009) */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "skn.h"
+#include "hal.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * PREPROCESSOR DEFINITIONS
+ *===========================================================================*/
+/** @brief Mask of one packed door state */
+#define SKN_WIRE_DOOR_MASK   ((1UL << CCS_WIRE_DOOR_BITS) - 1UL)
+
+/** @brief Index of the first door-state word */
+#define SKN_WIRE_DOOR_BASE   (CCS_WIRE_HDR_WORDS)
+
+/** @brief Index of the first lock/obstacle mask word */
+#define SKN_WIRE_MASK_BASE   (CCS_WIRE_HDR_WORDS + CCS_WIRE_DOOR_WORDS)
+
+/** @brief Mask bit of the first obstacle flag */
+#define SKN_WIRE_OBS_BIT     (MAX_DOORS)
+
+/** @brief CRC input of the unpacked state: all bytes except crc16 */
+#define SKN_STATE_CRC_LEN \
+    ((uint16_t)(sizeof(cross_channel_state_t) - sizeof(uint16_t)))
+
+#if ((CCS_WIRE_DOOR_BITS * CCS_WIRE_DOORS_PER_WORD) > 32U)
+#error "Packed door states must fit a 32-bit word"
+#endif
+
+/*============================================================================
+ * PRIVATE HELPERS
+ *===========================================================================*/
+
+/**
+ * @brief Set mask bit n in the lock/obstacle mask words if value != 0
+ *        (words are cleared beforehand).
+ * @complexity Cyclomatic complexity: 2
+ */
+static void skn_wire_mask_put(cross_channel_wire_t *wire, uint32_t bit,
+                              uint8_t value)
+{
+    if (0U != value)
+    {
+        wire->words[SKN_WIRE_MASK_BASE + (bit / 32U)] |= (1UL << (bit % 32U));
+    }
+}
+
+/**
+ * @brief Read mask bit n of the lock/obstacle mask words.
+ * @complexity Cyclomatic complexity: 1
+ */
+static uint8_t skn_wire_mask_get(const cross_channel_wire_t *wire,
+                                 uint32_t bit)
+{
+    return (uint8_t)((wire->words[SKN_WIRE_MASK_BASE + (bit / 32U)] >>
+                      (bit % 32U)) & 1UL);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Pack a cross-channel state into the SPI wire format.
+ * @complexity Cyclomatic complexity: 7 — within SIL 3 limit of 10
+ */
+error_t SKN_EncodeWireState(const cross_channel_state_t *state,
+                            cross_channel_wire_t *wire)
+{
+    /* Implements: REQ-SAFE-002/008, UNIT-SKN-018 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1 */
+    error_t  result = SUCCESS;
+    uint32_t i;
+    uint32_t door;
+    uint32_t word;
+
+    if ((NULL == state) || (NULL == wire))
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        for (i = 0U; i < CCS_WIRE_WORDS; i++)
+        {
+            wire->words[i] = 0U;
+        }
+        wire->words[0] = (uint32_t)state->speed_kmh_x10 |
+                         ((uint32_t)state->fault_flags << 16U) |
+                         ((uint32_t)state->safety_decisions << 24U);
+
+        for (door = 0U; door < MAX_DOORS; door++)
+        {
+            if ((state->door_states[door] > (uint8_t)DOOR_STATE_FAULT) ||
+                (state->lock_states[door] > 1U) ||
+                (state->obstacle_flags[door] > 1U))
+            {
+                result = ERR_RANGE;  /* Not representable: do not truncate */
+            }
+            word = SKN_WIRE_DOOR_BASE + (door / CCS_WIRE_DOORS_PER_WORD);
+            wire->words[word] |=
+                ((uint32_t)state->door_states[door] & SKN_WIRE_DOOR_MASK) <<
+                ((door % CCS_WIRE_DOORS_PER_WORD) * CCS_WIRE_DOOR_BITS);
+            skn_wire_mask_put(wire, door, state->lock_states[door]);
+            skn_wire_mask_put(wire, SKN_WIRE_OBS_BIT + door,
+                              state->obstacle_flags[door]);
+        }
+
+        wire->crc16 = CRC16_CCITT_Compute((const uint8_t *)wire->words,
+                                          (uint16_t)CCS_WIRE_PAYLOAD_BYTES);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Unpack a wire-format state.
+ * @details The wire CRC is not checked here (the comparator validates it
+ *          before use). The crc16 of the unpacked state is recomputed as
+ *          SKN_BuildLocalState does.
+ * @complexity Cyclomatic complexity: 4
+ */
+error_t SKN_DecodeWireState(const cross_channel_wire_t *wire,
+                            cross_channel_state_t *state)
+{
+    /* Implements: REQ-SAFE-002/008, UNIT-SKN-019 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §3.1 */
+    error_t  result;
+    uint32_t door;
+    uint32_t word;
+
+    if ((NULL == wire) || (NULL == state))
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        state->speed_kmh_x10    = (uint16_t)(wire->words[0] & 0xFFFFUL);
+        state->fault_flags      = (uint8_t)((wire->words[0] >> 16U) & 0xFFUL);
+        state->safety_decisions = (uint8_t)((wire->words[0] >> 24U) & 0xFFUL);
+
+        for (door = 0U; door < MAX_DOORS; door++)
+        {
+            word = SKN_WIRE_DOOR_BASE + (door / CCS_WIRE_DOORS_PER_WORD);
+            state->door_states[door] = (uint8_t)(
+                (wire->words[word] >>
+                 ((door % CCS_WIRE_DOORS_PER_WORD) * CCS_WIRE_DOOR_BITS)) &
+                SKN_WIRE_DOOR_MASK);
+            state->lock_states[door]    = skn_wire_mask_get(wire, door);
+            state->obstacle_flags[door] =
+                skn_wire_mask_get(wire, SKN_WIRE_OBS_BIT + door);
+        }
+
+        state->crc16 = CRC16_CCITT_Compute((const uint8_t *)state,
+                                           SKN_STATE_CRC_LEN);
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
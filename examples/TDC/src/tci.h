@@ -1,7 +1,7 @@
 /**
  * @file    tci.h
  * @brief   TCMS Interface (TCI) public interface for TDC
- * @details CAN receive mailbox, frame processing with CRC-16 validation,
+ * @details CAN receive FIFO, frame processing with CRC-16 validation,
  *          departure interlock and door status transmit, sequence counter
  *          management, and cycle entry.
  *
@@ -32,7 +32,19 @@
 #define TCI_CAN_RX_MAILBOX_COUNT (5U)
 
 /**
- * @brief CAN receive mailbox entry (one per expected CAN ID).
+ * @brief CAN receive FIFO depth (frames; must be a power of two).
+ * @details Sized for full bus load: CAN 2.0B at 250 kbit/s carries at most
+ *          ~5300 frames/s (47-bit minimum frame incl. IFS), i.e. ~106
+ *          frames per 20 ms cycle if every frame passes the 0x100–0x104
+ *          acceptance filter. 128 entries cover one full cycle of that.
+ */
+#define TCI_CAN_RX_FIFO_DEPTH    (128U)
+
+/** @brief Frames copied out of the FIFO per batch in TCI_ProcessReceivedFrames */
+#define TCI_CAN_RX_DRAIN_BATCH   (8U)
+
+/**
+ * @brief CAN receive frame (FIFO entry).
  */
 typedef struct {
     uint32_t msg_id;              /**< CAN message identifier */
@@ -43,36 +55,180 @@ typedef struct {
 } can_mailbox_t;
 
 /**
- * @brief Initialise TCI module — clear mailboxes, reset sequence counters.
+ * @brief Departure interlock event transmission statistics.
+ * @details Latency runs from the lock confirmation of the last door
+ *          (DSM_GetLockConfirmMs) to the event-triggered 0x200 frame that
+ *          reports the interlock as OK, in system ticks (ms). A 0 -> 1
+ *          change with no lock confirmed since the interlock was last 0
+ *          (e.g. it returns after a channel disagreement clears) has no
+ *          start point and is not sampled.
+ */
+typedef struct {
+    uint32_t event_tx_count;      /**< 0x200 frames sent on an interlock change */
+    uint32_t lock_event_count;    /**< Of which 0 -> 1 (latency measured) */
+    uint32_t last_latency_ms;     /**< Lock confirmation to transmit, last */
+    uint32_t max_latency_ms;      /**< Longest since TCI_Init */
+} tci_interlock_latency_t;
+
+/**
+ * @brief Emergency stop fast-path statistics (HAL cycle-counter ticks).
+ * @details Stop time runs from TCI_CanRxISR entry to the return of
+ *          HAL_EmergencyMotorStop (every PWM channel written to 0).
+ */
+typedef struct {
+    uint32_t isr_stop_count;   /**< 0x104 frames that stopped the motors */
+    uint32_t last_stop_ticks;  /**< ISR entry to motors stopped, last */
+    uint32_t max_stop_ticks;   /**< Longest since TCI_Init */
+} tci_estop_stats_t;
+
+/**
+ * @brief Initialise TCI module — empty Rx FIFO, reset sequence counters.
  * @return error_t SUCCESS
  * @note   UNIT-TCI-007; Complexity: 1
  */
 error_t TCI_Init(void);
 
 /**
- * @brief CAN receive ISR — copy frame from HAL FIFO to static mailbox.
- * @details Minimal ISR: one HAL read, one bounds check, copy. No processing.
- * @note   UNIT-TCI-001; Complexity: 3
+ * @brief CAN receive ISR — append frame from HAL to the Rx FIFO.
+ * @details Minimal ISR: one HAL read, one ID filter, one FIFO push.
+ *          Wait-free. The one exception to "no processing" is the
+ *          emergency stop fast path: a 0x104 frame with DLC >= 1 and a
+ *          non-zero stop code calls
+ *          HAL_EmergencyMotorStop before the push, so the motors stop within
+ *          the ISR instead of after the next cycle's frame processing.
+ *          Stopping is the safe reaction, so no further validation gates
+ *          it. The stop is recorded for TCI_ProcessReceivedFrames to
+ *          reconcile with FMG even if the frame is lost to a full FIFO.
+ * @note   UNIT-TCI-001; Complexity: 7
  */
 void TCI_CanRxISR(void);
 
 /**
- * @brief Process all pending CAN receive mailbox frames (called from cycle).
- * @details Validates CRC-16-CCITT, routes each validated frame to the
- *          appropriate handler by CAN message ID.
+ * @brief Reset the receive-side state (called by TCI_Init): pending
+ *        emergency stop and the fast-path statistics.
+ */
+void TCI_Rx_Init(void);
+
+/**
+ * @brief Get the emergency stop fast-path statistics.
+ * @param[out] stats_out Statistics since TCI_Init
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-TCI-013; Complexity: 2
+ */
+error_t TCI_GetEstopStats(tci_estop_stats_t *stats_out);
+
+/**
+ * @brief Drain the CAN Rx FIFO and process every frame (called from cycle).
+ * @details Copies frames out in batches of TCI_CAN_RX_DRAIN_BATCH, in
+ *          arrival order, validates CRC-16-CCITT and routes each frame to
+ *          the handler for its CAN message ID. At most TCI_CAN_RX_FIFO_DEPTH
+ *          frames are processed per call (bounded execution time).
+ *          New FIFO overflows are logged (EVT_CAN_RX_OVERFLOW) and set the
+ *          TCI fault flag. An emergency stop taken by the ISR fast path
+ *          whose frame was not processed (FIFO overflow) is passed to
+ *          FMG_ProcessEmergencyStop here. An emergency stop frame with
+ *          stop code 0x00 releases the stop (FMG_ReleaseEmergencyStop).
+ *          Finally the HAL motor inhibit is latched while the FMG stop is
+ *          active and released (HAL_ReleaseMotorInhibit) once it is not;
+ *          DSM stops every moving door while the inhibit is held.
  * @return error_t SUCCESS (individual frame CRC errors are logged, not returned)
- * @note   UNIT-TCI-002; Complexity: 8
+ * @note   UNIT-TCI-002; Complexity: 6
  */
 error_t TCI_ProcessReceivedFrames(void);
 
 /**
- * @brief Transmit departure interlock status (CAN ID 0x200) every 100 ms.
+ * @brief Reset the CAN Rx FIFO (called by TCI_Init).
+ */
+void TCI_RxFifo_Init(void);
+
+/**
+ * @brief Append one frame to the CAN Rx FIFO (producer: CAN Rx ISR only).
+ * @param[in] frame Frame to copy into the FIFO
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_RANGE (FIFO full — frame dropped
+ *         and overflow counter incremented)
+ * @note   UNIT-TCI-009; Complexity: 4
+ */
+error_t TCI_RxFifo_Push(const can_mailbox_t *frame);
+
+/**
+ * @brief Remove up to max_frames frames in arrival order (consumer: cycle task only).
+ * @param[out] out        Destination array of at least max_frames entries
+ * @param[in]  max_frames Batch size
+ * @return uint8_t Number of frames copied (0 if empty or out==NULL)
+ * @note   UNIT-TCI-010; Complexity: 4
+ */
+uint8_t TCI_RxFifo_PopBatch(can_mailbox_t *out, uint8_t max_frames);
+
+/**
+ * @brief Number of frames currently queued in the CAN Rx FIFO.
+ * @return uint32_t Fill level (0–TCI_CAN_RX_FIFO_DEPTH)
+ */
+uint32_t TCI_RxFifo_GetCount(void);
+
+/**
+ * @brief Total frames dropped on a full CAN Rx FIFO since TCI_Init.
+ * @return uint32_t Overflow counter
+ */
+uint32_t TCI_RxFifo_GetOverflowCount(void);
+
+/**
+ * @brief Frames dropped on a full CAN Rx FIFO since the previous call
+ *        (consumer: cycle task only).
+ * @return uint32_t Number of newly dropped frames
+ */
+uint32_t TCI_RxFifo_TakeNewOverflows(void);
+
+/**
+ * @brief Highest CAN Rx FIFO fill level observed since TCI_Init.
+ * @return uint32_t High-water mark (frames)
+ */
+uint32_t TCI_RxFifo_GetHighWater(void);
+
+/**
+ * @brief Reset the transmit-side state (called by TCI_Init): last
+ *        interlock value on the bus and the latency statistics.
+ */
+void TCI_Tx_Init(void);
+
+/**
+ * @brief Transmit departure interlock status (CAN ID 0x200) — periodic
+ *        heartbeat every 100 ms, and the event path below.
  * @param[in] interlock_ok 1=all doors locked (departure allowed), 0=not ready
  * @return error_t SUCCESS, ERR_TIMEOUT
- * @note   UNIT-TCI-003; Complexity: 1
+ * @note   UNIT-TCI-003; Complexity: 3
  */
 error_t TCI_TransmitDepartureInterlock(uint8_t interlock_ok);
 
+/**
+ * @brief Transmit the departure interlock (CAN ID 0x200) at once if it
+ *        differs from the value last sent on the bus.
+ * @details Called by SKN every cycle right after the interlock evaluation,
+ *          so a change reaches TCMS in the cycle it is detected instead of
+ *          the next 100 ms heartbeat. A failed transmit sets the TCI fault
+ *          flag and is retried next cycle (the value on the bus is
+ *          unchanged). A 0 -> 1 change records the latency from
+ *          lock_confirm_ms if lock_confirm_count has moved since the
+ *          interlock was last 0 (tci_interlock_latency_t).
+ * @param[in] interlock_ok       Current interlock evaluation (1 = OK)
+ * @param[in] lock_confirm_count Lock confirmations so far
+ *                               (DSM_GetLockConfirmCount)
+ * @param[in] lock_confirm_ms    System tick at the last lock confirmation
+ *                               (DSM_GetLockConfirmMs)
+ * @return error_t SUCCESS (also when unchanged), ERR_TIMEOUT
+ * @note   UNIT-TCI-011; Complexity: 6
+ */
+error_t TCI_TransmitInterlockOnChange(uint8_t interlock_ok,
+                                      uint32_t lock_confirm_count,
+                                      uint32_t lock_confirm_ms);
+
+/**
+ * @brief Get the departure interlock event transmission statistics.
+ * @param[out] latency_out Statistics since TCI_Init
+ * @return error_t SUCCESS, ERR_NULL_PTR
+ * @note   UNIT-TCI-012; Complexity: 2
+ */
+error_t TCI_GetInterlockLatency(tci_interlock_latency_t *latency_out);
+
 /**
  * @brief Transmit door and lock status summary (CAN ID 0x201) every 100 ms.
  * @param[in] door_states Array of door states [MAX_DOORS]
@@ -102,8 +258,10 @@ error_t TCI_TransmitFaultReport(uint8_t fault_code, fault_severity_t severity);
 error_t TCI_ValidateRxSeqDelta(uint8_t msg_id, uint8_t rx_seq);
 
 /**
- * @brief 20 ms cycle entry — transmit periodic status frames every 100 ms.
- * @note   UNIT-TCI-008; Complexity: 2
+ * @brief Periodic entry — process Rx frames and transmit status frames.
+ * @details Called by SKN_RunCycle in its 100 ms TCI transmit slots
+ *          (static schedule, skn_schedule.c).
+ * @note   UNIT-TCI-008; Complexity: 6
  */
 void TCI_TransmitCycle(void);
 
@@ -0,0 +1,234 @@
+/**
+ * @file    tci_fifo.c
+ * @brief   TCI CAN receive FIFO — lock-free single-producer/single-consumer
+ *          ring between TCI_CanRxISR and TCI_ProcessReceivedFrames.
+ * @details Implements UNIT-TCI-009 (RxFifo_Push), UNIT-TCI-010
+ *          (RxFifo_PopBatch), TCI_RxFifo_Init and the FIFO statistics
+ *          accessors.
+ *          The ring replaces the one-slot-per-ID mailbox, which overwrote
+ *          frames when two arrived for the same ID within one 20 ms cycle
+ *          (e.g. an open command followed by a close). Frames are now
+ *          delivered to the cycle task in arrival order.
+ *
+ *          Concurrency model (wait-free, no interrupt masking):
+ *          - head is written only by the producer (CAN Rx ISR);
+ *          - tail is written only by the consumer (20 ms cycle task);
+ *          - indices are free-running uint32_t; the slot index is
+ *            idx & (TCI_CAN_RX_FIFO_DEPTH - 1U), the fill level is
+ *            head - tail (unsigned wrap-around is well defined);
+ *          - the producer fills the slot before publishing head, and the
+ *            consumer copies the slot out before publishing tail, each
+ *            separated by TCI_FIFO_BARRIER().
+ *          A full ring drops the new frame and increments the overflow
+ *          counter (never overwrites unconsumed frames); the cycle task
+ *          reports new overflows to DGN/FMG.
+ *
+ * @project TDC (Train Door Control System)
+ * @module  TCI (TCMS Interface) — MOD-TCI-005
+ * @date    2026-04-04
+ * @version 1.0
+ *
+ * @safety  SIL Level: 3
+ * Safety Requirements: REQ-INT-007, REQ-SAFE-003/016
+ *
+ * @misra_compliance
+ * MISRA C:2012 Compliance: All mandatory rules compliant
+ * - Dir 4.3: compiler barrier intrinsic encapsulated in TCI_FIFO_BARRIER()
+ * - Rule 21.3: static storage only
+ *
+ * @en50128_references
+ * - EN 50128:2011 Section 7.4, Table A.4
+ * - SCDS DOC-COMPDES-2026-001 §8.1
+ */
+
+/* Implements: REQ-INT-007, REQ-SAFE-003/016 */
+/* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 (MOD-TCI-005) */
+/* SIL: 3 */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "tci.h"
+#include "tdc_types.h"
+
+/*============================================================================
+ * MODULE CONSTANTS
+ *===========================================================================*/
+/** @brief Slot index mask (depth is a power of two) */
+#define TCI_FIFO_INDEX_MASK  (TCI_CAN_RX_FIFO_DEPTH - 1U)
+
+#if ((TCI_CAN_RX_FIFO_DEPTH & TCI_FIFO_INDEX_MASK) != 0U) || \
+    (TCI_CAN_RX_FIFO_DEPTH < 2U)
+#error "TCI_CAN_RX_FIFO_DEPTH must be a power of two >= 2"
+#endif
+
+/**
+ * @brief Memory barrier between slot access and index publication.
+ * @note  On the single-core target this orders ISR and task accesses; the
+ *        full barrier (DMB on Cortex-M) also covers multi-core hosts. Other
+ *        toolchains must supply their barrier intrinsic: the FIFO is not
+ *        correct without it, so the build stops rather than omit it.
+ */
+#if defined(__GNUC__)
+#define TCI_FIFO_BARRIER()  __sync_synchronize()
+#else
+#error "TCI: provide the target toolchain's memory barrier (DMB)"
+#endif
+
+/*============================================================================
+ * MODULE-LEVEL STATIC STATE
+ *===========================================================================*/
+/** @brief Ring storage */
+static can_mailbox_t s_fifo_slot[TCI_CAN_RX_FIFO_DEPTH];
+
+/** @brief Next slot to write — written by producer (ISR) only */
+static volatile uint32_t s_fifo_head;
+
+/** @brief Next slot to read — written by consumer (cycle task) only */
+static volatile uint32_t s_fifo_tail;
+
+/** @brief Frames dropped because the ring was full — producer only */
+static volatile uint32_t s_fifo_overflow_count;
+
+/** @brief Highest fill level observed by the producer — producer only */
+static volatile uint32_t s_fifo_high_water;
+
+/** @brief Overflow count already reported — consumer only */
+static uint32_t s_fifo_overflow_reported;
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *===========================================================================*/
+
+/**
+ * @brief Reset the FIFO (empty, counters cleared).
+ * @details Called from TCI_Init with the CAN Rx interrupt not yet enabled.
+ * @complexity Cyclomatic complexity: 1
+ */
+void TCI_RxFifo_Init(void)
+{
+    s_fifo_head              = 0U;
+    s_fifo_tail              = 0U;
+    s_fifo_overflow_count    = 0U;
+    s_fifo_high_water        = 0U;
+    s_fifo_overflow_reported = 0U;
+}
+
+/**
+ * @brief Append one frame (producer side — CAN Rx ISR context).
+ * @complexity Cyclomatic complexity: 4
+ */
+error_t TCI_RxFifo_Push(const can_mailbox_t *frame)
+{
+    /* Implements: REQ-INT-007, UNIT-TCI-009 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 */
+    error_t  result;
+    uint32_t head;
+    uint32_t fill;
+
+    if (NULL == frame)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        head = s_fifo_head;
+        fill = head - s_fifo_tail;
+
+        if (fill >= TCI_CAN_RX_FIFO_DEPTH)
+        {
+            s_fifo_overflow_count++;  /* Drop newest; never overwrite */
+            result = ERR_RANGE;
+        }
+        else
+        {
+            s_fifo_slot[head & TCI_FIFO_INDEX_MASK] = *frame;
+            TCI_FIFO_BARRIER();       /* Slot contents before head */
+            s_fifo_head = head + 1U;
+
+            if ((fill + 1U) > s_fifo_high_water)
+            {
+                s_fifo_high_water = fill + 1U;
+            }
+            result = SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Remove up to max_frames frames in arrival order (consumer side).
+ * @complexity Cyclomatic complexity: 4
+ */
+uint8_t TCI_RxFifo_PopBatch(can_mailbox_t *out, uint8_t max_frames)
+{
+    /* Implements: REQ-INT-007, UNIT-TCI-010 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 */
+    uint32_t tail;
+    uint32_t avail;
+    uint8_t  count = 0U;
+
+    if (NULL != out)
+    {
+        tail  = s_fifo_tail;
+        avail = s_fifo_head - tail;
+        TCI_FIFO_BARRIER();           /* head before slot contents */
+
+        while ((count < max_frames) && ((uint32_t)count < avail))
+        {
+            out[count] = s_fifo_slot[(tail + (uint32_t)count) &
+                                     TCI_FIFO_INDEX_MASK];
+            count++;
+        }
+
+        TCI_FIFO_BARRIER();           /* Slot copies before tail */
+        s_fifo_tail = tail + (uint32_t)count;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Number of frames currently queued.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t TCI_RxFifo_GetCount(void)
+{
+    return s_fifo_head - s_fifo_tail;
+}
+
+/**
+ * @brief Total frames dropped on a full FIFO since TCI_Init.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t TCI_RxFifo_GetOverflowCount(void)
+{
+    return s_fifo_overflow_count;
+}
+
+/**
+ * @brief Frames dropped since the previous call (consumer side).
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t TCI_RxFifo_TakeNewOverflows(void)
+{
+    uint32_t total = s_fifo_overflow_count;
+    uint32_t delta = total - s_fifo_overflow_reported;
+
+    s_fifo_overflow_reported = total;
+    return delta;
+}
+
+/**
+ * @brief Highest FIFO fill level observed since TCI_Init.
+ * @complexity Cyclomatic complexity: 1
+ */
+uint32_t TCI_RxFifo_GetHighWater(void)
+{
+    return s_fifo_high_water;
+}
+
+/*============================================================================
+ * END OF FILE
+ *===========================================================================*/
@@ -1,11 +1,11 @@
 /**
  * @file    tci_init.c
  * @brief   TCI module initialisation, cycle entry, fault accessor, and
- *          global mailbox state.
+ *          global fault state.
  * @details Implements UNIT-TCI-007 (Init), UNIT-TCI-008 (TransmitCycle),
  *          TCI_GetFault.
- *          Also owns g_tci_mailbox and g_tci_fault_flag (extern in other TCI
- *          files).
+ *          Also owns g_tci_fault_flag (extern in other TCI files); received
+ *          frames are queued in the Rx FIFO (tci_fifo.c).
  *
  * @project TDC (Train Door Control System)
  * @module  TCI (TCMS Interface) — COMP-006
@@ -41,54 +41,35 @@
 /*============================================================================
  * GLOBAL SHARED STATE — Owned here, externs in tci_rx.c / tci_seq.c
  *===========================================================================*/
-can_mailbox_t g_tci_mailbox[TCI_CAN_RX_MAILBOX_COUNT];
-uint8_t       g_tci_fault_flag = 0U;
-
-/*============================================================================
- * MODULE CONSTANTS
- *===========================================================================*/
-/** @brief Transmit cycle divisor: transmit every 100 ms = 5 × 20 ms cycles */
-#define TCI_TX_CYCLE_DIVISOR  (5U)
-
-/*============================================================================
- * MODULE-LEVEL STATIC STATE
- *===========================================================================*/
-/** @brief 20 ms cycle counter (0–4) to time 100 ms transmit period */
-static uint8_t s_tx_cycle_count;
+uint8_t g_tci_fault_flag = 0U;
 
 /**
  * @brief Initialise TCI module.
- * @complexity Cyclomatic complexity: 2
+ * @complexity Cyclomatic complexity: 1
  */
 error_t TCI_Init(void)
 {
     /* Implements: UNIT-TCI-007 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §8 */
-    uint8_t i;
-    uint8_t b;
+    /* Empty the Rx FIFO (CAN Rx interrupt not yet enabled) */
+    TCI_RxFifo_Init();
 
-    for (i = 0U; i < TCI_CAN_RX_MAILBOX_COUNT; i++)
-    {
-        g_tci_mailbox[i].msg_id          = 0U;
-        g_tci_mailbox[i].dlc             = 0U;
-        g_tci_mailbox[i].rx_timestamp_ms = 0U;
-        g_tci_mailbox[i].valid           = 0U;
+    /* No emergency stop pending; clear the fast-path statistics */
+    TCI_Rx_Init();
 
-        for (b = 0U; b < 8U; b++)
-        {
-            g_tci_mailbox[i].data[b] = 0U;
-        }
-    }
+    /* Nothing sent on 0x200 yet; clear the interlock latency statistics */
+    TCI_Tx_Init();
 
-    g_tci_fault_flag  = 0U;
-    s_tx_cycle_count  = 0U;
+    g_tci_fault_flag = 0U;
 
     return SUCCESS;
 }
 
 /**
- * @brief 20 ms cycle entry — process Rx frames and transmit periodic status.
- * @complexity Cyclomatic complexity: 2
+ * @brief Periodic entry — process Rx frames and transmit status.
+ * @details The 100 ms transmit period is owned by the SKN static schedule
+ *          (skn_schedule.c); every call transmits.
+ * @complexity Cyclomatic complexity: 6
  */
 void TCI_TransmitCycle(void)
 {
@@ -96,40 +77,33 @@ void TCI_TransmitCycle(void)
     /* Design ref: SCDS DOC-COMPDES-2026-001 §8 */
     error_t err;
 
-    /* Process any newly received CAN frames every cycle */
+    /* Process any newly received CAN frames */
     err = TCI_ProcessReceivedFrames();
     if (SUCCESS != err)
     {
         g_tci_fault_flag = 1U;
     }
 
-    /* Transmit status every 100 ms */
-    s_tx_cycle_count++;
-    if (s_tx_cycle_count >= TCI_TX_CYCLE_DIVISOR)
+    err = TCI_TransmitDepartureInterlock(SKN_GetDepartureInterlock());
+    if (SUCCESS != err)
     {
-        s_tx_cycle_count = 0U;
+        g_tci_fault_flag = 1U;
+    }
 
-        err = TCI_TransmitDepartureInterlock(SKN_GetDepartureInterlock());
-        if (SUCCESS != err)
-        {
-            g_tci_fault_flag = 1U;
-        }
+    err = TCI_TransmitDoorStatus(DSM_GetDoorStates(), DSM_GetLockStates());
+    if (SUCCESS != err)
+    {
+        g_tci_fault_flag = 1U;
+    }
 
-        err = TCI_TransmitDoorStatus(DSM_GetDoorStates(), DSM_GetLockStates());
+    if (FMG_GetFaultState() != 0U)
+    {
+        err = TCI_TransmitFaultReport(FMG_GetFaultState(),
+                                      (fault_severity_t)FAULT_HIGH);
         if (SUCCESS != err)
         {
             g_tci_fault_flag = 1U;
         }
-
-        if (FMG_GetFaultState() != 0U)
-        {
-            err = TCI_TransmitFaultReport(FMG_GetFaultState(),
-                                          (fault_severity_t)FAULT_HIGH);
-            if (SUCCESS != err)
-            {
-                g_tci_fault_flag = 1U;
-            }
-        }
     }
 }
 
@@ -2,9 +2,20 @@
  * @file    tci_rx.c
  * @brief   TCI CAN receive ISR, frame processor, and speed frame accessor.
  * @details Implements UNIT-TCI-001 (CanRxISR), UNIT-TCI-002
- *          (ProcessReceivedFrames), and TCI_GetSpeedFramePtr.
- *          The ISR copies raw frames into a static double-buffer mailbox;
- *          the cycle-task processor validates CRC-16 and routes each frame.
+ *          (ProcessReceivedFrames), UNIT-TCI-013 (GetEstopStats) and
+ *          TCI_GetSpeedFramePtr.
+ *          The ISR appends raw frames to the lock-free Rx FIFO (tci_fifo.c);
+ *          the cycle-task processor drains it in arrival order, validates
+ *          CRC-16 and routes each frame.
+ *          Emergency stop (0x104) fast path: the ISR stops every motor
+ *          through HAL_EmergencyMotorStop before queuing the frame and
+ *          leaves s_tci_estop_pending set. Processing the queued frame
+ *          clears it; if the frame was dropped (FIFO full) the cycle task
+ *          reports the stop to FMG from the pending flag instead.
+ *          A 0x104 frame with stop code TCI_ESTOP_CODE_RELEASE releases
+ *          the stop. At the end of each drain the HAL motor inhibit is
+ *          reconciled with the FMG stop flag: latched while the stop is
+ *          active, released once TCMS has released it.
  *
  * @project TDC (Train Door Control System)
  * @module  TCI (TCMS Interface) — COMP-006
@@ -39,8 +50,7 @@
 /*============================================================================
  * EXTERNAL SHARED STATE (owned by tci_init.c)
  *===========================================================================*/
-extern can_mailbox_t g_tci_mailbox[TCI_CAN_RX_MAILBOX_COUNT];
-extern uint8_t       g_tci_fault_flag;
+extern uint8_t g_tci_fault_flag;
 
 /*============================================================================
  * MODULE CONSTANTS — CAN message IDs expected from TCMS
@@ -57,6 +67,9 @@ extern uint8_t       g_tci_fault_flag;
 /** @brief Maximum DLC for TCMS frames */
 #define TCI_MAX_DLC            (8U)
 
+/** @brief Emergency stop code that releases the stop (any other code stops) */
+#define TCI_ESTOP_CODE_RELEASE (0x00U)
+
 /*============================================================================
  * MODULE-LEVEL STATIC STATE
  *===========================================================================*/
@@ -66,6 +79,16 @@ static tcms_speed_msg_t s_last_speed_frame;
 /** @brief Valid flag: 1 if s_last_speed_frame has been populated at least once */
 static uint8_t s_speed_frame_valid;
 
+/** @brief Emergency stop taken by the ISR, not yet reported to FMG
+ *         (written by the ISR and the cycle task) */
+static volatile uint8_t s_tci_estop_pending;
+
+/** @brief Stop code of the last fast-path emergency stop */
+static volatile uint8_t s_tci_estop_code;
+
+/** @brief Fast-path statistics (written by the ISR only) */
+static tci_estop_stats_t s_tci_estop_stats;
+
 /*============================================================================
  * PRIVATE HELPERS
  *===========================================================================*/
@@ -126,13 +149,33 @@ static void tci_process_speed_frame(const can_mailbox_t *slot)
     s_speed_frame_valid              = 1U;
 }
 
+/**
+ * @brief Assemble the door mask of an open/close command frame.
+ * @details Data byte k carries doors 8k..8k+7 (bit n of the mask = door n),
+ *          so a 1-byte frame addresses doors 0–7 as before and an 8-byte
+ *          frame addresses up to 64 doors. Bytes beyond the DLC are ignored.
+ * @complexity Cyclomatic complexity: 3
+ */
+static door_mask_t tci_door_mask(const can_mailbox_t *slot)
+{
+    door_mask_t mask = 0U;
+    uint8_t     idx;
+
+    for (idx = 0U; (idx < slot->dlc) && (idx < TCI_MAX_DLC); idx++)
+    {
+        mask |= (door_mask_t)slot->data[idx] << (8U * (uint32_t)idx);
+    }
+
+    return mask;
+}
+
 /**
  * @brief Process a door open command frame (CAN 0x101).
  * @complexity Cyclomatic complexity: 1
  */
 static void tci_process_open_cmd(const can_mailbox_t *slot)
 {
-    (void)DSM_ProcessOpenCommand(slot->data[0U]);
+    (void)DSM_ProcessOpenCommand(tci_door_mask(slot));
 }
 
 /**
@@ -141,16 +184,82 @@ static void tci_process_open_cmd(const can_mailbox_t *slot)
  */
 static void tci_process_close_cmd(const can_mailbox_t *slot)
 {
-    (void)DSM_ProcessCloseCommand(slot->data[0U]);
+    (void)DSM_ProcessCloseCommand(tci_door_mask(slot));
 }
 
 /**
- * @brief Process an emergency stop frame (CAN 0x104).
- * @complexity Cyclomatic complexity: 1
+ * @brief Process an emergency stop frame (CAN 0x104): release on stop code
+ *        TCI_ESTOP_CODE_RELEASE, otherwise report the stop to FMG (the ISR
+ *        fast path has already stopped the motors). A frame without a stop
+ *        code is treated as a stop.
+ * @complexity Cyclomatic complexity: 3
  */
 static void tci_process_estop(const can_mailbox_t *slot)
 {
-    (void)FMG_ProcessEmergencyStop(slot->data[0U]);
+    if ((slot->dlc > 0U) && (TCI_ESTOP_CODE_RELEASE == slot->data[0U]))
+    {
+        (void)FMG_ReleaseEmergencyStop();
+    }
+    else
+    {
+        s_tci_estop_pending = 0U;  /* Reported to FMG by this frame */
+        (void)FMG_ProcessEmergencyStop(slot->data[0U]);
+    }
+}
+
+/**
+ * @brief Align the HAL motor inhibit with the FMG emergency stop flag.
+ * @details Latches the inhibit for a stop that did not take the ISR fast
+ *          path (frame without a stop code) and releases it once the stop
+ *          is released. A fast-path stop taken by the ISR during the
+ *          release leaves s_tci_estop_pending set and is latched again
+ *          before returning; it reaches FMG next cycle.
+ * @complexity Cyclomatic complexity: 5
+ */
+static void tci_estop_reconcile(void)
+{
+    if (0U != FMG_IsEmergencyStopActive())
+    {
+        if (0U == HAL_IsMotorInhibited())
+        {
+            (void)HAL_EmergencyMotorStop();
+        }
+    }
+    else if (0U != HAL_IsMotorInhibited())
+    {
+        (void)HAL_ReleaseMotorInhibit();
+        if (0U != s_tci_estop_pending)
+        {
+            (void)HAL_EmergencyMotorStop();
+        }
+    }
+    else
+    {
+        /* No stop active and motors enabled — nothing to do */
+    }
+}
+
+/**
+ * @brief Emergency stop fast path (ISR context): stop every motor, record
+ *        the stop for the cycle task and time it from ISR entry.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void tci_estop_fast_path(uint8_t stop_code, uint32_t entry_ticks)
+{
+    uint32_t stop_ticks;
+
+    (void)HAL_EmergencyMotorStop();
+    stop_ticks = HAL_GetCycleCounter() - entry_ticks;
+
+    s_tci_estop_code    = stop_code;
+    s_tci_estop_pending = 1U;
+
+    s_tci_estop_stats.isr_stop_count++;
+    s_tci_estop_stats.last_stop_ticks = stop_ticks;
+    if (stop_ticks > s_tci_estop_stats.max_stop_ticks)
+    {
+        s_tci_estop_stats.max_stop_ticks = stop_ticks;
+    }
 }
 
 /*============================================================================
@@ -158,91 +267,160 @@ static void tci_process_estop(const can_mailbox_t *slot)
  *===========================================================================*/
 
 /**
- * @brief CAN receive ISR — copy from HAL FIFO to mailbox.
- * @complexity Cyclomatic complexity: 3
+ * @brief Reset the pending emergency stop and the fast-path statistics.
+ * @complexity Cyclomatic complexity: 1
+ */
+void TCI_Rx_Init(void)
+{
+    s_tci_estop_pending              = 0U;
+    s_tci_estop_code                 = 0U;
+    s_tci_estop_stats.isr_stop_count  = 0U;
+    s_tci_estop_stats.last_stop_ticks = 0U;
+    s_tci_estop_stats.max_stop_ticks  = 0U;
+}
+
+/**
+ * @brief CAN receive ISR — stop the motors on an emergency stop frame,
+ *        then append the frame from HAL to the Rx FIFO.
+ * @complexity Cyclomatic complexity: 7
  */
 void TCI_CanRxISR(void)
 {
     /* Implements: UNIT-TCI-001 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 */
-    uint32_t msg_id = 0U;
-    uint8_t  data[TCI_MAX_DLC];
-    uint8_t  dlc    = 0U;
-    uint8_t  slot_idx;
-    uint8_t  b;
-    error_t  err;
-
-    err = HAL_CAN_Receive(&msg_id, data, &dlc);
+    can_mailbox_t frame;
+    error_t       err;
+    uint32_t      entry_ticks = HAL_GetCycleCounter();
+
+    err = HAL_CAN_Receive(&frame.msg_id, frame.data, &frame.dlc);
     if (SUCCESS != err)
     {
         return;
     }
 
-    slot_idx = tci_find_slot(msg_id);
-    if (slot_idx >= TCI_CAN_RX_MAILBOX_COUNT)
+    if (tci_find_slot(frame.msg_id) >= TCI_CAN_RX_MAILBOX_COUNT)
     {
         return; /* Unknown ID — discard */
     }
 
-    /* Bounds-checked copy */
-    g_tci_mailbox[slot_idx].msg_id         = msg_id;
-    g_tci_mailbox[slot_idx].dlc            = (dlc <= TCI_MAX_DLC) ? dlc : TCI_MAX_DLC;
-    g_tci_mailbox[slot_idx].rx_timestamp_ms = HAL_GetSystemTickMs();
-    g_tci_mailbox[slot_idx].valid          = 1U;
+    /* Fast path: stop the motors now, reconcile in the cycle task */
+    if ((TCI_CAN_ID_ESTOP == frame.msg_id) && (frame.dlc > 0U) &&
+        (TCI_ESTOP_CODE_RELEASE != frame.data[0U]))
+    {
+        tci_estop_fast_path(frame.data[0U], entry_ticks);
+    }
+
+    frame.dlc             = (frame.dlc <= TCI_MAX_DLC) ? frame.dlc : TCI_MAX_DLC;
+    frame.rx_timestamp_ms = HAL_GetSystemTickMs();
+    frame.valid           = 1U;
+
+    /* FIFO full → frame dropped and counted; reported by the cycle task */
+    (void)TCI_RxFifo_Push(&frame);
+}
 
-    for (b = 0U; b < g_tci_mailbox[slot_idx].dlc; b++)
+/**
+ * @brief Route one received frame to its handler by CAN message ID.
+ * @complexity Cyclomatic complexity: 6
+ */
+static void tci_dispatch_frame(const can_mailbox_t *frame)
+{
+    switch (tci_find_slot(frame->msg_id))
     {
-        g_tci_mailbox[slot_idx].data[b] = data[b];
+        case 0U:
+            tci_process_speed_frame(frame);
+            break;
+        case 1U:
+            tci_process_open_cmd(frame);
+            break;
+        case 2U:
+            tci_process_close_cmd(frame);
+            break;
+        case 3U:
+            /* Mode command — handled by DSM via FMG */
+            break;
+        case 4U:
+            tci_process_estop(frame);
+            break;
+        default:
+            /* Should not reach — ISR filters unknown IDs */
+            break;
     }
 }
 
 /**
- * @brief Process all pending CAN receive mailbox frames.
- * @complexity Cyclomatic complexity: 8 — within SIL 3 limit of 10
+ * @brief Drain the CAN Rx FIFO and process every frame in arrival order;
+ *        report a fast-path emergency stop whose frame was lost, then
+ *        reconcile the HAL motor inhibit with the FMG stop flag.
+ * @details A stop taken by the ISR after the drain is reported here and
+ *          again when its frame is processed next cycle (one extra
+ *          FMG_ProcessEmergencyStop log entry; the stop flag is idempotent).
+ * @complexity Cyclomatic complexity: 6 — within SIL 3 limit of 10
  */
 error_t TCI_ProcessReceivedFrames(void)
 {
     /* Implements: UNIT-TCI-002 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 */
-    uint8_t i;
-
-    for (i = 0U; i < TCI_CAN_RX_MAILBOX_COUNT; i++)
+    can_mailbox_t batch[TCI_CAN_RX_DRAIN_BATCH];
+    uint32_t      processed = 0U;
+    uint32_t      dropped;
+    uint8_t       count;
+    uint8_t       i;
+
+    /* Bounded drain: frames arriving during the drain are taken too, but
+     * never more than one FIFO's worth per call. */
+    do
     {
-        if (0U == g_tci_mailbox[i].valid)
+        count = TCI_RxFifo_PopBatch(batch, (uint8_t)TCI_CAN_RX_DRAIN_BATCH);
+        for (i = 0U; i < count; i++)
         {
-            continue;
+            tci_dispatch_frame(&batch[i]);
         }
+        processed += (uint32_t)count;
+    } while ((count > 0U) && (processed < TCI_CAN_RX_FIFO_DEPTH));
 
-        /* Process by slot (each slot maps to one CAN ID) */
-        switch (i)
-        {
-            case 0U:
-                tci_process_speed_frame(&g_tci_mailbox[i]);
-                break;
-            case 1U:
-                tci_process_open_cmd(&g_tci_mailbox[i]);
-                break;
-            case 2U:
-                tci_process_close_cmd(&g_tci_mailbox[i]);
-                break;
-            case 3U:
-                /* Mode command — handled by DSM via FMG */
-                break;
-            case 4U:
-                tci_process_estop(&g_tci_mailbox[i]);
-                break;
-            default:
-                /* Should not reach — defensive */
-                break;
-        }
+    /* Report frames lost to a full FIFO since the last cycle */
+    dropped = TCI_RxFifo_TakeNewOverflows();
+    if (dropped > 0U)
+    {
+        LOG_EVENT(COMP_TCI, COMP_TCI, EVT_CAN_RX_OVERFLOW, (uint16_t)dropped);
+        g_tci_fault_flag = 1U;
+    }
 
-        /* Clear mailbox slot after processing */
-        g_tci_mailbox[i].valid = 0U;
+    /* Fast-path stop whose frame never reached the FIFO */
+    if (0U != s_tci_estop_pending)
+    {
+        s_tci_estop_pending = 0U;
+        (void)FMG_ProcessEmergencyStop(s_tci_estop_code);
     }
 
+    tci_estop_reconcile();
+
     return SUCCESS;
 }
 
+/**
+ * @brief Get the emergency stop fast-path statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t TCI_GetEstopStats(tci_estop_stats_t *stats_out)
+{
+    /* Implements: UNIT-TCI-013 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §8.1 */
+    error_t result;
+
+    if (NULL == stats_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *stats_out = s_tci_estop_stats;
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
 /**
  * @brief Get pointer to latest validated speed frame (for SPM polling).
  * @complexity Cyclomatic complexity: 2
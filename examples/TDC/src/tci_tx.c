@@ -3,8 +3,12 @@
  * @brief   TCI CAN transmit functions.
  * @details Implements UNIT-TCI-003 (TransmitDepartureInterlock),
  *          UNIT-TCI-004 (TransmitDoorStatus), UNIT-TCI-005
- *          (TransmitFaultReport).  Each frame carries a CRC-16-CCITT over
- *          the payload bytes before the CRC field.
+ *          (TransmitFaultReport), UNIT-TCI-011 (TransmitInterlockOnChange)
+ *          and UNIT-TCI-012 (GetInterlockLatency).  Each frame carries a
+ *          CRC-16-CCITT over the payload bytes before the CRC field.
+ *          The departure interlock frame (0x200) is sent both as the 100 ms
+ *          heartbeat and, event-triggered, in the cycle the interlock
+ *          changes; the value last sent is kept to detect the change.
  *
  * @project TDC (Train Door Control System)
  * @module  TCI (TCMS Interface) — COMP-006
@@ -41,6 +45,22 @@
 #define TCI_TX_ID_DOOR_STATUS (0x201U)  /**< Door and lock status */
 #define TCI_TX_ID_FAULT       (0x202U)  /**< Fault report */
 
+/*============================================================================
+ * MODULE STATE
+ *===========================================================================*/
+/** @brief TCI fault flag (defined in tci_init.c) */
+extern uint8_t g_tci_fault_flag;
+
+/** @brief Interlock value of the last 0x200 frame sent (0 until the first) */
+static uint8_t s_tci_interlock_sent;
+
+/** @brief Event transmission counters and lock-to-transmit latency */
+static tci_interlock_latency_t s_tci_latency;
+
+/** @brief DSM lock confirmation count when the interlock was last 0; a
+ *         0 -> 1 change is sampled only if the count has moved since */
+static uint32_t s_tci_confirm_count_at_drop;
+
 /*============================================================================
  * PRIVATE HELPERS
  *===========================================================================*/
@@ -55,26 +75,135 @@ static void tci_pack_crc(uint16_t crc, uint8_t *buf, uint8_t offset)
     buf[offset + 1U] = (uint8_t)(crc & 0xFFU);
 }
 
+/**
+ * @brief Record the lock-confirmation-to-transmit latency of a 0 -> 1
+ *        event frame, unless no lock was confirmed since the interlock was
+ *        last 0 (lock_confirm_ms would be stale: no sample, not counted).
+ * @details Elapsed time is the unsigned difference of the ms system tick,
+ *          which wraps only after ~49 days.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void tci_record_lock_latency(uint32_t lock_confirm_count,
+                                    uint32_t lock_confirm_ms)
+{
+    uint32_t latency;
+
+    if (lock_confirm_count != s_tci_confirm_count_at_drop)
+    {
+        latency = HAL_GetSystemTickMs() - lock_confirm_ms;
+        s_tci_latency.lock_event_count++;
+        s_tci_latency.last_latency_ms = latency;
+        if (latency > s_tci_latency.max_latency_ms)
+        {
+            s_tci_latency.max_latency_ms = latency;
+        }
+    }
+}
+
 /*============================================================================
  * PUBLIC FUNCTIONS
  *===========================================================================*/
 
 /**
- * @brief Transmit departure interlock status (CAN ID 0x200) every 100 ms.
+ * @brief Reset the last interlock value sent and the latency statistics.
  * @complexity Cyclomatic complexity: 1
  */
+void TCI_Tx_Init(void)
+{
+    s_tci_interlock_sent              = 0U;
+    s_tci_latency.event_tx_count      = 0U;
+    s_tci_latency.lock_event_count    = 0U;
+    s_tci_latency.last_latency_ms     = 0U;
+    s_tci_latency.max_latency_ms      = 0U;
+    s_tci_confirm_count_at_drop       = 0U;
+}
+
+/**
+ * @brief Transmit departure interlock status (CAN ID 0x200) — 100 ms
+ *        heartbeat and event path.
+ * @complexity Cyclomatic complexity: 3
+ */
 error_t TCI_TransmitDepartureInterlock(uint8_t interlock_ok)
 {
     /* Implements: UNIT-TCI-003 */
     /* Design ref: SCDS DOC-COMPDES-2026-001 §8.2 */
     uint8_t  data[3];  /* [0]=interlock_ok, [1-2]=CRC */
     uint16_t crc;
+    error_t  err;
 
     data[0U] = (interlock_ok != 0U) ? 1U : 0U;
     crc = CRC16_CCITT_Compute(data, 1U);
     tci_pack_crc(crc, data, 1U);
 
-    return HAL_CAN_Transmit(TCI_TX_ID_INTERLOCK, data, 3U);
+    err = HAL_CAN_Transmit(TCI_TX_ID_INTERLOCK, data, 3U);
+    if (SUCCESS == err)
+    {
+        s_tci_interlock_sent = data[0U];
+    }
+
+    return err;
+}
+
+/**
+ * @brief Transmit the departure interlock at once when it changes; measure
+ *        the lock-confirmation-to-transmit latency on a 0 -> 1 change.
+ * @complexity Cyclomatic complexity: 6
+ */
+error_t TCI_TransmitInterlockOnChange(uint8_t interlock_ok,
+                                      uint32_t lock_confirm_count,
+                                      uint32_t lock_confirm_ms)
+{
+    /* Implements: UNIT-TCI-011 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §8.2 */
+    error_t err = SUCCESS;
+
+    if (((interlock_ok != 0U) ? 1U : 0U) != s_tci_interlock_sent)
+    {
+        err = TCI_TransmitDepartureInterlock(interlock_ok);
+        if (SUCCESS != err)
+        {
+            g_tci_fault_flag = 1U;  /* Value on the bus unchanged: retried */
+        }
+        else
+        {
+            s_tci_latency.event_tx_count++;
+            if (1U == s_tci_interlock_sent)
+            {
+                tci_record_lock_latency(lock_confirm_count, lock_confirm_ms);
+            }
+        }
+    }
+
+    /* Locks confirmed up to now cannot start the next 0 -> 1 latency */
+    if (0U == interlock_ok)
+    {
+        s_tci_confirm_count_at_drop = lock_confirm_count;
+    }
+
+    return err;
+}
+
+/**
+ * @brief Get the departure interlock event transmission statistics.
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t TCI_GetInterlockLatency(tci_interlock_latency_t *latency_out)
+{
+    /* Implements: UNIT-TCI-012 */
+    /* Design ref: SCDS DOC-COMPDES-2026-001 §8.2 */
+    error_t result;
+
+    if (NULL == latency_out)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        *latency_out = s_tci_latency;
+        result = SUCCESS;
+    }
+
+    return result;
 }
 
 /**
@@ -43,8 +43,15 @@
  * Design ref: SCDS DOC-COMPDES-2026-001 §2.1
  *===========================================================================*/
 
-/** @brief Maximum number of doors in the system */
+#ifndef MAX_DOORS
+/** @brief Number of doors handled by one DCU (1–64). Override at build time
+ *         for larger car sets, e.g. -DMAX_DOORS=64U. */
 #define MAX_DOORS         (4U)
+#endif
+
+#if (MAX_DOORS < 1U) || (MAX_DOORS > 64U)
+#error "MAX_DOORS must be between 1 and 64 (one door_mask_t bit per door)"
+#endif
 
 /** @brief Maximum number of DDU (Door Drive Unit) nodes */
 #define MAX_DDU_NODES     (4U)
@@ -67,6 +74,32 @@
 /** @brief System cycle period in milliseconds */
 #define CYCLE_MS          (20U)
 
+/*============================================================================
+ * DOOR BITSETS
+ * Bit n of a door_mask_t belongs to door n. Per-door flags are held as one
+ * mask word instead of one byte per door, so "any door"/"all doors" checks
+ * are single word operations for every MAX_DOORS.
+ * Design ref: SCDS DOC-COMPDES-2026-001 §2.1
+ *===========================================================================*/
+
+/** @brief One bit per door (MAX_DOORS <= 64) */
+typedef uint64_t door_mask_t;
+
+/** @brief Mask bit of door d */
+#define DOOR_BIT(d)            ((door_mask_t)1U << (d))
+
+/** @brief Door d's flag in mask m as 0/1 */
+#define DOOR_MASK_TEST(m, d)   ((uint8_t)(((m) >> (d)) & 1U))
+
+/** @brief All doors of this build (shift split in two: valid for 64 doors) */
+#define DOOR_MASK_ALL \
+    ((((door_mask_t)1U << (MAX_DOORS - 1U)) << 1U) - 1U)
+
+/** @brief Fold a door mask into a 16-bit event payload (XOR of its four
+ *         16-bit lanes — equal to the mask itself for up to 16 doors) */
+#define DOOR_MASK_FOLD16(m) \
+    ((uint16_t)(((m) ^ ((m) >> 16U) ^ ((m) >> 32U) ^ ((m) >> 48U)) & 0xFFFFU))
+
 /*============================================================================
  * ERROR CODES
  * Implements: REQ-SAFE-012, REQ-SAFE-013
@@ -185,6 +218,59 @@ typedef struct {
     uint16_t crc16;                       /**< CRC-16-CCITT over all preceding bytes */
 } cross_channel_state_t;
 
+/*============================================================================
+ * CROSS-CHANNEL SPI WIRE FORMAT (packed)
+ * Implements: REQ-SAFE-002, REQ-SAFE-008
+ * Design ref: SCDS DOC-COMPDES-2026-001 §3.1
+ *
+ * Packed encoding of cross_channel_state_t transferred over SPI
+ * (SKN_EncodeWireState / SKN_DecodeWireState). 32-bit words:
+ *   word 0               bits 0–15 speed_kmh_x10, 16–23 fault_flags,
+ *                        24–31 safety_decisions
+ *   door-state words     3 bits per door, 10 doors per word (bits 0–29)
+ *   mask words           lock bit i at mask bit i, obstacle bit i at mask
+ *                        bit MAX_DOORS + i (bit n in word n / 32)
+ * followed by CRC-16-CCITT over the payload words. Both channels run the
+ * same MCU, so words are transferred in native byte order.
+ * Size: 14 bytes at MAX_DOORS = 4 (18 unpacked), 50 bytes at 64 doors
+ * (198 unpacked).
+ *===========================================================================*/
+
+/** @brief Bits per packed door state (door_state_t 0–5) */
+#define CCS_WIRE_DOOR_BITS       (3U)
+
+/** @brief Packed door states per 32-bit word */
+#define CCS_WIRE_DOORS_PER_WORD  (10U)
+
+/** @brief Header words (speed, fault_flags, safety_decisions) */
+#define CCS_WIRE_HDR_WORDS       (1U)
+
+/** @brief Door-state words */
+#define CCS_WIRE_DOOR_WORDS \
+    ((MAX_DOORS + (CCS_WIRE_DOORS_PER_WORD - 1U)) / CCS_WIRE_DOORS_PER_WORD)
+
+/** @brief Lock + obstacle mask words (2 bits per door) */
+#define CCS_WIRE_MASK_WORDS      (((2U * MAX_DOORS) + 31U) / 32U)
+
+/** @brief Total payload words */
+#define CCS_WIRE_WORDS \
+    (CCS_WIRE_HDR_WORDS + CCS_WIRE_DOOR_WORDS + CCS_WIRE_MASK_WORDS)
+
+/** @brief Payload bytes covered by the wire CRC */
+#define CCS_WIRE_PAYLOAD_BYTES   (CCS_WIRE_WORDS * 4U)
+
+/** @brief Bytes transferred per SPI exchange (payload + CRC) */
+#define CCS_WIRE_BYTES           (CCS_WIRE_PAYLOAD_BYTES + 2U)
+
+/**
+ * @brief Packed cross-channel state as transferred over SPI.
+ * @note  Channels compare payload words directly (word-wise XOR).
+ */
+typedef struct {
+    uint32_t words[CCS_WIRE_WORDS];  /**< Packed payload (layout above) */
+    uint16_t crc16;                  /**< CRC-16-CCITT over words[] */
+} cross_channel_wire_t;
+
 /*============================================================================
  * TCMS SPEED CAN MESSAGE STRUCTURE
  * Implements: REQ-SAFE-001, REQ-SAFE-003, REQ-INT-007
@@ -214,7 +300,9 @@ typedef struct {
     uint8_t  source_comp;   /**< Source component ID (COMP_xxx constants) */
     uint8_t  event_code;    /**< Event code (EVT_xxx constants) */
     uint16_t data;          /**< Event-specific data payload */
-    uint16_t crc16;         /**< CRC-16-CCITT over preceding 8 bytes */
+    uint16_t guard;         /**< DGN_ENTRY_GUARD of the preceding fields (RAM
+                                 integrity until flushed; Flash pages carry
+                                 a CRC-16) */
 } event_log_entry_t;
 
 /*============================================================================
@@ -247,6 +335,11 @@ typedef struct {
 #define EVT_EMERGENCY_RELEASE      (0x0DU)  /**< Emergency door release activated */
 #define EVT_SEQ_DISCONTINUITY      (0x0EU)  /**< CAN Rx sequence discontinuity */
 #define EVT_LOG_INIT               (0x0FU)  /**< Diagnostic log initialised */
+#define EVT_CAN_RX_OVERFLOW        (0x10U)  /**< CAN Rx FIFO full — frame(s) dropped */
+#define EVT_DEADLINE_OVERRUN       (0x11U)  /**< Scheduler cycle exceeded CYCLE_MS (data: overrun µs) */
+#define EVT_FAULT_CLEARED          (0x12U)  /**< All FMG faults cleared (data: previous fault bitmask) */
+#define EVT_ESTOP_RELEASED         (0x13U)  /**< TCMS emergency stop released (CAN 0x104 code 0x00) */
+#define EVT_BG_STARVED             (0x14U)  /**< SKN background job without a chunk for SKN_BG_STARVE_CYCLES (data: job) */
 
 /*============================================================================
  * SAFETY GLOBALS MEMORY REGION CONSTANTS (for SKN memory integrity)
@@ -0,0 +1,166 @@
+/**
+ * @file    bench_crc.c
+ * @brief   Throughput benchmark for the CRC-16-CCITT backends (hal_crc.c).
+ * @details Measures bytes per cycle of each backend (bitwise reference,
+ *          256-entry table, slice-by-4, slice-by-8) over the buffer sizes
+ *          that occur in the TDC cycle:
+ *          - 8 bytes    DGN event-log entry (DGN_LogEvent)
+ *          - 22 bytes   cross_channel_state_t (SKN_BuildLocalState)
+ *          - 4096 bytes ROM block (SKN_CheckMemoryIntegrity)
+ *          - 65535 bytes maximum single CRC16_CCITT_Compute call
+ *          Each backend is first checked against the bitwise reference.
+ *
+ *          Build (host, from examples/TDC):
+ *            gcc -std=c99 -O2 -DHAL_CRC16_BUILD_ALL_BACKENDS -Isrc \
+ *                tests/bench/bench_crc.c src/hal_crc.c -o bench_crc
+ *            ./bench_crc
+ *          On target, link the same two files into the HIL image; the
+ *          cycle counter is DWT->CYCCNT (see bench_timer.h).
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../../src/hal.h"
+#include "bench_timer.h"
+
+#if !defined(HAL_CRC16_BUILD_ALL_BACKENDS)
+#error "bench_crc.c requires -DHAL_CRC16_BUILD_ALL_BACKENDS"
+#endif
+
+/** @brief Largest buffer measured (max CRC16_CCITT_Compute length) */
+#define BENCH_BUF_BYTES   (65535U)
+
+/** @brief Bytes hashed per measurement (repetitions scale to this) */
+#define BENCH_TOTAL_BYTES (16UL * 1024UL * 1024UL)
+
+/** @brief Timed runs per (backend, size); the fastest is reported */
+#define BENCH_RUNS        (5U)
+
+static uint8_t s_buf[BENCH_BUF_BYTES];
+
+/** @brief Sink so the compiler cannot discard the CRC computations */
+static volatile uint16_t s_sink;
+
+static const char *const s_backend_names[4] =
+{
+    "bitwise", "table", "slice4", "slice8"
+};
+
+static const uint32_t s_sizes[] = { 8U, 22U, 4096U, BENCH_BUF_BYTES };
+
+static void fill_buffer(void)
+{
+    uint32_t lcg = 0xC0FFEEU;
+    uint32_t idx;
+
+    for (idx = 0U; idx < BENCH_BUF_BYTES; idx++)
+    {
+        lcg = (lcg * 1103515245UL) + 12345UL;
+        s_buf[idx] = (uint8_t)(lcg >> 16U);
+    }
+}
+
+static int verify_backends(void)
+{
+    uint8_t  backend;
+    uint32_t len;
+    uint16_t ref;
+    int      failures = 0;
+
+    for (len = 1U; len <= 256U; len++)
+    {
+        ref = HAL_CRC16_ComputeWithBackend(HAL_CRC16_BACKEND_BITWISE,
+                                           s_buf, len);
+        for (backend = HAL_CRC16_BACKEND_TABLE;
+             backend <= HAL_CRC16_BACKEND_SLICE8; backend++)
+        {
+            if (HAL_CRC16_ComputeWithBackend(backend, s_buf, len) != ref)
+            {
+                (void)printf("MISMATCH backend=%s len=%u\n",
+                             s_backend_names[backend], (unsigned)len);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+static double measure(uint8_t backend, uint32_t len)
+{
+    uint32_t reps = (uint32_t)(BENCH_TOTAL_BYTES / len);
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    uint64_t dt;
+    uint32_t run;
+    uint32_t rep;
+
+    if (HAL_CRC16_BACKEND_BITWISE == backend)
+    {
+        reps /= 8U;  /* keep the reference run time reasonable */
+    }
+    if (0U == reps)
+    {
+        reps = 1U;
+    }
+
+    for (run = 0U; run < BENCH_RUNS; run++)
+    {
+        t0 = bench_cycles();
+        for (rep = 0U; rep < reps; rep++)
+        {
+            s_sink = HAL_CRC16_ComputeWithBackend(backend, s_buf, len);
+        }
+        dt = bench_cycles() - t0;
+        if (dt < best)
+        {
+            best = dt;
+        }
+    }
+
+    return ((double)len * (double)reps) / (double)best;
+}
+
+int main(void)
+{
+    uint8_t  backend;
+    uint32_t size_idx;
+    double   ref_rate;
+    double   rate;
+
+    fill_buffer();
+    if (verify_backends() != 0)
+    {
+        return 1;
+    }
+
+    (void)printf("CRC-16-CCITT backends — bytes/%s (speed-up vs bitwise)\n",
+                 BENCH_TIMER_UNIT);
+    (void)printf("%-8s", "size");
+    for (backend = HAL_CRC16_BACKEND_BITWISE;
+         backend <= HAL_CRC16_BACKEND_SLICE8; backend++)
+    {
+        (void)printf(" %18s", s_backend_names[backend]);
+    }
+    (void)printf("\n");
+
+    for (size_idx = 0U; size_idx < (sizeof(s_sizes) / sizeof(s_sizes[0]));
+         size_idx++)
+    {
+        (void)printf("%-8u", (unsigned)s_sizes[size_idx]);
+        ref_rate = measure(HAL_CRC16_BACKEND_BITWISE, s_sizes[size_idx]);
+        for (backend = HAL_CRC16_BACKEND_BITWISE;
+             backend <= HAL_CRC16_BACKEND_SLICE8; backend++)
+        {
+            rate = (HAL_CRC16_BACKEND_BITWISE == backend)
+                       ? ref_rate
+                       : measure(backend, s_sizes[size_idx]);
+            (void)printf(" %9.3f (%5.1fx)", rate, rate / ref_rate);
+        }
+        (void)printf("\n");
+    }
+
+    return 0;
+}
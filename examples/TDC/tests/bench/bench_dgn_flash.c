@@ -0,0 +1,242 @@
+/**
+ * @file    bench_dgn_flash.c
+ * @brief   Write amplification, wear and throughput of the DGN Flash log,
+ *          and a power-cut recovery campaign.
+ * @details Runs the log-structured store (dgn_flash.c) on the host flash
+ *          model (tests/stubs/hal_flash_sim.c) backed by an image file.
+ *
+ *          Workloads — each writes BENCH_LAPS laps of the ring through
+ *          DGN_LogEvent + DGN_FlushToFlash, optionally with DGN_SyncToFlash
+ *          every K events (a partial page costs a whole page). Reported:
+ *          - write amplification: Flash bytes programmed / record bytes
+ *            (DGN_FLASH_RECORD_BYTES per event), and erased bytes per
+ *            record byte;
+ *          - wear: min / max erase count over the sectors;
+ *          - sustained events/s: host (wall clock, including the file
+ *            write-through), and device-bound (events / modelled program
+ *            and erase time, HAL_FLASH_PROGRAM_US / HAL_FLASH_ERASE_US);
+ *          - the schedule bound: DGN_FLUSH_BATCH_SIZE events per 200 ms
+ *            DGN slot (skn_schedule.c).
+ *
+ *          Power-cut campaign — BENCH_CUT_TRIALS times: write a random
+ *          number of pages (one to two laps), cut the power at a random
+ *          byte of the next program or erase, power on, remount
+ *          (DGN_Init). Every page committed before the cut and not in the
+ *          sector being erased must read back valid with its page_seq at
+ *          its place in the ring, the mount must continue the sequence, and
+ *          the next page must be written and found by a second mount.
+ *          Exit status 1 on any failure.
+ *
+ *          Build (host, from examples/TDC):
+ *            gcc -std=c99 -O2 -Isrc -Itests/stubs \
+ *                tests/bench/bench_dgn_flash.c src/dgn_log.c \
+ *                src/dgn_flash.c src/hal_flash.c tests/stubs/hal_flash_sim.c \
+ *                tests/stubs/hal_stub.c tests/stubs/crc_stub.c \
+ *                -o bench_dgn_flash
+ *            ./bench_dgn_flash [image-file]
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../src/dgn.h"
+#include "../../src/hal.h"
+#include "../stubs/hal_flash_sim.h"
+
+/** @brief Pages in the ring */
+#define BENCH_PAGES       (HAL_FLASH_SIZE_BYTES / DGN_FLASH_PAGE_BYTES)
+
+/** @brief Pages per erase sector */
+#define BENCH_PPS         (HAL_FLASH_SECTOR_BYTES / DGN_FLASH_PAGE_BYTES)
+
+/** @brief Laps of the ring per workload */
+#define BENCH_LAPS        (20U)
+
+/** @brief DGN flush slot period, ms (SKN_DGN_PERIOD x CYCLE_MS) */
+#define BENCH_DGN_SLOT_MS (200U)
+
+/** @brief Power-cut trials */
+#define BENCH_CUT_TRIALS  (2000U)
+
+static uint32_t s_rand = 0x2545F491U;
+
+/** @brief Event payload counter: no two pages carry the same bytes */
+static uint16_t s_event;
+
+static uint32_t bench_rand(void)
+{
+    s_rand = (s_rand * 1103515245U) + 12345U;
+    return s_rand >> 8U;
+}
+
+static double wall_s(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/** @brief Log @p events, flushing after each; sync every @p sync_every
+ *         events (0: never) */
+static void run_workload(const char *name, uint32_t sync_every)
+{
+    const uint32_t        events = BENCH_LAPS * BENCH_PAGES *
+                                   DGN_FLASH_PAGE_RECORDS;
+    hal_flash_sim_stats_t sim;
+    uint32_t min_e = UINT32_MAX;
+    uint32_t max_e = 0U;
+    uint32_t e;
+    uint32_t i;
+    double   t0;
+    double   dt;
+    double   payload;
+
+    HAL_FlashSim_Reset();
+    (void)DGN_Init();
+
+    t0 = wall_s();
+    for (i = 0U; i < events; i++)
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x01U, (uint16_t)i);
+        (void)DGN_FlushToFlash();
+        if ((0U != sync_every) && (0U == ((i + 1U) % sync_every)))
+        {
+            (void)DGN_SyncToFlash();
+        }
+    }
+    dt = wall_s() - t0;
+
+    HAL_FlashSim_GetStats(&sim);
+    for (i = 0U; i < HAL_FLASH_SECTORS; i++)
+    {
+        e = HAL_FlashSim_GetEraseCount((uint16_t)i);
+        min_e = (e < min_e) ? e : min_e;
+        max_e = (e > max_e) ? e : max_e;
+    }
+    payload = (double)events * DGN_FLASH_RECORD_BYTES;
+
+    (void)printf("  %-22s %7.3f %7.3f %5u/%-5u %10.0f %10.0f\n", name,
+                 (double)sim.bytes_programmed / payload,
+                 (double)sim.bytes_erased / payload,
+                 (unsigned)min_e, (unsigned)max_e,
+                 (double)events / dt,
+                 (double)events / ((double)sim.busy_us * 1e-6));
+}
+
+/** @brief Log and flush until @p pages more pages are committed or a
+ *         commit fails; returns the pages committed */
+static uint32_t write_pages(uint32_t pages)
+{
+    dgn_flash_stats_t st;
+    uint32_t          start;
+    uint32_t          done = 0U;
+    error_t           ret  = SUCCESS;
+
+    (void)DGN_GetFlashStats(&st);
+    start = st.pages_written;
+    while ((done < pages) && (SUCCESS == ret))
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x02U, s_event++);
+        ret = DGN_FlushToFlash();
+        (void)DGN_GetFlashStats(&st);
+        done = st.pages_written - start;
+    }
+    return done;
+}
+
+/** @brief One power-cut trial; returns 1 on failure */
+static int cut_trial(void)
+{
+    const uint32_t    pages = BENCH_PAGES + (bench_rand() % BENCH_PAGES);
+    dgn_flash_stats_t st;
+    dgn_flash_page_t  page;
+    uint32_t          committed;
+    uint32_t          keep;
+    uint32_t          seq;
+    uint32_t          cut;
+    uint16_t          head;
+    int               bad = 0;
+
+    HAL_FlashSim_Reset();
+    (void)DGN_Init();
+    committed = write_pages(pages);
+
+    /* Next operation: an erase if the head is at a sector start */
+    (void)DGN_GetFlashStats(&st);
+    cut = (0U == (st.head_page % BENCH_PPS)) ?
+          (bench_rand() % HAL_FLASH_SECTOR_BYTES) :
+          (bench_rand() % DGN_FLASH_PAGE_BYTES);
+    HAL_FlashSim_CutPowerAfter(cut);
+    committed += write_pages(1U);
+    HAL_FlashSim_PowerOn();
+
+    bad |= (SUCCESS != DGN_Init());
+    (void)DGN_GetFlashStats(&st);
+    bad |= (st.next_page_seq != committed);
+
+    /* Newest pages outside the sector under erase must all be intact */
+    keep = BENCH_PAGES - BENCH_PPS;
+    for (seq = committed - keep; seq < committed; seq++)
+    {
+        head = (uint16_t)(seq % BENCH_PAGES);
+        bad |= (SUCCESS != DGN_ReadFlashPage(head, &page));
+        bad |= (page.page_seq != seq);
+    }
+
+    /* The log goes on, and a second mount finds the new page */
+    bad |= (1U != write_pages(1U));
+    (void)DGN_Init();
+    (void)DGN_GetFlashStats(&st);
+    bad |= (st.next_page_seq != (committed + 1U));
+
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : "bench_dgn_flash.img";
+    uint32_t    failed = 0U;
+    uint32_t    t;
+
+    (void)HAL_Init();
+    if (SUCCESS != HAL_FlashSim_Attach(path))
+    {
+        (void)printf("cannot open %s\n", path);
+        return 1;
+    }
+
+    (void)printf("DGN Flash log: %u KiB ring, %u-byte pages of %u records, "
+                 "%u laps per workload\n",
+                 (unsigned)(HAL_FLASH_SIZE_BYTES / 1024U),
+                 (unsigned)DGN_FLASH_PAGE_BYTES,
+                 (unsigned)DGN_FLASH_PAGE_RECORDS, (unsigned)BENCH_LAPS);
+    (void)printf("  %-22s %7s %7s %11s %10s %10s\n", "", "WA prog",
+                 "erase/B", "erases", "host ev/s", "device ev/s");
+    run_workload("full pages", 0U);
+    run_workload("sync every 100 events", 100U);
+    run_workload("sync every 10 events", 10U);
+    run_workload("sync every event", 1U);
+    (void)printf("  schedule bound: %u events per %u ms slot = %u events/s\n",
+                 (unsigned)DGN_FLUSH_BATCH_SIZE, (unsigned)BENCH_DGN_SLOT_MS,
+                 (unsigned)((DGN_FLUSH_BATCH_SIZE * 1000U) /
+                            BENCH_DGN_SLOT_MS));
+
+    for (t = 0U; t < BENCH_CUT_TRIALS; t++)
+    {
+        failed += (uint32_t)cut_trial();
+    }
+    (void)printf("Power-cut trials: %u, failed %u\n",
+                 (unsigned)BENCH_CUT_TRIALS, (unsigned)failed);
+
+    HAL_FlashSim_Detach();
+    (void)remove(path);
+    (void)printf("%s\n", (0U != failed) ? "FAIL" : "PASS");
+    return (0U != failed) ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file    bench_dgn_log.c
+ * @brief   Per-call latency benchmark for DGN_LogEvent (deferred CRC).
+ * @details Times every call individually and reports min / median / p99 in
+ *          timer ticks (timer overhead subtracted):
+ *          - deferred CRC: DGN_LogEvent as built — raw fields and the
+ *            in-RAM guard only;
+ *          - per-entry CRC: the same call followed by the work the former
+ *            DGN_LogEvent did before returning — serialise the entry into an
+ *            8-byte buffer and run CRC-16-CCITT over it — once with the
+ *            bitwise reference backend and once with the slice-by-8 default
+ *            backend of hal_crc.c.
+ *          Also reported: the cost per entry of DGN_FlushToFlash, which
+ *          computes one CRC per Flash page of DGN_FLASH_PAGE_RECORDS entries
+ *          (programmed into the host flash model,
+ *          tests/stubs/hal_flash_sim.c).
+ *
+ *          Build (host, from examples/TDC):
+ *            gcc -std=c99 -O2 -DHAL_CRC16_BUILD_ALL_BACKENDS -Isrc \
+ *                -Itests/stubs tests/bench/bench_dgn_log.c src/dgn_log.c \
+ *                src/dgn_flash.c src/hal_flash.c src/hal_crc.c \
+ *                tests/stubs/hal_flash_sim.c tests/stubs/hal_stub.c \
+ *                -o bench_dgn_log
+ *            ./bench_dgn_log
+ *          On target, link the same files into the HIL image; the cycle
+ *          counter is DWT->CYCCNT (see bench_timer.h).
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/dgn.h"
+#include "../../src/hal.h"
+#include "bench_timer.h"
+
+#if !defined(HAL_CRC16_BUILD_ALL_BACKENDS)
+#error "bench_dgn_log.c requires -DHAL_CRC16_BUILD_ALL_BACKENDS"
+#endif
+
+/** @brief Timed calls per variant */
+#define BENCH_SAMPLES   (200000U)
+
+/** @brief Entries per flush measurement (whole blocks) */
+#define BENCH_FLUSH_ENTRIES  (MAX_LOG_ENTRIES - DGN_FLUSH_BATCH_SIZE)
+
+/** @brief Per-entry CRC variants: none (deferred) or a hal_crc.c backend */
+#define BENCH_DEFERRED  (0xFFU)
+
+static uint64_t s_sample[BENCH_SAMPLES];
+
+/** @brief Sink so the compiler cannot discard the CRC computations */
+static volatile uint16_t s_sink;
+
+static int cmp_u64(const void *a, const void *b)
+{
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/** @brief Smallest back-to-back timer read difference */
+static uint64_t timer_overhead(void)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    uint64_t dt;
+    uint32_t i;
+
+    for (i = 0U; i < 10000U; i++)
+    {
+        t0 = bench_cycles();
+        dt = bench_cycles() - t0;
+        if (dt < best)
+        {
+            best = dt;
+        }
+    }
+    return best;
+}
+
+/** @brief The former hot-path CRC: serialise the entry, CRC over 8 bytes */
+static void per_entry_crc(uint8_t backend, uint8_t src, uint8_t code,
+                          uint16_t data)
+{
+    const uint32_t ts = HAL_GetSystemTickMs();
+    uint8_t        buf[8];
+
+    buf[0] = (uint8_t)(ts >> 24U);
+    buf[1] = (uint8_t)(ts >> 16U);
+    buf[2] = (uint8_t)(ts >> 8U);
+    buf[3] = (uint8_t)(ts);
+    buf[4] = src;
+    buf[5] = code;
+    buf[6] = (uint8_t)(data >> 8U);
+    buf[7] = (uint8_t)(data);
+    s_sink = HAL_CRC16_ComputeWithBackend(backend, buf, 8U);
+}
+
+static void measure_log(const char *name, uint8_t backend, uint64_t overhead)
+{
+    uint64_t t0;
+    uint64_t dt;
+    uint32_t i;
+
+    (void)DGN_Init();
+    for (i = 0U; i < BENCH_SAMPLES; i++)
+    {
+        t0 = bench_cycles();
+        (void)DGN_LogEvent(COMP_DSM, EVT_FSM_FAULT, (uint16_t)i);
+        if (BENCH_DEFERRED != backend)
+        {
+            per_entry_crc(backend, COMP_DSM, EVT_FSM_FAULT, (uint16_t)i);
+        }
+        dt = bench_cycles() - t0;
+        s_sample[i] = (dt > overhead) ? (dt - overhead) : 0U;
+    }
+    qsort(s_sample, BENCH_SAMPLES, sizeof(s_sample[0]), cmp_u64);
+    (void)printf("  %-28s %6llu %6llu %6llu\n", name,
+                 (unsigned long long)s_sample[0],
+                 (unsigned long long)s_sample[BENCH_SAMPLES / 2U],
+                 (unsigned long long)s_sample[(BENCH_SAMPLES * 99U) / 100U]);
+}
+
+static void measure_flush(void)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    uint64_t dt;
+    uint32_t run;
+    uint32_t i;
+
+    for (run = 0U; run < 20U; run++)
+    {
+        (void)DGN_Init();
+        for (i = 0U; i < BENCH_FLUSH_ENTRIES; i++)
+        {
+            (void)DGN_LogEvent(COMP_DSM, EVT_FSM_FAULT, (uint16_t)i);
+        }
+        t0 = bench_cycles();
+        while (0U != DGN_GetFlushPending())
+        {
+            (void)DGN_FlushToFlash();
+        }
+        dt = bench_cycles() - t0;
+        if (dt < best)
+        {
+            best = dt;
+        }
+    }
+    (void)printf("DGN_FlushToFlash: %.1f %s per entry (one CRC per %u-entry "
+                 "page, backend as built)\n",
+                 (double)best / (double)BENCH_FLUSH_ENTRIES, BENCH_TIMER_UNIT,
+                 (unsigned)DGN_FLASH_PAGE_RECORDS);
+}
+
+int main(void)
+{
+    const uint64_t overhead = timer_overhead();
+
+    (void)HAL_Init();
+    (void)printf("DGN_LogEvent latency per call, %s (timer overhead %llu "
+                 "subtracted)\n", BENCH_TIMER_UNIT,
+                 (unsigned long long)overhead);
+    (void)printf("  %-28s %6s %6s %6s\n", "", "min", "median", "p99");
+    measure_log("deferred CRC (as built)", BENCH_DEFERRED, overhead);
+    measure_log("per-entry CRC, bitwise", HAL_CRC16_BACKEND_BITWISE,
+                overhead);
+    measure_log("per-entry CRC, slice-by-8", HAL_CRC16_BACKEND_SLICE8,
+                overhead);
+    measure_flush();
+
+    return 0;
+}
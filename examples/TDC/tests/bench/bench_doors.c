@@ -0,0 +1,231 @@
+/**
+ * @file    bench_doors.c
+ * @brief   Door-count scaling benchmark for the per-cycle door path
+ *          (DSM_RunCycle, 2oo2 voting, OBD_RunCycle, departure interlock,
+ *          TCMS commands).
+ * @details Drives all doors through open/close sequences with the unit-test
+ *          HAL stub and reports the best-of-run cost of each stage per
+ *          20 ms cycle and per door. MAX_DOORS is a build-time constant, so
+ *          build once per door count and compare the tables:
+ *
+ *          Build (host, from examples/TDC), e.g. for 4 and 64 doors:
+ *            for n in 4 64; do
+ *              gcc -std=c99 -O2 -DMAX_DOORS=${n}U -Isrc -Itests/stubs \
+ *                  tests/bench/bench_doors.c src/dsm_*.c src/obd_detect.c \
+ *                  src/skn_safe_state.c src/dgn_log.c src/dgn_flash.c \
+ *                  src/dgn_port.c src/dgn_profile.c src/hal_flash.c \
+ *                  tests/stubs/hal_flash_sim.c \
+ *                  tests/stubs/hal_stub.c tests/stubs/crc_stub.c \
+ *                  tests/stubs/linker_symbols_stub.c \
+ *                  tests/stubs/skn_globals_stub.c -o bench_doors_${n}
+ *              ./bench_doors_${n}
+ *            done
+ *
+ *          The mask-based stages (commands, interlock, obstacle combine,
+ *          batch vote) are word operations and stay flat; the array
+ *          interlock and the per-door DSM_VotePosition loop are measured
+ *          alongside as the per-door references. Both vote stages cover the
+ *          position and lock sensor pairs of every door, as DSM_RunCycle
+ *          does. DSM_RunCycle is measured twice: with every door commanded
+ *          and its sensors toggling, and with only door 0 cycling through
+ *          open/close/lock while the others stay idle — the change-driven
+ *          dispatch makes the second case independent of MAX_DOORS.
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../../src/dsm.h"
+#include "../../src/obd.h"
+#include "../../src/skn.h"
+#include "../../src/hal.h"
+#include "bench_timer.h"
+
+/** @brief Simulated cycles per timed run */
+#define BENCH_CYCLES   (20000U)
+
+/** @brief Timed runs per stage; the fastest is reported */
+#define BENCH_RUNS     (5U)
+
+/** @brief Cycles between alternating open / close commands */
+#define BENCH_CMD_PERIOD (50U)
+
+/** @brief Stages measured */
+#define BENCH_STAGES   (8U)
+
+/** @brief Stage with a single active door (needs a fresh DSM) */
+#define BENCH_STAGE_ONE_DOOR (7U)
+
+/** @brief Test stub controls (tests/stubs/hal_stub.c, skn_globals_stub.c) */
+extern uint32_t hal_stub_tick_ms;
+extern uint8_t  hal_stub_gpio_value;
+
+/** @brief Sink so the compiler cannot discard results */
+static volatile uint32_t s_sink;
+
+static const char *const s_stage_names[BENCH_STAGES] =
+{
+    "DSM_RunCycle", "OBD_RunCycle", "interlock (array)", "interlock (mask)",
+    "open/close command", "vote (per door)", "vote (batch)",
+    "DSM_RunCycle (1 door)"
+};
+
+/** @brief Vote both sensor pairs of every door, one DSM_VotePosition each */
+static uint32_t vote_per_door(door_mask_t a, door_mask_t b)
+{
+    uint8_t  i;
+    uint8_t  voted;
+    uint8_t  dis;
+    uint32_t acc = 0U;
+
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        (void)DSM_VotePosition(i, DOOR_MASK_TEST(a, i), DOOR_MASK_TEST(b, i),
+                               &voted, &dis);
+        acc += (uint32_t)voted + (uint32_t)dis;
+        (void)DSM_VotePosition(i, DOOR_MASK_TEST(b, i), DOOR_MASK_TEST(a, i),
+                               &voted, &dis);
+        acc += (uint32_t)voted + (uint32_t)dis;
+    }
+
+    return acc;
+}
+
+/** @brief Vote both sensor pairs of all doors with the batch voter */
+static uint32_t vote_batch(door_mask_t a, door_mask_t b)
+{
+    door_mask_t voted;
+    door_mask_t dis;
+    uint32_t    acc;
+
+    (void)DSM_VotePositionBatch(a, b, &voted, &dis);
+    acc = (uint32_t)(voted ^ dis);
+    (void)DSM_VotePositionBatch(b, a, &voted, &dis);
+    acc += (uint32_t)(voted ^ dis);
+
+    return acc;
+}
+
+/** @brief Run one stage for BENCH_CYCLES simulated cycles */
+static void run_stage(uint32_t stage)
+{
+    uint32_t    cycle;
+    uint8_t     ok = 0U;
+    door_mask_t cmd;
+
+    for (cycle = 0U; cycle < BENCH_CYCLES; cycle++)
+    {
+        switch (stage)
+        {
+            case 0U:
+                if ((cycle % BENCH_CMD_PERIOD) == 0U)
+                {
+                    cmd = DOOR_MASK_ALL;
+                    if (((cycle / BENCH_CMD_PERIOD) % 2U) == 0U)
+                    {
+                        (void)DSM_ProcessOpenCommand(cmd);
+                    }
+                    else
+                    {
+                        (void)DSM_ProcessCloseCommand(cmd);
+                    }
+                }
+                hal_stub_tick_ms += CYCLE_MS;
+                hal_stub_gpio_value = (uint8_t)((cycle / 7U) & 1U);
+                DSM_RunCycle();
+                break;
+            case 1U:
+                OBD_RunCycle();
+                break;
+            case 2U:
+                (void)SKN_EvaluateDepartureInterlock(DSM_GetDoorStates(),
+                                                     DSM_GetLockStates(),
+                                                     0U, 0U, &ok);
+                break;
+            case 3U:
+                (void)SKN_EvaluateDepartureInterlockMask(DSM_GetLockedMask(),
+                                                         0U, 0U, &ok);
+                break;
+            case 4U:
+                cmd = (door_mask_t)cycle * 0x9E3779B97F4A7C15ULL;
+                (void)DSM_ProcessOpenCommand(cmd);
+                (void)DSM_ProcessCloseCommand(~cmd);
+                break;
+            case 5U:
+                cmd   = (door_mask_t)cycle * 0x9E3779B97F4A7C15ULL;
+                s_sink += vote_per_door(cmd, cmd ^ (cmd >> 7U));
+                break;
+            case 6U:
+                cmd   = (door_mask_t)cycle * 0x9E3779B97F4A7C15ULL;
+                s_sink += vote_batch(cmd, cmd ^ (cmd >> 7U));
+                break;
+            default:
+                if ((cycle % BENCH_CMD_PERIOD) == 0U)
+                {
+                    if (((cycle / BENCH_CMD_PERIOD) % 2U) == 0U)
+                    {
+                        (void)DSM_ProcessOpenCommand(DOOR_BIT(0U));
+                    }
+                    else
+                    {
+                        (void)DSM_ProcessCloseCommand(DOOR_BIT(0U));
+                    }
+                }
+                hal_stub_tick_ms += CYCLE_MS;
+                DSM_RunCycle();
+                break;
+        }
+        s_sink += ok;
+    }
+}
+
+static double measure(uint32_t stage)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t t0;
+    uint64_t dt;
+    uint32_t run;
+
+    for (run = 0U; run < BENCH_RUNS; run++)
+    {
+        t0 = bench_cycles();
+        run_stage(stage);
+        dt = bench_cycles() - t0;
+        if (dt < best)
+        {
+            best = dt;
+        }
+    }
+
+    return (double)best / (double)BENCH_CYCLES;
+}
+
+int main(void)
+{
+    uint32_t stage;
+    double   cost;
+
+    (void)DSM_Init();
+    (void)OBD_Init();
+    g_safe_state_active      = 0U;
+    g_speed_interlock_active = 0U;
+
+    (void)printf("Door path, MAX_DOORS = %u — %s per 20 ms cycle\n",
+                 (unsigned)MAX_DOORS, BENCH_TIMER_UNIT);
+    (void)printf("%-20s %12s %12s\n", "stage", "per cycle", "per door");
+    for (stage = 0U; stage < BENCH_STAGES; stage++)
+    {
+        if (BENCH_STAGE_ONE_DOOR == stage)
+        {
+            (void)DSM_Init();          /* All doors idle, sensors steady */
+            hal_stub_gpio_value = 1U;
+        }
+        cost = measure(stage);
+        (void)printf("%-20s %12.1f %12.2f\n", s_stage_names[stage], cost,
+                     cost / (double)MAX_DOORS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file    bench_obd_replay.c
+ * @brief   Replay benchmark for motor-current obstacle detection (OBD).
+ * @details Replays 1 kHz motor current traces of closing strokes through
+ *          two detectors and reports, per trace, how many strokes tripped,
+ *          the detection latency (obstacle contact to the end of the 20 ms
+ *          cycle that flags the door) and the false trips (flagged before
+ *          contact, or in a stroke without an obstacle):
+ *          - single sample: the former check, one HAL_ADC_ReadMotorCurrent
+ *            value per cycle (the last sample of the cycle) compared with
+ *            OBD_MAX_FORCE_ADC;
+ *          - block filter: OBD_PollSensorsAndEvaluate on the HAL ADC scan
+ *            block (median-of-3, moving average and slope detector in
+ *            obd_detect.c).
+ *          Every trace is replayed on all doors at once, each door shifted
+ *          by a different number of milliseconds so that the contact falls
+ *          at every position inside the cycle. A door stops being replayed
+ *          once it is flagged (the FSM would reverse it).
+ *
+ *          Without arguments a built-in set is replayed: strokes synthesised
+ *          from a motor model (inrush, running current, uniform noise,
+ *          single-sample EMI spikes, linear force build-up after contact up
+ *          to the stall current), BENCH_RUNS noise seeds each. Traces
+ *          recorded on the HIL rig are replayed by passing CSV files, one
+ *          stroke per file, one line per millisecond:
+ *            t_ms,current_adc,obstacle
+ *          where obstacle is 1 from the first sample under load onwards;
+ *          lines starting with '#' are ignored.
+ *
+ *          Build (host, from examples/TDC):
+ *            gcc -std=c99 -O2 -Isrc -Itests/stubs \
+ *                tests/bench/bench_obd_replay.c src/obd_detect.c \
+ *                tests/stubs/hal_stub.c tests/stubs/obd_dsm_stub.c \
+ *                tests/stubs/skn_globals_stub.c -o bench_obd_replay
+ *            ./bench_obd_replay [trace.csv ...]
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../src/obd.h"
+#include "../../src/hal.h"
+#include "bench_timer.h"
+
+/** @brief Force limit of the single-sample check (OBD_MAX_FORCE_ADC) */
+#define BENCH_MAX_FORCE_ADC  (3000U)
+
+/** @brief Longest stroke replayed (ms at 1 kHz) */
+#define BENCH_MAX_TRACE_MS   (10000U)
+
+/** @brief Length of a built-in stroke */
+#define BENCH_STROKE_MS      (3000U)
+
+/** @brief Noise seeds per built-in trace */
+#define BENCH_RUNS           (50U)
+
+/** @brief Built-in traces */
+#define BENCH_SCENARIOS      (7U)
+
+/** @brief No obstacle in the stroke */
+#define BENCH_NO_CONTACT     (-1L)
+
+/** @brief Test stub controls (tests/stubs/hal_stub.c, obd_dsm_stub.c) */
+extern hal_adc_block_t hal_stub_adc_block;
+extern void obd_stub_set_closing_flags(const uint8_t flags[MAX_DOORS]);
+
+/** @brief Motor model of one built-in trace */
+typedef struct
+{
+    const char *name;
+    uint16_t    run_adc;       /**< Running current while closing */
+    uint16_t    noise_adc;     /**< Uniform noise amplitude (+/-) */
+    uint16_t    spike_period;  /**< Mean samples between EMI spikes, 0 = none */
+    int32_t     contact_ms;    /**< Obstacle contact, BENCH_NO_CONTACT = none */
+    uint16_t    ramp_adc_ms;   /**< Current rise per ms after contact */
+    uint16_t    stall_adc;     /**< Current once the motor stalls */
+} bench_scenario_t;
+
+static const bench_scenario_t s_scenarios[BENCH_SCENARIOS] =
+{
+    { "clean close",     1200U, 120U,   0U, BENCH_NO_CONTACT,   0U,    0U },
+    { "EMI spikes",      1200U, 120U, 200U, BENCH_NO_CONTACT,   0U,    0U },
+    { "noisy supply",    1200U, 300U,   0U, BENCH_NO_CONTACT,   0U,    0U },
+    { "rigid obstacle",  1200U, 120U,   0U, 1503L,            150U, 3900U },
+    { "medium obstacle", 1200U, 120U,   0U, 2207L,             80U, 3700U },
+    { "soft obstacle",   1200U, 120U,   0U, 1711L,             30U, 3500U },
+    { "soft + EMI",      1200U, 120U, 200U, 1877L,             30U, 3500U }
+};
+
+/** @brief One stroke: samples and contact */
+typedef struct
+{
+    uint16_t sample[BENCH_MAX_TRACE_MS];
+    uint32_t length_ms;
+    int32_t  contact_ms;
+} bench_trace_t;
+
+/** @brief Results of one detector over the runs of one trace */
+typedef struct
+{
+    uint32_t strokes;
+    uint32_t detected;       /**< Flagged at or after contact */
+    uint32_t false_trips;    /**< Flagged before contact / without obstacle */
+    uint32_t latency_min;
+    uint32_t latency_max;
+    uint64_t latency_sum;
+} bench_result_t;
+
+static bench_trace_t s_trace;
+
+/** @brief Time spent in OBD_PollSensorsAndEvaluate and number of calls */
+static uint64_t s_filter_time;
+static uint32_t s_filter_calls;
+
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = (*state * 1103515245UL) + 12345UL;
+    return *state >> 8U;
+}
+
+/** @brief Synthesise one stroke of a built-in trace */
+static void synthesise(const bench_scenario_t *sc, uint32_t seed)
+{
+    uint32_t rng = (seed * 2654435761UL) + 1U;
+    uint32_t t;
+    int32_t  adc;
+    int32_t  loaded;
+
+    for (t = 0U; t < BENCH_STROKE_MS; t++)
+    {
+        adc = (int32_t)sc->run_adc;
+        if (t < 60U)                      /* Inrush: 2600 decaying in 60 ms */
+        {
+            adc += ((2600L - adc) * (60L - (int32_t)t)) / 60L;
+        }
+        if ((BENCH_NO_CONTACT != sc->contact_ms) &&
+            ((int32_t)t >= sc->contact_ms))
+        {
+            loaded = adc + ((int32_t)sc->ramp_adc_ms *
+                            ((int32_t)t - sc->contact_ms + 1L));
+            adc = (loaded < (int32_t)sc->stall_adc) ? loaded
+                                                    : (int32_t)sc->stall_adc;
+        }
+        adc += (int32_t)(bench_rand(&rng) % ((2U * sc->noise_adc) + 1U)) -
+               (int32_t)sc->noise_adc;
+        if ((0U != sc->spike_period) &&
+            ((bench_rand(&rng) % sc->spike_period) == 0U))
+        {
+            adc = 3300L + (int32_t)(bench_rand(&rng) % 796U);
+        }
+        adc = (adc < 0L) ? 0L : ((adc > 4095L) ? 4095L : adc);
+        s_trace.sample[t] = (uint16_t)adc;
+    }
+    s_trace.length_ms  = BENCH_STROKE_MS;
+    s_trace.contact_ms = sc->contact_ms;
+}
+
+/** @brief Load a recorded stroke; returns 0 on success */
+static int load_csv(const char *path)
+{
+    FILE         *f = fopen(path, "r");
+    char          line[128];
+    unsigned long t_ms;
+    unsigned long adc;
+    unsigned long obstacle;
+
+    if (NULL == f)
+    {
+        return -1;
+    }
+    s_trace.length_ms  = 0U;
+    s_trace.contact_ms = BENCH_NO_CONTACT;
+    while ((NULL != fgets(line, (int)sizeof(line), f)) &&
+           (s_trace.length_ms < BENCH_MAX_TRACE_MS))
+    {
+        if (('#' == line[0]) ||
+            (3 != sscanf(line, "%lu,%lu,%lu", &t_ms, &adc, &obstacle)))
+        {
+            continue;
+        }
+        if ((0UL != obstacle) && (BENCH_NO_CONTACT == s_trace.contact_ms))
+        {
+            s_trace.contact_ms = (int32_t)s_trace.length_ms;
+        }
+        s_trace.sample[s_trace.length_ms] =
+            (uint16_t)((adc > 4095UL) ? 4095UL : adc);
+        s_trace.length_ms++;
+    }
+    (void)fclose(f);
+
+    return (0U != s_trace.length_ms) ? 0 : -1;
+}
+
+/** @brief Sample of a door's replay at time t (the door starts shift ms late;
+ *         motor off before and after the stroke) */
+static uint16_t door_sample(uint32_t t, uint32_t shift)
+{
+    return ((t >= shift) && ((t - shift) < s_trace.length_ms)) ?
+           s_trace.sample[t - shift] : 0U;
+}
+
+static void record(bench_result_t *res, uint32_t end_ms, int32_t contact_ms)
+{
+    uint32_t latency;
+
+    if ((BENCH_NO_CONTACT == contact_ms) || ((int32_t)end_ms <= contact_ms))
+    {
+        res->false_trips++;
+    }
+    else
+    {
+        latency = end_ms - (uint32_t)contact_ms;
+        res->detected++;
+        res->latency_sum += latency;
+        res->latency_min = (latency < res->latency_min) ? latency
+                                                        : res->latency_min;
+        res->latency_max = (latency > res->latency_max) ? latency
+                                                        : res->latency_max;
+    }
+}
+
+/** @brief Replay s_trace on all doors through both detectors */
+static void replay(uint32_t run, bench_result_t *single, bench_result_t *filter)
+{
+    uint8_t  closing[MAX_DOORS];
+    uint8_t  obs[MAX_DOORS];
+    uint8_t  single_done[MAX_DOORS];
+    uint32_t shift[MAX_DOORS];
+    uint32_t cycle;
+    uint32_t k;
+    uint32_t t;
+    uint32_t end_ms;
+    uint32_t cycles;
+    uint64_t t0;
+    uint8_t  door;
+
+    (void)OBD_Init();
+    for (door = 0U; door < MAX_DOORS; door++)
+    {
+        closing[door]     = 1U;
+        single_done[door] = 0U;
+        shift[door]       = ((door * 7U) + (run * 3U)) % CYCLE_MS;
+    }
+    single->strokes += MAX_DOORS;
+    filter->strokes += MAX_DOORS;
+
+    cycles = (s_trace.length_ms + CYCLE_MS) / CYCLE_MS;
+    for (cycle = 0U; cycle < cycles; cycle++)
+    {
+        for (k = 0U; k < HAL_ADC_BLOCK_SAMPLES; k++)
+        {
+            t = (cycle * CYCLE_MS) + k;
+            for (door = 0U; door < MAX_DOORS; door++)
+            {
+                hal_stub_adc_block.sample[k][door] = door_sample(t, shift[door]);
+            }
+        }
+        end_ms = (cycle + 1U) * CYCLE_MS;
+
+        /* Block filter: the OBD path */
+        obd_stub_set_closing_flags(closing);
+        t0 = bench_cycles();
+        (void)OBD_PollSensorsAndEvaluate(closing, obs);
+        s_filter_time += bench_cycles() - t0;
+        s_filter_calls++;
+
+        for (door = 0U; door < MAX_DOORS; door++)
+        {
+            if ((0U != closing[door]) && (0U != obs[door]))
+            {
+                closing[door] = 0U;
+                record(filter, end_ms - shift[door], s_trace.contact_ms);
+            }
+            /* Single sample: the value at the end of the cycle */
+            if ((0U == single_done[door]) &&
+                (hal_stub_adc_block.sample[HAL_ADC_BLOCK_SAMPLES - 1U][door] >
+                 BENCH_MAX_FORCE_ADC))
+            {
+                single_done[door] = 1U;
+                record(single, end_ms - shift[door], s_trace.contact_ms);
+            }
+        }
+    }
+}
+
+static void print_row(const char *name, int32_t contact_ms,
+                      const bench_result_t *res)
+{
+    const double missed = (BENCH_NO_CONTACT == contact_ms) ? 0.0 :
+                          (double)(res->strokes - res->detected -
+                                   res->false_trips);
+
+    if (0U != res->detected)
+    {
+        (void)printf("  %-16s %5u/%-5u %4u %6.1f %4u %7u %7.0f\n", name,
+                     (unsigned)res->detected, (unsigned)res->strokes,
+                     (unsigned)res->latency_min,
+                     (double)res->latency_sum / (double)res->detected,
+                     (unsigned)res->latency_max,
+                     (unsigned)res->false_trips, missed);
+    }
+    else
+    {
+        (void)printf("  %-16s %5u/%-5u %4s %6s %4s %7u %7.0f\n", name,
+                     0U, (unsigned)res->strokes, "-", "-", "-",
+                     (unsigned)res->false_trips, missed);
+    }
+}
+
+static void report(const char *name, int32_t contact_ms,
+                   const bench_result_t *single, const bench_result_t *filter)
+{
+    if (BENCH_NO_CONTACT == contact_ms)
+    {
+        (void)printf("%s (no obstacle)\n", name);
+    }
+    else
+    {
+        (void)printf("%s (contact at %ld ms)\n", name, (long)contact_ms);
+    }
+    print_row("single sample", contact_ms, single);
+    print_row("block filter", contact_ms, filter);
+}
+
+static void reset_result(bench_result_t *res)
+{
+    (void)memset(res, 0, sizeof(*res));
+    res->latency_min = UINT32_MAX;
+}
+
+int main(int argc, char **argv)
+{
+    bench_result_t single;
+    bench_result_t filter;
+    uint32_t       sc;
+    uint32_t       run;
+    int            arg;
+
+    (void)HAL_Init();
+    (void)printf("Obstacle detection replay, MAX_DOORS = %u, %u Hz scan\n",
+                 (unsigned)MAX_DOORS, (unsigned)HAL_ADC_SCAN_RATE_HZ);
+    (void)printf("  %-16s %11s %4s %6s %4s %7s %7s\n", "detector",
+                 "tripped", "min", "avg", "max", "false", "missed");
+    (void)printf("  %-16s %11s %16s\n", "", "", "latency ms");
+
+    if (argc > 1)
+    {
+        for (arg = 1; arg < argc; arg++)
+        {
+            if (0 != load_csv(argv[arg]))
+            {
+                (void)printf("%s: cannot read trace\n", argv[arg]);
+                continue;
+            }
+            reset_result(&single);
+            reset_result(&filter);
+            replay(0U, &single, &filter);
+            report(argv[arg], s_trace.contact_ms, &single, &filter);
+        }
+    }
+    else
+    {
+        for (sc = 0U; sc < BENCH_SCENARIOS; sc++)
+        {
+            reset_result(&single);
+            reset_result(&filter);
+            for (run = 0U; run < BENCH_RUNS; run++)
+            {
+                synthesise(&s_scenarios[sc], (sc * BENCH_RUNS) + run);
+                replay(run, &single, &filter);
+            }
+            report(s_scenarios[sc].name, s_scenarios[sc].contact_ms,
+                   &single, &filter);
+        }
+    }
+
+    if (0U != s_filter_calls)
+    {
+        (void)printf("block filter cost: %.1f %s per 20 ms cycle "
+                     "(%.2f per door)\n",
+                     (double)s_filter_time / (double)s_filter_calls,
+                     BENCH_TIMER_UNIT,
+                     (double)s_filter_time /
+                     ((double)s_filter_calls * (double)MAX_DOORS));
+    }
+
+    return 0;
+}
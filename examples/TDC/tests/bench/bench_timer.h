@@ -0,0 +1,73 @@
+/**
+ * @file    bench_timer.h
+ * @brief   Cycle-resolution timer for host and target benchmarks.
+ * @details Returns a free-running 64-bit cycle count:
+ *          - x86/x86-64 (GCC/Clang): RDTSC time-stamp counter.
+ *          - ARMv7-M (Cortex-M7 target): DWT->CYCCNT, enabled on first use.
+ *          - Otherwise: CLOCK_MONOTONIC nanoseconds (reported as "cycles"
+ *            with BENCH_TIMER_UNIT set to "ns").
+ *
+ * @note    NOT safety software — benchmark infrastructure only.
+ */
+
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#define BENCH_TIMER_UNIT "cycles"
+
+static inline uint64_t bench_cycles(void)
+{
+    uint32_t lo;
+    uint32_t hi;
+    __asm__ __volatile__ ("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) :: "memory");
+    return ((uint64_t)hi << 32U) | (uint64_t)lo;
+}
+
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+
+#define BENCH_TIMER_UNIT "cycles"
+
+#define BENCH_DEMCR      (*(volatile uint32_t *)0xE000EDFCUL)
+#define BENCH_DWT_CTRL   (*(volatile uint32_t *)0xE0001000UL)
+#define BENCH_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004UL)
+
+static inline uint64_t bench_cycles(void)
+{
+    static uint64_t s_ext   = 0U;
+    static uint32_t s_last  = 0U;
+    static uint8_t  s_ready = 0U;
+    uint32_t now;
+
+    if (0U == s_ready)
+    {
+        BENCH_DEMCR    |= (1UL << 24U);   /* TRCENA */
+        BENCH_DWT_CYCCNT = 0U;
+        BENCH_DWT_CTRL |= 1UL;            /* CYCCNTENA */
+        s_ready = 1U;
+    }
+    now = BENCH_DWT_CYCCNT;
+    s_ext += (uint64_t)(uint32_t)(now - s_last);  /* extend across wrap */
+    s_last = now;
+    return s_ext;
+}
+
+#else
+
+#include <time.h>
+
+#define BENCH_TIMER_UNIT "ns"
+
+static inline uint64_t bench_cycles(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+#endif
+
+#endif /* BENCH_TIMER_H */
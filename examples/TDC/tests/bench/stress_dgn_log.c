@@ -0,0 +1,296 @@
+/**
+ * @file    stress_dgn_log.c
+ * @brief   Host multi-threaded stress test of the lock-free DGN event log.
+ * @details Each round, BENCH_PRODUCERS threads call DGN_LogEvent
+ *          concurrently (standing in for the cycle task, background tasks
+ *          and ISRs), BENCH_EVENTS each, while
+ *          - a consumer thread takes the entries in sequence order through
+ *            DGN_CopyLogEntry, exactly as DGN_FlushToFlash does, and calls
+ *            DGN_FlushToFlash itself;
+ *          - a reader thread reads random slots through DGN_ReadEvent, as
+ *            the diagnostic port does.
+ *          Each entry carries its producer (source_comp) and per-producer
+ *          number (data). After the round every entry must have been seen
+ *          by the consumer exactly once, in per-producer order, with a
+ *          valid guard; every entry returned to the reader must have a
+ *          valid guard; the flush must be complete. One round fills at most
+ *          MAX_LOG_ENTRIES slots, so no entry is lost to overwriting.
+ *
+ *          Reported: lost, duplicated, out-of-order and torn (guard mismatch)
+ *          entries — all must be zero — and how often a reader met an entry
+ *          still being written (ERR_INVALID_STATE), i.e. how often the
+ *          commit marker was actually exercised. Exit status 1 on any error.
+ *
+ *          Build (host, from examples/TDC):
+ *            gcc -std=c99 -O2 -pthread -Isrc -Itests/stubs \
+ *                tests/bench/stress_dgn_log.c src/dgn_log.c \
+ *                src/dgn_flash.c src/hal_flash.c tests/stubs/hal_flash_sim.c \
+ *                tests/stubs/hal_stub.c tests/stubs/crc_stub.c \
+ *                -o stress_dgn_log
+ *            ./stress_dgn_log [rounds]
+ *
+ * @note    NOT safety software — test infrastructure only.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "../../src/dgn.h"
+#include "../../src/hal.h"
+
+/** @brief Concurrent writers */
+#define BENCH_PRODUCERS   (4U)
+
+/** @brief Events per writer per round (all fit in the log) */
+#define BENCH_EVENTS      ((MAX_LOG_ENTRIES - 8U) / BENCH_PRODUCERS)
+
+/** @brief Default number of rounds */
+#define BENCH_ROUNDS      (2000U)
+
+/** @brief Error and activity counters of all rounds */
+typedef struct
+{
+    uint64_t entries;       /**< Entries written */
+    uint64_t lost;          /**< Never seen by the consumer */
+    uint64_t duplicated;    /**< Seen more than once */
+    uint64_t out_of_order;  /**< Older than the producer's previous entry */
+    uint64_t torn;          /**< guard mismatch or bad payload (consumer) */
+    uint64_t torn_reads;    /**< guard mismatch or bad payload (reader) */
+    uint64_t reads;         /**< Successful random reads */
+    uint64_t busy_reads;    /**< Reads of an entry still being written */
+    uint64_t busy_takes;    /**< Consumer waits on an entry being written */
+    uint64_t unflushed;     /**< Rounds ending with DGN_GetFlushPending != 0 */
+} bench_stats_t;
+
+static bench_stats_t s_stats;
+static volatile int  s_running;    /**< Reader keeps reading */
+static volatile int  s_producing;  /**< Producers not all finished */
+static uint8_t       s_seen[BENCH_PRODUCERS][BENCH_EVENTS];
+
+/** @brief An entry is intact: guard matches and the payload is one we
+ *         wrote */
+static int entry_ok(const event_log_entry_t *e, uint8_t round)
+{
+    return (DGN_ENTRY_GUARD(e) == e->guard) &&
+           (e->source_comp >= 1U) && (e->source_comp <= BENCH_PRODUCERS) &&
+           (e->event_code == round) && (e->data < BENCH_EVENTS);
+}
+
+static int is_set(volatile int *flag)
+{
+    return __atomic_load_n(flag, __ATOMIC_ACQUIRE);
+}
+
+/** @brief Round number, written as event_code by the producers */
+static uint8_t s_round;
+
+static void *producer(void *arg)
+{
+    const uint8_t id = (uint8_t)(uintptr_t)arg;
+    uint16_t      n;
+
+    for (n = 0U; n < BENCH_EVENTS; n++)
+    {
+        (void)DGN_LogEvent(id, s_round, n);
+        if (0U == (n % 64U))
+        {
+            (void)sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/** @brief Consumer: takes every entry in sequence order, like the flusher */
+static void *consumer(void *arg)
+{
+    const uint32_t    total = BENCH_PRODUCERS * BENCH_EVENTS;
+    int32_t           last[BENCH_PRODUCERS];
+    event_log_entry_t e;
+    uint32_t          seq = 0U;
+    uint32_t          p;
+    int               done;
+
+    (void)arg;
+    for (p = 0U; p < BENCH_PRODUCERS; p++)
+    {
+        last[p] = -1;
+    }
+    while (seq < total)
+    {
+        /* Once all producers have returned, a missing entry never comes */
+        done = (0 == is_set(&s_producing));
+        if (SUCCESS != DGN_CopyLogEntry(seq, &e))
+        {
+            if (0 != done)
+            {
+                break;
+            }
+            s_stats.busy_takes++;
+            (void)sched_yield();
+            continue;
+        }
+        seq++;
+        if (0 == entry_ok(&e, s_round))
+        {
+            s_stats.torn++;
+            continue;
+        }
+        p = e.source_comp - 1U;
+        if (0U != s_seen[p][e.data])
+        {
+            s_stats.duplicated++;
+        }
+        s_seen[p][e.data] = 1U;
+        if ((int32_t)e.data <= last[p])
+        {
+            s_stats.out_of_order++;
+        }
+        last[p] = (int32_t)e.data;
+        (void)DGN_FlushToFlash();
+    }
+    return NULL;
+}
+
+/** @brief Reader: random slots through DGN_ReadEvent, like the diag port */
+static void *reader(void *arg)
+{
+    event_log_entry_t e;
+    uint32_t          r = (uint32_t)(uintptr_t)arg;
+    uint16_t          count;
+    error_t           ret;
+
+    while (0 != is_set(&s_running))
+    {
+        count = DGN_GetLogCount();
+        if (0U == count)
+        {
+            continue;
+        }
+        r   = (r * 1103515245U) + 12345U;
+        ret = DGN_ReadEvent((uint16_t)((r >> 8U) % count), &e);
+        if (SUCCESS == ret)
+        {
+            s_stats.reads++;
+            if (0 == entry_ok(&e, s_round))
+            {
+                s_stats.torn_reads++;
+            }
+        }
+        else if (ERR_INVALID_STATE == ret)
+        {
+            s_stats.busy_reads++;
+        }
+        else
+        {
+            s_stats.torn_reads++;
+        }
+    }
+    return NULL;
+}
+
+static void run_round(uint8_t round)
+{
+    pthread_t prod[BENCH_PRODUCERS];
+    pthread_t cons;
+    pthread_t rd;
+    uint32_t  p;
+    uint32_t  n;
+
+    (void)DGN_Init();
+    (void)memset(s_seen, 0, sizeof(s_seen));
+    s_round = round;
+    __atomic_store_n(&s_running, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&s_producing, 1, __ATOMIC_RELEASE);
+
+    (void)pthread_create(&rd, NULL, reader, (void *)(uintptr_t)(round + 1U));
+    (void)pthread_create(&cons, NULL, consumer, NULL);
+    for (p = 0U; p < BENCH_PRODUCERS; p++)
+    {
+        (void)pthread_create(&prod[p], NULL, producer,
+                             (void *)(uintptr_t)(p + 1U));
+    }
+    for (p = 0U; p < BENCH_PRODUCERS; p++)
+    {
+        (void)pthread_join(prod[p], NULL);
+    }
+    __atomic_store_n(&s_producing, 0, __ATOMIC_RELEASE);
+    (void)pthread_join(cons, NULL);
+    __atomic_store_n(&s_running, 0, __ATOMIC_RELEASE);
+    (void)pthread_join(rd, NULL);
+
+    /* Writers done: the remaining batches flush completely */
+    for (n = 0U; n <= (MAX_LOG_ENTRIES / 8U); n++)
+    {
+        (void)DGN_FlushToFlash();
+    }
+    if (0U != DGN_GetFlushPending())
+    {
+        s_stats.unflushed++;
+    }
+
+    s_stats.entries += (uint64_t)BENCH_PRODUCERS * BENCH_EVENTS;
+    for (p = 0U; p < BENCH_PRODUCERS; p++)
+    {
+        for (n = 0U; n < BENCH_EVENTS; n++)
+        {
+            if (0U == s_seen[p][n])
+            {
+                s_stats.lost++;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = BENCH_ROUNDS;
+    uint32_t round;
+    int      failed;
+
+    if (argc > 1)
+    {
+        rounds = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+
+    (void)printf("DGN log stress: %u producers x %u events, %u rounds, "
+                 "MAX_LOG_ENTRIES = %u\n", (unsigned)BENCH_PRODUCERS,
+                 (unsigned)BENCH_EVENTS, (unsigned)rounds,
+                 (unsigned)MAX_LOG_ENTRIES);
+
+    for (round = 0U; round < rounds; round++)
+    {
+        run_round((uint8_t)round);
+    }
+
+    (void)printf("  entries written      %llu\n",
+                 (unsigned long long)s_stats.entries);
+    (void)printf("  lost                 %llu\n",
+                 (unsigned long long)s_stats.lost);
+    (void)printf("  duplicated           %llu\n",
+                 (unsigned long long)s_stats.duplicated);
+    (void)printf("  out of order         %llu\n",
+                 (unsigned long long)s_stats.out_of_order);
+    (void)printf("  torn                 %llu consumer, %llu reader\n",
+                 (unsigned long long)s_stats.torn,
+                 (unsigned long long)s_stats.torn_reads);
+    (void)printf("  rounds not flushed   %llu\n",
+                 (unsigned long long)s_stats.unflushed);
+    (void)printf("  random reads         %llu (%llu met an entry being "
+                 "written)\n", (unsigned long long)s_stats.reads,
+                 (unsigned long long)s_stats.busy_reads);
+    (void)printf("  consumer waits       %llu\n",
+                 (unsigned long long)s_stats.busy_takes);
+
+    failed = (0U != s_stats.lost) || (0U != s_stats.duplicated) ||
+             (0U != s_stats.out_of_order) || (0U != s_stats.torn) ||
+             (0U != s_stats.torn_reads) ||
+             (0U != s_stats.unflushed);
+    (void)printf("%s\n", (0 != failed) ? "FAIL" : "PASS");
+    return (0 != failed) ? 1 : 0;
+}
@@ -4,7 +4,7 @@
  *          instead of hal_services.c.
  *
  * @note    NOT safety software — test infrastructure only.
- *          Copies the production algorithm from hal_services.c so that
+ *          Copies the bitwise reference backend of hal_crc.c so that
  *          SKN and other modules that call CRC16_CCITT_Compute can link
  *          when the real HAL is replaced by hal_stub.c.
  */
@@ -18,20 +18,19 @@
 /** @brief CRC-16-CCITT initial value */
 #define CRC16_INIT  (0xFFFFU)
 
-uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length)
+uint16_t CRC16_CCITT_Init(void)
 {
-    uint16_t crc;
-    uint16_t byte_idx;
+    return (uint16_t)CRC16_INIT;
+}
+
+uint16_t CRC16_CCITT_Update(uint16_t crc_in, const uint8_t *data, uint32_t length)
+{
+    uint16_t crc = crc_in;
+    uint32_t byte_idx;
     uint8_t  bit_idx;
 
-    if ((NULL == data) || (0U == length))
+    if ((NULL != data) && (0U != length))
     {
-        crc = 0x0000U;
-    }
-    else
-    {
-        crc = CRC16_INIT;
-
         for (byte_idx = 0U; byte_idx < length; byte_idx++)
         {
             crc ^= ((uint16_t)data[byte_idx] << 8U);
@@ -52,3 +51,24 @@ uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length)
 
     return crc;
 }
+
+uint16_t CRC16_CCITT_Final(uint16_t crc)
+{
+    return crc;
+}
+
+uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc;
+
+    if ((NULL == data) || (0U == length))
+    {
+        crc = 0x0000U;
+    }
+    else
+    {
+        crc = CRC16_CCITT_Update(CRC16_INIT, data, (uint32_t)length);
+    }
+
+    return crc;
+}
@@ -46,7 +46,7 @@ uint8_t OBD_GetFault(void)
     return s_obd_fault;
 }
 
-static uint8_t s_obstacle_flags[MAX_DOORS] = {0U, 0U, 0U, 0U};
+static uint8_t s_obstacle_flags[MAX_DOORS] = {0U};
 
 const uint8_t *OBD_GetObstacleFlags(void)
 {
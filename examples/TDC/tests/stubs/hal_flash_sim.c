@@ -0,0 +1,359 @@
+/**
+ * @file    hal_flash_sim.c
+ * @brief   Host SPI NOR device model: the HAL_FlashDev_* device layer below
+ *          HAL_Flash_* (src/hal_flash.c) for test and benchmark builds.
+ * @details NOR semantics over a RAM image of the event log partition:
+ *          - optionally backed by an image file (Linux host,
+ *            HAL_FlashSim_Attach) so the log survives the process like a
+ *            real device survives a reset;
+ *          - power-cut injection part-way through a program or erase
+ *            (HAL_FlashSim_CutPowerAfter), leaving a torn page or a
+ *            partially erased sector behind;
+ *          - per-sector erase counters and program / erase byte counters
+ *            with modelled busy time (HAL_FLASH_PROGRAM_US /
+ *            HAL_FLASH_ERASE_US), for wear and write amplification
+ *            measurement (tests/bench/bench_dgn_flash.c).
+ *
+ * @project TDC (Train Door Control System) — Unit Test Build Support
+ * @note    NOT safety software.  Test infrastructure only.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__linux__)
+#include <stdio.h>
+#endif
+
+#include "hal.h"
+#include "hal_flash_sim.h"
+#include "tdc_types.h"
+
+/** @brief Value of an erased byte */
+#define HAL_FLASH_ERASED  (0xFFU)
+
+/* -------------------------------------------------------------------------
+ * Model state
+ * ------------------------------------------------------------------------- */
+/** @brief Partition contents (erased at start-up) */
+static uint8_t s_flash_image[HAL_FLASH_SIZE_BYTES];
+
+/** @brief 1 once s_flash_image has been erased or loaded */
+static uint8_t s_flash_ready;
+
+/** @brief 0 after an injected power cut, until HAL_FlashSim_PowerOn */
+static uint8_t s_flash_powered = 1U;
+
+/** @brief 1 while a power cut is armed */
+static uint8_t s_flash_cut_armed;
+
+/** @brief Bytes of the interrupted operation that still take effect */
+static uint32_t s_flash_cut_bytes;
+
+/** @brief Erase cycles per sector */
+static uint32_t s_flash_erase_count[HAL_FLASH_SECTORS];
+
+/** @brief Activity counters */
+static hal_flash_sim_stats_t s_flash_stats;
+
+#if defined(__linux__)
+/** @brief Image file, or NULL (RAM only) */
+static FILE *s_flash_file;
+#endif
+
+/* -------------------------------------------------------------------------
+ * Model helpers
+ * ------------------------------------------------------------------------- */
+/**
+ * @brief Erase the RAM image on first use.
+ * @complexity Cyclomatic complexity: 3
+ */
+static void hal_flash_dev_ready(void)
+{
+    uint32_t i;
+
+    if (0U == s_flash_ready)
+    {
+        for (i = 0U; i < HAL_FLASH_SIZE_BYTES; i++)
+        {
+            s_flash_image[i] = HAL_FLASH_ERASED;
+        }
+        s_flash_ready = 1U;
+    }
+}
+
+/**
+ * @brief Write a changed range of the image through to the image file.
+ * @complexity Cyclomatic complexity: 2
+ */
+static void hal_flash_dev_sync(uint32_t addr, uint32_t length)
+{
+#if defined(__linux__)
+    if (NULL != s_flash_file)
+    {
+        (void)fseek(s_flash_file, (long)addr, SEEK_SET);
+        (void)fwrite(&s_flash_image[addr], 1U, (size_t)length, s_flash_file);
+        (void)fflush(s_flash_file);
+    }
+#else
+    (void)addr;
+    (void)length;
+#endif
+}
+
+/**
+ * @brief Bytes of a program / erase of @p length that take effect; applies
+ *        an armed power cut.
+ * @complexity Cyclomatic complexity: 3
+ */
+static uint32_t hal_flash_dev_budget(uint32_t length)
+{
+    uint32_t n = length;
+
+    if ((0U != s_flash_cut_armed) && (s_flash_cut_bytes < length))
+    {
+        n = s_flash_cut_bytes;
+        s_flash_cut_armed = 0U;
+        s_flash_powered   = 0U;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Model of page program (PP): AND the data into the image.
+ * @complexity Cyclomatic complexity: 3
+ */
+static error_t hal_flash_dev_program(uint32_t addr, const uint8_t *data,
+                                     uint16_t length)
+{
+    const uint32_t n = hal_flash_dev_budget(length);
+    uint32_t       i;
+
+    for (i = 0U; i < n; i++)
+    {
+        s_flash_image[addr + i] = (uint8_t)(s_flash_image[addr + i] & data[i]);
+    }
+    hal_flash_dev_sync(addr, n);
+
+    s_flash_stats.bytes_programmed += length;
+    s_flash_stats.program_ops++;
+    s_flash_stats.busy_us += HAL_FLASH_PROGRAM_US;
+
+    return (n == (uint32_t)length) ? SUCCESS : ERR_HW_FAULT;
+}
+
+/**
+ * @brief Model of sector erase (SE): set the sector to 0xFF.
+ * @complexity Cyclomatic complexity: 3
+ */
+static error_t hal_flash_dev_erase(uint32_t addr)
+{
+    const uint32_t n = hal_flash_dev_budget(HAL_FLASH_SECTOR_BYTES);
+    uint32_t       i;
+
+    for (i = 0U; i < n; i++)
+    {
+        s_flash_image[addr + i] = HAL_FLASH_ERASED;
+    }
+    hal_flash_dev_sync(addr, n);
+
+    s_flash_erase_count[addr / HAL_FLASH_SECTOR_BYTES]++;
+    s_flash_stats.bytes_erased += HAL_FLASH_SECTOR_BYTES;
+    s_flash_stats.erase_ops++;
+    s_flash_stats.busy_us += HAL_FLASH_ERASE_US;
+
+    return (n == HAL_FLASH_SECTOR_BYTES) ? SUCCESS : ERR_HW_FAULT;
+}
+
+/* -------------------------------------------------------------------------
+ * Device layer (hal.h)
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Model of READ (0x03).
+ * @complexity Cyclomatic complexity: 3
+ */
+error_t HAL_FlashDev_Read(uint32_t addr, uint8_t *data, uint32_t length)
+{
+    error_t  result = ERR_HW_FAULT;
+    uint32_t i;
+
+    if (0U != s_flash_powered)
+    {
+        hal_flash_dev_ready();
+        for (i = 0U; i < length; i++)
+        {
+            data[i] = s_flash_image[addr + i];
+        }
+        result = SUCCESS;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Model of WREN (0x06) + PP (0x02).
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t HAL_FlashDev_Program(uint32_t addr, const uint8_t *data,
+                             uint16_t length)
+{
+    error_t result = ERR_HW_FAULT;
+
+    if (0U != s_flash_powered)
+    {
+        hal_flash_dev_ready();
+        result = hal_flash_dev_program(addr, data, length);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Model of WREN (0x06) + SE (0x20).
+ * @complexity Cyclomatic complexity: 2
+ */
+error_t HAL_FlashDev_Erase(uint32_t addr)
+{
+    error_t result = ERR_HW_FAULT;
+
+    if (0U != s_flash_powered)
+    {
+        hal_flash_dev_ready();
+        result = hal_flash_dev_erase(addr);
+    }
+
+    return result;
+}
+
+/* -------------------------------------------------------------------------
+ * Model control (hal_flash_sim.h)
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Erase the whole partition, clear the counters and power on.
+ * @complexity Cyclomatic complexity: 2
+ */
+void HAL_FlashSim_Reset(void)
+{
+    uint16_t s;
+
+    s_flash_ready = 0U;
+    hal_flash_dev_ready();
+    hal_flash_dev_sync(0U, HAL_FLASH_SIZE_BYTES);
+
+    for (s = 0U; s < HAL_FLASH_SECTORS; s++)
+    {
+        s_flash_erase_count[s] = 0U;
+    }
+    s_flash_stats.bytes_programmed = 0U;
+    s_flash_stats.bytes_erased     = 0U;
+    s_flash_stats.program_ops      = 0U;
+    s_flash_stats.erase_ops        = 0U;
+    s_flash_stats.busy_us          = 0U;
+
+    s_flash_cut_armed = 0U;
+    s_flash_powered   = 1U;
+}
+
+/**
+ * @brief Arm a power cut after @p bytes of the next program or erase.
+ * @complexity Cyclomatic complexity: 1
+ */
+void HAL_FlashSim_CutPowerAfter(uint32_t bytes)
+{
+    s_flash_cut_bytes = bytes;
+    s_flash_cut_armed = 1U;
+}
+
+/**
+ * @brief Restore power.
+ * @complexity Cyclomatic complexity: 1
+ */
+void HAL_FlashSim_PowerOn(void)
+{
+    s_flash_cut_armed = 0U;
+    s_flash_powered   = 1U;
+}
+
+/**
+ * @brief Erase cycles of one sector.
+ * @complexity Cyclomatic complexity: 2
+ */
+uint32_t HAL_FlashSim_GetEraseCount(uint16_t sector)
+{
+    return (sector < HAL_FLASH_SECTORS) ? s_flash_erase_count[sector] : 0U;
+}
+
+/**
+ * @brief Activity counters.
+ * @complexity Cyclomatic complexity: 2
+ */
+void HAL_FlashSim_GetStats(hal_flash_sim_stats_t *stats_out)
+{
+    if (NULL != stats_out)
+    {
+        *stats_out = s_flash_stats;
+    }
+}
+
+#if defined(__linux__)
+/**
+ * @brief Back the partition with an image file.
+ * @details A file shorter than the partition (e.g. newly created) is
+ *          padded with erased bytes.
+ * @complexity Cyclomatic complexity: 6
+ */
+error_t HAL_FlashSim_Attach(const char *path)
+{
+    error_t result = SUCCESS;
+    size_t  loaded;
+
+    HAL_FlashSim_Detach();
+    if (NULL == path)
+    {
+        result = ERR_NULL_PTR;
+    }
+    else
+    {
+        s_flash_file = fopen(path, "r+b");
+        if (NULL == s_flash_file)
+        {
+            s_flash_file = fopen(path, "w+b");
+        }
+    }
+
+    if ((SUCCESS == result) && (NULL == s_flash_file))
+    {
+        result = ERR_HW_FAULT;
+    }
+    else if (SUCCESS == result)
+    {
+        s_flash_ready = 0U;
+        hal_flash_dev_ready();
+        loaded = fread(s_flash_image, 1U, HAL_FLASH_SIZE_BYTES, s_flash_file);
+        hal_flash_dev_sync((uint32_t)loaded,
+                           HAL_FLASH_SIZE_BYTES - (uint32_t)loaded);
+    }
+    else
+    {
+        /* ERR_NULL_PTR */
+    }
+
+    return result;
+}
+
+/**
+ * @brief Close the image file.
+ * @complexity Cyclomatic complexity: 2
+ */
+void HAL_FlashSim_Detach(void)
+{
+    if (NULL != s_flash_file)
+    {
+        (void)fclose(s_flash_file);
+        s_flash_file = NULL;
+    }
+}
+#endif
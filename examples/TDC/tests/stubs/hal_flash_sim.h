@@ -0,0 +1,85 @@
+/**
+ * @file    hal_flash_sim.h
+ * @brief   Host SPI NOR device model behind HAL_Flash_* — control interface.
+ * @details tests/stubs/hal_flash_sim.c implements the HAL_FlashDev_* device
+ *          layer (hal.h) over a RAM image of the event log partition and
+ *          adds the controls below for tests and benchmarks: power-cut
+ *          injection, wear and activity counters with modelled busy time,
+ *          and (Linux host) an image file so the log survives the process.
+ *
+ * @project TDC (Train Door Control System) — Unit Test Build Support
+ * @note    NOT safety software.  Test infrastructure only.
+ */
+
+#ifndef HAL_FLASH_SIM_H
+#define HAL_FLASH_SIM_H
+
+#include <stdint.h>
+#include "hal.h"
+#include "tdc_types.h"
+
+/** @brief Typical page program time, µs (W25Q64JV tPP) */
+#define HAL_FLASH_PROGRAM_US     (400U)
+
+/** @brief Typical sector erase time, µs (W25Q64JV tSE) */
+#define HAL_FLASH_ERASE_US       (45000U)
+
+/** @brief Activity counters of the host flash model */
+typedef struct {
+    uint64_t bytes_programmed;  /**< Bytes passed to HAL_Flash_ProgramPage */
+    uint64_t bytes_erased;      /**< Sectors erased x HAL_FLASH_SECTOR_BYTES */
+    uint32_t program_ops;       /**< HAL_Flash_ProgramPage calls accepted */
+    uint32_t erase_ops;         /**< HAL_Flash_EraseSector calls accepted */
+    uint64_t busy_us;           /**< Modelled device busy time */
+} hal_flash_sim_stats_t;
+
+/**
+ * @brief Erase the whole partition, clear the counters and power on. An
+ *        attached image file is rewritten.
+ */
+void HAL_FlashSim_Reset(void);
+
+/**
+ * @brief Cut the power part-way through the next program or erase, after
+ *        @p bytes bytes of it have changed. That call and every later one
+ *        fail with ERR_HW_FAULT until HAL_FlashSim_PowerOn.
+ * @param[in] bytes Bytes of the interrupted operation that take effect
+ */
+void HAL_FlashSim_CutPowerAfter(uint32_t bytes);
+
+/**
+ * @brief Restore power (contents are kept).
+ */
+void HAL_FlashSim_PowerOn(void);
+
+/**
+ * @brief Erase cycles of one sector since HAL_FlashSim_Reset.
+ * @param[in] sector Sector index (0 .. HAL_FLASH_SECTORS-1)
+ * @return uint32_t Erase count (0 for an invalid index)
+ */
+uint32_t HAL_FlashSim_GetEraseCount(uint16_t sector);
+
+/**
+ * @brief Activity counters since HAL_FlashSim_Reset.
+ * @param[out] stats_out Counters (ignored if NULL)
+ */
+void HAL_FlashSim_GetStats(hal_flash_sim_stats_t *stats_out);
+
+#if defined(__linux__)
+/**
+ * @brief Back the partition with an image file. An existing file is loaded
+ *        (its contents survive the process, like a real device across a
+ *        reset); a missing one is created erased. Every later program /
+ *        erase is written through to the file.
+ * @param[in] path Image file path (must not be NULL)
+ * @return error_t SUCCESS, ERR_NULL_PTR, ERR_HW_FAULT (file I/O)
+ */
+error_t HAL_FlashSim_Attach(const char *path);
+
+/**
+ * @brief Close the image file; the RAM image is kept.
+ */
+void HAL_FlashSim_Detach(void);
+#endif
+
+#endif /* HAL_FLASH_SIM_H */
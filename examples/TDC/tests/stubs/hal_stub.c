@@ -23,33 +23,86 @@ uint8_t  hal_stub_can_receive_data[8] = {0};
 uint8_t  hal_stub_can_receive_dlc   = 5U;
 
 error_t  hal_stub_can_transmit_ret  = SUCCESS;
+uint32_t hal_stub_can_transmit_count = 0U; /* HAL_CAN_Transmit calls */
+uint32_t hal_stub_can_transmit_id   = 0U;  /* msg_id of the last transmit */
+uint8_t  hal_stub_can_transmit_data0 = 0U; /* data[0] of the last transmit */
 error_t  hal_stub_spi_exchange_ret  = SUCCESS;
 error_t  hal_stub_watchdog_ret      = SUCCESS;
 uint32_t hal_stub_tick_ms           = 0U;
+uint32_t hal_stub_cycle_counter     = 0U;   /* HAL_GetCycleCounter value */
+uint32_t hal_stub_estop_count       = 0U;   /* HAL_EmergencyMotorStop calls */
+uint32_t hal_stub_estop_write_ticks = 0U;   /* Cycle counter advance per call */
+uint8_t  hal_stub_motor_inhibit     = 0U;   /* Set by HAL_EmergencyMotorStop */
+uint32_t hal_stub_inhibit_release_count = 0U; /* HAL_ReleaseMotorInhibit calls */
+uint32_t hal_stub_stop_now_count    = 0U;   /* HAL_MotorStopNow calls */
+uint8_t  hal_stub_stop_now_door     = 0xFFU; /* door_id of the last call */
 uint8_t  hal_stub_gpio_value        = 0U;   /* position/lock sensor value */
 uint8_t  hal_stub_emerg_gpio        = 0U;   /* emergency release GPIO */
+uint8_t  hal_stub_input_fault_mask  = 0U;   /* input image read_fault bits */
 error_t  hal_stub_motor_start_ret   = SUCCESS;
 error_t  hal_stub_motor_stop_ret    = SUCCESS;
 error_t  hal_stub_lock_engage_ret   = SUCCESS;
 error_t  hal_stub_lock_disengage_ret = SUCCESS;
 
+/* Motor current scan: HAL_ADC_DmaBlockISR completes the next block from
+ * hal_stub_adc_block into a ring like the HAL's. With hal_stub_adc_auto set
+ * each drain (takes until ERR_TIMEOUT) gets exactly one new block; clear it
+ * to complete blocks from the test by calling HAL_ADC_DmaBlockISR. */
+hal_adc_block_t hal_stub_adc_block;
+error_t  hal_stub_adc_take_ret      = SUCCESS;
+uint8_t  hal_stub_adc_auto          = 1U;
+
+static hal_adc_block_t s_stub_adc_ring[HAL_ADC_RING_BLOCKS];
+static uint32_t        s_stub_adc_seq;
+static uint32_t        s_stub_adc_taken;
+static uint8_t         s_stub_adc_drained;
+
+/* Called by HAL_GetSystemTickMs when set: lets a test run code at that
+ * point, e.g. an ISR preempting DGN_LogEvent between slot reservation and
+ * commit */
+void (*hal_stub_tick_hook)(void)    = NULL;
+
+/* Called at the end of HAL_ReleaseMotorInhibit when set: lets a test run an
+ * emergency stop ISR during the release */
+void (*hal_stub_release_hook)(void) = NULL;
+
+/* Actuator call trace: each motor/lock call shifts in a 3-bit code
+ * (1 = start open, 2 = start close, 3 = stop, 4 = lock, 5 = unlock) */
+uint32_t hal_stub_actuator_trace    = 0U;
+
 /* Remote SPI state for SKN exchange tests */
 #include "skn.h"
-static cross_channel_state_t s_spi_remote;
-void hal_stub_set_spi_remote(const cross_channel_state_t *r)
+static cross_channel_wire_t s_spi_remote;
+void hal_stub_set_spi_remote(const cross_channel_wire_t *r)
 {
     if (r != NULL) { s_spi_remote = *r; }
 }
 
+/* Asynchronous SPI model: the "DMA" completes hal_stub_spi_transfer_ticks
+ * after Start; Complete advances hal_stub_cycle_counter to that point if
+ * called earlier (simulated busy-wait). Errors are injected at Complete. */
+uint32_t hal_stub_spi_transfer_ticks = 0U;
+static uint8_t  s_stub_spi_busy;
+static uint32_t s_stub_spi_start;
+
 /* -------------------------------------------------------------------------
  * HAL stub implementations
  * ------------------------------------------------------------------------- */
 
 uint32_t HAL_GetSystemTickMs(void)
 {
+    if (NULL != hal_stub_tick_hook)
+    {
+        hal_stub_tick_hook();
+    }
     return hal_stub_tick_ms;
 }
 
+uint32_t HAL_GetCycleCounter(void)
+{
+    return hal_stub_cycle_counter;
+}
+
 error_t HAL_CAN_Receive(uint32_t *msg_id_out, uint8_t *data_out, uint8_t *dlc_out)
 {
     uint8_t i;
@@ -72,14 +125,15 @@ error_t HAL_CAN_Receive(uint32_t *msg_id_out, uint8_t *data_out, uint8_t *dlc_ou
 
 error_t HAL_CAN_Transmit(uint32_t msg_id, const uint8_t *data, uint8_t dlc)
 {
-    (void)msg_id;
-    (void)data;
     (void)dlc;
+    hal_stub_can_transmit_id    = msg_id;
+    hal_stub_can_transmit_data0 = (NULL != data) ? data[0] : 0U;
+    hal_stub_can_transmit_count++;
     return hal_stub_can_transmit_ret;
 }
 
-error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
-                                       cross_channel_state_t       *remote_out)
+error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_wire_t *local,
+                                       cross_channel_wire_t       *remote_out)
 {
     (void)local;
     if (remote_out != NULL)
@@ -89,6 +143,47 @@ error_t HAL_SPI_CrossChannel_Exchange(const cross_channel_state_t *local,
     return hal_stub_spi_exchange_ret;
 }
 
+error_t HAL_SPI_CrossChannel_Start(const cross_channel_wire_t *local)
+{
+    if (local == NULL)          { return ERR_NULL_PTR; }
+    if (s_stub_spi_busy != 0U)  { return ERR_INVALID_STATE; }
+    s_stub_spi_busy  = 1U;
+    s_stub_spi_start = hal_stub_cycle_counter;
+    return SUCCESS;
+}
+
+error_t HAL_SPI_CrossChannel_Poll(uint8_t *done_out)
+{
+    if (done_out == NULL)       { return ERR_NULL_PTR; }
+    if (s_stub_spi_busy == 0U)  { return ERR_INVALID_STATE; }
+    *done_out = ((hal_stub_cycle_counter - s_stub_spi_start) >=
+                 hal_stub_spi_transfer_ticks) ? 1U : 0U;
+    return SUCCESS;
+}
+
+error_t HAL_SPI_CrossChannel_Complete(cross_channel_wire_t *remote)
+{
+    if (remote == NULL)         { return ERR_NULL_PTR; }
+    if (s_stub_spi_busy == 0U)  { return ERR_INVALID_STATE; }
+    s_stub_spi_busy = 0U;
+    if ((hal_stub_cycle_counter - s_stub_spi_start) <
+        hal_stub_spi_transfer_ticks)
+    {
+        hal_stub_cycle_counter = s_stub_spi_start + hal_stub_spi_transfer_ticks;
+    }
+    *remote = s_spi_remote;
+    return hal_stub_spi_exchange_ret;
+}
+
+uint32_t HAL_SPI_CrossChannel_GetTransferTicks(void)
+{
+    return hal_stub_spi_transfer_ticks;
+}
+
+void HAL_SPI_DmaCompleteISR(void)
+{
+}
+
 error_t HAL_Watchdog_Refresh(void)
 {
     return hal_stub_watchdog_ret;
@@ -120,33 +215,116 @@ uint8_t HAL_GPIO_ReadEmergencyRelease(uint8_t door_id)
     return hal_stub_emerg_gpio;
 }
 
+/* Input process image — rebuilt from the stub control variables on every
+ * access so tests may change them between calls without a capture step.
+ * Doors flagged in hal_stub_input_fault_mask are reported as the real HAL
+ * reports unreadable inputs (obstacle bits set, all other bits clear). */
+static hal_input_image_t s_input_image;
+
+const hal_input_image_t *HAL_GPIO_GetInputImage(void)
+{
+    door_mask_t all   = DOOR_MASK_ALL;
+    door_mask_t fault = (door_mask_t)hal_stub_input_fault_mask & all;
+    door_mask_t gpio  = (hal_stub_gpio_value != 0U) ? all : 0U;
+    door_mask_t ok    = all & ~fault;
+
+    s_input_image.position_a = gpio & ok;
+    s_input_image.position_b = gpio & ok;
+    s_input_image.lock_a     = gpio & ok;
+    s_input_image.lock_b     = gpio & ok;
+    s_input_image.obstacle_a = (gpio & ok) | fault;
+    s_input_image.obstacle_b = s_input_image.obstacle_a;
+    s_input_image.emergency  = ((hal_stub_emerg_gpio != 0U) ? all : 0U) & ok;
+    s_input_image.read_fault = fault;
+    return &s_input_image;
+}
+
+error_t HAL_GPIO_CaptureInputImage(void)
+{
+    (void)HAL_GPIO_GetInputImage();
+    return SUCCESS;
+}
+
 error_t HAL_MotorStart(uint8_t door_id, uint8_t direction)
 {
     (void)door_id;
-    (void)direction;
+    hal_stub_actuator_trace = (hal_stub_actuator_trace << 3U) |
+                              ((direction != 0U) ? 1U : 2U);
     return hal_stub_motor_start_ret;
 }
 
 error_t HAL_MotorStop(uint8_t door_id)
 {
     (void)door_id;
+    hal_stub_actuator_trace = (hal_stub_actuator_trace << 3U) | 3U;
     return hal_stub_motor_stop_ret;
 }
 
 error_t HAL_LockEngage(uint8_t door_id)
 {
     (void)door_id;
+    hal_stub_actuator_trace = (hal_stub_actuator_trace << 3U) | 4U;
     return hal_stub_lock_engage_ret;
 }
 
 error_t HAL_LockDisengage(uint8_t door_id)
 {
     (void)door_id;
+    hal_stub_actuator_trace = (hal_stub_actuator_trace << 3U) | 5U;
     return hal_stub_lock_disengage_ret;
 }
 
+error_t HAL_CommitOutputImage(void)
+{
+    return SUCCESS;
+}
+
+/* Emergency stop: models the register write time on the cycle counter */
+error_t HAL_EmergencyMotorStop(void)
+{
+    hal_stub_cycle_counter += hal_stub_estop_write_ticks;
+    hal_stub_estop_count++;
+    hal_stub_motor_inhibit = 1U;
+    return SUCCESS;
+}
+
+error_t HAL_ReleaseMotorInhibit(void)
+{
+    hal_stub_motor_inhibit = 0U;
+    hal_stub_inhibit_release_count++;
+    if (NULL != hal_stub_release_hook)
+    {
+        hal_stub_release_hook();
+    }
+    return SUCCESS;
+}
+
+/* Single-door immediate stop: same register write time model */
+error_t HAL_MotorStopNow(uint8_t door_id)
+{
+    if (door_id >= MAX_DOORS) { return ERR_RANGE; }
+    hal_stub_cycle_counter += hal_stub_estop_write_ticks;
+    hal_stub_stop_now_door  = door_id;
+    hal_stub_stop_now_count++;
+    return SUCCESS;
+}
+
+uint8_t HAL_IsMotorInhibited(void)
+{
+    return hal_stub_motor_inhibit;
+}
+
+uint8_t HAL_GetOutputWriteCount(void)
+{
+    return 0U;
+}
+
 error_t HAL_Init(void)
 {
+    hal_stub_motor_inhibit = 0U;
+    s_stub_adc_seq     = 0U;
+    s_stub_adc_taken   = 0U;
+    s_stub_adc_drained = 0U;
     return SUCCESS;
 }
 
@@ -168,6 +346,37 @@ error_t HAL_ADC_ReadMotorCurrent(uint8_t door_id, uint16_t *adc_value)
     return SUCCESS;
 }
 
+error_t HAL_ADC_TakeBlock(const hal_adc_block_t **block_out,
+                          uint32_t *seq_out)
+{
+    if ((block_out == NULL) || (seq_out == NULL)) { return ERR_NULL_PTR; }
+    if (hal_stub_adc_take_ret != SUCCESS) { return hal_stub_adc_take_ret; }
+    if (s_stub_adc_seq == s_stub_adc_taken)
+    {
+        /* Auto: alternate one block / ERR_TIMEOUT, one block per drain */
+        s_stub_adc_drained = (uint8_t)(s_stub_adc_drained ^ 1U);
+        if ((hal_stub_adc_auto == 0U) || (s_stub_adc_drained == 0U))
+        {
+            return ERR_TIMEOUT;
+        }
+        HAL_ADC_DmaBlockISR();
+    }
+    if ((s_stub_adc_seq - s_stub_adc_taken) > (HAL_ADC_RING_BLOCKS - 1U))
+    {
+        s_stub_adc_taken = s_stub_adc_seq - (HAL_ADC_RING_BLOCKS - 1U);
+    }
+    *block_out = &s_stub_adc_ring[s_stub_adc_taken % HAL_ADC_RING_BLOCKS];
+    *seq_out   = s_stub_adc_taken;
+    s_stub_adc_taken++;
+    return SUCCESS;
+}
+
+void HAL_ADC_DmaBlockISR(void)
+{
+    s_stub_adc_ring[s_stub_adc_seq % HAL_ADC_RING_BLOCKS] = hal_stub_adc_block;
+    s_stub_adc_seq++;
+}
+
 error_t HAL_GPIO_SetMotorDirection(uint8_t door_id, uint8_t direction)
 {
     (void)direction;
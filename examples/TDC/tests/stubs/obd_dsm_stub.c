@@ -1,8 +1,8 @@
 /**
  * @file    obd_dsm_stub.c
  * @brief   DSM stub for OBD unit tests.
- *          obd_detect.c calls DSM_GetClosingFlags() to determine which
- *          doors are closing.  This stub returns a controllable array.
+ *          obd_detect.c calls DSM_GetClosingMask() to determine which
+ *          doors are closing.  This stub derives it from a controllable array.
  *
  * @project TDC (Train Door Control System) — Unit Test Build Support
  * @note    NOT safety software.  Test infrastructure only.
@@ -13,7 +13,7 @@
 #include "dsm.h"
 #include "tdc_types.h"
 
-static uint8_t s_closing_flags[MAX_DOORS] = {0U, 0U, 0U, 0U};
+static uint8_t s_closing_flags[MAX_DOORS] = {0U};
 
 void obd_stub_set_closing_flags(const uint8_t flags[MAX_DOORS])
 {
@@ -28,3 +28,14 @@ const uint8_t *DSM_GetClosingFlags(void)
 {
     return s_closing_flags;
 }
+
+door_mask_t DSM_GetClosingMask(void)
+{
+    door_mask_t mask = 0U;
+    uint8_t     i;
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        mask |= (door_mask_t)(s_closing_flags[i] & 1U) << i;
+    }
+    return mask;
+}
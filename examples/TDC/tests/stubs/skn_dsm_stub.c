@@ -0,0 +1,27 @@
+/**
+ * @file    skn_dsm_stub.c
+ * @brief   DSM stub for SKN unit tests.
+ *          The diagnostic-port background job (skn_background.c) reads the
+ *          operating mode.  Each call also advances the HAL stub cycle
+ *          counter by skn_stub_diag_cost_ticks, so a test can give that
+ *          job's chunk a known cost.
+ *
+ * @project TDC (Train Door Control System) — Unit Test Build Support
+ * @note    NOT safety software.  Test infrastructure only.
+ */
+
+#include <stdint.h>
+#include "dsm.h"
+#include "tdc_types.h"
+
+extern uint32_t hal_stub_cycle_counter;
+
+uint32_t skn_stub_diag_cost_ticks = 0U;
+uint32_t skn_stub_diag_calls      = 0U;
+
+op_mode_t DSM_GetMode(void)
+{
+    skn_stub_diag_calls++;
+    hal_stub_cycle_counter += skn_stub_diag_cost_ticks;
+    return MODE_NORMAL;
+}
@@ -19,4 +19,7 @@ uint8_t g_safe_state_active      = 1U;  /* Default fail-safe ON */
 uint8_t g_speed_interlock_active = 1U;  /* Default inhibit at startup */
 
 /** @brief Global obstacle flags per door */
-uint8_t g_obstacle_flags[MAX_DOORS] = {0U, 0U, 0U, 0U};
+uint8_t g_obstacle_flags[MAX_DOORS] = {0U};
+
+/** @brief Mask form of g_obstacle_flags */
+door_mask_t g_obstacle_mask = 0U;
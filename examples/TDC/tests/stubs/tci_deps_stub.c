@@ -4,7 +4,9 @@
  *          tci_init.c calls: SKN_GetDepartureInterlock, DSM_GetDoorStates,
  *          DSM_GetLockStates, FMG_GetFaultState.
  *          tci_rx.c calls: DSM_ProcessOpenCommand, DSM_ProcessCloseCommand,
- *          FMG_ProcessEmergencyStop.
+ *          FMG_ProcessEmergencyStop (calls counted for TC-TCI-026/027),
+ *          FMG_ReleaseEmergencyStop, FMG_IsEmergencyStopActive (stop flag
+ *          modelled for TC-TCI-028/029).
  *
  * @project TDC (Train Door Control System) — Unit Test Build Support
  * @note    NOT safety software.  Test infrastructure only.
@@ -20,11 +22,27 @@
 /* -------------------------------------------------------------------------
  * Static stub state
  * ------------------------------------------------------------------------- */
-static uint8_t s_door_states[MAX_DOORS]  = {0U, 0U, 0U, 0U};
-static uint8_t s_lock_states[MAX_DOORS]  = {0U, 0U, 0U, 0U};
+static uint8_t s_door_states[MAX_DOORS]  = {0U};
+static uint8_t s_lock_states[MAX_DOORS]  = {0U};
 static uint8_t s_fault_state             = 0U;
 static uint8_t s_departure_interlock     = 0U;
 
+/** @brief Order in which DSM commands reached the stub (TC-TCI-020) */
+#define TCI_STUB_CMD_LOG_LEN  (16U)
+static uint8_t s_cmd_log[TCI_STUB_CMD_LOG_LEN];   /* 'O' = open, 'C' = close */
+static door_mask_t s_cmd_mask[TCI_STUB_CMD_LOG_LEN];
+static uint8_t s_cmd_count               = 0U;
+
+static void stub_log_cmd(uint8_t kind, door_mask_t door_mask)
+{
+    if (s_cmd_count < TCI_STUB_CMD_LOG_LEN)
+    {
+        s_cmd_log[s_cmd_count]  = kind;
+        s_cmd_mask[s_cmd_count] = door_mask;
+        s_cmd_count++;
+    }
+}
+
 /* -------------------------------------------------------------------------
  * DSM stubs
  * ------------------------------------------------------------------------- */
@@ -38,15 +56,15 @@ const uint8_t *DSM_GetLockStates(void)
     return s_lock_states;
 }
 
-error_t DSM_ProcessOpenCommand(uint8_t door_mask)
+error_t DSM_ProcessOpenCommand(door_mask_t door_mask)
 {
-    (void)door_mask;
+    stub_log_cmd((uint8_t)'O', door_mask);
     return SUCCESS;
 }
 
-error_t DSM_ProcessCloseCommand(uint8_t door_mask)
+error_t DSM_ProcessCloseCommand(door_mask_t door_mask)
 {
-    (void)door_mask;
+    stub_log_cmd((uint8_t)'C', door_mask);
     return SUCCESS;
 }
 
@@ -58,12 +76,31 @@ uint8_t FMG_GetFaultState(void)
     return s_fault_state;
 }
 
+static uint8_t s_estop_count   = 0U;
+static uint8_t s_estop_code    = 0U;
+static uint8_t s_estop_active  = 0U;
+static uint8_t s_release_count = 0U;
+
 error_t FMG_ProcessEmergencyStop(uint8_t stop_code)
 {
-    (void)stop_code;
+    s_estop_code   = stop_code;
+    s_estop_active = 1U;
+    s_estop_count++;
+    return SUCCESS;
+}
+
+error_t FMG_ReleaseEmergencyStop(void)
+{
+    s_estop_active = 0U;
+    s_release_count++;
     return SUCCESS;
 }
 
+uint8_t FMG_IsEmergencyStopActive(void)
+{
+    return s_estop_active;
+}
+
 /* -------------------------------------------------------------------------
  * SKN stubs
  * ------------------------------------------------------------------------- */
@@ -78,3 +115,14 @@ uint8_t SKN_GetDepartureInterlock(void)
  * ------------------------------------------------------------------------- */
 void tci_stub_set_fault_state(uint8_t val)       { s_fault_state         = val; }
 void tci_stub_set_departure_interlock(uint8_t v) { s_departure_interlock = v;   }
+void    tci_stub_reset_cmd_log(void)             { s_cmd_count = 0U;            }
+uint8_t tci_stub_get_cmd_count(void)             { return s_cmd_count;          }
+uint8_t tci_stub_get_cmd(uint8_t idx)            { return s_cmd_log[idx];       }
+door_mask_t tci_stub_get_cmd_mask(uint8_t idx)   { return s_cmd_mask[idx];      }
+void    tci_stub_reset_estop(void)               { s_estop_count = 0U;
+                                                   s_estop_active = 0U;
+                                                   s_release_count = 0U;        }
+uint8_t tci_stub_get_estop_count(void)           { return s_estop_count;        }
+uint8_t tci_stub_get_estop_code(void)            { return s_estop_code;         }
+uint8_t tci_stub_get_estop_active(void)          { return s_estop_active;       }
+uint8_t tci_stub_get_release_count(void)         { return s_release_count;      }
@@ -1,8 +1,15 @@
 /**
  * @file    test_dgn.c
- * @brief   Unit tests for DGN module (COMP-007, SIL 1) — 3 test cases.
- * @details Covers TC-DGN-001 through TC-DGN-003.
- *          Tests: DGN_LogEvent, DGN_ReadEvent, DGN_GetLogCount.
+ * @brief   Unit tests for DGN module (COMP-007, SIL 1) — 12 test cases.
+ * @details Covers TC-DGN-001 through TC-DGN-012.
+ *          Tests: DGN_LogEvent, DGN_ReadEvent, DGN_GetLogCount,
+ *                 DGN_CopyLogEntry, DGN_FlushToFlash, DGN_GetFlushPending,
+ *                 DGN_GetGuardFailCount, DGN_SyncToFlash, DGN_MountFlash,
+ *                 DGN_ReadFlashPage, DGN_GetFlashStats.
+ *          TC-DGN-010..012 run the Flash log on the host flash model
+ *          (stubs/hal_flash_sim.c): sector rotation, remount, power cuts.
+ *          TC-DGN-004/005 cover the cycle profiler and run only in builds
+ *          with -DDGN_PROFILE_ENABLE=1 (dgn_profile.c).
  *          DGN is SIL 1 — branch coverage HR, statement coverage HR.
  *
  * @project TDC (Train Door Control System)
@@ -13,15 +20,28 @@
  * @traceability
  *   Tests: REQ-FUN-018
  *   Item 16: Software Component Test Specification §COMP-007
- *   Item 18: Source Code (dgn_log.c)
+ *   Item 18: Source Code (dgn_log.c, dgn_flash.c, dgn_profile.c,
+ *            hal_flash.c)
  */
 
+#include <string.h>
+
 #include "../unity/src/unity.h"
 #include "../../src/tdc_types.h"
 #include "../../src/dgn.h"
 #include "../../src/hal.h"
+#include "stubs/hal_flash_sim.h"
 
 extern uint32_t hal_stub_tick_ms;
+extern uint32_t hal_stub_cycle_counter;
+extern void (*hal_stub_tick_hook)(void);
+extern event_log_entry_t g_dgn_log[MAX_LOG_ENTRIES];
+
+/** @brief Pages in the Flash log ring */
+#define TEST_FLASH_PAGES   (HAL_FLASH_SIZE_BYTES / DGN_FLASH_PAGE_BYTES)
+
+/** @brief Pages per erase sector */
+#define TEST_FLASH_PPS     (HAL_FLASH_SECTOR_BYTES / DGN_FLASH_PAGE_BYTES)
 
 /* =========================================================================
  * setUp / tearDown
@@ -30,10 +50,14 @@ void setUp(void)
 {
     hal_stub_tick_ms = 1000U;
     (void)HAL_Init();
+    HAL_FlashSim_Reset();
     (void)DGN_Init();
 }
 
-void tearDown(void) {}
+void tearDown(void)
+{
+    hal_stub_tick_hook = NULL;
+}
 
 /* =========================================================================
  * TC-DGN-001: DGN_LogEvent — write and read back single entry
@@ -101,6 +125,448 @@ void test_DGN_ReadEvent_ErrorCases(void)
     TEST_ASSERT_EQUAL_INT(ERR_RANGE, ret);
 }
 
+/* =========================================================================
+ * TC-DGN-006: DGN_FlushToFlash — one bounded batch (8 entries) per call;
+ *             DGN_GetFlushPending counts down to zero
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlushToFlash_BatchedPending(void)
+{
+    /* TC-DGN-006 */
+    uint16_t i;
+
+    for (i = 0U; i < 20U; i++)
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x01U, i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(20U, DGN_GetFlushPending());
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(12U, DGN_GetFlushPending());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(0U, DGN_GetFlushPending());
+
+    /* Nothing pending: flush is a no-op */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(0U, DGN_GetFlushPending());
+}
+
+/* =========================================================================
+ * TC-DGN-007: DGN_LogEvent — a writer preempted between slot reservation
+ *             and commit (nested call from the tick read, as from an ISR):
+ *             the nested entry takes the next slot, the half-written entry
+ *             is not readable and stops the flush until it is committed
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+static uint16_t          s_tc007_count;
+static error_t           s_tc007_read_ret[2];
+static uint16_t          s_tc007_pending;
+static event_log_entry_t s_tc007_entry;
+
+/** @brief Runs inside the outer DGN_LogEvent (the "ISR") */
+static void tc007_isr(void)
+{
+    hal_stub_tick_hook = NULL;
+    (void)DGN_LogEvent(COMP_TCI, EVT_CAN_RX_OVERFLOW, 0x00AAU);
+    s_tc007_count       = DGN_GetLogCount();
+    s_tc007_read_ret[0] = DGN_ReadEvent(0U, &s_tc007_entry);
+    s_tc007_read_ret[1] = DGN_ReadEvent(1U, &s_tc007_entry);
+    (void)DGN_FlushToFlash();
+    s_tc007_pending     = DGN_GetFlushPending();
+}
+
+void test_DGN_LogEvent_PreemptedWriter_NotReadUntilCommitted(void)
+{
+    /* TC-DGN-007 */
+    event_log_entry_t entry;
+
+    hal_stub_tick_hook = tc007_isr;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_LogEvent(COMP_DSM, EVT_FSM_FAULT, 0x0055U));
+
+    TEST_ASSERT_EQUAL_UINT16(2U, s_tc007_count);
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE, s_tc007_read_ret[0]);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, s_tc007_read_ret[1]);
+    TEST_ASSERT_EQUAL_UINT8(COMP_TCI, s_tc007_entry.source_comp);
+    TEST_ASSERT_EQUAL_UINT16(0x00AAU, s_tc007_entry.data);
+    TEST_ASSERT_EQUAL_UINT16(2U, s_tc007_pending);   /* Nothing flushed */
+
+    /* Committed: both readable, flushed in write order */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(0U, &entry));
+    TEST_ASSERT_EQUAL_UINT8(COMP_DSM, entry.source_comp);
+    TEST_ASSERT_EQUAL_UINT16(0x0055U, entry.data);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(0U, DGN_GetFlushPending());
+
+    /* Sequence access: overwritten / not yet written → ERR_INVALID_STATE */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_CopyLogEntry(1U, &entry));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE,
+                          DGN_CopyLogEntry(1U + MAX_LOG_ENTRIES, &entry));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE, DGN_CopyLogEntry(2U, &entry));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, DGN_CopyLogEntry(0U, NULL));
+}
+
+/* =========================================================================
+ * TC-DGN-008: DGN_FlushToFlash — writers lapping the flusher: pending is
+ *             capped at MAX_LOG_ENTRIES and the flush resumes at the oldest
+ *             entry still in the log
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlushToFlash_LappedResumesAtOldest(void)
+{
+    /* TC-DGN-008 */
+    event_log_entry_t entry;
+    uint32_t i;
+
+    for (i = 0U; i < (MAX_LOG_ENTRIES + 5U); i++)
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x01U, (uint16_t)i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(MAX_LOG_ENTRIES, DGN_GetFlushPending());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(MAX_LOG_ENTRIES - 8U, DGN_GetFlushPending());
+
+    /* Slot 4 holds the last lap's entry; slot 5 the first lap's */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(4U, &entry));
+    TEST_ASSERT_EQUAL_UINT16(MAX_LOG_ENTRIES + 4U, entry.data);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(5U, &entry));
+    TEST_ASSERT_EQUAL_UINT16(5U, entry.data);
+}
+
+/* =========================================================================
+ * TC-DGN-009: Deferred CRC — DGN_LogEvent stores raw fields and the guard;
+ *             a corrupted entry is refused by DGN_ReadEvent (ERR_CRC) and
+ *             dropped by the flush; each Flash page carries one CRC over
+ *             its header and records
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlushToFlash_PageCrc_GuardDropsCorrupted(void)
+{
+    /* TC-DGN-009 */
+    event_log_entry_t entry;
+    dgn_flash_page_t  page;
+    dgn_flash_stats_t stats;
+    uint8_t  expect[8U + (2U * DGN_FLASH_RECORD_BYTES)];
+    uint16_t i;
+
+    hal_stub_tick_ms = 0x01020304U;
+    (void)DGN_LogEvent(COMP_DSM, EVT_FSM_FAULT, 0x0A0BU);
+    (void)DGN_LogEvent(COMP_OBD, EVT_SENSOR_DISAGREE, 0x1111U);
+    (void)DGN_LogEvent(COMP_FMG, EVT_FAULT_ACTIVE, 0x0C0DU);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(0U, &entry));
+    TEST_ASSERT_EQUAL_UINT16(DGN_ENTRY_GUARD(&entry), entry.guard);
+
+    /* Single-bit RAM error in the second entry */
+    g_dgn_log[1].data ^= 0x0004U;
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, DGN_ReadEvent(1U, &entry));
+
+    /* Header as covered by the CRC: magic, count 2, page_seq 0 */
+    (void)memset(expect, 0, sizeof(expect));
+    expect[0] = 0xDEU;
+    expect[1] = 0xADU;
+    expect[3] = 2U;
+    for (i = 0U; i < 2U; i++)
+    {
+        expect[8U + (i * 8U) + 0U] = 0x01U;
+        expect[8U + (i * 8U) + 1U] = 0x02U;
+        expect[8U + (i * 8U) + 2U] = 0x03U;
+        expect[8U + (i * 8U) + 3U] = 0x04U;
+    }
+    expect[12] = COMP_DSM;
+    expect[13] = EVT_FSM_FAULT;
+    expect[14] = 0x0AU;
+    expect[15] = 0x0BU;
+    expect[20] = COMP_FMG;
+    expect[21] = EVT_FAULT_ACTIVE;
+    expect[22] = 0x0CU;
+    expect[23] = 0x0DU;
+
+    /* The flush only fills the RAM page; the sync programs it */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_UINT16(0U, DGN_GetFlushPending());
+    TEST_ASSERT_EQUAL_UINT32(1U, DGN_GetGuardFailCount());
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, DGN_ReadFlashPage(0U, &page));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_SyncToFlash());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(0U, &page));
+    TEST_ASSERT_EQUAL_UINT16(DGN_FLASH_MAGIC, page.magic);
+    TEST_ASSERT_EQUAL_UINT16(2U, page.count);
+    TEST_ASSERT_EQUAL_UINT32(0U, page.page_seq);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&expect[8], page.record,
+                                    2U * DGN_FLASH_RECORD_BYTES));
+    TEST_ASSERT_EQUAL_UINT16(CRC16_CCITT_Compute(expect,
+                                                 (uint16_t)sizeof(expect)),
+                             page.crc16);
+
+    /* 20 entries: taken 8, 8 and 4 into the RAM page, nothing programmed */
+    for (i = 0U; i < 20U; i++)
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x01U, i);
+    }
+    for (i = 0U; i < 3U; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    }
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(20U, stats.buffered);
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.pages_written);
+
+    /* 10 more fill the page (8 + 2): programmed as page 1 */
+    for (i = 20U; i < 30U; i++)
+    {
+        (void)DGN_LogEvent(COMP_DGN, 0x01U, i);
+    }
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_FlushToFlash());
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(0U, stats.buffered);
+    TEST_ASSERT_EQUAL_UINT16(2U, stats.head_page);
+    TEST_ASSERT_EQUAL_UINT32(32U, stats.records_written);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(1U, &page));
+    TEST_ASSERT_EQUAL_UINT16(DGN_FLASH_PAGE_RECORDS, page.count);
+    TEST_ASSERT_EQUAL_UINT8(29U, page.record[DGN_FLASH_PAGE_RECORDS - 1U][7]);
+}
+
+/** @brief Log and flush @p pages full Flash pages; count failed commits */
+static uint32_t dgn_write_pages(uint32_t pages)
+{
+    uint32_t failed = 0U;
+    uint32_t p;
+    uint16_t i;
+
+    for (p = 0U; p < pages; p++)
+    {
+        for (i = 0U; i < DGN_FLASH_PAGE_RECORDS; i++)
+        {
+            (void)DGN_LogEvent(COMP_DGN, 0x02U, (uint16_t)p);
+        }
+        while (0U != DGN_GetFlushPending())
+        {
+            if (SUCCESS != DGN_FlushToFlash())
+            {
+                failed++;
+            }
+        }
+    }
+    return failed;
+}
+
+/* =========================================================================
+ * TC-DGN-010: Flash log — full pages written once each; sectors erased in
+ *             rotation over more than two laps of the ring (erase counts
+ *             differ by at most one); a remount continues after the newest
+ *             page
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlashLog_RotatesSectors_Remounts(void)
+{
+    /* TC-DGN-010 */
+    const uint32_t        pages = (2U * TEST_FLASH_PAGES) + 5U;
+    hal_flash_sim_stats_t sim;
+    dgn_flash_stats_t     stats;
+    dgn_flash_page_t      page;
+    uint32_t min_erase = 0xFFFFFFFFU;
+    uint32_t max_erase = 0U;
+    uint32_t e;
+    uint16_t s;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(pages));
+
+    for (s = 0U; s < HAL_FLASH_SECTORS; s++)
+    {
+        e = HAL_FlashSim_GetEraseCount(s);
+        min_erase = (e < min_erase) ? e : min_erase;
+        max_erase = (e > max_erase) ? e : max_erase;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2U, min_erase);
+    TEST_ASSERT_EQUAL_UINT32(3U, max_erase);
+
+    HAL_FlashSim_GetStats(&sim);
+    TEST_ASSERT_EQUAL_UINT32(pages, sim.program_ops);
+    TEST_ASSERT_TRUE((uint64_t)pages * DGN_FLASH_PAGE_BYTES ==
+                     sim.bytes_programmed);
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(sim.erase_ops, stats.sectors_erased);
+    TEST_ASSERT_EQUAL_UINT16(5U, stats.head_page);
+    TEST_ASSERT_EQUAL_UINT32(pages, stats.next_page_seq);
+
+    /* Newest page, and the oldest still present (just after the erased
+     * part of the sector ahead) */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(4U, &page));
+    TEST_ASSERT_EQUAL_UINT32(pages - 1U, page.page_seq);
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, DGN_ReadFlashPage(5U, &page));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(TEST_FLASH_PPS, &page));
+    TEST_ASSERT_EQUAL_UINT32(pages - TEST_FLASH_PAGES + TEST_FLASH_PPS - 5U,
+                             page.page_seq);
+
+    /* Reset: the RAM log restarts, the Flash log continues */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Init());
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(5U, stats.head_page);
+    TEST_ASSERT_EQUAL_UINT32(pages, stats.next_page_seq);
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(5U, &page));
+    TEST_ASSERT_EQUAL_UINT32(pages, page.page_seq);
+}
+
+/* =========================================================================
+ * TC-DGN-011: Flash log — power cut during a page program: the torn page
+ *             fails its CRC, the remount skips it and earlier pages stay
+ *             valid; DGN_ReadFlashPage argument checks
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlashLog_PowerCutDuringProgram(void)
+{
+    /* TC-DGN-011 */
+    dgn_flash_stats_t stats;
+    dgn_flash_page_t  page;
+    uint16_t          p;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(3U));
+
+    HAL_FlashSim_CutPowerAfter(100U);
+    TEST_ASSERT_EQUAL_UINT32(1U, dgn_write_pages(1U));
+    TEST_ASSERT_EQUAL_INT(ERR_HW_FAULT, DGN_Init());   /* Still off */
+
+    HAL_FlashSim_PowerOn();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Init());
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, DGN_ReadFlashPage(3U, &page));
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(4U, stats.head_page);
+    TEST_ASSERT_EQUAL_UINT32(3U, stats.next_page_seq);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(1U));
+    for (p = 0U; p < 3U; p++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(p, &page));
+        TEST_ASSERT_EQUAL_UINT32(p, page.page_seq);
+    }
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(4U, &page));
+    TEST_ASSERT_EQUAL_UINT32(3U, page.page_seq);
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, DGN_ReadFlashPage(0U, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE,
+                          DGN_ReadFlashPage(TEST_FLASH_PAGES, &page));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, DGN_GetFlashStats(NULL));
+}
+
+/* =========================================================================
+ * TC-DGN-012: Flash log — power cut during the erase of the sector ahead
+ *             (oldest pages half erased): the remount ignores the old pages
+ *             left in it, erases it again and continues the sequence
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_FlashLog_PowerCutDuringErase(void)
+{
+    /* TC-DGN-012 */
+    dgn_flash_stats_t stats;
+    dgn_flash_page_t  page;
+
+    /* One full lap: the head is back at sector 0, holding pages 0..15 */
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(TEST_FLASH_PAGES));
+
+    HAL_FlashSim_CutPowerAfter(HAL_FLASH_SECTOR_BYTES / 2U);
+    TEST_ASSERT_EQUAL_UINT32(1U, dgn_write_pages(1U));
+    HAL_FlashSim_PowerOn();
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, DGN_ReadFlashPage(0U, &page));
+    TEST_ASSERT_EQUAL_INT(SUCCESS,
+                          DGN_ReadFlashPage(TEST_FLASH_PPS - 1U, &page));
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Init());
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(0U, stats.head_page);
+    TEST_ASSERT_EQUAL_UINT32(TEST_FLASH_PAGES, stats.next_page_seq);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, dgn_write_pages(1U));
+    TEST_ASSERT_EQUAL_UINT32(3U, HAL_FlashSim_GetEraseCount(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(0U, &page));
+    TEST_ASSERT_EQUAL_UINT32(TEST_FLASH_PAGES, page.page_seq);
+    TEST_ASSERT_EQUAL_INT(ERR_CRC,
+                          DGN_ReadFlashPage(TEST_FLASH_PPS - 1U, &page));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadFlashPage(TEST_FLASH_PPS, &page));
+    TEST_ASSERT_EQUAL_UINT32(TEST_FLASH_PPS, page.page_seq);
+}
+
+#if (DGN_PROFILE_ENABLE != 0)
+/* =========================================================================
+ * TC-DGN-004: DGN_Profile — per-step min/max/p99 from histograms; one slow
+ *             sample in 100 does not move p99
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_Profile_StepStats(void)
+{
+    /* TC-DGN-004 */
+    dgn_profile_stats_t st;
+    uint32_t i;
+
+    hal_stub_cycle_counter = 0xFFFFFF00U;  /* Counter wraps during the run */
+    DGN_Profile_Reset();
+    for (i = 0U; i < 100U; i++)
+    {
+        DGN_Profile_CycleStart();
+        hal_stub_cycle_counter += 100U;
+        DGN_Profile_StepEnd(0U);
+        hal_stub_cycle_counter += (i == 50U) ? 1000U : 10U;
+        DGN_Profile_StepEnd(1U);
+        DGN_Profile_CycleEnd();
+    }
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Profile_GetStats(0U, &st));
+    TEST_ASSERT_EQUAL_UINT32(100U, st.sample_count);
+    TEST_ASSERT_EQUAL_UINT32(100U, st.min_ticks);
+    TEST_ASSERT_EQUAL_UINT32(100U, st.max_ticks);
+    TEST_ASSERT_EQUAL_UINT32(100U, st.p99_ticks);   /* clamped to max */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Profile_GetStats(1U, &st));
+    TEST_ASSERT_EQUAL_UINT32(10U, st.min_ticks);
+    TEST_ASSERT_EQUAL_UINT32(1000U, st.max_ticks);
+    TEST_ASSERT_EQUAL_UINT32(11U, st.p99_ticks);    /* bucket [10, 11] */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Profile_GetStats(DGN_PROFILE_TOTAL, &st));
+    TEST_ASSERT_EQUAL_UINT32(110U, st.min_ticks);
+    TEST_ASSERT_EQUAL_UINT32(1100U, st.max_ticks);
+    TEST_ASSERT_EQUAL_UINT32(0U, DGN_Profile_GetOverrunCount());
+}
+
+/* =========================================================================
+ * TC-DGN-005: DGN_Profile — cycle over CYCLE_MS counted as overrun;
+ *             GetStats argument checks
+ * Tests: REQ-FUN-018
+ * SIL: 1
+ * ========================================================================= */
+void test_DGN_Profile_OverrunAndErrors(void)
+{
+    /* TC-DGN-005 */
+    dgn_profile_stats_t st;
+    uint32_t budget = CYCLE_MS * (uint32_t)(HAL_CYCLE_COUNTER_HZ / 1000UL);
+
+    hal_stub_cycle_counter = 0U;
+    DGN_Profile_Reset();
+
+    DGN_Profile_CycleStart();
+    hal_stub_cycle_counter += budget;       /* exactly on budget */
+    DGN_Profile_CycleEnd();
+    DGN_Profile_CycleStart();
+    hal_stub_cycle_counter += budget + 1U;  /* one tick over */
+    DGN_Profile_CycleEnd();
+    TEST_ASSERT_EQUAL_UINT32(1U, DGN_Profile_GetOverrunCount());
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, DGN_Profile_GetStats(0U, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE,
+                          DGN_Profile_GetStats(DGN_PROFILE_TOTAL + 1U, &st));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Profile_GetStats(3U, &st));
+    TEST_ASSERT_EQUAL_UINT32(0U, st.sample_count);
+    TEST_ASSERT_EQUAL_UINT32(0U, st.p99_ticks);
+}
+#endif /* DGN_PROFILE_ENABLE */
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -111,6 +577,17 @@ int main(void)
     RUN_TEST(test_DGN_LogEvent_WriteAndRead);
     RUN_TEST(test_DGN_LogEvent_CircularWrap);
     RUN_TEST(test_DGN_ReadEvent_ErrorCases);
+    RUN_TEST(test_DGN_FlushToFlash_BatchedPending);
+    RUN_TEST(test_DGN_LogEvent_PreemptedWriter_NotReadUntilCommitted);
+    RUN_TEST(test_DGN_FlushToFlash_LappedResumesAtOldest);
+    RUN_TEST(test_DGN_FlushToFlash_PageCrc_GuardDropsCorrupted);
+    RUN_TEST(test_DGN_FlashLog_RotatesSectors_Remounts);
+    RUN_TEST(test_DGN_FlashLog_PowerCutDuringProgram);
+    RUN_TEST(test_DGN_FlashLog_PowerCutDuringErase);
+#if (DGN_PROFILE_ENABLE != 0)
+    RUN_TEST(test_DGN_Profile_StepStats);
+    RUN_TEST(test_DGN_Profile_OverrunAndErrors);
+#endif
 
     return UNITY_END();
 }
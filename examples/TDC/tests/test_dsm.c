@@ -1,13 +1,19 @@
 /**
  * @file    test_dsm.c
- * @brief   Unit tests for DSM module (COMP-004) — 56 test cases.
- * @details Covers TC-DSM-001 through TC-DSM-056.
+ * @brief   Unit tests for DSM module (COMP-004) — 73 test cases.
+ * @details Covers TC-DSM-001 through TC-DSM-073.
  *          Tests: DSM_UpdateFSM (all 9 FSM states + all branches),
- *                 DSM_VotePosition, DSM_TransitionMode,
+ *                 DSM_StepFSM, DSM_VotePosition, DSM_VotePositionBatch,
+ *                 DSM_TransitionMode,
  *                 DSM_HandleEmergencyRelease, DSM_Init,
  *                 DSM_RunCycle, DSM_ProcessOpenCommand,
  *                 DSM_ProcessCloseCommand, DSM_GetDoorStates,
- *                 DSM_GetLockStates, DSM_GetClosingFlags, DSM_GetFault.
+ *                 DSM_GetLockStates, DSM_GetClosingFlags, DSM_GetLockedMask,
+ *                 DSM_GetLockConfirmMs, DSM_GetLockConfirmCount,
+ *                 DSM_GetClosingMask, DSM_GetFault, DSM_GetEvalStats,
+ *                 DSM_GetStateTimeoutMs, DSM_Timer_Init, DSM_Timer_Arm,
+ *                 DSM_Timer_Cancel, DSM_Timer_GetArmed, DSM_Timer_Advance,
+ *                 DSM_Timer_TakeExpired.
  *
  * @project TDC (Train Door Control System)
  * @phase   Phase 5 — Implementation & Testing
@@ -18,27 +24,30 @@
  *   Tests: REQ-FUN-001–015, REQ-SAFE-007/008/009/010/011/019/020
  *   Item 16: Software Component Test Specification §COMP-004
  *   Item 18: Source Code (dsm_fsm.c, dsm_voter.c, dsm_mode.c,
- *             dsm_emergency.c, dsm_init.c)
+ *             dsm_emergency.c, dsm_init.c, dsm_timer.c)
  */
 
 #include "../unity/src/unity.h"
 #include "../../src/tdc_types.h"
 #include "../../src/dsm.h"
 #include "../../src/hal.h"
+#include "../../src/dgn.h"
 
 /* =========================================================================
  * Access internal DSM globals for test setup
  * ========================================================================= */
 extern door_fsm_state_t g_dsm_state[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_open[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_close[MAX_DOORS];
-extern uint8_t          g_dsm_disabled[MAX_DOORS];
+extern door_mask_t      g_dsm_cmd_open;
+extern door_mask_t      g_dsm_cmd_close;
+extern door_mask_t      g_dsm_disabled;
 extern uint32_t         g_dsm_entry_time_ms[MAX_DOORS];
+extern door_mask_t      g_dsm_dirty;
 extern op_mode_t        g_dsm_mode;
 
 /* skn_globals_stub.c provides these (default=1); tests override as needed */
 extern uint8_t g_safe_state_active;
 extern uint8_t g_speed_interlock_active;
+extern door_mask_t g_obstacle_mask;
 
 extern uint8_t hal_stub_motor_start_ret;
 extern uint8_t hal_stub_motor_stop_ret;
@@ -46,6 +55,9 @@ extern uint8_t hal_stub_lock_engage_ret;
 extern uint8_t hal_stub_lock_disengage_ret;
 extern uint8_t hal_stub_emerg_gpio;
 extern uint32_t hal_stub_tick_ms;
+extern uint8_t  hal_stub_gpio_value;
+extern uint32_t hal_stub_actuator_trace;
+extern uint32_t hal_stub_cycle_counter;
 
 /* =========================================================================
  * setUp / tearDown
@@ -109,7 +121,7 @@ void test_DSM_UpdateFSM_Idle_CmdOpen_ToOpening(void)
 {
     /* TC-DSM-003 */
     g_dsm_state[0]    = FSM_IDLE;
-    g_dsm_disabled[0] = 0U;
+    g_dsm_disabled = 0U;
     error_t ret = DSM_UpdateFSM(0U,
         1U,0U, 0U,0U,0U,0U, 0U,0U, 0U,0U,
         0U /* safe_state=0 */,
@@ -164,7 +176,7 @@ void test_DSM_UpdateFSM_FullyOpen_CmdClose_ToClosing(void)
 {
     /* TC-DSM-006 */
     g_dsm_state[0]    = FSM_FULLY_OPEN;
-    g_dsm_disabled[0] = 0U;
+    g_dsm_disabled = 0U;
     DSM_UpdateFSM(0U,
         0U,1U /* cmd_close */,
         0U,0U,0U,0U, 0U,0U, 0U,0U,
@@ -239,7 +251,7 @@ void test_DSM_UpdateFSM_ClosedAndLocked_CmdOpen_ToOpening(void)
 {
     /* TC-DSM-010 */
     g_dsm_state[0]    = FSM_CLOSED_AND_LOCKED;
-    g_dsm_disabled[0] = 0U;
+    g_dsm_disabled = 0U;
     hal_stub_lock_disengage_ret = SUCCESS;
     DSM_UpdateFSM(0U,
         1U /* cmd_open */,
@@ -698,7 +710,7 @@ void test_DSM_UpdateFSM_ClosedAndLocked_DisengageFail_ToFault(void)
 {
     /* TC-DSM-036 */
     g_dsm_state[0]              = FSM_CLOSED_AND_LOCKED;
-    g_dsm_disabled[0]           = 0U;
+    g_dsm_disabled              = 0U;
     hal_stub_lock_disengage_ret = ERR_HW_FAULT;
     DSM_UpdateFSM(0U,
         1U /* cmd_open */,
@@ -719,7 +731,7 @@ void test_DSM_UpdateFSM_Idle_SpeedInterlock_StaysIdle(void)
 {
     /* TC-DSM-037: speed interlock = 1 → cmd_open blocked */
     g_dsm_state[0]    = FSM_IDLE;
-    g_dsm_disabled[0] = 0U;
+    g_dsm_disabled = 0U;
     DSM_UpdateFSM(0U,
         1U /* cmd_open */,
         0U, 0U,0U,0U,0U, 0U,0U, 0U,
@@ -758,11 +770,11 @@ void test_DSM_ProcessOpenCommand_SetsBit(void)
 {
     /* TC-DSM-039: mask = 0x03 → doors 0 and 1 get cmd_open=1 */
     (void)DSM_ProcessOpenCommand(0x03U);
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_open[0]);
-    TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_close[0]);
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_open[1]);
-    TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_close[1]);
-    TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_open[2]);
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_open, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_close, 0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_open, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_close, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_open, 2U));
 }
 
 /* =========================================================================
@@ -778,7 +790,7 @@ void test_DSM_ProcessOpenCommand_ZeroMask(void)
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
     uint8_t i;
     for (i = 0U; i < MAX_DOORS; i++) {
-        TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_open[i]);
+        TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_open, i));
     }
 }
 
@@ -790,13 +802,13 @@ void test_DSM_ProcessOpenCommand_ZeroMask(void)
  * ========================================================================= */
 void test_DSM_ProcessCloseCommand_SetsBit(void)
 {
-    /* TC-DSM-041: mask = 0x0F → all 4 doors get cmd_close=1 */
-    error_t ret = DSM_ProcessCloseCommand(0x0FU);
+    /* TC-DSM-041: mask = DOOR_MASK_ALL → all doors get cmd_close=1 */
+    error_t ret = DSM_ProcessCloseCommand(DOOR_MASK_ALL);
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
     uint8_t i;
     for (i = 0U; i < MAX_DOORS; i++) {
-        TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_close[i]);
-        TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_open[i]);
+        TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_close, i));
+        TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_open, i));
     }
 }
 
@@ -813,7 +825,7 @@ void test_DSM_ProcessCloseCommand_ZeroMask(void)
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
     uint8_t i;
     for (i = 0U; i < MAX_DOORS; i++) {
-        TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_close[i]);
+        TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_close, i));
     }
 }
 
@@ -1067,6 +1079,958 @@ void test_DSM_RunCycle_EmergencyReleaseError_SetsFault(void)
     TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
 }
 
+/* =========================================================================
+ * TC-DSM-057: DSM_ProcessOpen/CloseCommand — 64-bit mask; bits above
+ *             MAX_DOORS - 1 ignored
+ * Tests: REQ-FUN-002/003
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_ProcessCommand_WideMask_ClippedToDoors(void)
+{
+    /* TC-DSM-057 */
+    (void)DSM_ProcessOpenCommand(~(door_mask_t)0U);
+    TEST_ASSERT_TRUE(g_dsm_cmd_open == DOOR_MASK_ALL);
+    TEST_ASSERT_TRUE(g_dsm_cmd_close == 0U);
+
+    (void)DSM_ProcessCloseCommand(DOOR_BIT(MAX_DOORS - 1U) | ~DOOR_MASK_ALL);
+    TEST_ASSERT_TRUE(g_dsm_cmd_close == DOOR_BIT(MAX_DOORS - 1U));
+    TEST_ASSERT_TRUE(g_dsm_cmd_open ==
+                     (DOOR_MASK_ALL & ~DOOR_BIT(MAX_DOORS - 1U)));
+}
+
+/* =========================================================================
+ * TC-DSM-058: DSM_RunCycle — locked/closing masks match the lock-state and
+ *             closing-flag arrays for every door
+ * Tests: REQ-SAFE-007, REQ-FUN-003
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_MasksMatchArrays(void)
+{
+    /* TC-DSM-058 */
+    uint8_t i;
+
+    g_safe_state_active      = 0U;
+    g_speed_interlock_active = 0U;
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        g_dsm_state[i] = ((i % 2U) == 0U) ? FSM_CLOSED_AND_LOCKED : FSM_CLOSING;
+    }
+    DSM_RunCycle();
+
+    TEST_ASSERT_TRUE((DSM_GetLockedMask() & ~DOOR_MASK_ALL) == 0U);
+    TEST_ASSERT_TRUE((DSM_GetClosingMask() & ~DOOR_MASK_ALL) == 0U);
+    TEST_ASSERT_TRUE(DSM_GetLockedMask() != 0U);
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(DSM_GetLockStates()[i],
+                                DOOR_MASK_TEST(DSM_GetLockedMask(), i));
+        TEST_ASSERT_EQUAL_UINT8(DSM_GetClosingFlags()[i],
+                                DOOR_MASK_TEST(DSM_GetClosingMask(), i));
+    }
+}
+
+/* =========================================================================
+ * TC-DSM-059: DSM_VotePositionBatch — every door's voted/disagree bit equals
+ *             DSM_VotePosition for all sensor combinations; bits above
+ *             MAX_DOORS - 1 cleared
+ * Tests: REQ-SAFE-008/010
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_VotePositionBatch_MatchesPerDoorVoter(void)
+{
+    /* TC-DSM-059: all four uniform (A, B) combinations, then pseudo-random
+     * masks so neighbouring doors see different combinations */
+    door_mask_t a;
+    door_mask_t b;
+    door_mask_t voted;
+    door_mask_t dis;
+    uint64_t    seed = 0x0123456789ABCDEFULL;
+    uint8_t     ref_voted;
+    uint8_t     ref_dis;
+    uint32_t    k;
+    uint8_t     i;
+
+    for (k = 0U; k < 260U; k++)
+    {
+        if (k < 4U)
+        {
+            a = ((k & 1U) != 0U) ? ~(door_mask_t)0U : 0U;
+            b = ((k & 2U) != 0U) ? ~(door_mask_t)0U : 0U;
+        }
+        else
+        {
+            seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+            a    = seed;
+            seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+            b    = seed;
+        }
+
+        TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_VotePositionBatch(a, b, &voted, &dis));
+        TEST_ASSERT_TRUE((voted & ~DOOR_MASK_ALL) == 0U);
+        TEST_ASSERT_TRUE((dis & ~DOOR_MASK_ALL) == 0U);
+        for (i = 0U; i < MAX_DOORS; i++)
+        {
+            (void)DSM_VotePosition(i, DOOR_MASK_TEST(a, i), DOOR_MASK_TEST(b, i),
+                                   &ref_voted, &ref_dis);
+            TEST_ASSERT_EQUAL_UINT8(ref_voted, DOOR_MASK_TEST(voted, i));
+            TEST_ASSERT_EQUAL_UINT8(ref_dis, DOOR_MASK_TEST(dis, i));
+        }
+    }
+}
+
+/* =========================================================================
+ * TC-DSM-060: DSM_VotePositionBatch — NULL output → ERR_NULL_PTR
+ * Tests: REQ-SAFE-008
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_VotePositionBatch_NullOut(void)
+{
+    /* TC-DSM-060 */
+    door_mask_t out = 0U;
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR,
+                          DSM_VotePositionBatch(1U, 1U, NULL, &out));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR,
+                          DSM_VotePositionBatch(1U, 1U, &out, NULL));
+}
+
+/* =========================================================================
+ * TC-DSM-061: DSM_StepFSM — NULL votes / bad door rejected; a door reads
+ *             only its own vote bits
+ * Tests: REQ-SAFE-008, REQ-FUN-008
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_StepFSM_UsesOwnDoorVotes(void)
+{
+    /* TC-DSM-061: lock disagreement on door 0 only; the last door is
+     * locked by agreement and must not see door 0's disagreement */
+    dsm_votes_t votes = {0U, 0U, 0U, 0U, 0U, 0U};
+    uint8_t     last  = (uint8_t)(MAX_DOORS - 1U);
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR,
+                          DSM_StepFSM(0U, 0U, 0U, NULL, 0U, 0U, 0U, 0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE,
+                          DSM_StepFSM((uint8_t)MAX_DOORS, 0U, 0U, &votes,
+                                      0U, 0U, 0U, 0U));
+
+    votes.lock_disagree = DOOR_BIT(0U);
+    votes.lock_voted    = DOOR_BIT(last);
+    g_dsm_state[0]      = FSM_LOCKING;
+    g_dsm_state[last]   = FSM_LOCKING;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS,
+                          DSM_StepFSM(0U, 0U, 0U, &votes, 0U, 0U, 0U, 0U));
+    TEST_ASSERT_EQUAL_INT(FSM_FAULT, g_dsm_state[0]);
+    if (last != 0U)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS,
+                              DSM_StepFSM(last, 0U, 0U, &votes, 0U, 0U, 0U, 0U));
+        TEST_ASSERT_EQUAL_INT(FSM_CLOSED_AND_LOCKED, g_dsm_state[last]);
+    }
+}
+
+/* =========================================================================
+ * TC-DSM-062: DSM_RunCycle — no input change → every door skipped
+ * Tests: REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_NoChange_SkipsAllDoors(void)
+{
+    /* TC-DSM-062: first cycle after init evaluates all doors, the second
+     * sees no change */
+    dsm_eval_stats_t stats;
+
+    hal_stub_gpio_value = 0U;
+    g_obstacle_mask     = 0U;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_GetEvalStats(&stats));
+    TEST_ASSERT_EQUAL_UINT8(MAX_DOORS, stats.last_evaluated);
+
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_GetEvalStats(&stats));
+    TEST_ASSERT_EQUAL_UINT8(0U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_UINT32(MAX_DOORS, stats.evaluated);
+    TEST_ASSERT_EQUAL_UINT32(MAX_DOORS, stats.skipped);
+}
+
+/* =========================================================================
+ * TC-DSM-063: DSM_RunCycle — a command dirties only the commanded door,
+ *             which is evaluated again after each state change
+ * Tests: REQ-FUN-002/003, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_Command_EvaluatesOnlyThatDoor(void)
+{
+    /* TC-DSM-063: sensors report open, so door 0 goes IDLE → OPENING →
+     * FULLY_OPEN and then stays clean */
+    dsm_eval_stats_t stats;
+    uint8_t          last = (uint8_t)(MAX_DOORS - 1U);
+
+    hal_stub_gpio_value = 1U;
+    g_obstacle_mask     = 0U;
+    DSM_RunCycle();
+
+    (void)DSM_ProcessOpenCommand(DOOR_BIT(0U));
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(1U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[last]);
+
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(1U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_INT(FSM_FULLY_OPEN, g_dsm_state[0]);
+
+    DSM_RunCycle();  /* FULLY_OPEN re-checked once, then clean */
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(0U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)DOOR_STATE_FULLY_OPEN,
+                            DSM_GetDoorStates()[0]);
+}
+
+/* =========================================================================
+ * TC-DSM-064: DSM_RunCycle — clean door in a timed state is evaluated when
+ *             its timer expires
+ * Tests: REQ-FUN-004, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_TimerExpiry_DirtiesDoor(void)
+{
+    /* TC-DSM-064: no open feedback — door 0 waits in OPENING unevaluated
+     * until the motor timeout, then faults */
+    dsm_eval_stats_t stats;
+
+    hal_stub_gpio_value = 0U;
+    g_obstacle_mask     = 0U;
+    DSM_RunCycle();
+    (void)DSM_ProcessOpenCommand(DOOR_BIT(0U));
+    DSM_RunCycle();                 /* IDLE → OPENING at t=0 */
+    DSM_RunCycle();                 /* OPENING re-checked once */
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+
+    hal_stub_tick_ms = DSM_GetStateTimeoutMs(FSM_OPENING) - 1U;
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(0U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+
+    hal_stub_tick_ms = DSM_GetStateTimeoutMs(FSM_OPENING);
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(1U, stats.last_evaluated);
+    TEST_ASSERT_EQUAL_INT(FSM_FAULT, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_UINT8(1U, DSM_GetFault());
+}
+
+/* =========================================================================
+ * TC-DSM-065: DSM_RunCycle — safe-state change dirties every door;
+ *             DSM_GetEvalStats NULL → ERR_NULL_PTR; state timeouts
+ * Tests: REQ-SAFE-007, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_SafeStateChange_DirtiesAllDoors(void)
+{
+    /* TC-DSM-065 */
+    dsm_eval_stats_t stats;
+
+    hal_stub_gpio_value = 0U;
+    g_obstacle_mask     = 0U;
+    DSM_RunCycle();
+    DSM_RunCycle();
+    g_safe_state_active = 1U;
+    DSM_RunCycle();
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_EQUAL_UINT8(MAX_DOORS, stats.last_evaluated);
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, DSM_GetEvalStats(NULL));
+    TEST_ASSERT_EQUAL_UINT32(5000U, DSM_GetStateTimeoutMs(FSM_CLOSING));
+    TEST_ASSERT_EQUAL_UINT32(2000U,
+                             DSM_GetStateTimeoutMs(FSM_OBSTACLE_REVERSAL));
+    TEST_ASSERT_EQUAL_UINT32(500U, DSM_GetStateTimeoutMs(FSM_LOCKING));
+    TEST_ASSERT_EQUAL_UINT32(0U, DSM_GetStateTimeoutMs(FSM_CLOSED_AND_LOCKED));
+}
+
+/* =========================================================================
+ * TC-DSM-066: DSM_RunCycle — change-driven dispatch gives the same door
+ *             states as evaluating every door (FSM and emergency release)
+ *             every cycle
+ * Tests: REQ-FUN-001–015, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+#define TC066_CYCLES (600U)
+
+/** @brief Pseudo-random input sequence shared by both runs of TC-DSM-066 */
+static uint32_t tc066_next(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245U) + 12345U;
+    return *seed >> 8U;
+}
+
+/** @brief Release every emergency debounce left over by earlier tests */
+static void tc066_reset_emergency(void)
+{
+    uint8_t i;
+
+    hal_stub_emerg_gpio = 0U;
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        (void)DSM_HandleEmergencyRelease(i, 0U);
+    }
+}
+
+/** @brief Apply one cycle of pseudo-random inputs and advance the tick */
+static void tc066_inputs(uint32_t *seed)
+{
+    uint32_t r = tc066_next(seed);
+    door_mask_t m = ((door_mask_t)tc066_next(seed) << 32U) |
+                    (door_mask_t)tc066_next(seed);
+
+    switch (r % 40U)
+    {
+        case 0U: (void)DSM_ProcessOpenCommand(m);  break;
+        case 1U: (void)DSM_ProcessCloseCommand(m); break;
+        case 2U:
+        case 3U: hal_stub_gpio_value ^= 1U;        break;
+        case 4U: g_obstacle_mask = m & (m >> 3U) & DOOR_MASK_ALL; break;
+        case 5U: g_speed_interlock_active ^= (uint8_t)((r >> 4U) & 1U); break;
+        case 6U: g_safe_state_active = (uint8_t)(((r >> 4U) % 8U) == 0U);
+                 break;
+        case 7U: hal_stub_tick_ms += 450U;         break;  /* timer expiries */
+        case 8U: hal_stub_emerg_gpio ^= 1U;        break;
+        default: break;
+    }
+    hal_stub_tick_ms += CYCLE_MS;
+}
+
+static uint8_t s_tc066_trace[TC066_CYCLES][MAX_DOORS];
+
+void test_DSM_RunCycle_ChangeDriven_MatchesFullEvaluation(void)
+{
+    /* TC-DSM-066: run A uses DSM_RunCycle; run B replays the same inputs
+     * through DSM_UpdateFSM for every door every cycle */
+    uint32_t seed = 20260404U;
+    uint32_t cycle;
+    uint8_t  i;
+    uint8_t  g;
+    dsm_eval_stats_t stats;
+
+    tc066_reset_emergency();
+    hal_stub_gpio_value = 0U;
+    g_obstacle_mask     = 0U;
+    for (cycle = 0U; cycle < TC066_CYCLES; cycle++)
+    {
+        tc066_inputs(&seed);
+        DSM_RunCycle();
+        for (i = 0U; i < MAX_DOORS; i++)
+        {
+            s_tc066_trace[cycle][i] = (uint8_t)g_dsm_state[i];
+        }
+    }
+    (void)DSM_GetEvalStats(&stats);
+    TEST_ASSERT_TRUE(stats.skipped > 0U);
+
+    setUp();
+    tc066_reset_emergency();
+    seed                = 20260404U;
+    hal_stub_gpio_value = 0U;
+    g_obstacle_mask     = 0U;
+    for (cycle = 0U; cycle < TC066_CYCLES; cycle++)
+    {
+        tc066_inputs(&seed);
+        g = hal_stub_gpio_value;
+        for (i = 0U; i < MAX_DOORS; i++)
+        {
+            (void)DSM_UpdateFSM(i,
+                                DOOR_MASK_TEST(g_dsm_cmd_open, i),
+                                DOOR_MASK_TEST(g_dsm_cmd_close, i),
+                                g, g, g, g, g, g,
+                                DOOR_MASK_TEST(g_obstacle_mask, i),
+                                g_speed_interlock_active,
+                                g_safe_state_active,
+                                hal_stub_tick_ms);
+            (void)DSM_HandleEmergencyRelease(i, hal_stub_tick_ms);
+            TEST_ASSERT_EQUAL_UINT8(s_tc066_trace[cycle][i],
+                                    (uint8_t)g_dsm_state[i]);
+        }
+    }
+}
+
+/* =========================================================================
+ * TC-DSM-067: DSM_StepFSM — the transition table is equivalent to the
+ *             per-state handlers it replaced, over every state (and one
+ *             invalid value), every combination of the six scalar inputs,
+ *             every sensor-pair combination, both sides of each state
+ *             timeout with and without tick wrap, and lock actuator
+ *             success/failure: same next state, entry time, actuator calls
+ *             and logged event
+ * Tests: REQ-FUN-001–015, REQ-SAFE-007/008/009/010/011
+ * SIL: 3
+ * ========================================================================= */
+#define TC067_STATES  ((uint32_t)FSM_FAULT + 2U)  /* + one invalid value */
+
+/** @brief Actuator codes of hal_stub_actuator_trace */
+#define TC067_OPEN    (1U)
+#define TC067_CLOSE   (2U)
+#define TC067_STOP    (3U)
+#define TC067_LOCK    (4U)
+#define TC067_UNLOCK  (5U)
+
+/** @brief One input combination of TC-DSM-067 */
+typedef struct
+{
+    uint8_t  cmd_open, cmd_close, disabled, obstacle, interlock, safe;
+    uint8_t  ov, od, cv, cd, lv, ld;    /* voted / disagree per sensor pair */
+    uint32_t elapsed_ms;
+    uint8_t  engage_ok, disengage_ok;
+} tc067_in_t;
+
+static uint32_t s_tc067_trace;   /* Reference actuator trace */
+static uint8_t  s_tc067_event;   /* Reference logged event (0 = none) */
+
+static void tc067_act(uint32_t code)
+{
+    s_tc067_trace = (s_tc067_trace << 3U) | code;
+}
+
+/** @brief Reference model: the per-state handlers of dsm_fsm.c before the
+ *         transition table, transcribed guard for guard */
+static door_fsm_state_t tc067_reference(door_fsm_state_t st,
+                                        const tc067_in_t *in)
+{
+    uint8_t open_ok = (uint8_t)((1U == in->cmd_open) &&
+                                (0U == in->interlock) &&
+                                (0U == in->disabled));
+
+    switch (st)
+    {
+        case FSM_IDLE:
+            if ((0U == in->safe) && (1U == open_ok))
+            {
+                tc067_act(TC067_OPEN);
+                return FSM_OPENING;
+            }
+            return FSM_IDLE;
+        case FSM_OPENING:
+            if (1U == in->safe) { tc067_act(TC067_STOP); return FSM_FAULT; }
+            if (1U == in->od)
+            {
+                s_tc067_event = EVT_SENSOR_DISAGREE;
+                tc067_act(TC067_STOP);
+                return FSM_FAULT;
+            }
+            if (1U == in->ov) { tc067_act(TC067_STOP); return FSM_FULLY_OPEN; }
+            if (1U == in->obstacle)
+            {
+                tc067_act(TC067_STOP);
+                return FSM_FULLY_OPEN;
+            }
+            if (in->elapsed_ms >= 5000U)
+            {
+                s_tc067_event = EVT_FSM_FAULT;
+                tc067_act(TC067_STOP);
+                return FSM_FAULT;
+            }
+            return FSM_OPENING;
+        case FSM_FULLY_OPEN:
+            if ((0U == in->safe) && (1U == in->cmd_close) &&
+                (0U == in->disabled))
+            {
+                tc067_act(TC067_CLOSE);
+                return FSM_CLOSING;
+            }
+            return FSM_FULLY_OPEN;
+        case FSM_CLOSING:
+            if (1U == in->safe) { tc067_act(TC067_STOP); return FSM_FAULT; }
+            if (1U == in->obstacle)
+            {
+                tc067_act(TC067_STOP);
+                tc067_act(TC067_OPEN);
+                s_tc067_event = EVT_SENSOR_DISAGREE;
+                return FSM_OBSTACLE_REVERSAL;
+            }
+            if (1U == in->cd)
+            {
+                s_tc067_event = EVT_SENSOR_DISAGREE;
+                tc067_act(TC067_STOP);
+                return FSM_FAULT;
+            }
+            if (1U == in->cv)
+            {
+                tc067_act(TC067_STOP);
+                return FSM_FULLY_CLOSED;
+            }
+            if (in->elapsed_ms >= 5000U)
+            {
+                s_tc067_event = EVT_FSM_FAULT;
+                tc067_act(TC067_STOP);
+                return FSM_FAULT;
+            }
+            return FSM_CLOSING;
+        case FSM_OBSTACLE_REVERSAL:
+            if (1U == in->ov) { tc067_act(TC067_STOP); return FSM_FULLY_OPEN; }
+            if (in->elapsed_ms >= 2000U)
+            {
+                s_tc067_event = EVT_FSM_FAULT;
+                tc067_act(TC067_STOP);
+                return FSM_FAULT;
+            }
+            return FSM_OBSTACLE_REVERSAL;
+        case FSM_FULLY_CLOSED:
+            tc067_act(TC067_LOCK);
+            if (0U == in->engage_ok)
+            {
+                s_tc067_event = EVT_FSM_FAULT;
+                return FSM_FAULT;
+            }
+            return FSM_LOCKING;
+        case FSM_LOCKING:
+            if (1U == in->ld)
+            {
+                s_tc067_event = EVT_SENSOR_DISAGREE;
+                return FSM_FAULT;
+            }
+            if (1U == in->lv) { return FSM_CLOSED_AND_LOCKED; }
+            if (in->elapsed_ms >= 500U)
+            {
+                s_tc067_event = EVT_FSM_FAULT;
+                return FSM_FAULT;
+            }
+            return FSM_LOCKING;
+        case FSM_CLOSED_AND_LOCKED:
+            if ((0U == in->safe) && (1U == open_ok))
+            {
+                tc067_act(TC067_UNLOCK);
+                if (0U == in->disengage_ok)
+                {
+                    s_tc067_event = EVT_FSM_FAULT;
+                    return FSM_FAULT;
+                }
+                tc067_act(TC067_OPEN);
+                return FSM_OPENING;
+            }
+            return FSM_CLOSED_AND_LOCKED;
+        case FSM_FAULT:
+            return FSM_FAULT;
+        default:
+            tc067_act(TC067_STOP);
+            return FSM_FAULT;
+    }
+}
+
+/** @brief Decode the six scalar input bits and the six sensor line bits
+ *         (a/b of open, closed, lock) into in and raw */
+static void tc067_decode(uint32_t scalars, uint32_t sensors,
+                         tc067_in_t *in, uint8_t raw[6])
+{
+    uint8_t k;
+
+    in->cmd_open  = (uint8_t)(scalars & 1U);
+    in->cmd_close = (uint8_t)((scalars >> 1U) & 1U);
+    in->disabled  = (uint8_t)((scalars >> 2U) & 1U);
+    in->obstacle  = (uint8_t)((scalars >> 3U) & 1U);
+    in->interlock = (uint8_t)((scalars >> 4U) & 1U);
+    in->safe      = (uint8_t)((scalars >> 5U) & 1U);
+    for (k = 0U; k < 6U; k++)
+    {
+        raw[k] = (uint8_t)((sensors >> k) & 1U);
+    }
+    /* raw: a_open, b_open, a_closed, b_closed, lock_a, lock_b */
+    in->ov = (uint8_t)(raw[0] & raw[1]);
+    in->od = (uint8_t)(raw[0] ^ raw[1]);
+    in->cv = (uint8_t)(raw[2] & raw[3]);
+    in->cd = (uint8_t)(raw[2] ^ raw[3]);
+    in->lv = (uint8_t)(raw[4] & raw[5]);
+    in->ld = (uint8_t)(raw[4] ^ raw[5]);
+}
+
+void test_DSM_StepFSM_TransitionTable_MatchesHandlers(void)
+{
+    /* TC-DSM-067 */
+    static const uint32_t entry_ms[2] = { 1000U, 0xFFFFFF00U }; /* + wrap */
+    const uint8_t door = (uint8_t)(MAX_DOORS - 1U);
+    uint32_t st;
+    uint32_t scalars;
+    uint32_t sensors;
+    uint32_t variant;
+    uint32_t timeout_ms;
+    uint32_t now;
+    uint32_t mismatches = 0U;
+    uint16_t count;
+    door_fsm_state_t   expect;
+    event_log_entry_t  ev;
+    tc067_in_t         in;
+    uint8_t            raw[6];
+    uint8_t            logged;
+
+    (void)DGN_Init();
+    for (st = 0U; st < TC067_STATES; st++)
+    {
+        timeout_ms = DSM_GetStateTimeoutMs((door_fsm_state_t)st);
+        if (0U == timeout_ms)
+        {
+            timeout_ms = 5000U;  /* Untimed: any elapsed time */
+        }
+        for (scalars = 0U; scalars < 64U; scalars++)
+        {
+            for (sensors = 0U; sensors < 64U; sensors++)
+            {
+                for (variant = 0U; variant < 16U; variant++)
+                {
+                    tc067_decode(scalars, sensors, &in, raw);
+                    in.elapsed_ms   = timeout_ms - 1U + (variant & 1U);
+                    in.engage_ok    = (uint8_t)((variant >> 1U) & 1U);
+                    in.disengage_ok = (uint8_t)((variant >> 2U) & 1U);
+                    now = entry_ms[variant >> 3U] + in.elapsed_ms;
+
+                    if (DGN_GetLogCount() >= (MAX_LOG_ENTRIES - 1U))
+                    {
+                        (void)DGN_Init();
+                    }
+                    count = DGN_GetLogCount();
+
+                    g_dsm_state[door]         = (door_fsm_state_t)st;
+                    g_dsm_entry_time_ms[door] = entry_ms[variant >> 3U];
+                    g_dsm_disabled = (0U != in.disabled) ? DOOR_BIT(door) : 0U;
+                    hal_stub_lock_engage_ret    = (0U != in.engage_ok) ?
+                                                  SUCCESS : ERR_HW_FAULT;
+                    hal_stub_lock_disengage_ret = (0U != in.disengage_ok) ?
+                                                  SUCCESS : ERR_HW_FAULT;
+                    hal_stub_actuator_trace = 0U;
+                    s_tc067_trace = 0U;
+                    s_tc067_event = 0U;
+
+                    (void)DSM_UpdateFSM(door, in.cmd_open, in.cmd_close,
+                                        raw[0], raw[2], raw[1], raw[3],
+                                        raw[4], raw[5], in.obstacle,
+                                        in.interlock, in.safe, now);
+                    expect = tc067_reference((door_fsm_state_t)st, &in);
+
+                    logged = (uint8_t)(DGN_GetLogCount() - count);
+                    ev.event_code = 0U;
+                    ev.data       = door;
+                    if (1U == logged)
+                    {
+                        (void)DGN_ReadEvent(count, &ev);
+                    }
+                    if ((expect != g_dsm_state[door]) ||
+                        (hal_stub_actuator_trace != s_tc067_trace) ||
+                        (g_dsm_entry_time_ms[door] !=
+                         (((uint32_t)expect != st) ?
+                          now : entry_ms[variant >> 3U])) ||
+                        (logged != ((0U != s_tc067_event) ? 1U : 0U)) ||
+                        (ev.event_code != s_tc067_event) ||
+                        (ev.data != (uint16_t)door))
+                    {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0U, mismatches);
+}
+
+/* =========================================================================
+ * TC-DSM-068: DSM_Timer — random arm / cancel / advance sequence across
+ *             both wheel levels and the 32-bit tick wrap matches a
+ *             per-timer deadline model: each timer expires at the first
+ *             advance with now >= deadline, exactly once
+ * Tests: REQ-PERF-001, REQ-FUN-001–015
+ * SIL: 3
+ * ========================================================================= */
+#define TC068_STEPS  (20000U)
+#define TC068_DOORS  ((MAX_DOORS < 8U) ? MAX_DOORS : 8U)
+
+void test_DSM_Timer_RandomSequence_MatchesDeadlineModel(void)
+{
+    /* TC-DSM-068 */
+    uint32_t    seed = 0x5EEDU;
+    uint32_t    now  = 0xFFFC0000U;   /* Wraps after ~4 min of wheel time */
+    uint32_t    deadline[DSM_TIMER_CHANNELS][8];
+    door_mask_t armed[DSM_TIMER_CHANNELS] = { 0U, 0U };
+    door_mask_t due;
+    uint32_t    step;
+    uint32_t    r;
+    uint32_t    mismatches = 0U;
+    uint8_t     ch;
+    uint8_t     door;
+
+    DSM_Timer_Init(now);
+    for (step = 0U; step < TC068_STEPS; step++)
+    {
+        r    = tc066_next(&seed);
+        ch   = (uint8_t)(r & 1U);
+        door = (uint8_t)((r >> 1U) % TC068_DOORS);
+
+        switch ((r >> 8U) % 4U)
+        {
+            case 0U:    /* Arm 1 ms .. 6 s ahead (level 0 and level 1) */
+                deadline[ch][door] = now + 1U + ((r >> 12U) % 6000U);
+                (void)DSM_Timer_Arm(ch, door, deadline[ch][door]);
+                armed[ch] |= DOOR_BIT(door);
+                break;
+            case 1U:
+                (void)DSM_Timer_Cancel(ch, door);
+                armed[ch] &= ~DOOR_BIT(door);
+                break;
+            default:    /* Advance 0 .. 99 ms (irregular cycle length) */
+                now += (r >> 12U) % 100U;
+                DSM_Timer_Advance(now);
+                for (ch = 0U; ch < DSM_TIMER_CHANNELS; ch++)
+                {
+                    due = 0U;
+                    for (door = 0U; door < TC068_DOORS; door++)
+                    {
+                        if ((0U != DOOR_MASK_TEST(armed[ch], door)) &&
+                            ((now - deadline[ch][door]) < 0x80000000UL))
+                        {
+                            due |= DOOR_BIT(door);
+                        }
+                    }
+                    armed[ch] &= ~due;
+                    if ((DSM_Timer_TakeExpired(ch) != due) ||
+                        (DSM_Timer_GetArmed(ch) != armed[ch]))
+                    {
+                        mismatches++;
+                    }
+                }
+                break;
+        }
+    }
+    TEST_ASSERT_TRUE(now < 0xFFFC0000U);   /* The tick wrapped */
+    TEST_ASSERT_EQUAL_UINT32(0U, mismatches);
+}
+
+/* =========================================================================
+ * TC-DSM-069: DSM_Timer — exact expiry of a 5 s timer across the tick wrap,
+ *             cancel discards a pending expiry, due / out-of-span deadlines
+ *             expire at once, invalid channel or door → ERR_RANGE
+ * Tests: REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_Timer_ExactExpiry_Cancel_Range(void)
+{
+    /* TC-DSM-069 */
+    const uint8_t door = (uint8_t)(MAX_DOORS - 1U);
+    uint32_t      now  = 0xFFFFFFF0U;
+    uint32_t      t;
+
+    DSM_Timer_Init(now);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_Timer_Arm(DSM_TIMER_STATE, door,
+                                                 now + 5000U));
+    for (t = 0U; t < 4999U; t += 20U)
+    {
+        DSM_Timer_Advance(now + t);
+        TEST_ASSERT_TRUE(0U == DSM_Timer_TakeExpired(DSM_TIMER_STATE));
+    }
+    DSM_Timer_Advance(now + 4999U);
+    TEST_ASSERT_TRUE(0U == DSM_Timer_TakeExpired(DSM_TIMER_STATE));
+    DSM_Timer_Advance(now + 5000U);
+    TEST_ASSERT_TRUE(DOOR_BIT(door) == DSM_Timer_TakeExpired(DSM_TIMER_STATE));
+    TEST_ASSERT_TRUE(0U == DSM_Timer_GetArmed(DSM_TIMER_STATE));
+
+    /* Cancel after expiry, before it is taken */
+    now += 5000U;
+    (void)DSM_Timer_Arm(DSM_TIMER_EMERGENCY, door, now + 60U);
+    DSM_Timer_Advance(now + 60U);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_Timer_Cancel(DSM_TIMER_EMERGENCY, door));
+    TEST_ASSERT_TRUE(0U == DSM_Timer_TakeExpired(DSM_TIMER_EMERGENCY));
+
+    /* Already due, and beyond the wheel span: expire at once */
+    now += 60U;
+    (void)DSM_Timer_Arm(DSM_TIMER_STATE, 0U, now);
+    (void)DSM_Timer_Arm(DSM_TIMER_EMERGENCY, 0U, now + 0x10000000U);
+    TEST_ASSERT_TRUE(DOOR_BIT(0U) == DSM_Timer_TakeExpired(DSM_TIMER_STATE));
+    TEST_ASSERT_TRUE(DOOR_BIT(0U) ==
+                     DSM_Timer_TakeExpired(DSM_TIMER_EMERGENCY));
+
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, DSM_Timer_Arm(DSM_TIMER_CHANNELS, 0U, 0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, DSM_Timer_Arm(DSM_TIMER_STATE,
+                                                   MAX_DOORS, 0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, DSM_Timer_Cancel(DSM_TIMER_CHANNELS, 0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, DSM_Timer_Cancel(DSM_TIMER_STATE,
+                                                      MAX_DOORS));
+    TEST_ASSERT_TRUE(0U == DSM_Timer_GetArmed(DSM_TIMER_CHANNELS));
+    TEST_ASSERT_TRUE(0U == DSM_Timer_TakeExpired(DSM_TIMER_CHANNELS));
+}
+
+/* =========================================================================
+ * TC-DSM-070: DSM_RunCycle — state and debounce timers are armed on the
+ *             wheel; a held emergency button is confirmed after 60 ms
+ *             without running the debounce every cycle
+ * Tests: REQ-SAFE-011, SW-HAZ-009, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_TimersArmedOnWheel(void)
+{
+    /* TC-DSM-070 */
+    hal_stub_gpio_value = 0U;
+    hal_stub_emerg_gpio = 0U;
+    DSM_RunCycle();
+    (void)DSM_ProcessOpenCommand(DOOR_BIT(0U));
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+    TEST_ASSERT_TRUE(DOOR_BIT(0U) == DSM_Timer_GetArmed(DSM_TIMER_STATE));
+
+    /* Press: debounce armed for every door, no door forced yet */
+    hal_stub_emerg_gpio = 1U;
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_TRUE(DOOR_MASK_ALL ==
+                     DSM_Timer_GetArmed(DSM_TIMER_EMERGENCY));
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[MAX_DOORS - 1U]);
+
+    hal_stub_tick_ms += 2U * CYCLE_MS;   /* 40 ms: still debouncing */
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[MAX_DOORS - 1U]);
+    hal_stub_tick_ms += CYCLE_MS;        /* 60 ms: confirmed */
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[MAX_DOORS - 1U]);
+    TEST_ASSERT_TRUE(DOOR_MASK_ALL == DSM_Timer_GetArmed(DSM_TIMER_STATE));
+    TEST_ASSERT_TRUE(0U == DSM_Timer_GetArmed(DSM_TIMER_EMERGENCY));
+
+    /* Still held: the next cycle restarts the debounce */
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_TRUE(DOOR_MASK_ALL ==
+                     DSM_Timer_GetArmed(DSM_TIMER_EMERGENCY));
+
+    /* Release cancels the debounce */
+    hal_stub_emerg_gpio = 0U;
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_TRUE(0U == DSM_Timer_GetArmed(DSM_TIMER_EMERGENCY));
+}
+
+/* =========================================================================
+ * TC-DSM-071: DSM_GetLockConfirmMs / DSM_GetLockConfirmCount — system tick
+ *             of the most recent door entering FSM_CLOSED_AND_LOCKED and
+ *             the number of such entries; a door staying locked moves
+ *             neither
+ * Tests: REQ-SAFE-007, REQ-PERF-001
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_GetLockConfirmMs_LastLockEntry(void)
+{
+    /* TC-DSM-071 */
+    const uint8_t last  = (uint8_t)(MAX_DOORS - 1U);
+    uint32_t      first_ms;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, DSM_GetLockConfirmMs());
+    TEST_ASSERT_EQUAL_UINT32(0U, DSM_GetLockConfirmCount());
+
+    hal_stub_gpio_value = 1U;             /* Both lock sensors engaged */
+    g_dsm_state[0]      = FSM_LOCKING;
+    hal_stub_tick_ms   += CYCLE_MS;
+    first_ms            = hal_stub_tick_ms;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_CLOSED_AND_LOCKED, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_UINT32(first_ms, DSM_GetLockConfirmMs());
+    TEST_ASSERT_EQUAL_UINT32(1U, DSM_GetLockConfirmCount());
+
+    /* Door 0 re-evaluated while still locked: unchanged */
+    hal_stub_tick_ms   += CYCLE_MS;
+    g_dsm_dirty         = DOOR_BIT(0U);
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_UINT32(first_ms, DSM_GetLockConfirmMs());
+    TEST_ASSERT_EQUAL_UINT32(1U, DSM_GetLockConfirmCount());
+
+    /* Another door locks later */
+    g_dsm_state[last]   = FSM_LOCKING;
+    g_dsm_dirty         = DOOR_BIT(last);
+    hal_stub_tick_ms   += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_CLOSED_AND_LOCKED, g_dsm_state[last]);
+    TEST_ASSERT_EQUAL_UINT32(first_ms + (2U * CYCLE_MS),
+                             DSM_GetLockConfirmMs());
+    TEST_ASSERT_EQUAL_UINT32(2U, DSM_GetLockConfirmCount());
+
+    /* DSM_Init: no lock confirmed yet */
+    (void)DSM_Init();
+    TEST_ASSERT_EQUAL_UINT32(0U, DSM_GetLockConfirmMs());
+    TEST_ASSERT_EQUAL_UINT32(0U, DSM_GetLockConfirmCount());
+    hal_stub_gpio_value = 0U;
+}
+
+/* =========================================================================
+ * TC-DSM-072: DSM_RunCycle — while the HAL motor inhibit is held (TCMS
+ *             emergency stop) a moving door is stopped in FSM_IDLE without
+ *             a motor timeout or FSM_FAULT, and open/close commands do not
+ *             start a door; after the release the pending commands run
+ * Tests: REQ-FUN-017, REQ-INT-004, REQ-SAFE-003
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_RunCycle_MotorInhibit_StopsDoorsInIdle(void)
+{
+    /* TC-DSM-072 */
+    hal_stub_gpio_value = 0U;
+    (void)DSM_ProcessOpenCommand(DOOR_BIT(0U));
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+
+    (void)HAL_EmergencyMotorStop();
+    hal_stub_actuator_trace = 0U;
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_UINT32(3U, hal_stub_actuator_trace);   /* Stop only */
+
+    /* Held states keep their door; commands start nothing */
+    g_dsm_state[1] = FSM_FULLY_OPEN;
+    g_dsm_state[2] = FSM_CLOSED_AND_LOCKED;
+    (void)DSM_ProcessCloseCommand(DOOR_BIT(1U));
+    (void)DSM_ProcessOpenCommand(DOOR_BIT(2U));
+    hal_stub_tick_ms += 6000U;                               /* > timeout */
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_INT(FSM_FULLY_OPEN, g_dsm_state[1]);
+    TEST_ASSERT_EQUAL_INT(FSM_CLOSED_AND_LOCKED, g_dsm_state[2]);
+    TEST_ASSERT_EQUAL_UINT32(3U, hal_stub_actuator_trace);
+    TEST_ASSERT_EQUAL_UINT8(0U, DSM_GetFault());
+
+    /* Release: every door is re-evaluated against its pending command */
+    (void)HAL_ReleaseMotorInhibit();
+    hal_stub_tick_ms += CYCLE_MS;
+    DSM_RunCycle();
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_INT(FSM_CLOSING, g_dsm_state[1]);
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[2]);
+}
+
+/* =========================================================================
+ * TC-DSM-073: DSM_HandleEmergencyRelease — a confirmed release under the
+ *             HAL motor inhibit unlocks the door without driving it and
+ *             leaves it in FSM_IDLE; once released it drives open again
+ * Tests: REQ-SAFE-011, SW-HAZ-009, REQ-INT-004
+ * SIL: 3
+ * ========================================================================= */
+void test_DSM_HandleEmergencyRelease_MotorInhibit_UnlockOnly(void)
+{
+    /* TC-DSM-073 */
+    g_dsm_state[0]      = FSM_CLOSED_AND_LOCKED;
+    hal_stub_emerg_gpio = 1U;
+    (void)HAL_EmergencyMotorStop();
+    hal_stub_actuator_trace = 0U;
+
+    (void)DSM_HandleEmergencyRelease(0U, 0U);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_HandleEmergencyRelease(0U, 70U));
+    TEST_ASSERT_EQUAL_INT(FSM_IDLE, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_UINT32(5U, hal_stub_actuator_trace);   /* Unlock only */
+
+    (void)HAL_ReleaseMotorInhibit();
+    (void)DSM_HandleEmergencyRelease(0U, 80U);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DSM_HandleEmergencyRelease(0U, 150U));
+    TEST_ASSERT_EQUAL_INT(FSM_OPENING, g_dsm_state[0]);
+    TEST_ASSERT_EQUAL_UINT32((5U << 6U) | (5U << 3U) | 1U,
+                             hal_stub_actuator_trace);
+    hal_stub_emerg_gpio = 0U;
+}
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -1130,6 +2094,23 @@ int main(void)
     RUN_TEST(test_DSM_RunCycle_Fault_DoorStateFault);
     RUN_TEST(test_DSM_RunCycle_UpdateFsmError_SetsFault);
     RUN_TEST(test_DSM_RunCycle_EmergencyReleaseError_SetsFault);
+    RUN_TEST(test_DSM_ProcessCommand_WideMask_ClippedToDoors);
+    RUN_TEST(test_DSM_RunCycle_MasksMatchArrays);
+    RUN_TEST(test_DSM_VotePositionBatch_MatchesPerDoorVoter);
+    RUN_TEST(test_DSM_VotePositionBatch_NullOut);
+    RUN_TEST(test_DSM_StepFSM_UsesOwnDoorVotes);
+    RUN_TEST(test_DSM_RunCycle_NoChange_SkipsAllDoors);
+    RUN_TEST(test_DSM_RunCycle_Command_EvaluatesOnlyThatDoor);
+    RUN_TEST(test_DSM_RunCycle_TimerExpiry_DirtiesDoor);
+    RUN_TEST(test_DSM_RunCycle_SafeStateChange_DirtiesAllDoors);
+    RUN_TEST(test_DSM_RunCycle_ChangeDriven_MatchesFullEvaluation);
+    RUN_TEST(test_DSM_StepFSM_TransitionTable_MatchesHandlers);
+    RUN_TEST(test_DSM_Timer_RandomSequence_MatchesDeadlineModel);
+    RUN_TEST(test_DSM_Timer_ExactExpiry_Cancel_Range);
+    RUN_TEST(test_DSM_RunCycle_TimersArmedOnWheel);
+    RUN_TEST(test_DSM_GetLockConfirmMs_LastLockEntry);
+    RUN_TEST(test_DSM_RunCycle_MotorInhibit_StopsDoorsInIdle);
+    RUN_TEST(test_DSM_HandleEmergencyRelease_MotorInhibit_UnlockOnly);
 
     return UNITY_END();
 }
@@ -1,10 +1,12 @@
 /**
  * @file    test_fmg.c
- * @brief   Unit tests for FMG module (COMP-005) — 17 test cases.
- * @details Covers TC-FMG-001 through TC-FMG-017.
+ * @brief   Unit tests for FMG module (COMP-005) — 21 test cases.
+ * @details Covers TC-FMG-001 through TC-FMG-021.
  *          Tests: FMG_AggregateFaults, FMG_ClassifyAndEscalate,
  *                 FMG_HandleSelectiveDisablement, FMG_Init, FMG_GetFaultState,
- *                 FMG_RunCycle, FMG_GetFault.
+ *                 FMG_RunCycle, FMG_GetFault, FMG_GetFaultStats,
+ *                 FMG_ProcessEmergencyStop, FMG_ReleaseEmergencyStop,
+ *                 FMG_IsEmergencyStopActive.
  *
  * @project TDC (Train Door Control System)
  * @phase   Phase 5 — Implementation & Testing
@@ -21,6 +23,7 @@
 #include "../../src/tdc_types.h"
 #include "../../src/fmg.h"
 #include "../../src/hal.h"
+#include "../../src/dgn.h"
 
 /* Stub setters from fmg_deps_stub.c */
 extern void fmg_stub_set_spm_fault(uint8_t v);
@@ -29,6 +32,8 @@ extern void fmg_stub_set_dsm_fault(uint8_t v);
 extern void fmg_stub_set_tci_fault(uint8_t v);
 extern void fmg_stub_reset_all(void);
 
+extern uint32_t hal_stub_tick_ms;
+
 /* =========================================================================
  * setUp / tearDown
  * ========================================================================= */
@@ -279,6 +284,185 @@ void test_FMG_RunCycle_AllFaults(void)
     TEST_ASSERT_EQUAL_UINT8(1U, FMG_GetFault());
 }
 
+/* =========================================================================
+ * TC-FMG-018: Soak — 20 000 cycles (400 s) with a persistent TCI fault and
+ *             a one-cycle OBD fault every 1000 cycles: the log grows by one
+ *             entry per fault-bitmask change, not per cycle; the activation
+ *             history counts the rising edges and first/last-seen ticks
+ * Tests: REQ-SAFE-012/013, REQ-FUN-018, UNIT-FMG-002/005/007
+ * SIL: 3
+ * ========================================================================= */
+#define TC018_CYCLES  (20000U)
+#define TC018_PERIOD  (1000U)
+
+void test_FMG_Soak_LogGrowsWithFaultChanges(void)
+{
+    /* TC-FMG-018 */
+    fmg_fault_stats_t stats;
+    event_log_entry_t entry;
+    uint32_t          cycle;
+    uint32_t          changes = 0U;
+    uint8_t           prev    = 0U;
+    uint16_t          count_before;
+
+    (void)DGN_Init();
+    count_before     = DGN_GetLogCount();
+    hal_stub_tick_ms = 1000U;
+
+    fmg_stub_set_tci_fault(1U);
+    for (cycle = 0U; cycle < TC018_CYCLES; cycle++)
+    {
+        fmg_stub_set_obd_fault(((cycle % TC018_PERIOD) == 500U) ? 1U : 0U);
+        FMG_RunCycle();
+        if (FMG_GetFaultState() != prev)
+        {
+            changes++;
+            prev = FMG_GetFaultState();
+        }
+        hal_stub_tick_ms += CYCLE_MS;
+    }
+
+    /* 0→TCI, then TCI→TCI|OBD→TCI per period: 41 entries, not 20 000 */
+    TEST_ASSERT_EQUAL_UINT32(1U + (2U * (TC018_CYCLES / TC018_PERIOD)),
+                             changes);
+    TEST_ASSERT_EQUAL_UINT32(changes,
+                             (uint32_t)(DGN_GetLogCount() - count_before));
+
+    (void)FMG_GetFaultStats(3U, &stats);     /* TCI */
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.activation_count);
+    TEST_ASSERT_EQUAL_UINT32(1000U, stats.first_seen_ms);
+    TEST_ASSERT_EQUAL_UINT32(1000U + ((TC018_CYCLES - 1U) * CYCLE_MS),
+                             stats.last_seen_ms);
+    (void)FMG_GetFaultStats(1U, &stats);     /* OBD */
+    TEST_ASSERT_EQUAL_UINT32(TC018_CYCLES / TC018_PERIOD,
+                             stats.activation_count);
+    TEST_ASSERT_EQUAL_UINT32(1000U + (500U * CYCLE_MS), stats.first_seen_ms);
+    TEST_ASSERT_EQUAL_UINT32(1000U + ((TC018_CYCLES - 500U) * CYCLE_MS),
+                             stats.last_seen_ms);
+    (void)FMG_GetFaultStats(4U, &stats);     /* HAL: never set */
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.activation_count);
+
+    /* Clearing logs one EVT_FAULT_CLEARED with the previous bitmask */
+    fmg_stub_set_tci_fault(0U);
+    FMG_RunCycle();
+    FMG_RunCycle();
+    TEST_ASSERT_EQUAL_UINT32(changes + 1U,
+                             (uint32_t)(DGN_GetLogCount() - count_before));
+    (void)DGN_ReadEvent((uint16_t)(DGN_GetLogCount() - 1U), &entry);
+    TEST_ASSERT_EQUAL_UINT8(EVT_FAULT_CLEARED, entry.event_code);
+    TEST_ASSERT_EQUAL_UINT16(0x08U, entry.data);
+}
+
+/* =========================================================================
+ * TC-FMG-019: FMG_ClassifyAndEscalate — an unchanged bitmask returns the
+ *             cached severity without a log entry; a change is logged with
+ *             bitmask and severity; FMG_GetFaultStats NULL / range checks
+ * Tests: REQ-SAFE-013, UNIT-FMG-002/007
+ * SIL: 3
+ * ========================================================================= */
+void test_FMG_ClassifyAndEscalate_EdgeTriggered(void)
+{
+    /* TC-FMG-019 */
+    fault_severity_t  sev = FAULT_NONE;
+    fmg_fault_stats_t stats;
+    event_log_entry_t entry;
+    uint16_t          count;
+
+    (void)DGN_Init();
+    count = DGN_GetLogCount();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, FMG_ClassifyAndEscalate(0x04U, &sev));
+    TEST_ASSERT_EQUAL_INT(FAULT_HIGH, sev);
+    TEST_ASSERT_EQUAL_UINT16(count + 1U, DGN_GetLogCount());
+    (void)DGN_ReadEvent(count, &entry);
+    TEST_ASSERT_EQUAL_UINT8(EVT_FAULT_ACTIVE, entry.event_code);
+    TEST_ASSERT_EQUAL_UINT16((0x04U << 8U) | (uint16_t)FAULT_HIGH, entry.data);
+
+    sev = FAULT_NONE;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, FMG_ClassifyAndEscalate(0x04U, &sev));
+    TEST_ASSERT_EQUAL_INT(FAULT_HIGH, sev);
+    TEST_ASSERT_EQUAL_UINT16(count + 1U, DGN_GetLogCount());
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, FMG_ClassifyAndEscalate(0x14U, &sev));
+    TEST_ASSERT_EQUAL_INT(FAULT_CRITICAL, sev);
+    TEST_ASSERT_EQUAL_UINT16(count + 2U, DGN_GetLogCount());
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, FMG_GetFaultStats(0U, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, FMG_GetFaultStats(FMG_FAULT_BITS, &stats));
+}
+
+/* =========================================================================
+ * TC-FMG-020: Severity table — for all 32 fault bitmasks, FMG_AggregateFaults
+ *             rebuilds the bitmask from arbitrary non-zero flags and
+ *             FMG_ClassifyAndEscalate matches the priority chain it replaced
+ * Tests: REQ-SAFE-013, UNIT-FMG-001/002
+ * SIL: 3
+ * ========================================================================= */
+
+/** @brief Reference model: the if/else priority chain of fmg_classify */
+static fault_severity_t tc020_reference(uint8_t fault_state)
+{
+    if ((fault_state & 0x10U) != 0U) { return FAULT_CRITICAL; }
+    if ((fault_state & 0x04U) != 0U) { return FAULT_HIGH; }
+    if ((fault_state & 0x09U) != 0U) { return FAULT_MEDIUM; }
+    if ((fault_state & 0x02U) != 0U) { return FAULT_LOW; }
+    return FAULT_NONE;
+}
+
+void test_FMG_SeverityTable_MatchesPriorityChain(void)
+{
+    /* TC-FMG-020 */
+    fault_severity_t sev;
+    uint32_t         mask;
+    uint32_t         mismatches = 0U;
+    uint8_t          state;
+
+    for (mask = 0U; mask < (1UL << FMG_FAULT_BITS); mask++)
+    {
+        state = 0xFFU;
+        sev   = FAULT_NONE;
+        (void)FMG_AggregateFaults((uint8_t)((mask & 0x01U) * 0x81U),
+                                  (uint8_t)((mask & 0x02U) * 0x40U),
+                                  (uint8_t)(mask & 0x04U),
+                                  (uint8_t)((mask & 0x08U) * 0x1FU),
+                                  (uint8_t)((mask & 0x10U) * 0x0FU),
+                                  &state);
+        (void)FMG_ClassifyAndEscalate(state, &sev);
+        if ((state != (uint8_t)mask) ||
+            (sev != tc020_reference((uint8_t)mask)))
+        {
+            mismatches++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0U, mismatches);
+}
+
+/* =========================================================================
+ * TC-FMG-021: FMG_ReleaseEmergencyStop — clears the stop flag and logs
+ *             EVT_ESTOP_RELEASED once; a release without an active stop
+ *             logs nothing
+ * Tests: REQ-SAFE-021, REQ-INT-004
+ * SIL: 3
+ * ========================================================================= */
+void test_FMG_ReleaseEmergencyStop_ClearsFlag(void)
+{
+    /* TC-FMG-021 */
+    event_log_entry_t entry;
+    uint16_t          count_before;
+
+    (void)FMG_ProcessEmergencyStop(0x21U);
+    TEST_ASSERT_EQUAL_UINT8(1U, FMG_IsEmergencyStopActive());
+
+    count_before = DGN_GetLogCount();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, FMG_ReleaseEmergencyStop());
+    TEST_ASSERT_EQUAL_UINT8(0U, FMG_IsEmergencyStopActive());
+    TEST_ASSERT_EQUAL_UINT16(count_before + 1U, DGN_GetLogCount());
+    (void)DGN_ReadEvent((uint16_t)(DGN_GetLogCount() - 1U), &entry);
+    TEST_ASSERT_EQUAL_UINT8(EVT_ESTOP_RELEASED, entry.event_code);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, FMG_ReleaseEmergencyStop());
+    TEST_ASSERT_EQUAL_UINT16(count_before + 1U, DGN_GetLogCount());
+}
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -303,6 +487,10 @@ int main(void)
     RUN_TEST(test_FMG_GetFault_AfterInit_ReturnsZero);
     RUN_TEST(test_FMG_GetFault_AfterRunCycle_WithFault_ReturnsOne);
     RUN_TEST(test_FMG_RunCycle_AllFaults);
+    RUN_TEST(test_FMG_Soak_LogGrowsWithFaultChanges);
+    RUN_TEST(test_FMG_ClassifyAndEscalate_EdgeTriggered);
+    RUN_TEST(test_FMG_SeverityTable_MatchesPriorityChain);
+    RUN_TEST(test_FMG_ReleaseEmergencyStop_ClearsFlag);
 
     return UNITY_END();
 }
@@ -5,6 +5,16 @@
  *          Tests: HAL_GPIO_ReadPositionSensor, CRC16_CCITT_Compute,
  *                 HAL_CAN_Transmit, HAL_SPI_CrossChannel_Exchange,
  *                 HAL_Watchdog_Refresh.
+ *          TC-HAL-058/059 check the build-selected CRC backend
+ *          (HAL_CRC16_BACKEND) against the bitwise reference;
+ *          TC-HAL-060/061 cover the streaming CRC API;
+ *          TC-HAL-062 covers the input process image; TC-HAL-063/064 the
+ *          output image commit; TC-HAL-065/066 the asynchronous SPI
+ *          exchange (Start/Poll/Complete); TC-HAL-067 the emergency
+ *          motor stop; TC-HAL-068 the motor current scan blocks;
+ *          TC-HAL-069 the SPI NOR Flash driver on the host device model
+ *          (stubs/hal_flash_sim.c);
+ *          TC-HAL-070 the obstacle stop latch of HAL_MotorStopNow.
  *
  * @project TDC (Train Door Control System)
  * @phase   Phase 5 — Implementation & Testing
@@ -14,12 +24,15 @@
  * @traceability
  *   Tests: REQ-SAFE-001, REQ-SAFE-016
  *   Item 16: Software Component Test Specification §COMP-001
- *   Item 18: Source Code (hal_services.c)
+ *   Item 18: Source Code (hal_services.c, hal_flash.c)
  */
 
+#include <stdio.h>
+
 #include "../unity/src/unity.h"
 #include "../../src/tdc_types.h"
 #include "../../src/hal.h"
+#include "stubs/hal_flash_sim.h"
 
 /* =========================================================================
  * External HAL stub controls (defined in hal_stub.c)
@@ -190,18 +203,13 @@ void test_HAL_CAN_Transmit_Success(void)
 void test_HAL_SPI_CrossChannel_Exchange_Success(void)
 {
     /* TC-HAL-010 */
-    cross_channel_state_t local;
-    cross_channel_state_t remote;
+    cross_channel_wire_t local;
+    cross_channel_wire_t remote;
     uint8_t i;
-    for (i = 0U; i < MAX_DOORS; i++) {
-        local.door_states[i]    = 0U;
-        local.lock_states[i]    = 0U;
-        local.obstacle_flags[i] = 0U;
+    for (i = 0U; i < CCS_WIRE_WORDS; i++) {
+        local.words[i] = 0U;
     }
-    local.speed_kmh_x10    = 0U;
-    local.fault_flags      = 0U;
-    local.safety_decisions = 0U;
-    local.crc16            = 0U;
+    local.crc16 = 0U;
 
     error_t ret = HAL_SPI_CrossChannel_Exchange(&local, &remote);
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
@@ -573,7 +581,7 @@ void test_HAL_CAN_Transmit_NotInitialized(void)
 void test_HAL_SPI_CrossChannel_NullLocal(void)
 {
     /* TC-HAL-037 */
-    cross_channel_state_t remote;
+    cross_channel_wire_t remote;
     error_t ret = HAL_SPI_CrossChannel_Exchange(NULL, &remote);
     TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, ret);
 }
@@ -586,17 +594,12 @@ void test_HAL_SPI_CrossChannel_NullLocal(void)
 void test_HAL_SPI_CrossChannel_NullRemote(void)
 {
     /* TC-HAL-038 */
-    cross_channel_state_t local;
+    cross_channel_wire_t local;
     uint8_t i;
-    for (i = 0U; i < MAX_DOORS; i++) {
-        local.door_states[i]    = 0U;
-        local.lock_states[i]    = 0U;
-        local.obstacle_flags[i] = 0U;
+    for (i = 0U; i < CCS_WIRE_WORDS; i++) {
+        local.words[i] = 0U;
     }
-    local.speed_kmh_x10 = 0U;
-    local.fault_flags   = 0U;
-    local.safety_decisions = 0U;
-    local.crc16         = 0U;
+    local.crc16 = 0U;
     error_t ret = HAL_SPI_CrossChannel_Exchange(&local, NULL);
     TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, ret);
 }
@@ -838,6 +841,495 @@ void test_HAL_PWM_SetDutyCycle_LastDoor(void)
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
 }
 
+/* =========================================================================
+ * CRC backend equivalence helpers
+ * Reference: bit-by-bit CRC-16-CCITT (poly 0x1021, init 0xFFFF), i.e. the
+ * original algorithm. The build-selected backend (HAL_CRC16_BACKEND) must
+ * match it for every length and alignment.
+ * ========================================================================= */
+static uint16_t crc16_reference(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0xFFFFU;
+    uint16_t byte_idx;
+    uint8_t  bit_idx;
+
+    for (byte_idx = 0U; byte_idx < length; byte_idx++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[byte_idx] << 8U);
+        for (bit_idx = 0U; bit_idx < 8U; bit_idx++)
+        {
+            if ((crc & 0x8000U) != 0U)
+            {
+                crc = (uint16_t)((crc << 1U) ^ 0x1021U);
+            }
+            else
+            {
+                crc = (uint16_t)(crc << 1U);
+            }
+        }
+    }
+    return crc;
+}
+
+static void crc16_fill_pattern(uint8_t *buf, uint16_t length)
+{
+    uint32_t lcg = 0x12345678UL;
+    uint16_t idx;
+
+    for (idx = 0U; idx < length; idx++)
+    {
+        lcg = (lcg * 1103515245UL) + 12345UL;
+        buf[idx] = (uint8_t)(lcg >> 16U);
+    }
+}
+
+/* =========================================================================
+ * TC-HAL-058: CRC16_CCITT_Compute — selected backend equals bitwise
+ *             reference for lengths 1..67 at byte offsets 0..7
+ * Tests: REQ-SAFE-018, UNIT-HAL-020 (block/tail boundaries of slice-by-4/8)
+ * SIL: 3
+ * ========================================================================= */
+void test_CRC16_CCITT_BackendMatchesReference(void)
+{
+    /* TC-HAL-058 */
+    uint8_t  buf[80];
+    uint16_t len;
+    uint8_t  offset;
+
+    crc16_fill_pattern(buf, (uint16_t)sizeof(buf));
+    for (offset = 0U; offset < 8U; offset++)
+    {
+        for (len = 1U; len <= 67U; len++)
+        {
+            TEST_ASSERT_EQUAL_HEX16(crc16_reference(&buf[offset], len),
+                                    CRC16_CCITT_Compute(&buf[offset], len));
+        }
+    }
+}
+
+/* =========================================================================
+ * TC-HAL-059: CRC16_CCITT_Compute — selected backend equals bitwise
+ *             reference over a ROM-scan sized block (4 KiB)
+ * Tests: REQ-SAFE-018, UNIT-HAL-020, UNIT-SKN-006 (ROM integrity input)
+ * SIL: 3
+ * ========================================================================= */
+void test_CRC16_CCITT_BackendLargeBlock(void)
+{
+    /* TC-HAL-059 */
+    static uint8_t buf[4096];
+
+    crc16_fill_pattern(buf, (uint16_t)sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX16(crc16_reference(buf, (uint16_t)sizeof(buf)),
+                            CRC16_CCITT_Compute(buf, (uint16_t)sizeof(buf)));
+}
+
+/* =========================================================================
+ * TC-HAL-060: CRC16_CCITT_Init/Update/Final — any split of a buffer into
+ *             consecutive Update calls equals CRC16_CCITT_Compute
+ * Tests: REQ-SAFE-018, UNIT-HAL-021..023
+ * SIL: 3
+ * ========================================================================= */
+void test_CRC16_CCITT_StreamingMatchesOneShot(void)
+{
+    /* TC-HAL-060 */
+    uint8_t  buf[257];
+    uint16_t expected;
+    uint16_t crc;
+    uint16_t split;
+
+    crc16_fill_pattern(buf, (uint16_t)sizeof(buf));
+    expected = CRC16_CCITT_Compute(buf, (uint16_t)sizeof(buf));
+
+    for (split = 0U; split <= (uint16_t)sizeof(buf); split++)
+    {
+        crc = CRC16_CCITT_Init();
+        crc = CRC16_CCITT_Update(crc, buf, split);
+        crc = CRC16_CCITT_Update(crc, &buf[split],
+                                 (uint32_t)sizeof(buf) - split);
+        TEST_ASSERT_EQUAL_HEX16(expected, CRC16_CCITT_Final(crc));
+    }
+}
+
+/* =========================================================================
+ * TC-HAL-061: CRC16_CCITT_Update — NULL data or length=0 → register
+ *             unchanged; Init returns 0xFFFF
+ * Tests: REQ-SAFE-018, UNIT-HAL-021/022 (defensive paths)
+ * SIL: 3
+ * ========================================================================= */
+void test_CRC16_CCITT_UpdateDefensive(void)
+{
+    /* TC-HAL-061 */
+    uint8_t data[2] = {0x31U, 0x32U};
+
+    TEST_ASSERT_EQUAL_HEX16(0xFFFFU, CRC16_CCITT_Init());
+    TEST_ASSERT_EQUAL_HEX16(0x1234U, CRC16_CCITT_Update(0x1234U, NULL, 2U));
+    TEST_ASSERT_EQUAL_HEX16(0x1234U, CRC16_CCITT_Update(0x1234U, data, 0U));
+}
+
+/* =========================================================================
+ * TC-HAL-062: HAL_GPIO_CaptureInputImage — after HAL_Init all inputs
+ *             inactive, no read fault; image pointer stable and non-NULL
+ * Tests: REQ-INT-001/002/003, UNIT-HAL-024/025
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_GPIO_CaptureInputImage_AfterInit(void)
+{
+    /* TC-HAL-062 */
+    const hal_input_image_t *image = HAL_GPIO_GetInputImage();
+
+    TEST_ASSERT_NOT_NULL(image);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_GPIO_CaptureInputImage());
+    TEST_ASSERT_TRUE(image == HAL_GPIO_GetInputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, image->position_a | image->position_b);
+    TEST_ASSERT_EQUAL_UINT8(0U, image->lock_a | image->lock_b);
+    TEST_ASSERT_EQUAL_UINT8(0U, image->obstacle_a | image->obstacle_b);
+    TEST_ASSERT_EQUAL_UINT8(0U, image->emergency);
+    TEST_ASSERT_EQUAL_UINT8(0U, image->read_fault);
+}
+
+/* =========================================================================
+ * TC-HAL-063: HAL_CommitOutputImage — repeated motor writes to one door in
+ *             a cycle collapse to one write per changed output; an
+ *             unchanged image commits with zero writes
+ * Tests: REQ-INT-004, UNIT-HAL-026/027
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_CommitOutputImage_CoalescesAndSuppresses(void)
+{
+    /* TC-HAL-063 */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStop(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStop(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(2U, HAL_GetOutputWriteCount()); /* dir + PWM0 */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+
+    /* Same value restaged — still suppressed */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+
+    /* Stop two doors: PWM only, one write per changed channel */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(1U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStop(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStop(1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(2U, HAL_GetOutputWriteCount());
+}
+
+/* =========================================================================
+ * TC-HAL-064: HAL_CommitOutputImage — lock outputs of all doors form one
+ *             port write; engage+disengage in one cycle writes nothing
+ * Tests: REQ-INT-002, UNIT-HAL-026/027
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_CommitOutputImage_LockPortBatched(void)
+{
+    /* TC-HAL-064 */
+    uint8_t i;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_LockEngage(2U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_LockDisengage(2U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_LockEngage(i));
+    }
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+}
+
+/* =========================================================================
+ * TC-HAL-065: HAL_SPI_CrossChannel_Start/Poll/Complete — asynchronous
+ *             exchange delivers the peer state (stub: loopback)
+ * Tests: REQ-SAFE-002, UNIT-HAL-029/030/031/032
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_SPI_CrossChannel_AsyncExchange(void)
+{
+    /* TC-HAL-065 */
+    cross_channel_wire_t local;
+    cross_channel_wire_t remote;
+    uint8_t done = 0U;
+    uint8_t i;
+
+    for (i = 0U; i < CCS_WIRE_WORDS; i++) {
+        local.words[i]  = 0x01020304UL * ((uint32_t)i + 1U);
+        remote.words[i] = 0U;
+    }
+    local.crc16  = 0xBEEFU;
+    remote.crc16 = 0U;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_SPI_CrossChannel_Start(&local));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_SPI_CrossChannel_Poll(&done));
+    TEST_ASSERT_EQUAL_UINT8(1U, done);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_SPI_CrossChannel_Complete(&remote));
+    for (i = 0U; i < CCS_WIRE_WORDS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(local.words[i], remote.words[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0xBEEFU, remote.crc16);
+}
+
+/* =========================================================================
+ * TC-HAL-066: HAL_SPI_CrossChannel_Start/Poll/Complete — sequencing and
+ *             NULL errors
+ * Tests: REQ-SAFE-002, UNIT-HAL-029/030/031
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_SPI_CrossChannel_AsyncSequenceErrors(void)
+{
+    /* TC-HAL-066 */
+    cross_channel_wire_t local;
+    cross_channel_wire_t remote;
+    uint8_t done = 0U;
+
+    local.words[0] = 0U;
+
+    /* Nothing in flight */
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE, HAL_SPI_CrossChannel_Poll(&done));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE,
+                          HAL_SPI_CrossChannel_Complete(&remote));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_SPI_CrossChannel_Start(NULL));
+
+    /* One transfer at a time */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_SPI_CrossChannel_Start(&local));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE,
+                          HAL_SPI_CrossChannel_Start(&local));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_SPI_CrossChannel_Poll(NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_SPI_CrossChannel_Complete(NULL));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_SPI_CrossChannel_Complete(&remote));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE,
+                          HAL_SPI_CrossChannel_Complete(&remote));
+}
+
+/* =========================================================================
+ * TC-HAL-067: HAL_EmergencyMotorStop — PWM stopped without a commit;
+ *             the inhibit keeps later commits and HAL_PWM_SetDutyCycle at
+ *             duty 0 until HAL_ReleaseMotorInhibit (a duty staged meanwhile
+ *             is discarded) or HAL_Init
+ * Tests: REQ-INT-004, REQ-SAFE-003, UNIT-HAL-026/033/034
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_EmergencyMotorStop_InhibitsMotors(void)
+{
+    /* TC-HAL-067 */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_IsMotorInhibited());
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_EmergencyMotorStop());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_IsMotorInhibited());
+
+    /* Register already 0: the next commit has no PWM write */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+
+    /* A staged start is committed as direction only, PWM stays 0 */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(1U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+
+    TEST_ASSERT_EQUAL_INT(ERR_NOT_PERMITTED, HAL_PWM_SetDutyCycle(0U, 50U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_PWM_SetDutyCycle(0U, 0U));
+
+    /* Release: the start staged during the inhibit is not committed */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_ReleaseMotorInhibit());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_IsMotorInhibited());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(1U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+
+    /* HAL_Init clears a latched inhibit as well */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_EmergencyMotorStop());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Init());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_IsMotorInhibited());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_PWM_SetDutyCycle(0U, 50U));
+}
+
+/* =========================================================================
+ * TC-HAL-068: HAL_ADC_TakeBlock — NULL → ERR_NULL_PTR; nothing completed →
+ *             ERR_TIMEOUT; blocks completed by the DMA ISR are taken
+ *             oldest first with consecutive sequence numbers, each a full
+ *             block of every door; a consumer behind by more than the ring
+ *             resumes at the oldest intact block
+ * Tests: REQ-SAFE-006, UNIT-HAL-036/037
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_ADC_TakeBlock_Ring(void)
+{
+    /* TC-HAL-068 */
+    const hal_adc_block_t *first  = NULL;
+    const hal_adc_block_t *second = NULL;
+    uint32_t seq = 0xFFFFFFFFU;
+    uint8_t  i;
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_ADC_TakeBlock(NULL, &seq));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_ADC_TakeBlock(&first, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_TIMEOUT, HAL_ADC_TakeBlock(&first, &seq));
+
+    /* Two blocks between takes: both returned, in order */
+    HAL_ADC_DmaBlockISR();
+    HAL_ADC_DmaBlockISR();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_ADC_TakeBlock(&first, &seq));
+    TEST_ASSERT_EQUAL_UINT32(0U, seq);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_ADC_TakeBlock(&second, &seq));
+    TEST_ASSERT_EQUAL_UINT32(1U, seq);
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_TRUE(first != second);
+    TEST_ASSERT_EQUAL_UINT16(0U, second->sample[HAL_ADC_BLOCK_SAMPLES - 1U]
+                                               [MAX_DOORS - 1U]);
+    TEST_ASSERT_EQUAL_INT(ERR_TIMEOUT, HAL_ADC_TakeBlock(&first, &seq));
+
+    /* Ring overrun: blocks 2 .. 2 + HAL_ADC_RING_BLOCKS completed, the
+     * oldest intact one is the first after the one being overwritten */
+    for (i = 0U; i <= HAL_ADC_RING_BLOCKS; i++)
+    {
+        HAL_ADC_DmaBlockISR();
+    }
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_ADC_TakeBlock(&first, &seq));
+    TEST_ASSERT_EQUAL_UINT32(4U, seq);
+    for (i = 2U; i < HAL_ADC_RING_BLOCKS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_ADC_TakeBlock(&first, &seq));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2U + HAL_ADC_RING_BLOCKS, seq);
+    TEST_ASSERT_EQUAL_INT(ERR_TIMEOUT, HAL_ADC_TakeBlock(&first, &seq));
+}
+
+/* =========================================================================
+ * TC-HAL-069: HAL_Flash — argument checks; NOR semantics (program clears
+ *             bits only, erase sets the sector to 0xFF); an injected power
+ *             cut tears a page program and fails every access until power
+ *             returns; the image file keeps the contents across attach
+ * Tests: REQ-FUN-018, UNIT-HAL-038..040
+ * SIL: 1
+ * ========================================================================= */
+void test_HAL_Flash_NorSemantics_PowerCut(void)
+{
+    /* TC-HAL-069 */
+    const char *const path = "tc_hal_069.img";
+    const uint8_t     f0[2] = { 0xF0U, 0xF0U };
+    const uint8_t     x3[2] = { 0x3CU, 0x3CU };
+    uint8_t           page[HAL_FLASH_PAGE_BYTES];
+    uint8_t           rd[4];
+    uint16_t          i;
+
+    HAL_FlashSim_Reset();
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_Flash_Read(0U, NULL, 1U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, HAL_Flash_Read(HAL_FLASH_SIZE_BYTES - 1U,
+                                                    rd, 2U));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_Flash_ProgramPage(0U, NULL, 1U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, HAL_Flash_ProgramPage(0U, f0, 0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE,
+                          HAL_Flash_ProgramPage(HAL_FLASH_PAGE_BYTES - 1U,
+                                                f0, 2U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, HAL_Flash_EraseSector(HAL_FLASH_PAGE_BYTES));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, HAL_Flash_EraseSector(HAL_FLASH_SIZE_BYTES));
+
+    /* Program ANDs into the cells; only an erase sets them again */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_ProgramPage(0U, f0, 2U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_ProgramPage(1U, x3, 2U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_Read(0U, rd, 4U));
+    TEST_ASSERT_EQUAL_UINT8(0xF0U, rd[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x30U, rd[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x3CU, rd[2]);
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, rd[3]);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_EraseSector(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_Read(0U, rd, 4U));
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, rd[1]);
+    TEST_ASSERT_EQUAL_UINT32(1U, HAL_FlashSim_GetEraseCount(0U));
+    TEST_ASSERT_EQUAL_UINT32(0U, HAL_FlashSim_GetEraseCount(HAL_FLASH_SECTORS));
+
+    /* Power cut after 100 of 256 bytes */
+    for (i = 0U; i < HAL_FLASH_PAGE_BYTES; i++)
+    {
+        page[i] = 0x00U;
+    }
+    HAL_FlashSim_CutPowerAfter(100U);
+    TEST_ASSERT_EQUAL_INT(ERR_HW_FAULT,
+                          HAL_Flash_ProgramPage(HAL_FLASH_PAGE_BYTES, page,
+                                                HAL_FLASH_PAGE_BYTES));
+    TEST_ASSERT_EQUAL_INT(ERR_HW_FAULT, HAL_Flash_Read(0U, rd, 1U));
+    TEST_ASSERT_EQUAL_INT(ERR_HW_FAULT, HAL_Flash_EraseSector(0U));
+    HAL_FlashSim_PowerOn();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_Read(HAL_FLASH_PAGE_BYTES + 99U,
+                                                  rd, 2U));
+    TEST_ASSERT_EQUAL_UINT8(0x00U, rd[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, rd[1]);
+
+#if defined(__linux__)
+    /* Image file: contents survive detach, reset of the RAM image, attach */
+    (void)remove(path);
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, HAL_FlashSim_Attach(NULL));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_FlashSim_Attach(path));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_Read(0U, rd, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, rd[0]);   /* New file: erased */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_ProgramPage(HAL_FLASH_SIZE_BYTES -
+                                                         2U, x3, 2U));
+    HAL_FlashSim_Detach();
+    HAL_FlashSim_Reset();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_FlashSim_Attach(path));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Flash_Read(HAL_FLASH_SIZE_BYTES - 2U,
+                                                  rd, 2U));
+    TEST_ASSERT_EQUAL_UINT8(0x3CU, rd[1]);
+    HAL_FlashSim_Detach();
+    (void)remove(path);
+#else
+    (void)path;
+#endif
+    HAL_FlashSim_Reset();
+}
+
+/* =========================================================================
+ * TC-HAL-070: HAL_MotorStopNow — the door's stop latch keeps later commits
+ *             at duty 0 even for a close duty staged after the stop (the
+ *             duty a preempted commit had read); other doors are not
+ *             affected; the open-direction start of the reversal or
+ *             HAL_Init releases it; door_id >= MAX_DOORS → ERR_RANGE
+ * Tests: REQ-INT-004, REQ-SAFE-004, UNIT-HAL-026/035
+ * SIL: 3
+ * ========================================================================= */
+void test_HAL_MotorStopNow_LatchHoldsUntilReversal(void)
+{
+    /* TC-HAL-070 */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 0U));  /* Closing */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStopNow(0U));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, HAL_MotorStopNow(MAX_DOORS));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 0U));  /* Stale duty */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_GetOutputWriteCount());  /* Held at 0 */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(1U, 0U));  /* Other door */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+
+    /* Reversal: direction and PWM of door 0 written */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStop(0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(0U, 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(2U, HAL_GetOutputWriteCount());
+
+    /* HAL_Init releases a latch as well */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStopNow(1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_Init());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_MotorStart(1U, 0U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, HAL_CommitOutputImage());
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_GetOutputWriteCount());
+}
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -903,6 +1395,19 @@ int main(void)
     RUN_TEST(test_HAL_GPIO_ReadPositionSensor_SensorId1);
     RUN_TEST(test_HAL_Init_Repeated);
     RUN_TEST(test_HAL_PWM_SetDutyCycle_LastDoor);
+    RUN_TEST(test_CRC16_CCITT_BackendMatchesReference);
+    RUN_TEST(test_CRC16_CCITT_BackendLargeBlock);
+    RUN_TEST(test_CRC16_CCITT_StreamingMatchesOneShot);
+    RUN_TEST(test_CRC16_CCITT_UpdateDefensive);
+    RUN_TEST(test_HAL_GPIO_CaptureInputImage_AfterInit);
+    RUN_TEST(test_HAL_CommitOutputImage_CoalescesAndSuppresses);
+    RUN_TEST(test_HAL_CommitOutputImage_LockPortBatched);
+    RUN_TEST(test_HAL_SPI_CrossChannel_AsyncExchange);
+    RUN_TEST(test_HAL_SPI_CrossChannel_AsyncSequenceErrors);
+    RUN_TEST(test_HAL_EmergencyMotorStop_InhibitsMotors);
+    RUN_TEST(test_HAL_ADC_TakeBlock_Ring);
+    RUN_TEST(test_HAL_Flash_NorSemantics_PowerCut);
+    RUN_TEST(test_HAL_MotorStopNow_LatchHoldsUntilReversal);
 
     return UNITY_END();
 }
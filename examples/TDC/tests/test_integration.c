@@ -58,6 +58,7 @@ extern error_t  hal_stub_can_transmit_ret;
 extern error_t  hal_stub_spi_exchange_ret;
 extern uint32_t hal_stub_tick_ms;
 extern uint8_t  hal_stub_gpio_value;
+extern uint8_t  hal_stub_motor_inhibit;
 
 /* SKN globals stub controls (from skn_globals_stub.c) */
 extern uint8_t g_safe_state_active;
@@ -66,11 +67,10 @@ extern uint8_t g_obstacle_flags[MAX_DOORS];
 
 /* DSM global state (from dsm_init.c) — allows direct FSM state injection */
 extern door_fsm_state_t g_dsm_state[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_open[MAX_DOORS];
-extern uint8_t          g_dsm_cmd_close[MAX_DOORS];
+extern door_mask_t      g_dsm_cmd_open;
+extern door_mask_t      g_dsm_cmd_close;
 
-/* TCI global mailbox (from tci_init.c) — allows direct mailbox injection */
-extern can_mailbox_t g_tci_mailbox[TCI_CAN_RX_MAILBOX_COUNT];
+/* TCI fault flag (from tci_init.c) */
 extern uint8_t       g_tci_fault_flag;
 
 /* FMG global state (from fmg_init.c) */
@@ -81,8 +81,17 @@ extern uint8_t          g_fmg_emergency_stop_active;
 /* CRC-16-CCITT function (from crc_stub.c) */
 extern uint16_t CRC16_CCITT_Compute(const uint8_t *data, uint16_t length);
 
-/* SKN remote state helper */
-void hal_stub_set_spi_remote(const cross_channel_state_t *r);
+/* SKN remote state helper (packed wire format) */
+void hal_stub_set_spi_remote(const cross_channel_wire_t *r);
+
+/* Peer DCU sends the packed form of the unpacked state r */
+static void set_remote_state(const cross_channel_state_t *r)
+{
+    cross_channel_wire_t wire;
+
+    (void)SKN_EncodeWireState(r, &wire);
+    hal_stub_set_spi_remote(&wire);
+}
 
 /*============================================================================
  * TEST SETUP / TEARDOWN
@@ -104,6 +113,7 @@ void setUp(void)
     hal_stub_spi_exchange_ret = SUCCESS;
     hal_stub_tick_ms          = 0U;
     hal_stub_gpio_value       = 0U;
+    hal_stub_motor_inhibit    = 0U;
 
     for (i = 0U; i < 8U; i++)
     {
@@ -397,7 +407,7 @@ void test_TC_INT_009_HAL_position_to_DSM_transition(void)
 
     /* Command door 0 to open */
     (void)DSM_ProcessOpenCommand(0x01U);
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_open[0]);
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_open, 0U));
 
     /* GPIO sensors return 0 (door not at open position yet) */
     hal_stub_gpio_value = 0U;
@@ -421,7 +431,7 @@ void test_TC_INT_010_obstacle_ISR_to_DSM_reversal(void)
     g_safe_state_active      = 0U;
     g_speed_interlock_active = 0U;
     g_dsm_state[0]           = FSM_CLOSING;
-    g_dsm_cmd_close[0]       = 1U;
+    g_dsm_cmd_close          |= DOOR_BIT(0U);
 
     /* Trigger obstacle ISR for door 0 */
     OBD_ObstacleISR(0U);
@@ -453,7 +463,7 @@ void test_TC_INT_012_DSM_to_HAL_lock_actuator(void)
     g_safe_state_active      = 0U;
     g_speed_interlock_active = 0U;
     g_dsm_state[0]           = FSM_FULLY_CLOSED;
-    g_dsm_cmd_close[0]       = 1U;
+    g_dsm_cmd_close          |= DOOR_BIT(0U);
 
     /* Both position sensors report closed (gpio=1), lock sensors report unlocked */
     hal_stub_gpio_value = 1U;
@@ -621,7 +631,10 @@ void test_TC_INT_017_departure_interlock_all_closed_and_locked(void)
 }
 
 /**
- * TC-INT-ERR-002: CRC-16-CCITT consistency across DGN log entry.
+ * TC-INT-ERR-002: CRC-16-CCITT consistency across the DGN Flash page.
+ *                 The logged entry carries a matching in-RAM guard; the
+ *                 synced page holds its record and one CRC over header
+ *                 and record.
  * Tests: REQ-SAFE-003 (data integrity via CRC), REQ-FUN-018
  * SIL: 3
  * Technique: Boundary Value Analysis, Functional Testing (Table A.5 items 9, 13)
@@ -629,8 +642,10 @@ void test_TC_INT_017_departure_interlock_all_closed_and_locked(void)
 void test_TC_INT_ERR_002_CRC16_consistency_DGN_entry(void)
 {
     event_log_entry_t entry;
+    dgn_flash_page_t  page;
+    dgn_flash_stats_t stats;
     uint16_t          computed_crc;
-    uint8_t           buf[8];
+    uint8_t           buf[16];
     error_t           err;
 
     /* Log one event */
@@ -638,26 +653,45 @@ void test_TC_INT_ERR_002_CRC16_consistency_DGN_entry(void)
     err = DGN_LogEvent(COMP_FMG, EVT_FAULT_ACTIVE, 0x0042U);
     TEST_ASSERT_EQUAL_INT(SUCCESS, (int)err);
 
-    /* Read it back */
+    /* Read it back: raw fields and guard, no per-entry CRC */
     err = DGN_ReadEvent(0U, &entry);
     TEST_ASSERT_EQUAL_INT(SUCCESS, (int)err);
-
-    /* Recompute CRC using the same big-endian serialization as dgn_entry_crc()
-     * (dgn_log.c:56-76).  Direct struct cast produces wrong CRC on little-endian
-     * hosts due to endianness of timestamp_ms and data fields.
-     * Serialization: timestamp_ms (4B big-endian) + source_comp (1B) +
-     *                event_code (1B) + data (2B big-endian) = 8 bytes. */
-    buf[0U] = (uint8_t)(entry.timestamp_ms >> 24U);
-    buf[1U] = (uint8_t)(entry.timestamp_ms >> 16U);
-    buf[2U] = (uint8_t)(entry.timestamp_ms >>  8U);
-    buf[3U] = (uint8_t)(entry.timestamp_ms        );
-    buf[4U] = entry.source_comp;
-    buf[5U] = entry.event_code;
-    buf[6U] = (uint8_t)(entry.data >> 8U);
-    buf[7U] = (uint8_t)(entry.data       );
-
-    computed_crc = CRC16_CCITT_Compute(buf, 8U);
-    TEST_ASSERT_EQUAL_UINT16(computed_crc, entry.crc16);
+    TEST_ASSERT_EQUAL_UINT16(DGN_ENTRY_GUARD(&entry), entry.guard);
+
+    /* Sync: one Flash page with this single record */
+    (void)DGN_GetFlashStats(&stats);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, (int)DGN_SyncToFlash());
+    TEST_ASSERT_EQUAL_INT(SUCCESS,
+                          (int)DGN_ReadFlashPage(stats.head_page, &page));
+    TEST_ASSERT_EQUAL_UINT16(DGN_FLASH_MAGIC, page.magic);
+    TEST_ASSERT_EQUAL_UINT16(1U, page.count);
+
+    /* Recompute CRC using the big-endian page layout of dgn_flash.c:
+     * header magic (2B) + count (2B) + page_seq (4B), then the record of
+     * dgn_flash_take().  Direct struct cast produces wrong CRC on
+     * little-endian hosts due to endianness of timestamp_ms and data.
+     * Record: timestamp_ms (4B big-endian) + source_comp (1B) +
+     *         event_code (1B) + data (2B big-endian) = 8 bytes. */
+    buf[0U]  = (uint8_t)(DGN_FLASH_MAGIC >> 8U);
+    buf[1U]  = (uint8_t)(DGN_FLASH_MAGIC & 0xFFU);
+    buf[2U]  = 0U;
+    buf[3U]  = 1U;
+    buf[4U]  = (uint8_t)(page.page_seq >> 24U);
+    buf[5U]  = (uint8_t)(page.page_seq >> 16U);
+    buf[6U]  = (uint8_t)(page.page_seq >>  8U);
+    buf[7U]  = (uint8_t)(page.page_seq        );
+    buf[8U]  = (uint8_t)(entry.timestamp_ms >> 24U);
+    buf[9U]  = (uint8_t)(entry.timestamp_ms >> 16U);
+    buf[10U] = (uint8_t)(entry.timestamp_ms >>  8U);
+    buf[11U] = (uint8_t)(entry.timestamp_ms        );
+    buf[12U] = entry.source_comp;
+    buf[13U] = entry.event_code;
+    buf[14U] = (uint8_t)(entry.data >> 8U);
+    buf[15U] = (uint8_t)(entry.data       );
+
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[8U], page.record[0], 8U));
+    computed_crc = CRC16_CCITT_Compute(buf, 16U);
+    TEST_ASSERT_EQUAL_UINT16(computed_crc, page.crc16);
 }
 
 /**
@@ -725,7 +759,7 @@ void test_TC_INT_021_normal_SPI_exchange(void)
 
     /* Remote is identical (same-channel simulation) */
     remote = local;  /* identical fields + same CRC */
-    hal_stub_set_spi_remote(&remote);
+    set_remote_state(&remote);
     hal_stub_spi_exchange_ret = SUCCESS;
 
     err = SKN_ExchangeAndCompare(&local, &safe_state_out);
@@ -765,7 +799,7 @@ void test_TC_INT_022_SPI_safety_data_disagreement(void)
                                         (uint16_t)(sizeof(cross_channel_state_t) -
                                                    sizeof(uint16_t)));
 
-    hal_stub_set_spi_remote(&remote);
+    set_remote_state(&remote);
     hal_stub_spi_exchange_ret = SUCCESS;
 
     err = SKN_ExchangeAndCompare(&local, &safe_state_out);
@@ -835,8 +869,8 @@ void test_TC_INT_024_TCI_open_command_to_DSM(void)
     TCI_TransmitCycle();
 
     /* TCI routes to tci_process_open_cmd → DSM_ProcessOpenCommand */
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_open[0]);
-    TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_open[1]);
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_open, 0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_open, 1U));
 }
 
 /**
@@ -855,9 +889,9 @@ void test_TC_INT_025_TCI_close_command_to_DSM(void)
     TCI_CanRxISR();
     TCI_TransmitCycle();
 
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_close[0]);
-    TEST_ASSERT_EQUAL_UINT8(1U, g_dsm_cmd_close[1]);
-    TEST_ASSERT_EQUAL_UINT8(0U, g_dsm_cmd_close[2]);
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_close, 0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, DOOR_MASK_TEST(g_dsm_cmd_close, 1U));
+    TEST_ASSERT_EQUAL_UINT8(0U, DOOR_MASK_TEST(g_dsm_cmd_close, 2U));
 }
 
 /**
@@ -882,6 +916,48 @@ void test_TC_INT_026_TCI_emergency_stop_to_FMG(void)
     TEST_ASSERT_EQUAL_UINT8(1U, g_fmg_emergency_stop_active);
 }
 
+/**
+ * TC-INT-033: Emergency stop CAN 0x104 → HAL motor inhibit → DSM stops the
+ *             opening door in FSM_IDLE; release (stop code 0x00) clears FMG
+ *             and the inhibit and the door can be opened again.
+ * Tests: REQ-FUN-017, REQ-INT-004 (emergency stop and release from TCMS)
+ * SIL: 3
+ * Technique: Functional Testing (Table A.5 item 9)
+ */
+void test_TC_INT_033_TCI_emergency_stop_and_release_to_DSM(void)
+{
+    g_dsm_state[0]           = FSM_IDLE;
+    g_safe_state_active      = 0U;
+    g_speed_interlock_active = 0U;
+    (void)DSM_UpdateFSM(0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 100U);
+    TEST_ASSERT_EQUAL_INT((int)FSM_OPENING, (int)g_dsm_state[0]);
+
+    /* Stop: the ISR latches the inhibit, the cycle reports it to FMG */
+    hal_stub_can_receive_id      = 0x104U;
+    hal_stub_can_receive_dlc     = 1U;
+    hal_stub_can_receive_data[0] = 0x01U;
+    TCI_CanRxISR();
+    (void)TCI_ProcessReceivedFrames();
+    TEST_ASSERT_EQUAL_UINT8(1U, g_fmg_emergency_stop_active);
+    TEST_ASSERT_EQUAL_UINT8(1U, HAL_IsMotorInhibited());
+
+    /* DSM stops the door — no motor timeout, no FSM_FAULT */
+    (void)DSM_UpdateFSM(0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 120U);
+    TEST_ASSERT_EQUAL_INT((int)FSM_IDLE, (int)g_dsm_state[0]);
+    (void)DSM_UpdateFSM(0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 9000U);
+    TEST_ASSERT_EQUAL_INT((int)FSM_IDLE, (int)g_dsm_state[0]);
+
+    /* Release: FMG flag and HAL inhibit cleared in the same cycle */
+    hal_stub_can_receive_data[0] = 0x00U;
+    TCI_CanRxISR();
+    (void)TCI_ProcessReceivedFrames();
+    TEST_ASSERT_EQUAL_UINT8(0U, g_fmg_emergency_stop_active);
+    TEST_ASSERT_EQUAL_UINT8(0U, HAL_IsMotorInhibited());
+
+    (void)DSM_UpdateFSM(0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 9020U);
+    TEST_ASSERT_EQUAL_INT((int)FSM_OPENING, (int)g_dsm_state[0]);
+}
+
 /**
  * TC-INT-027: FMG RunCycle integrates SPM+OBD+DSM+TCI fault accessors.
  * Tests: REQ-SAFE-012 (integrated FMG aggregation)
@@ -938,7 +1014,7 @@ void test_TC_INT_028_departure_interlock_one_door_not_locked(void)
 void test_TC_INT_029_SPI_CRC_failure_immediate_safe_state(void)
 {
     cross_channel_state_t local;
-    cross_channel_state_t remote_bad_crc;
+    cross_channel_wire_t  remote_bad_crc;
     uint8_t safe_state_out = 0U;
     error_t err;
     uint8_t door_states[MAX_DOORS]    = {0U, 0U, 0U, 0U};
@@ -949,9 +1025,9 @@ void test_TC_INT_029_SPI_CRC_failure_immediate_safe_state(void)
                               obstacle_flags, 0U, 0U);
     TEST_ASSERT_EQUAL_INT(SUCCESS, (int)err);
 
-    /* Build remote with corrupted CRC */
-    remote_bad_crc       = local;
-    remote_bad_crc.crc16 = (uint16_t)(local.crc16 ^ 0xFFFFU);
+    /* Build remote (packed) with corrupted CRC */
+    (void)SKN_EncodeWireState(&local, &remote_bad_crc);
+    remote_bad_crc.crc16 = (uint16_t)(remote_bad_crc.crc16 ^ 0xFFFFU);
 
     hal_stub_set_spi_remote(&remote_bad_crc);
     hal_stub_spi_exchange_ret = SUCCESS;
@@ -1054,6 +1130,7 @@ int main(void)
     RUN_TEST(test_TC_INT_024_TCI_open_command_to_DSM);
     RUN_TEST(test_TC_INT_025_TCI_close_command_to_DSM);
     RUN_TEST(test_TC_INT_026_TCI_emergency_stop_to_FMG);
+    RUN_TEST(test_TC_INT_033_TCI_emergency_stop_and_release_to_DSM);
     RUN_TEST(test_TC_INT_027_FMG_RunCycle_all_clear);
     RUN_TEST(test_TC_INT_028_departure_interlock_one_door_not_locked);
     RUN_TEST(test_TC_INT_029_SPI_CRC_failure_immediate_safe_state);
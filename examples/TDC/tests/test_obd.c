@@ -1,9 +1,10 @@
 /**
  * @file    test_obd.c
- * @brief   Unit tests for OBD module (COMP-008) — 9 test cases.
- * @details Covers TC-OBD-001 through TC-OBD-009.
+ * @brief   Unit tests for OBD module (COMP-008) — 17 test cases.
+ * @details Covers TC-OBD-001 through TC-OBD-017.
  *          Tests: OBD_PollSensorsAndEvaluate, OBD_Init, OBD_GetFault,
- *                 OBD_GetObstacleFlags.
+ *                 OBD_GetObstacleFlags, OBD_RunCycle, OBD_ObstacleISR,
+ *                 OBD_GetIsrStopStats.
  *
  * @project TDC (Train Door Control System)
  * @phase   Phase 5 — Implementation & Testing
@@ -16,6 +17,8 @@
  *   Item 18: Source Code (obd_detect.c)
  */
 
+#include <string.h>
+
 #include "../unity/src/unity.h"
 #include "../../src/tdc_types.h"
 #include "../../src/obd.h"
@@ -27,6 +30,18 @@
 extern void obd_stub_set_closing_flags(const uint8_t flags[MAX_DOORS]);
 
 extern uint8_t hal_stub_gpio_value;
+extern uint8_t hal_stub_input_fault_mask;
+extern uint32_t hal_stub_cycle_counter;
+extern uint32_t hal_stub_estop_write_ticks;
+extern uint32_t hal_stub_stop_now_count;
+extern uint8_t  hal_stub_stop_now_door;
+extern hal_adc_block_t hal_stub_adc_block;
+extern error_t  hal_stub_adc_take_ret;
+extern uint8_t  hal_stub_adc_auto;
+
+/* skn_globals_stub.c — written by OBD_RunCycle */
+extern uint8_t     g_obstacle_flags[MAX_DOORS];
+extern door_mask_t g_obstacle_mask;
 
 /* =========================================================================
  * setUp / tearDown
@@ -35,6 +50,13 @@ void setUp(void)
 {
     uint8_t no_close[MAX_DOORS] = {0U, 0U, 0U, 0U};
     hal_stub_gpio_value = 0U;
+    hal_stub_input_fault_mask = 0U;
+    hal_stub_estop_write_ticks = 0U;
+    hal_stub_stop_now_count    = 0U;
+    hal_stub_stop_now_door     = 0xFFU;
+    hal_stub_adc_take_ret      = SUCCESS;
+    hal_stub_adc_auto          = 1U;
+    (void)memset(&hal_stub_adc_block, 0, sizeof(hal_stub_adc_block));
     obd_stub_set_closing_flags(no_close);
     (void)HAL_Init();
     (void)OBD_Init();
@@ -177,6 +199,280 @@ void test_OBD_PollSensorsAndEvaluate_AllClosing_NoForce(void)
     }
 }
 
+/* =========================================================================
+ * TC-OBD-010: OBD_PollSensorsAndEvaluate — obstacle bits set in the input
+ *             process image → all doors detected, no fault
+ * Tests: REQ-SAFE-004/005, UNIT-OBD-002
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_PollSensorsAndEvaluate_ImageObstacle_Detected(void)
+{
+    /* TC-OBD-010 */
+    uint8_t closing[MAX_DOORS] = {0U, 0U, 0U, 0U};
+    uint8_t obs[MAX_DOORS]     = {0U, 0U, 0U, 0U};
+    uint8_t i;
+    hal_stub_gpio_value = 1U;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    for (i = 0U; i < MAX_DOORS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(1U, obs[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+}
+
+/* =========================================================================
+ * TC-OBD-011: OBD_PollSensorsAndEvaluate — input image read fault on one
+ *             door → that door fail-safe obstacle + OBD fault, others clear
+ * Tests: REQ-SAFE-004, SW-HAZ-002, UNIT-OBD-002
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_PollSensorsAndEvaluate_ImageReadFault_FailSafe(void)
+{
+    /* TC-OBD-011 */
+    uint8_t closing[MAX_DOORS] = {0U, 0U, 0U, 0U};
+    uint8_t obs[MAX_DOORS]     = {0U, 0U, 0U, 0U};
+    hal_stub_input_fault_mask = 0x04U;  /* door 2 unreadable */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[0]);
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[1]);
+    TEST_ASSERT_EQUAL_UINT8(1U, obs[2]);
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[3]);
+    TEST_ASSERT_EQUAL_UINT8(1U, OBD_GetFault());
+}
+
+/* =========================================================================
+ * TC-OBD-012: OBD_RunCycle — g_obstacle_mask matches g_obstacle_flags
+ * Tests: REQ-SAFE-004, UNIT-OBD-004
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_RunCycle_PublishesMask(void)
+{
+    /* TC-OBD-012 */
+    uint8_t i;
+
+    hal_stub_gpio_value = 1U;   /* obstacle sensors active on every door */
+    OBD_RunCycle();
+    TEST_ASSERT_TRUE(g_obstacle_mask == DOOR_MASK_ALL);
+    for (i = 0U; i < MAX_DOORS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(g_obstacle_flags[i],
+                                DOOR_MASK_TEST(g_obstacle_mask, i));
+    }
+
+    hal_stub_gpio_value = 0U;
+    OBD_RunCycle();
+    TEST_ASSERT_TRUE(g_obstacle_mask == 0U);
+}
+
+/* =========================================================================
+ * TC-OBD-013: OBD_ObstacleISR — a closing door's motor is stopped from the
+ *             ISR within 1 ms of entry (instrumented); a door that is not
+ *             closing only latches; the latch still reaches the cycle
+ * Tests: REQ-SAFE-004, REQ-PERF-003, UNIT-OBD-001, UNIT-OBD-006
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_ObstacleISR_ClosingDoor_StopsMotor(void)
+{
+    /* TC-OBD-013 */
+    const uint8_t door = (uint8_t)(MAX_DOORS - 1U);
+    uint8_t closing[MAX_DOORS] = {0U};
+    obd_isr_stop_stats_t stats;
+
+    /* Not closing: latch only */
+    OBD_ObstacleISR(0U);
+    TEST_ASSERT_EQUAL_UINT32(0U, hal_stub_stop_now_count);
+
+    /* Closing: motor stopped in the ISR, latency measured */
+    closing[door] = 1U;
+    obd_stub_set_closing_flags(closing);
+    hal_stub_cycle_counter     = 0xFFFFFF00U;   /* Counter wraps in the ISR */
+    hal_stub_estop_write_ticks = 400U;          /* 1 us at 400 MHz */
+    OBD_ObstacleISR(door);
+    TEST_ASSERT_EQUAL_UINT32(1U, hal_stub_stop_now_count);
+    TEST_ASSERT_EQUAL_UINT8(door, hal_stub_stop_now_door);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_GetIsrStopStats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.isr_stop_count);
+    TEST_ASSERT_EQUAL_UINT32(400U, stats.last_stop_ticks);
+    TEST_ASSERT_EQUAL_UINT32(400U, stats.max_stop_ticks);
+    TEST_ASSERT_TRUE(stats.max_stop_ticks < (HAL_CYCLE_COUNTER_HZ / 1000UL));
+
+    /* The FSM reversal still comes from the latched flag in the cycle */
+    OBD_RunCycle();
+    TEST_ASSERT_EQUAL_UINT8(1U, g_obstacle_flags[0]);
+    TEST_ASSERT_EQUAL_UINT8(1U, g_obstacle_flags[door]);
+
+    /* Out-of-range door: ignored */
+    OBD_ObstacleISR((uint8_t)MAX_DOORS);
+    TEST_ASSERT_EQUAL_UINT32(1U, hal_stub_stop_now_count);
+}
+
+/* =========================================================================
+ * TC-OBD-014: OBD_GetIsrStopStats — NULL → ERR_NULL_PTR; max keeps the
+ *             longest stop; OBD_Init clears the statistics
+ * Tests: UNIT-OBD-003, UNIT-OBD-006
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_GetIsrStopStats_MaxAndReset(void)
+{
+    /* TC-OBD-014 */
+    uint8_t closing[MAX_DOORS] = {0U};
+    obd_isr_stop_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, OBD_GetIsrStopStats(NULL));
+
+    closing[0] = 1U;
+    obd_stub_set_closing_flags(closing);
+    hal_stub_estop_write_ticks = 900U;
+    OBD_ObstacleISR(0U);
+    hal_stub_estop_write_ticks = 300U;
+    OBD_ObstacleISR(0U);
+    (void)OBD_GetIsrStopStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2U, stats.isr_stop_count);
+    TEST_ASSERT_EQUAL_UINT32(300U, stats.last_stop_ticks);
+    TEST_ASSERT_EQUAL_UINT32(900U, stats.max_stop_ticks);
+
+    (void)OBD_Init();
+    (void)OBD_GetIsrStopStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.isr_stop_count);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.last_stop_ticks);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.max_stop_ticks);
+}
+
+/** @brief Fill one door's samples of the stub ADC block: base + k * step */
+static void obd_fill_block(uint8_t door, uint16_t base, uint16_t step)
+{
+    uint8_t k;
+
+    for (k = 0U; k < HAL_ADC_BLOCK_SAMPLES; k++)
+    {
+        hal_stub_adc_block.sample[k][door] = (uint16_t)(base + (k * step));
+    }
+}
+
+/* =========================================================================
+ * TC-OBD-015: Motor current block filter — start-up rise blanked, a single
+ *             full-scale sample ignored, a force build-up tripped by the
+ *             slope while every sample is below the limit, an average above
+ *             the limit tripped at once; doors not closing never trip
+ * Tests: REQ-SAFE-006, REQ-PERF-003, UNIT-OBD-002
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_MotorCurrentBlockFilter(void)
+{
+    /* TC-OBD-015 */
+    const uint8_t door = (uint8_t)(MAX_DOORS - 1U);
+    uint8_t closing[MAX_DOORS] = {0U};
+    uint8_t obs[MAX_DOORS]     = {0U};
+    uint8_t cycle;
+
+    closing[door] = 1U;
+    obd_fill_block(0U, 3500U, 0U);          /* Door 0 not closing */
+
+    /* 0 → 1200 at closing start: slope blanked, average below the limit */
+    for (cycle = 0U; cycle < 6U; cycle++)
+    {
+        obd_fill_block(door, 1200U, 0U);
+        TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+        TEST_ASSERT_EQUAL_UINT8(0U, obs[door]);
+        TEST_ASSERT_EQUAL_UINT8(0U, obs[0]);
+    }
+
+    /* One full-scale sample (EMI): filtered out */
+    hal_stub_adc_block.sample[10][door] = 4095U;
+    (void)OBD_PollSensorsAndEvaluate(closing, obs);
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[door]);
+
+    /* 80 counts/ms build-up, last sample 2720 < OBD_MAX_FORCE_ADC */
+    obd_fill_block(door, 1200U, 80U);
+    (void)OBD_PollSensorsAndEvaluate(closing, obs);
+    TEST_ASSERT_EQUAL_UINT8(1U, obs[door]);
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[0]);
+
+    /* Average above the limit trips within the blanking time */
+    (void)OBD_Init();
+    obd_fill_block(door, 3100U, 0U);
+    (void)OBD_PollSensorsAndEvaluate(closing, obs);
+    TEST_ASSERT_EQUAL_UINT8(1U, obs[door]);
+    TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+}
+
+/* =========================================================================
+ * TC-OBD-016: No motor current block for three consecutive cycles (scan
+ *             stalled) → fault, closing doors treated as obstructed, other
+ *             doors unaffected; fewer empty cycles do not fault and the
+ *             next block clears the fault
+ * Tests: REQ-SAFE-006, UNIT-OBD-002
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_MotorCurrentBlockMissing_FailSafe(void)
+{
+    /* TC-OBD-016 */
+    uint8_t closing[MAX_DOORS] = {0U};
+    uint8_t obs[MAX_DOORS]     = {0U};
+    uint8_t cycle;
+
+    closing[1] = 1U;
+    hal_stub_adc_take_ret = ERR_TIMEOUT;
+    for (cycle = 0U; cycle < 2U; cycle++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS,
+                              OBD_PollSensorsAndEvaluate(closing, obs));
+        TEST_ASSERT_EQUAL_UINT8(0U, obs[1]);
+        TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+    }
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[0]);
+    TEST_ASSERT_EQUAL_UINT8(1U, obs[1]);
+    TEST_ASSERT_EQUAL_UINT8(1U, OBD_GetFault());
+
+    hal_stub_adc_take_ret = SUCCESS;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[1]);
+    TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+}
+
+/* =========================================================================
+ * TC-OBD-017: Scan and cycle clocks drifting — a cycle with no new block
+ *             neither faults nor obstructs; a cycle with two new blocks
+ *             filters both, so a build-up in the older one still trips
+ * Tests: REQ-SAFE-006, UNIT-OBD-002, UNIT-HAL-036
+ * SIL: 3
+ * ========================================================================= */
+void test_OBD_MotorCurrentBlockDrift_DrainsAll(void)
+{
+    /* TC-OBD-017 */
+    const uint8_t door = (uint8_t)(MAX_DOORS - 1U);
+    uint8_t closing[MAX_DOORS] = {0U};
+    uint8_t obs[MAX_DOORS]     = {0U};
+    uint8_t cycle;
+
+    hal_stub_adc_auto = 0U;
+    closing[door] = 1U;
+
+    /* Steady closing current, one block per cycle, past the blanking */
+    obd_fill_block(door, 1200U, 0U);
+    for (cycle = 0U; cycle < 6U; cycle++)
+    {
+        HAL_ADC_DmaBlockISR();
+        (void)OBD_PollSensorsAndEvaluate(closing, obs);
+        TEST_ASSERT_EQUAL_UINT8(0U, obs[door]);
+    }
+
+    /* No block completed this cycle */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    TEST_ASSERT_EQUAL_UINT8(0U, obs[door]);
+    TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+
+    /* Two blocks: a build-up, then steady current again */
+    obd_fill_block(door, 1200U, 80U);
+    HAL_ADC_DmaBlockISR();
+    obd_fill_block(door, 1200U, 0U);
+    HAL_ADC_DmaBlockISR();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, OBD_PollSensorsAndEvaluate(closing, obs));
+    TEST_ASSERT_EQUAL_UINT8(1U, obs[door]);
+    TEST_ASSERT_EQUAL_UINT8(0U, OBD_GetFault());
+}
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -193,6 +489,14 @@ int main(void)
     RUN_TEST(test_OBD_GetObstacleFlags_NotNull);
     RUN_TEST(test_OBD_RunCycle_Runs);
     RUN_TEST(test_OBD_PollSensorsAndEvaluate_AllClosing_NoForce);
+    RUN_TEST(test_OBD_PollSensorsAndEvaluate_ImageObstacle_Detected);
+    RUN_TEST(test_OBD_PollSensorsAndEvaluate_ImageReadFault_FailSafe);
+    RUN_TEST(test_OBD_RunCycle_PublishesMask);
+    RUN_TEST(test_OBD_ObstacleISR_ClosingDoor_StopsMotor);
+    RUN_TEST(test_OBD_GetIsrStopStats_MaxAndReset);
+    RUN_TEST(test_OBD_MotorCurrentBlockFilter);
+    RUN_TEST(test_OBD_MotorCurrentBlockMissing_FailSafe);
+    RUN_TEST(test_OBD_MotorCurrentBlockDrift_DrainsAll);
 
     return UNITY_END();
 }
@@ -1,10 +1,18 @@
 /**
  * @file    test_skn.c
- * @brief   Unit tests for SKN module (COMP-003) — 28 test cases.
- * @details Covers TC-SKN-001 through TC-SKN-028.
+ * @brief   Unit tests for SKN module (COMP-003) — 47 test cases.
+ * @details Covers TC-SKN-001 through TC-SKN-047.
  *          Tests: SKN_BuildLocalState, SKN_ExchangeAndCompare,
  *                 SKN_EvaluateSafeState, SKN_EvaluateDepartureInterlock,
- *                 SKN_CheckStackCanary, SKN_CheckMemoryIntegrity, SKN_Init.
+ *                 SKN_EvaluateDepartureInterlockMask,
+ *                 SKN_CheckStackCanary, SKN_CheckMemoryIntegrity, SKN_Init,
+ *                 SKN_ScrubStep, SKN_Timing_CycleStart/CycleEnd,
+ *                 SKN_GetCycleTiming, SKN_IsStepDue, SKN_Background_Run,
+ *                 SKN_GetBackgroundStats,
+ *                 SKN_Scrub_BackgroundStep, SKN_ExchangeStart,
+ *                 SKN_ExchangeComplete, SKN_GetSpiLatency,
+ *                 SKN_EncodeWireState, SKN_DecodeWireState,
+ *                 SKN_GetRemoteState.
  *
  * @project TDC (Train Door Control System)
  * @phase   Phase 5 — Implementation & Testing
@@ -14,24 +22,42 @@
  * @traceability
  *   Tests: REQ-SAFE-001/002/003/006/008/010/014/015/018
  *   Item 16: Software Component Test Specification §COMP-003
- *   Item 18: Source Code (skn_comparator.c, skn_safe_state.c, skn_init.c)
+ *   Item 18: Source Code (skn_comparator.c, skn_safe_state.c, skn_init.c,
+ *            skn_scrub.c, skn_timing.c, skn_schedule.c, skn_background.c,
+ *            skn_wire.c)
  */
 
 #include "../unity/src/unity.h"
 #include "../../src/tdc_types.h"
 #include "../../src/skn.h"
 #include "../../src/hal.h"
+#include "../../src/dgn.h"
 
 /* =========================================================================
  * External HAL stub controls
  * ========================================================================= */
 extern error_t  hal_stub_spi_exchange_ret;
 extern uint32_t hal_stub_tick_ms;
+extern uint32_t hal_stub_cycle_counter;
+extern uint32_t hal_stub_spi_transfer_ticks;
+
+/* skn_dsm_stub.c — cost of the diagnostic-port background job's chunk */
+extern uint32_t skn_stub_diag_cost_ticks;
+extern uint32_t skn_stub_diag_calls;
 extern uint32_t __stack_top_canary__;
 extern uint32_t __stack_bottom_canary__;
 
+/* Safety RAM region scrubbed by SKN_ScrubStep (owned by skn_safe_state.c) */
+extern uint8_t  g_skn_safety_globals_region[SAFETY_GLOBALS_LEN];
+
+/** @brief Full scrub pass length used by tests (default build value) */
+#define TEST_SCRUB_PERIOD_CYCLES  (5U)
+
+/** @brief Cycle budget in HAL cycle-counter ticks (20 ms at 400 MHz) */
+#define TEST_CYCLE_BUDGET_TICKS   (CYCLE_MS * (HAL_CYCLE_COUNTER_HZ / 1000UL))
+
 /* hal_stub_set_spi_remote declared in hal_stub.c */
-void hal_stub_set_spi_remote(const cross_channel_state_t *r);
+void hal_stub_set_spi_remote(const cross_channel_wire_t *r);
 
 /* =========================================================================
  * Helpers
@@ -50,13 +76,35 @@ static void build_zero_state(cross_channel_state_t *s)
     s->crc16            = 0U;
 }
 
+/* Peer DCU sends the packed form of s */
+static void set_remote_state(const cross_channel_state_t *s)
+{
+    cross_channel_wire_t wire;
+
+    (void)SKN_EncodeWireState(s, &wire);
+    hal_stub_set_spi_remote(&wire);
+}
+
+/* -------------------------------------------------------------------------
+ * Background executor: one cycle with fg_ticks of foreground work
+ * ------------------------------------------------------------------------- */
+static uint8_t bg_cycle(uint32_t fg_ticks)
+{
+    SKN_Timing_CycleStart();
+    hal_stub_cycle_counter += fg_ticks;
+    return SKN_Background_Run();
+}
+
 /* =========================================================================
  * setUp / tearDown
  * ========================================================================= */
 void setUp(void)
 {
-    hal_stub_spi_exchange_ret = SUCCESS;
-    hal_stub_tick_ms          = 0U;
+    hal_stub_spi_exchange_ret   = SUCCESS;
+    hal_stub_spi_transfer_ticks = 0U;
+    hal_stub_tick_ms            = 0U;
+    skn_stub_diag_cost_ticks    = 0U;
+    skn_stub_diag_calls         = 0U;
     __stack_top_canary__      = CANARY_VALUE;
     __stack_bottom_canary__   = CANARY_VALUE;
     (void)HAL_Init();
@@ -155,7 +203,7 @@ void test_SKN_ExchangeAndCompare_Matching(void)
     uint8_t safe_out = 0U;
 
     (void)SKN_BuildLocalState(&local, 100U, doors, locks, obs, 0U, 0U);
-    hal_stub_set_spi_remote(&local); /* Remote = same as local */
+    set_remote_state(&local); /* Remote = same as local */
 
     error_t ret = SKN_ExchangeAndCompare(&local, &safe_out);
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
@@ -179,7 +227,7 @@ void test_SKN_ExchangeAndCompare_SpeedDisagree(void)
 
     (void)SKN_BuildLocalState(&local, 100U, doors, locks, obs, 0U, 0U);
     (void)SKN_BuildLocalState(&remote, 200U, doors, locks, obs, 0U, 0U);
-    hal_stub_set_spi_remote(&remote);
+    set_remote_state(&remote);
 
     (void)SKN_ExchangeAndCompare(&local, &safe_out);
     TEST_ASSERT_EQUAL_UINT8(1U, safe_out);
@@ -344,13 +392,18 @@ void test_SKN_EvaluateDepartureInterlock_NullDoorStates(void)
 void test_SKN_EvaluateDepartureInterlock_AllLocked(void)
 {
     /* TC-SKN-018 */
-    uint8_t doors[MAX_DOORS] = {(uint8_t)DOOR_STATE_CLOSED_AND_LOCKED,
-                                  (uint8_t)DOOR_STATE_CLOSED_AND_LOCKED,
-                                  (uint8_t)DOOR_STATE_CLOSED_AND_LOCKED,
-                                  (uint8_t)DOOR_STATE_CLOSED_AND_LOCKED};
-    uint8_t locks[MAX_DOORS] = {1U, 1U, 1U, 1U};
+    uint8_t doors[MAX_DOORS];
+    uint8_t locks[MAX_DOORS];
     uint8_t ok  = 0U;
-    error_t ret = SKN_EvaluateDepartureInterlock(doors, locks, 0U, 0U, &ok);
+    uint8_t i;
+    error_t ret;
+
+    for (i = 0U; i < MAX_DOORS; i++)
+    {
+        doors[i] = (uint8_t)DOOR_STATE_CLOSED_AND_LOCKED;
+        locks[i] = 1U;
+    }
+    ret = SKN_EvaluateDepartureInterlock(doors, locks, 0U, 0U, &ok);
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
     TEST_ASSERT_EQUAL_UINT8(1U, ok);
 }
@@ -508,6 +561,651 @@ void test_SKN_Init_Success(void)
     TEST_ASSERT_EQUAL_INT(SUCCESS, ret);
 }
 
+/* =========================================================================
+ * TC-SKN-029: SKN_ScrubStep — NULL out → ERR_NULL_PTR
+ * Tests: REQ-SAFE-009, UNIT-SKN-010
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ScrubStep_NullOut(void)
+{
+    /* TC-SKN-029 */
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_ScrubStep(NULL));
+}
+
+/* =========================================================================
+ * TC-SKN-030: SKN_ScrubStep — intact memory over two full passes → ok=1
+ * Tests: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ScrubStep_IntactMemory(void)
+{
+    /* TC-SKN-030 */
+    uint8_t  ok = 0U;
+    uint32_t cycle;
+
+    for (cycle = 0U; cycle < (2U * TEST_SCRUB_PERIOD_CYCLES); cycle++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ScrubStep(&ok));
+        TEST_ASSERT_EQUAL_UINT8(1U, ok);
+    }
+}
+
+/* =========================================================================
+ * TC-SKN-031: SKN_ScrubStep — safety RAM corruption detected within one
+ *             scrub period, and the verdict is sticky
+ * Tests: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ScrubStep_RamCorruptionDetected(void)
+{
+    /* TC-SKN-031 */
+    uint8_t  ok = 1U;
+    uint32_t cycle;
+    error_t  ret = SUCCESS;
+
+    g_skn_safety_globals_region[SAFETY_GLOBALS_LEN - 1U] ^= 0x5AU;
+
+    for (cycle = 0U; (cycle < TEST_SCRUB_PERIOD_CYCLES) && (SUCCESS == ret);
+         cycle++)
+    {
+        ret = SKN_ScrubStep(&ok);
+    }
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, ret);
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+
+    /* Repair the region: verdict must stay failed (sticky) */
+    g_skn_safety_globals_region[SAFETY_GLOBALS_LEN - 1U] ^= 0x5AU;
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, SKN_ScrubStep(&ok));
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+}
+
+/* =========================================================================
+ * TC-SKN-032: SKN cycle timing — cycles within budget: slack, EMA and worst
+ *             slack tracked, no overrun counted
+ * Tests: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-011, UNIT-SKN-012
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_CycleTiming_WithinBudget(void)
+{
+    /* TC-SKN-032 */
+    skn_cycle_timing_t timing;
+    uint32_t exec = TEST_CYCLE_BUDGET_TICKS / 4U;   /* 5 ms */
+
+    hal_stub_cycle_counter = 1000U;
+    SKN_Timing_CycleStart();
+    hal_stub_cycle_counter += exec;
+    SKN_Timing_CycleEnd();
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetCycleTiming(&timing));
+    TEST_ASSERT_EQUAL_UINT32(exec, timing.last_exec_ticks);
+    TEST_ASSERT_EQUAL_INT((int32_t)(TEST_CYCLE_BUDGET_TICKS - exec),
+                          timing.worst_slack_ticks);
+    /* EMA moves 1/8 of the way from the full budget towards the sample */
+    TEST_ASSERT_EQUAL_INT((int32_t)(TEST_CYCLE_BUDGET_TICKS - (exec / 8U)),
+                          timing.slack_ema_ticks);
+    TEST_ASSERT_EQUAL_UINT32(0U, timing.overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(1U, timing.cycle_count);
+
+    /* A shorter cycle does not improve the worst slack */
+    SKN_Timing_CycleStart();
+    hal_stub_cycle_counter += 10U;
+    SKN_Timing_CycleEnd();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetCycleTiming(&timing));
+    TEST_ASSERT_EQUAL_INT((int32_t)(TEST_CYCLE_BUDGET_TICKS - exec),
+                          timing.worst_slack_ticks);
+    TEST_ASSERT_EQUAL_UINT32(2U, timing.cycle_count);
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_GetCycleTiming(NULL));
+}
+
+/* =========================================================================
+ * TC-SKN-033: SKN cycle timing — overrun counted, negative slack recorded
+ *             and EVT_DEADLINE_OVERRUN logged with the overrun in µs
+ * Tests: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-011, UNIT-SKN-012
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_CycleTiming_OverrunLogged(void)
+{
+    /* TC-SKN-033 */
+    skn_cycle_timing_t timing;
+    event_log_entry_t  entry;
+    uint32_t over = HAL_CYCLE_COUNTER_HZ / 1000UL;  /* 1 ms late */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Init());
+
+    hal_stub_cycle_counter = 0xFFFFFF00UL;           /* Counter wraps */
+    SKN_Timing_CycleStart();
+    hal_stub_cycle_counter += TEST_CYCLE_BUDGET_TICKS + over;
+    SKN_Timing_CycleEnd();
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetCycleTiming(&timing));
+    TEST_ASSERT_EQUAL_UINT32(1U, timing.overrun_count);
+    TEST_ASSERT_EQUAL_UINT32(TEST_CYCLE_BUDGET_TICKS + over,
+                             timing.last_exec_ticks);
+    TEST_ASSERT_EQUAL_INT(-(int32_t)over, timing.worst_slack_ticks);
+
+    TEST_ASSERT_EQUAL_UINT16(1U, DGN_GetLogCount());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(0U, &entry));
+    TEST_ASSERT_EQUAL_UINT8(COMP_SKN, entry.source_comp);
+    TEST_ASSERT_EQUAL_UINT8(EVT_DEADLINE_OVERRUN, entry.event_code);
+    TEST_ASSERT_EQUAL_UINT16(1000U, entry.data);
+}
+
+/* =========================================================================
+ * TC-SKN-034: SKN_IsStepDue — safety steps run every minor cycle; TCI
+ *             transmit every 5th and DGN flush every 10th, never in the
+ *             same minor cycle; unknown step never due
+ * Tests: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-013
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_IsStepDue_StaticSchedule(void)
+{
+    /* TC-SKN-034 */
+    uint8_t minor;
+    uint8_t step;
+    uint8_t tci_runs = 0U;
+    uint8_t dgn_runs = 0U;
+
+    for (minor = 0U; minor < SKN_MAJOR_CYCLE_MINORS; minor++)
+    {
+        for (step = 0U; step < SKN_STEP_COUNT; step++)
+        {
+            if ((SKN_STEP_TCI_TX != step) && (SKN_STEP_DGN != step))
+            {
+                TEST_ASSERT_EQUAL_UINT8(1U, SKN_IsStepDue(step, minor));
+            }
+        }
+        tci_runs += SKN_IsStepDue(SKN_STEP_TCI_TX, minor);
+        dgn_runs += SKN_IsStepDue(SKN_STEP_DGN, minor);
+        TEST_ASSERT_FALSE((0U != SKN_IsStepDue(SKN_STEP_TCI_TX, minor)) &&
+                          (0U != SKN_IsStepDue(SKN_STEP_DGN, minor)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(2U, tci_runs);  /* 100 ms */
+    TEST_ASSERT_EQUAL_UINT8(1U, dgn_runs);  /* 200 ms */
+
+    TEST_ASSERT_EQUAL_UINT8(0U, SKN_IsStepDue(SKN_STEP_COUNT, 0U));
+}
+
+/* =========================================================================
+ * TC-SKN-035: SKN_Background_Run — with the cycle free every job runs until
+ *             it reports done (diagnostic port once per cycle), bounded by
+ *             SKN_BG_MAX_CHUNKS; no cycle counted as skipped
+ * Tests: REQ-PERF-002, UNIT-SKN-014
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_Background_Run_JobsRunToCompletion(void)
+{
+    /* TC-SKN-035 */
+    skn_bg_stats_t stats;
+    uint8_t        chunks;
+    uint8_t        job;
+
+    chunks = bg_cycle(0U);
+    TEST_ASSERT_TRUE(chunks >= SKN_BG_JOB_COUNT);
+    TEST_ASSERT_TRUE(chunks <= SKN_BG_MAX_CHUNKS);
+    TEST_ASSERT_EQUAL_UINT32(1U, skn_stub_diag_calls);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    for (job = 0U; job < SKN_BG_JOB_COUNT; job++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0U, stats.skipped_cycles[job]);
+        TEST_ASSERT_EQUAL_UINT16(0U, stats.starved_cycles[job]);
+    }
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_GetBackgroundStats(NULL));
+}
+
+/* =========================================================================
+ * TC-SKN-036: SKN_Background_Run — no chunk starts unless the job's
+ *             chunk-time estimate fits the cycle budget; cheaper jobs still
+ *             use the slack; no slack at all runs nothing
+ * Tests: REQ-SAFE-015, REQ-PERF-002, UNIT-SKN-014
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_Background_Run_StopsAtBudget(void)
+{
+    /* TC-SKN-036 */
+    uint32_t       limit = (TEST_CYCLE_BUDGET_TICKS / 100U) *
+                           SKN_BG_BUDGET_PERCENT;
+    uint32_t       cost  = limit / 2U;
+    skn_bg_stats_t stats;
+
+    /* Whole cycle free: the diagnostic port chunk teaches its cost */
+    skn_stub_diag_cost_ticks = cost;
+    (void)bg_cycle(0U);
+    TEST_ASSERT_EQUAL_UINT32(1U, skn_stub_diag_calls);
+    TEST_ASSERT_TRUE(SKN_Timing_GetElapsedTicks() <= limit);
+
+    /* Foreground leaves less than that: only the other jobs run */
+    TEST_ASSERT_TRUE(bg_cycle(limit - (cost / 2U)) > 0U);
+    TEST_ASSERT_EQUAL_UINT32(1U, skn_stub_diag_calls);
+    TEST_ASSERT_TRUE(SKN_Timing_GetElapsedTicks() <= limit);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.skipped_cycles[SKN_BG_JOB_DIAG_PORT]);
+    TEST_ASSERT_EQUAL_UINT32(0U, stats.skipped_cycles[SKN_BG_JOB_SCRUB]);
+
+    /* No slack left: nothing runs */
+    TEST_ASSERT_EQUAL_UINT8(0U, bg_cycle(limit + 1U));
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(1U, stats.skipped_cycles[SKN_BG_JOB_SCRUB]);
+}
+
+/* =========================================================================
+ * TC-SKN-037: SKN_Scrub_BackgroundStep — extra chunks finish a pass early
+ *             and detect corruption before the next SKN_ScrubStep
+ * Tests: REQ-SAFE-009, SW-HAZ-008, UNIT-SKN-010
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_Scrub_BackgroundStep_DetectsCorruption(void)
+{
+    /* TC-SKN-037 */
+    uint8_t  ok = 1U;
+    uint32_t steps = 0U;
+
+    /* Intact memory: the background pass ends and reports done */
+    while ((0U != SKN_Scrub_BackgroundStep()) &&
+           (steps < TEST_SCRUB_PERIOD_CYCLES))
+    {
+        steps++;
+    }
+    TEST_ASSERT_TRUE(steps < TEST_SCRUB_PERIOD_CYCLES);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ScrubStep(&ok));
+    TEST_ASSERT_EQUAL_UINT8(1U, ok);
+
+    /* Corruption found by background chunks within one pass */
+    g_skn_safety_globals_region[0] ^= 0x01U;
+    for (steps = 0U; steps < (2U * TEST_SCRUB_PERIOD_CYCLES); steps++)
+    {
+        (void)SKN_Scrub_BackgroundStep();
+    }
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, SKN_ScrubStep(&ok));
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+    g_skn_safety_globals_region[0] ^= 0x01U;
+}
+
+/* =========================================================================
+ * TC-SKN-038: SKN_ExchangeStart/Complete — transfer overlapped with other
+ *             work: no blocking, whole transfer time reported hidden
+ * Tests: REQ-SAFE-002/008, REQ-PERF-002, UNIT-SKN-015/016/017
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ExchangeStartComplete_Overlapped(void)
+{
+    /* TC-SKN-038 */
+    cross_channel_state_t local;
+    skn_spi_latency_t     lat;
+    uint8_t doors[MAX_DOORS] = {0U};
+    uint8_t locks[MAX_DOORS] = {0U};
+    uint8_t obs[MAX_DOORS]   = {0U};
+    uint8_t safe_out = 1U;
+
+    (void)SKN_BuildLocalState(&local, 100U, doors, locks, obs, 0U, 0U);
+    set_remote_state(&local);
+    hal_stub_spi_transfer_ticks = 4000U;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ExchangeStart(&local));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE, SKN_ExchangeStart(&local));
+
+    /* Local state changes after start: the snapshot is what is compared */
+    local.speed_kmh_x10 = 200U;
+    hal_stub_cycle_counter += 5000U;  /* Canary + scrub steps */
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ExchangeComplete(&safe_out));
+    TEST_ASSERT_EQUAL_UINT8(0U, safe_out);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetSpiLatency(&lat));
+    TEST_ASSERT_EQUAL_UINT32(1U, lat.exchange_count);
+    TEST_ASSERT_EQUAL_UINT32(0U, lat.failed_count);
+    TEST_ASSERT_EQUAL_UINT32(4000U, lat.last_transfer_ticks);
+    TEST_ASSERT_EQUAL_UINT32(0U, lat.last_blocked_ticks);
+    TEST_ASSERT_TRUE(4000U == lat.total_hidden_ticks);
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_GetSpiLatency(NULL));
+}
+
+/* =========================================================================
+ * TC-SKN-039: SKN_ExchangeAndCompare — blocking exchange waits for the
+ *             whole transfer; nothing hidden
+ * Tests: REQ-PERF-002, UNIT-SKN-002/017
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ExchangeAndCompare_BlockingLatency(void)
+{
+    /* TC-SKN-039 */
+    cross_channel_state_t local;
+    skn_spi_latency_t     lat;
+    uint8_t safe_out = 1U;
+
+    build_zero_state(&local);
+    set_remote_state(&local);
+    hal_stub_spi_transfer_ticks = 4000U;
+    hal_stub_spi_exchange_ret   = ERR_COMM_TIMEOUT;  /* Transient path */
+
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, SKN_ExchangeAndCompare(&local, &safe_out));
+    TEST_ASSERT_EQUAL_UINT8(0U, safe_out);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetSpiLatency(&lat));
+    TEST_ASSERT_EQUAL_UINT32(1U, lat.exchange_count);
+    TEST_ASSERT_EQUAL_UINT32(4000U, lat.last_blocked_ticks);
+    TEST_ASSERT_EQUAL_UINT32(4000U, lat.max_blocked_ticks);
+    TEST_ASSERT_TRUE(0U == lat.total_hidden_ticks);
+}
+
+/* =========================================================================
+ * TC-SKN-040: SKN_ExchangeComplete — no exchange in flight counts as an SPI
+ *             infrastructure fault (3 consecutive → safe state)
+ * Tests: REQ-SAFE-002, OI-FMEA-001, UNIT-SKN-016
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ExchangeComplete_NotStarted(void)
+{
+    /* TC-SKN-040 */
+    uint8_t safe_out = 1U;
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_ExchangeComplete(NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, SKN_ExchangeComplete(&safe_out));
+    TEST_ASSERT_EQUAL_UINT8(0U, safe_out);
+    TEST_ASSERT_EQUAL_INT(ERR_CRC, SKN_ExchangeComplete(&safe_out));
+    TEST_ASSERT_EQUAL_INT(ERR_COMM_TIMEOUT, SKN_ExchangeComplete(&safe_out));
+    TEST_ASSERT_EQUAL_UINT8(1U, safe_out);
+}
+
+/* =========================================================================
+ * TC-SKN-041: SKN_EncodeWireState/DecodeWireState — every door state, lock
+ *             and obstacle combination round-trips to the unpacked layout;
+ *             the packed form is shorter
+ * Tests: REQ-SAFE-002/008, UNIT-SKN-018/019
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_WireState_RoundTrip(void)
+{
+    /* TC-SKN-041 */
+    cross_channel_state_t in;
+    cross_channel_state_t out;
+    cross_channel_wire_t  wire;
+    uint8_t doors[MAX_DOORS];
+    uint8_t locks[MAX_DOORS];
+    uint8_t obs[MAX_DOORS];
+    uint8_t pattern;
+    uint8_t i;
+
+    TEST_ASSERT_TRUE(CCS_WIRE_BYTES < sizeof(cross_channel_state_t));
+
+    /* Door i state (pattern + i) % 6; lock/obstacle flags from the pattern
+     * bits */
+    for (pattern = 0U; pattern < 64U; pattern++)
+    {
+        for (i = 0U; i < MAX_DOORS; i++)
+        {
+            doors[i] = (uint8_t)((pattern + i) %
+                                 ((uint8_t)DOOR_STATE_FAULT + 1U));
+            locks[i] = (uint8_t)((pattern >> i) & 1U);
+            obs[i]   = (uint8_t)((pattern >> (i + 2U)) & 1U);
+        }
+        (void)SKN_BuildLocalState(&in, (uint16_t)(pattern * 1021U), doors,
+                                  locks, obs, (uint8_t)(pattern ^ 0xA5U),
+                                  (uint8_t)(pattern & 3U));
+
+        TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_EncodeWireState(&in, &wire));
+        TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_DecodeWireState(&wire, &out));
+        TEST_ASSERT_EQUAL_UINT16(in.speed_kmh_x10, out.speed_kmh_x10);
+        TEST_ASSERT_EQUAL_UINT8(in.fault_flags, out.fault_flags);
+        TEST_ASSERT_EQUAL_UINT8(in.safety_decisions, out.safety_decisions);
+        for (i = 0U; i < MAX_DOORS; i++)
+        {
+            TEST_ASSERT_EQUAL_UINT8(in.door_states[i], out.door_states[i]);
+            TEST_ASSERT_EQUAL_UINT8(in.lock_states[i], out.lock_states[i]);
+            TEST_ASSERT_EQUAL_UINT8(in.obstacle_flags[i],
+                                    out.obstacle_flags[i]);
+        }
+        TEST_ASSERT_EQUAL_HEX16(in.crc16, out.crc16);
+    }
+}
+
+/* =========================================================================
+ * TC-SKN-042: SKN_EncodeWireState — values the packed fields cannot hold
+ *             are rejected; ExchangeStart does not send them
+ * Tests: REQ-SAFE-002, UNIT-SKN-015/018/019
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_WireState_RangeAndNull(void)
+{
+    /* TC-SKN-042 */
+    cross_channel_state_t s;
+    cross_channel_wire_t  wire;
+
+    build_zero_state(&s);
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_EncodeWireState(NULL, &wire));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_EncodeWireState(&s, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_DecodeWireState(NULL, &s));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_DecodeWireState(&wire, NULL));
+
+    s.door_states[MAX_DOORS - 1U] = (uint8_t)DOOR_STATE_FAULT + 1U;
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, SKN_EncodeWireState(&s, &wire));
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, SKN_ExchangeStart(&s));
+
+    build_zero_state(&s);
+    s.lock_states[0] = 2U;
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, SKN_EncodeWireState(&s, &wire));
+
+    build_zero_state(&s);
+    s.obstacle_flags[1] = 0xFFU;
+    TEST_ASSERT_EQUAL_INT(ERR_RANGE, SKN_EncodeWireState(&s, &wire));
+}
+
+/* =========================================================================
+ * TC-SKN-043: SKN_ExchangeAndCompare — word-wise compare detects a
+ *             difference in every field; last good remote is readable
+ * Tests: REQ-SAFE-008, UNIT-SKN-003/020
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ExchangeAndCompare_EachFieldDisagrees(void)
+{
+    /* TC-SKN-043 */
+    cross_channel_state_t local;
+    cross_channel_state_t remote;
+    cross_channel_state_t got;
+    uint8_t doors[MAX_DOORS] = {0U};
+    uint8_t locks[MAX_DOORS] = {0U};
+    uint8_t obs[MAX_DOORS]   = {0U};
+    uint8_t safe_out;
+    uint8_t field;
+
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_STATE, SKN_GetRemoteState(&got));
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR, SKN_GetRemoteState(NULL));
+
+    (void)SKN_BuildLocalState(&local, 100U, doors, locks, obs, 0x10U, 1U);
+
+    for (field = 0U; field < 6U; field++)
+    {
+        remote = local;
+        switch (field)
+        {
+            case 0U: remote.speed_kmh_x10 = 101U; break;
+            case 1U: remote.door_states[MAX_DOORS - 1U] = 1U; break;
+            case 2U: remote.lock_states[MAX_DOORS - 1U] = 1U; break;
+            case 3U: remote.obstacle_flags[MAX_DOORS - 1U] = 1U; break;
+            case 4U: remote.fault_flags = 0x11U; break;
+            default: remote.safety_decisions = 3U; break;
+        }
+        set_remote_state(&remote);
+        safe_out = 0U;
+        TEST_ASSERT_EQUAL_INT(ERR_SENSOR_DISAGREE,
+                              SKN_ExchangeAndCompare(&local, &safe_out));
+        TEST_ASSERT_EQUAL_UINT8(1U, safe_out);
+    }
+
+    /* Last exchange passed the CRC check: its decoded state is readable */
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetRemoteState(&got));
+    TEST_ASSERT_EQUAL_UINT8(3U, got.safety_decisions);
+    TEST_ASSERT_EQUAL_UINT16(100U, got.speed_kmh_x10);
+}
+
+/* =========================================================================
+ * TC-SKN-044: SKN_EvaluateDepartureInterlockMask — all MAX_DOORS bits
+ *             required; bits above ignored; safe state / disagreement and
+ *             NULL output fail closed
+ * Tests: REQ-SAFE-007, SW-HAZ-003, UNIT-SKN-021
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_EvaluateDepartureInterlockMask(void)
+{
+    /* TC-SKN-044 */
+    uint8_t ok = 0U;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS,
+        SKN_EvaluateDepartureInterlockMask(DOOR_MASK_ALL, 0U, 0U, &ok));
+    TEST_ASSERT_EQUAL_UINT8(1U, ok);
+    TEST_ASSERT_EQUAL_UINT8(1U, SKN_GetDepartureInterlock());
+
+    (void)SKN_EvaluateDepartureInterlockMask(~(door_mask_t)0U, 0U, 0U, &ok);
+    TEST_ASSERT_EQUAL_UINT8(1U, ok);
+
+    (void)SKN_EvaluateDepartureInterlockMask(
+        DOOR_MASK_ALL & ~DOOR_BIT(MAX_DOORS - 1U), 0U, 0U, &ok);
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+
+    (void)SKN_EvaluateDepartureInterlockMask(~DOOR_MASK_ALL, 0U, 0U, &ok);
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+
+    ok = 1U;
+    (void)SKN_EvaluateDepartureInterlockMask(DOOR_MASK_ALL, 0U, 1U, &ok);
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+    ok = 1U;
+    (void)SKN_EvaluateDepartureInterlockMask(DOOR_MASK_ALL, 1U, 0U, &ok);
+    TEST_ASSERT_EQUAL_UINT8(0U, ok);
+    TEST_ASSERT_EQUAL_UINT8(0U, SKN_GetDepartureInterlock());
+
+    TEST_ASSERT_EQUAL_INT(ERR_NULL_PTR,
+        SKN_EvaluateDepartureInterlockMask(DOOR_MASK_ALL, 0U, 0U, NULL));
+}
+
+/* =========================================================================
+ * TC-SKN-045: SKN_ExchangeComplete — a timed-out exchange counts its wait
+ *             and a failure; transfer and hidden totals keep only completed
+ *             transfers
+ * Tests: REQ-PERF-002, UNIT-SKN-016/017
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_ExchangeComplete_TimeoutLatency(void)
+{
+    /* TC-SKN-045 */
+    cross_channel_state_t local;
+    skn_spi_latency_t     lat;
+    uint8_t safe_out = 1U;
+
+    build_zero_state(&local);
+    set_remote_state(&local);
+
+    /* One completed exchange, fully overlapped */
+    hal_stub_spi_transfer_ticks = 4000U;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ExchangeStart(&local));
+    hal_stub_cycle_counter += 5000U;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ExchangeComplete(&safe_out));
+
+    /* Then a timeout: Complete blocks for the whole bounded wait */
+    hal_stub_spi_transfer_ticks = 9000U;
+    hal_stub_spi_exchange_ret   = ERR_TIMEOUT;
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_ExchangeStart(&local));
+    (void)SKN_ExchangeComplete(&safe_out);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetSpiLatency(&lat));
+    TEST_ASSERT_EQUAL_UINT32(2U, lat.exchange_count);
+    TEST_ASSERT_EQUAL_UINT32(1U, lat.failed_count);
+    TEST_ASSERT_EQUAL_UINT32(9000U, lat.last_blocked_ticks);
+    TEST_ASSERT_EQUAL_UINT32(9000U, lat.max_blocked_ticks);
+    TEST_ASSERT_EQUAL_UINT32(4000U, lat.last_transfer_ticks);
+    TEST_ASSERT_TRUE(4000U == lat.total_transfer_ticks);
+    TEST_ASSERT_TRUE(4000U == lat.total_hidden_ticks);
+
+    /* Re-initialisation clears the failure count */
+    (void)SKN_Init();
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetSpiLatency(&lat));
+    TEST_ASSERT_EQUAL_UINT32(0U, lat.failed_count);
+    TEST_ASSERT_EQUAL_UINT32(0U, lat.exchange_count);
+}
+
+/* =========================================================================
+ * TC-SKN-046: SKN_Background_Run — one chunk stretched to the whole budget
+ *             (interrupt burst, Flash erase) bars the job only until its
+ *             estimate has decayed; the skipped cycles are counted
+ * Tests: REQ-PERF-002, UNIT-SKN-014
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_Background_Run_SlowChunkEstimateDecays(void)
+{
+    /* TC-SKN-046 */
+    uint32_t       limit = (TEST_CYCLE_BUDGET_TICKS / 100U) *
+                           SKN_BG_BUDGET_PERCENT;
+    skn_bg_stats_t stats;
+    uint32_t       cycles = 0U;
+
+    skn_stub_diag_cost_ticks = limit;
+    (void)bg_cycle(0U);
+    TEST_ASSERT_EQUAL_UINT32(1U, skn_stub_diag_calls);
+
+    /* Normal chunks again; half the cycle left each cycle */
+    skn_stub_diag_cost_ticks = 0U;
+    while ((1U == skn_stub_diag_calls) && (cycles < 20U))
+    {
+        (void)bg_cycle(limit / 2U);
+        cycles++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2U, skn_stub_diag_calls);
+    TEST_ASSERT_TRUE(cycles > 1U);
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    TEST_ASSERT_EQUAL_UINT32(cycles - 1U,
+                             stats.skipped_cycles[SKN_BG_JOB_DIAG_PORT]);
+    TEST_ASSERT_EQUAL_UINT16(0U, stats.starved_cycles[SKN_BG_JOB_DIAG_PORT]);
+}
+
+/* =========================================================================
+ * TC-SKN-047: SKN_Background_Run — a job without a chunk for
+ *             SKN_BG_STARVE_CYCLES cycles logs EVT_BG_STARVED once; the
+ *             run of starved cycles ends with the next chunk
+ * Tests: REQ-PERF-002, UNIT-SKN-014
+ * SIL: 3
+ * ========================================================================= */
+void test_SKN_Background_Run_StarvationLogged(void)
+{
+    /* TC-SKN-047 */
+    uint32_t          limit = (TEST_CYCLE_BUDGET_TICKS / 100U) *
+                              SKN_BG_BUDGET_PERCENT;
+    skn_bg_stats_t    stats;
+    event_log_entry_t entry;
+    uint16_t          cycle;
+    uint8_t           job;
+
+    TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_Init());
+
+    for (cycle = 0U; cycle < SKN_BG_STARVE_CYCLES; cycle++)
+    {
+        TEST_ASSERT_EQUAL_UINT16(0U, DGN_GetLogCount());
+        (void)bg_cycle(limit + 1U);
+    }
+    TEST_ASSERT_EQUAL_UINT16(SKN_BG_JOB_COUNT, DGN_GetLogCount());
+    for (job = 0U; job < SKN_BG_JOB_COUNT; job++)
+    {
+        TEST_ASSERT_EQUAL_INT(SUCCESS, DGN_ReadEvent(job, &entry));
+        TEST_ASSERT_EQUAL_UINT8(COMP_SKN, entry.source_comp);
+        TEST_ASSERT_EQUAL_UINT8(EVT_BG_STARVED, entry.event_code);
+        TEST_ASSERT_EQUAL_UINT16(job, entry.data);
+    }
+
+    /* Still starved: not logged again */
+    (void)bg_cycle(limit + 1U);
+    TEST_ASSERT_EQUAL_UINT16(SKN_BG_JOB_COUNT, DGN_GetLogCount());
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    TEST_ASSERT_EQUAL_UINT16(SKN_BG_STARVE_CYCLES + 1U,
+                             stats.starved_cycles[SKN_BG_JOB_SCRUB]);
+
+    /* Slack again */
+    (void)bg_cycle(0U);
+    TEST_ASSERT_EQUAL_INT(SUCCESS, SKN_GetBackgroundStats(&stats));
+    TEST_ASSERT_EQUAL_UINT16(0U, stats.starved_cycles[SKN_BG_JOB_SCRUB]);
+    TEST_ASSERT_EQUAL_UINT32(SKN_BG_STARVE_CYCLES + 1U,
+                             stats.skipped_cycles[SKN_BG_JOB_SCRUB]);
+}
+
 /* =========================================================================
  * Main
  * ========================================================================= */
@@ -543,6 +1241,25 @@ int main(void)
     RUN_TEST(test_SKN_CheckMemoryIntegrity_NullOut);
     RUN_TEST(test_SKN_CheckMemoryIntegrity_Runs);
     RUN_TEST(test_SKN_Init_Success);
+    RUN_TEST(test_SKN_ScrubStep_NullOut);
+    RUN_TEST(test_SKN_ScrubStep_IntactMemory);
+    RUN_TEST(test_SKN_ScrubStep_RamCorruptionDetected);
+    RUN_TEST(test_SKN_CycleTiming_WithinBudget);
+    RUN_TEST(test_SKN_CycleTiming_OverrunLogged);
+    RUN_TEST(test_SKN_IsStepDue_StaticSchedule);
+    RUN_TEST(test_SKN_Background_Run_JobsRunToCompletion);
+    RUN_TEST(test_SKN_Background_Run_StopsAtBudget);
+    RUN_TEST(test_SKN_Scrub_BackgroundStep_DetectsCorruption);
+    RUN_TEST(test_SKN_ExchangeStartComplete_Overlapped);
+    RUN_TEST(test_SKN_ExchangeAndCompare_BlockingLatency);
+    RUN_TEST(test_SKN_ExchangeComplete_NotStarted);
+    RUN_TEST(test_SKN_WireState_RoundTrip);
+    RUN_TEST(test_SKN_WireState_RangeAndNull);
+    RUN_TEST(test_SKN_ExchangeAndCompare_EachFieldDisagrees);
+    RUN_TEST(test_SKN_EvaluateDepartureInterlockMask);
+    RUN_TEST(test_SKN_ExchangeComplete_TimeoutLatency);
+    RUN_TEST(test_SKN_Background_Run_SlowChunkEstimateDecays);
+    RUN_TEST(test_SKN_Background_Run_StarvationLogged);
 
     return UNITY_END();
 }